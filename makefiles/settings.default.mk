@@ -5,6 +5,8 @@ BLD ?= debug
 # WITH_COVERAGE := 1
 # WITH_PAPI :=
 # WITH_V8 := 0
+# WITH_LLVM := 1
+# LLVM_CONFIG := llvm-config-14
 # WITH_PROFILER := 1
 
 # Per Default HYRISE is compiled with MySQL support, set to 0 to disable
@@ -197,6 +197,13 @@ $(error V8_BASE_DIRECTORY is not defined)
 endif
 endif
 
+ifeq ($(WITH_LLVM),1)
+LLVM_CONFIG ?= llvm-config
+ifeq ($(shell which $(LLVM_CONFIG)),)
+$(error $(LLVM_CONFIG) not found, set LLVM_CONFIG to the llvm-config of LLVM 14)
+endif
+endif
+
 include $(PROJECT_ROOT)/makefiles/config.$(COMPILER).mk
 include $(PLUGINS:%=$(PROJECT_ROOT)/mkplugins/%.mk)
 
@@ -17,6 +17,7 @@
 
 #include "helper/HwlocHelper.h"
 #include "net/AsyncConnection.h"
+#include "net/EventLoops.h"
 #include "io/StorageManager.h"
 #include "taskscheduler/SharedScheduler.h"
 
@@ -40,10 +41,10 @@ LoggerPtr logger(Logger::getLogger("hyrise"));
 /// we initialize
 class PortResource {
  public:
-  PortResource(size_t start, size_t end, ebb_server& s) : _current(0) {
+  PortResource(size_t start, size_t end, net::EventLoops& loops) : _current(0) {
     assert((start < end) && "start must be smaller than end");
     for (size_t current = start; current < end; ++current) {
-      if (ebb_server_listen_on_port(&s, current) != -1) {
+      if (loops.listen(current)) {
           _current = current;
           break;
       } else {
@@ -124,6 +125,7 @@ void bindToNode(int node) {
 int main(int argc, char *argv[]) {
   size_t port = 0;
   int worker_threads = 0;
+  size_t event_loops = 1;
   std::string logPropertyFile;
   std::string scheduler_name;
 
@@ -133,7 +135,8 @@ int main(int argc, char *argv[]) {
   ("port,p", po::value<size_t>(&port)->default_value(DEFAULT_PORT), "Server Port")
   ("logdef,l", po::value<std::string>(&logPropertyFile)->default_value("build/log.properties"), "Log4CXX Log Properties File")
   ("scheduler,s", po::value<std::string>(&scheduler_name)->default_value("ThreadPerTaskScheduler"), "Name of the scheduler to use")
-  ("threads,t", po::value<int>(&worker_threads)->default_value(getNumberOfCoresOnSystem()), "Number of worker threads for scheduler (only relevant for scheduler with fixed number of threads)");
+  ("threads,t", po::value<int>(&worker_threads)->default_value(getNumberOfCoresOnSystem()), "Number of worker threads for scheduler (only relevant for scheduler with fixed number of threads)")
+  ("loops,n", po::value<size_t>(&event_loops)->default_value(1), "Number of network threads, each with its own event loop and listening socket");
   po::variables_map vm;
 
   try {
@@ -163,22 +166,14 @@ int main(int argc, char *argv[]) {
 
   SharedScheduler::getInstance().init(scheduler_name, worker_threads);
 
-  // Main Server Loop
-  struct ev_loop *loop = ev_default_loop(0);
-  ebb_server server;
-  // Initialize server based on libev event loop
-  ebb_server_init(&server, loop);
-
-
-  // Define handler for ebb
-  server.new_connection = net::new_connection;
+  // Server loops based on libev, the first one runs on this thread
+  net::EventLoops loops(event_loops);
 
   PidFile pi;
-  PortResource pa(port, port+100, server);
+  PortResource pa(port, port+100, loops);
 
-  LOG4CXX_INFO(logger, "Started server on port " << pa.getPort());
-  ev_loop(loop, 0);
+  LOG4CXX_INFO(logger, "Started server on port " << pa.getPort() << " with " << loops.size() << " event loops");
+  loops.run();
   LOG4CXX_INFO(logger, "Stopping Server...");
-  ev_default_destroy ();
   return 0;
 }
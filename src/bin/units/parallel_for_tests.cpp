@@ -0,0 +1,41 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include "helper/parallel_for.h"
+
+namespace hyrise { namespace helper {
+
+TEST(ParallelForTest, runs_every_item_once) {
+  std::vector<size_t> runs(1000, 0);
+  std::vector<size_t> items(64, 0);
+  parallelFor(runs.size(), 64, [&](const size_t thread, const size_t i) {
+    ++runs[i];
+    ++items[thread];
+  });
+  for (const auto& count : runs)
+    ASSERT_EQ(1u, count);
+
+  // Threads are bounded by the hardware
+  size_t busy = 0;
+  for (const auto& count : items)
+    busy += count > 0 ? 1 : 0;
+  ASSERT_LE(busy, maxParallelThreads());
+}
+
+TEST(ParallelForTest, rethrows_exceptions) {
+  ASSERT_THROW(parallelFor(100, 4, [](const size_t, const size_t i) {
+    if (i == 42)
+      throw std::runtime_error("failed");
+  }), std::runtime_error);
+}
+
+TEST(ParallelForTest, nothing_to_do) {
+  parallelFor(0, 4, [](const size_t, const size_t) {
+    FAIL();
+  });
+}
+
+} } // namespace hyrise::helper
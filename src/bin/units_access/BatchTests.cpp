@@ -0,0 +1,111 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/RequestParseTask.h"
+#include "io/shortcuts.h"
+#include "io/StorageManager.h"
+#include "io/TransactionManager.h"
+#include "storage/AbstractTable.h"
+#include "net/AbstractConnection.h"
+#include "testing/test.h"
+
+#include "json.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+
+class BatchConnection : public net::AbstractConnection {
+ public:
+  explicit BatchConnection(const std::string &body) : _body(body) {}
+
+  std::string getBody() const { return _body; }
+  std::string getPath() const { return "/batch/"; }
+  bool hasBody() const { return !_body.empty(); }
+  void respond(const std::string &message, size_t status, const std::string &contentType) {
+    _response = message;
+  }
+
+  Json::Value response() const {
+    Json::Value result;
+    Json::Reader().parse(_response, result);
+    return result;
+  }
+
+ private:
+  std::string _body;
+  std::string _response;
+};
+
+const std::string get_table = "{\"operators\": {\"get\": {\"type\": \"GetTable\", \"name\": \"batchTable\"}}}";
+
+Json::Value execute(const std::string &body) {
+  BatchConnection connection(body);
+  auto request = std::make_shared<RequestParseTask>(&connection);
+  (*request)();
+  return connection.response();
+}
+
+}
+
+class BatchTests : public AccessTest {
+ public:
+  void SetUp() {
+    AccessTest::SetUp();
+    table = Loader::shortcuts::load("test/lin_xxs.tbl");
+    io::StorageManager::getInstance()->loadTable("batchTable", table);
+  }
+
+  void TearDown() {
+    io::StorageManager::getInstance()->removeTable("batchTable");
+    AccessTest::TearDown();
+  }
+
+  storage::atable_ptr_t table;
+};
+
+TEST_F(BatchTests, queries_share_a_transaction) {
+  const auto response = execute("queries=[" + get_table + "," + get_table + "]");
+  const auto &results = response["results"];
+  ASSERT_EQ(2u, results.size());
+  for (const auto &result : results) {
+    ASSERT_EQ(table->size(), result["rows"].size());
+    ASSERT_FALSE(result.isMember("error"));
+  }
+  ASSERT_EQ(results[0u]["session_context"], results[1u]["session_context"]);
+}
+
+TEST_F(BatchTests, autocommit_ends_the_transaction_with_the_last_query) {
+  const auto response = execute("autocommit=true&queries=[" + get_table + "," + get_table + "]");
+  const auto &results = response["results"];
+  ASSERT_EQ(2u, results.size());
+  ASSERT_TRUE(results[0u].isMember("session_context"));
+  ASSERT_FALSE(results[1u].isMember("session_context"));
+}
+
+TEST_F(BatchTests, execution_stops_at_the_first_failing_query) {
+  const std::string unknown = "{\"operators\": {\"x\": {\"type\": \"UnknownOperation\"}}}";
+  const auto response = execute("queries=[" + get_table + "," + unknown + "," + get_table + "]");
+  const auto &results = response["results"];
+  ASSERT_EQ(2u, results.size());
+  ASSERT_FALSE(results[0u].isMember("error"));
+  ASSERT_TRUE(results[1u].isMember("error"));
+}
+
+TEST_F(BatchTests, failed_autocommit_batch_rolls_back) {
+  const std::string unknown = "{\"operators\": {\"x\": {\"type\": \"UnknownOperation\"}}}";
+  const auto response = execute("autocommit=true&queries=[" + get_table + "," + unknown + "," + get_table + "]");
+  const auto &results = response["results"];
+  ASSERT_EQ(2u, results.size());
+  ASSERT_TRUE(results[1u].isMember("error"));
+  const auto tid = results[0u]["session_context"].asInt64();
+  ASSERT_FALSE(tx::TransactionManager::isRunningTransaction(tid));
+}
+
+TEST_F(BatchTests, queries_need_to_be_an_array) {
+  const auto response = execute("queries=" + get_table);
+  ASSERT_FALSE(response.isMember("results"));
+  ASSERT_TRUE(response.isMember("error"));
+}
+
+}
+}
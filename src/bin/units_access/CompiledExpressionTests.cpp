@@ -0,0 +1,285 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/SimpleTableScan.h"
+#include "access/UpdateScan.h"
+#include "access/expressions/pred_EqualsExpression.h"
+#include "access/expressions/pred_buildExpression.h"
+#include "access/expressions/pred_CompiledExpression.h"
+#include "access/expressions/ScanCompiler.h"
+#include "access/system/QueryParser.h"
+#include "io/TransactionManager.h"
+#include "io/shortcuts.h"
+#include "storage/PointerCalculator.h"
+#include "storage/RunLengthVector.h"
+#include "storage/TableBuilder.h"
+#include "storage/Store.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class CompiledExpressionTests : public AccessTest {
+ protected:
+  Json::Value predicates(const std::string &json) {
+    Json::Value root;
+    Json::Reader reader;
+    EXPECT_TRUE(reader.parse(json, root));
+    return root;
+  }
+
+  // The compiled predicates have to select the same rows as the
+  // interpreted expressions of `reference`, by default the same predicates
+  void expectSameRows(const storage::c_atable_ptr_t &table, const std::string &json, const std::string &reference = "") {
+    const auto p = predicates(json);
+    std::unique_ptr<CompiledExpression> compiled(CompiledExpression::compile(p));
+    ASSERT_TRUE(compiled != nullptr) << json;
+    std::unique_ptr<SimpleExpression> interpreted(buildExpression(reference.empty() ? p : predicates(reference)));
+    compiled->walk({table});
+    interpreted->walk({table});
+
+    std::unique_ptr<pos_list_t> expected(interpreted->match(0, table->size()));
+    std::unique_ptr<pos_list_t> rows(compiled->match(0, table->size()));
+    EXPECT_EQ(*expected, *rows) << json;
+
+    for (size_t row = 0; row < table->size(); ++row)
+      EXPECT_EQ((*interpreted)(row), (*compiled)(row)) << json << " row " << row;
+
+    const size_t start = table->size() / 3;
+    expected.reset(interpreted->match(start, table->size()));
+    rows.reset(compiled->match(start, table->size()));
+    EXPECT_EQ(*expected, *rows) << json;
+  }
+
+  // Number of zone map chunks a scan of the whole table skips
+  size_t skippedChunks(const storage::c_atable_ptr_t &table, const std::string &json) {
+    std::unique_ptr<CompiledExpression> compiled(CompiledExpression::compile(predicates(json)));
+    compiled->walk({table});
+    std::unique_ptr<pos_list_t> rows(compiled->match(0, table->size()));
+    return compiled->skippedChunks();
+  }
+
+  std::shared_ptr<storage::Store> storeWithDelta() {
+    auto s = std::dynamic_pointer_cast<storage::Store>(Loader::shortcuts::load("test/lin_xxs.tbl"));
+    const size_t main_size = s->getMainTable()->size();
+    s->appendToDelta(30);
+    for (size_t row = main_size; row < s->size(); ++row) {
+      for (size_t column = 0; column < s->columnCount(); ++column)
+        s->setValue<storage::hyrise_int_t>(column, row, (row % 7) * 100 + column);
+    }
+    return s;
+  }
+};
+
+TEST_F(CompiledExpressionTests, comparisons_on_main_and_delta) {
+  auto s = storeWithDelta();
+  // The interpreted EQ only finds values of the main dictionary
+  expectSameRows(s, "[{\"type\": \"EQ\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 300}]",
+                 "[{\"type\": \"EQ_V\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 300}]");
+  expectSameRows(s, "[{\"type\": \"EQ\", \"in\": 0, \"f\": \"col_1\", \"vtype\": 0, \"value\": 55}]",
+                 "[{\"type\": \"EQ_V\", \"in\": 0, \"f\": \"col_1\", \"vtype\": 0, \"value\": 55}]");
+  expectSameRows(s, "[{\"type\": \"LT_V\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 305}]");
+  expectSameRows(s, "[{\"type\": \"LTE_V\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 300}]");
+  expectSameRows(s, "[{\"type\": \"GT_V\", \"in\": 0, \"f\": 8, \"vtype\": 0, \"value\": 508}]");
+  expectSameRows(s, "[{\"type\": \"GTE_V\", \"in\": 0, \"f\": 9, \"vtype\": 0, \"value\": 509}]");
+  expectSameRows(s, "[{\"type\": \"IN\", \"in\": 0, \"f\": 2, \"vtype\": 0, \"value\": [2, 302, 1000, 602]}]");
+  expectSameRows(s, "[{\"type\": \"NEQ_V\", \"in\": 0, \"f\": 3, \"vtype\": 0, \"value\": 403}]");
+  expectSameRows(s, "[{\"type\": \"NEQ_V\", \"in\": 0, \"f\": 3, \"vtype\": 0, \"value\": 1}]");
+  expectSameRows(s, "[{\"type\": \"BETWEEN\", \"in\": 0, \"f\": 4, \"vtype\": 0, \"value\": [204, 504]}]",
+                 "[{\"type\": \"AND\"},"
+                 " {\"type\": \"GTE_V\", \"in\": 0, \"f\": 4, \"vtype\": 0, \"value\": 204},"
+                 " {\"type\": \"LTE_V\", \"in\": 0, \"f\": 4, \"vtype\": 0, \"value\": 504}]");
+}
+
+TEST_F(CompiledExpressionTests, conjunctions_and_negations) {
+  auto s = storeWithDelta();
+  expectSameRows(s,
+                 "[{\"type\": \"AND\"},"
+                 " {\"type\": \"GTE_V\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 200},"
+                 " {\"type\": \"LT_V\", \"in\": 0, \"f\": 1, \"vtype\": 0, \"value\": 601}]");
+  expectSameRows(s,
+                 "[{\"type\": \"AND\"},"
+                 " {\"type\": \"AND\"},"
+                 " {\"type\": \"NEQ_V\", \"in\": 0, \"f\": 2, \"vtype\": 0, \"value\": 302},"
+                 " {\"type\": \"IN\", \"in\": 0, \"f\": 5, \"vtype\": 0, \"value\": [5, 305, 405, 15]},"
+                 " {\"type\": \"GT_V\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 0}]");
+  expectSameRows(s,
+                 "[{\"type\": \"OR\"},"
+                 " {\"type\": \"NOT\"},"
+                 " {\"type\": \"GT_V\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 100},"
+                 " {\"type\": \"AND\"},"
+                 " {\"type\": \"EQ_V\", \"in\": 0, \"f\": 8, \"vtype\": 0, \"value\": 408},"
+                 " {\"type\": \"IN\", \"in\": 0, \"f\": 3, \"vtype\": 0, \"value\": [403, 503]}]");
+}
+
+TEST_F(CompiledExpressionTests, all_types) {
+  auto t = Loader::shortcuts::load("test/alltypes.tbl");
+  expectSameRows(t, "[{\"type\": \"EQ\", \"in\": 0, \"f\": 1, \"vtype\": 2, \"value\": \"grace\"}]");
+  expectSameRows(t, "[{\"type\": \"LT_V\", \"in\": 0, \"f\": 1, \"vtype\": 2, \"value\": \"h\"}]");
+  expectSameRows(t, "[{\"type\": \"GT_V\", \"in\": 0, \"f\": 2, \"vtype\": 1, \"value\": 0.1}]");
+  expectSameRows(t, "[{\"type\": \"IN\", \"in\": 0, \"f\": 1, \"vtype\": 2, \"value\": [\"s\", \"amazing\"]}]");
+}
+
+TEST_F(CompiledExpressionTests, chunks_skipped_by_zone_maps) {
+  storage::TableBuilder::param_list list;
+  list.append().set_type("INTEGER").set_name("ts");
+  list.append().set_type("INTEGER").set_name("mod");
+  auto main = storage::TableBuilder::build(list);
+  const size_t rows = storage::ZoneMap::chunk_rows + 1000;
+  main->resize(rows);
+  for (size_t row = 0; row < rows; ++row)
+    main->setValue<storage::hyrise_int_t>(0, row, row);
+  for (size_t row = 0; row < rows; ++row)
+    main->setValue<storage::hyrise_int_t>(1, row, 0);
+
+  const std::string later = "[{\"type\": \"GTE_V\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 65600}]";
+  const std::string none = "[{\"type\": \"GTE_V\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 70000}]";
+  const std::string first = "[{\"type\": \"LT_V\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 65540}]";
+  const std::string negated = "[{\"type\": \"OR\"},"
+                              " {\"type\": \"NOT\"},"
+                              " {\"type\": \"EQ_V\", \"in\": 0, \"f\": 1, \"vtype\": 0, \"value\": 0},"
+                              " {\"type\": \"LT_V\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 10}]";
+
+  // A store without delta rows only scans its main
+  auto s = std::make_shared<storage::Store>(main);
+  EXPECT_EQ(1u, skippedChunks(s, later));
+  EXPECT_EQ(2u, skippedChunks(s, none));
+  expectSameRows(s, later);
+  expectSameRows(s, first);
+  expectSameRows(s, negated);
+
+  s->appendToDelta(100);
+  for (size_t row = rows; row < s->size(); ++row) {
+    s->setValue<storage::hyrise_int_t>(0, row, row);
+    s->setValue<storage::hyrise_int_t>(1, row, row % 3);
+  }
+
+  // Only the second chunk of the main and the delta can match
+  EXPECT_EQ(1u, skippedChunks(s, later));
+  EXPECT_EQ(3u, skippedChunks(s, none));
+  expectSameRows(s, later);
+  // Every row of the first chunk matches
+  expectSameRows(s, first);
+  expectSameRows(s, negated);
+}
+
+TEST_F(CompiledExpressionTests, updated_rows_are_found_in_the_delta) {
+  storage::TableBuilder::param_list list;
+  list.append().set_type("INTEGER").set_name("ts");
+  list.append().set_type("INTEGER").set_name("mod");
+  auto main = storage::TableBuilder::build(list);
+  main->resize(1000);
+  for (size_t row = 0; row < 1000; ++row) {
+    main->setValue<storage::hyrise_int_t>(0, row, row);
+    main->setValue<storage::hyrise_int_t>(1, row, row % 3);
+  }
+  auto s = std::make_shared<storage::Store>(main);
+
+  storage::TableBuilder::param_list data_list;
+  data_list.append().set_type("INTEGER").set_name("mod");
+  auto data = storage::TableBuilder::build(data_list);
+  data->resize(1);
+  data->setValue<storage::hyrise_int_t>(0, 0, 7);
+
+  storage::c_atable_ptr_t input = s;
+  EqualsExpression<storage::hyrise_int_t> eq(input, 0, 5);
+  eq.walk({input});
+  UpdateScan us;
+  us.setTXContext(tx::TransactionManager::getInstance().buildContext());
+  us.addInput(s);
+  us.setUpdateTable(data);
+  us.setPredicate(&eq);
+  us.execute();
+
+  ASSERT_EQ(1001u, s->size());
+  EXPECT_EQ(5, s->getValue<storage::hyrise_int_t>(0, 1000));
+  EXPECT_EQ(7, s->getValue<storage::hyrise_int_t>(1, 1000));
+  expectSameRows(s, "[{\"type\": \"EQ_V\", \"in\": 0, \"f\": 1, \"vtype\": 0, \"value\": 7}]");
+}
+
+TEST_F(CompiledExpressionTests, pointer_calculators_use_interpreted_expressions) {
+  auto s = storeWithDelta();
+  auto pc = PointerCalculator::create(s, new pos_list_t({3, 1, 120, 101, 7}));
+  expectSameRows(pc, "[{\"type\": \"LT_V\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 305}]");
+}
+
+TEST_F(CompiledExpressionTests, programs_are_cached) {
+  CompiledExpression::clearCache();
+  const auto p = predicates("[{\"type\": \"EQ\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 300}]");
+  std::unique_ptr<CompiledExpression> first(CompiledExpression::compile(p));
+  std::unique_ptr<CompiledExpression> second(CompiledExpression::compile(p));
+  ASSERT_TRUE(first != nullptr);
+  ASSERT_TRUE(second != nullptr);
+  ASSERT_EQ(1u, CompiledExpression::cachedPrograms());
+
+  const auto other_input = predicates("[{\"type\": \"EQ\", \"in\": 1, \"f\": 0, \"vtype\": 0, \"value\": 1}]");
+  ASSERT_TRUE(CompiledExpression::compile(other_input) == nullptr);
+}
+
+#ifdef WITH_LLVM
+TEST_F(CompiledExpressionTests, scans_are_compiled_once_per_plan) {
+  // A bit compressed main and a concurrent delta
+  auto s = storeWithDelta();
+  expectSameRows(s, "[{\"type\": \"LT_V\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 305}]");
+  const size_t compiled = ScanCompiler::compiledScans();
+  EXPECT_LT(0u, compiled);
+  expectSameRows(s, "[{\"type\": \"LT_V\", \"in\": 0, \"f\": 3, \"vtype\": 0, \"value\": 103}]");
+  EXPECT_EQ(compiled, ScanCompiler::compiledScans());
+
+  // Vectors without a loop of their own are read through get()
+  const auto main = s->getMainTable();
+  std::vector<value_id_t> ids;
+  for (size_t row = 0; row < main->size(); ++row)
+    ids.push_back(main->getValueId(0, row).valueId);
+  auto encoded = std::make_shared<Table>(std::vector<ColumnMetadata> {*main->metadataAt(0)},
+                                         std::make_shared<RunLengthVector<value_id_t> >(ids),
+                                         std::vector<AbstractTable::SharedDictionaryPtr> {main->dictionaryAt(0)});
+  expectSameRows(encoded,
+                 "[{\"type\": \"OR\"},"
+                 " {\"type\": \"LT_V\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 5},"
+                 " {\"type\": \"IN\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": [7, 11, 20]}]");
+  EXPECT_EQ(compiled + 1, ScanCompiler::compiledScans());
+}
+#endif
+
+TEST_F(CompiledExpressionTests, like_on_main_and_delta) {
+  storage::TableBuilder::param_list list;
+  list.append().set_type("STRING").set_name("sku");
+  auto s = std::make_shared<storage::Store>(storage::TableBuilder::build(list));
+  s->appendToDelta(200);
+  for (size_t row = 0; row < s->size(); ++row)
+    s->setValue<storage::hyrise_string_t>(0, row, (row % 3 ? "item-" : "part-") + std::to_string(row % 70));
+  s->merge();
+  const size_t main_size = s->size();
+  s->appendToDelta(50);
+  for (size_t row = main_size; row < s->size(); ++row)
+    s->setValue<storage::hyrise_string_t>(0, row, "item-" + std::to_string(row));
+
+  expectSameRows(s, "[{\"type\": \"LIKE\", \"in\": 0, \"f\": 0, \"vtype\": 2, \"value\": \"item-.*\"}]");
+  expectSameRows(s, "[{\"type\": \"LIKE\", \"in\": 0, \"f\": 0, \"vtype\": 2, \"value\": \"item-2.\"}]");
+  expectSameRows(s, "[{\"type\": \"LIKE\", \"in\": 0, \"f\": 0, \"vtype\": 2, \"value\": \".*-1[0-9]\"}]");
+  expectSameRows(s, "[{\"type\": \"LIKE\", \"in\": 0, \"f\": 0, \"vtype\": 2, \"value\": \"parts?-6.*\"}]");
+  expectSameRows(s,
+                 "[{\"type\": \"AND\"},"
+                 " {\"type\": \"LIKE\", \"in\": 0, \"f\": 0, \"vtype\": 2, \"value\": \"part-.*\"},"
+                 " {\"type\": \"GT_V\", \"in\": 0, \"f\": 0, \"vtype\": 2, \"value\": \"part-5\"}]");
+}
+
+TEST_F(CompiledExpressionTests, simple_table_scan_of_delta) {
+  auto s = storeWithDelta();
+  Json::Value data = predicates(
+      "{\"type\": \"SimpleTableScan\", \"ofDelta\": true,"
+      " \"predicates\": [{\"type\": \"LT_V\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 305}]}");
+  auto scan = QueryParser::instance().parse("SimpleTableScan", data);
+  scan->addInput(s);
+  scan->execute();
+
+  const auto& result = scan->getResultTable();
+  size_t expected = 0;
+  for (size_t row = s->deltaOffset(); row < s->size(); ++row)
+    expected += s->getValue<storage::hyrise_int_t>(0, row) < 305;
+  ASSERT_EQ(expected, result->size());
+  for (size_t row = 0; row < result->size(); ++row)
+    ASSERT_LT(result->getValue<storage::hyrise_int_t>(0, row), 305);
+}
+
+}
+}
@@ -1,12 +1,23 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/ExpressionScan.h"
+#include "access/system/QueryParser.h"
 #include "io/shortcuts.h"
 #include "testing/test.h"
 
 namespace hyrise {
 namespace access {
 
-class ExpressionScanTests : public AccessTest {};
+class ExpressionScanTests : public AccessTest {
+ protected:
+  std::shared_ptr<PlanOperation> parse(const storage::c_atable_ptr_t &t, const std::string &expressions) {
+    Json::Value root;
+    Json::Reader reader;
+    EXPECT_TRUE(reader.parse("{\"type\": \"ExpressionScan\", \"expressions\": " + expressions + "}", root));
+    auto es = std::dynamic_pointer_cast<PlanOperation>(QueryParser::instance().parse("ExpressionScan", root));
+    es->addInput(t);
+    return es;
+  }
+};
 
 TEST_F(ExpressionScanTests, basic_expression_scan_test) {
   auto t = Loader::shortcuts::load("test/lin_xxxs.tbl");
@@ -24,5 +35,44 @@ TEST_F(ExpressionScanTests, basic_expression_scan_test) {
   ASSERT_TABLE_EQUAL(result, reference);
 }
 
+TEST_F(ExpressionScanTests, arithmetic_expressions_from_json) {
+  auto t = Loader::shortcuts::load("test/lin_xxs.tbl");
+  const auto& es = parse(t, R"([
+    {"name": "sum", "expression": {"op": "+", "left": {"op": "*", "left": {"column": 0}, "right": {"value": 2}},
+                                   "right": {"column": "col_1"}}},
+    {"name": "ratio", "expression": {"op": "/", "left": {"op": "CAST", "to": "FLOAT", "of": {"column": 2}},
+                                     "right": {"value": 4.0}}},
+    {"name": "bucket", "expression": {"op": "CASE",
+                                      "cases": [{"when": {"op": "<", "left": {"column": 0}, "right": {"value": 300}}, "then": {"value": 1}},
+                                                {"when": {"op": "AND", "left": {"op": ">=", "left": {"column": 0}, "right": {"value": 300}},
+                                                                       "right": {"op": "!=", "left": {"column": 1}, "right": {"value": 501}}},
+                                                 "then": {"value": 2.5}}],
+                                      "else": {"column": 3}}}
+  ])");
+  es->execute();
+  const auto& result = es->getResultTable();
+
+  ASSERT_EQ(t->columnCount() + 3, result->columnCount());
+  ASSERT_EQ(IntegerType, result->typeOfColumn(10));
+  ASSERT_EQ(FloatType, result->typeOfColumn(11));
+  ASSERT_EQ(FloatType, result->typeOfColumn(12));
+  ASSERT_EQ("bucket", result->nameOfColumn(12));
+
+  for (size_t row = 0; row < t->size(); ++row) {
+    const auto col0 = t->getValue<hyrise_int_t>(0, row);
+    const auto col1 = t->getValue<hyrise_int_t>(1, row);
+    ASSERT_EQ(col0 * 2 + col1, result->getValue<hyrise_int_t>(10, row));
+    ASSERT_FLOAT_EQ(t->getValue<hyrise_int_t>(2, row) / 4.0f, result->getValue<hyrise_float_t>(11, row));
+    const float bucket = col0 < 300 ? 1.0f : col1 != 501 ? 2.5f : t->getValue<hyrise_int_t>(3, row);
+    ASSERT_FLOAT_EQ(bucket, result->getValue<hyrise_float_t>(12, row));
+  }
+}
+
+TEST_F(ExpressionScanTests, integer_division_by_zero) {
+  auto t = Loader::shortcuts::load("test/lin_xxs.tbl");
+  const auto& es = parse(t, R"([{"name": "div", "expression": {"op": "/", "left": {"column": 1}, "right": {"column": 0}}}])");
+  ASSERT_THROW(es->execute(), std::runtime_error);
+}
+
 }
 }
@@ -1,6 +1,7 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/HashBuild.h"
 #include "io/shortcuts.h"
+#include "storage/GroupKeyJoinTable.h"
 #include "storage/HashTable.h"
 #include "testing/test.h"
 
@@ -37,5 +38,19 @@ TEST_F(HashBuildTests, basic_hash_build_for_join_test) {
   ASSERT_NE(result.get(), (JoinHashTable *) nullptr);
 }
 
+TEST_F(HashBuildTests, join_on_base_table_uses_group_key_index) {
+  auto t = Loader::shortcuts::load("test/10_30_group.tbl");
+
+  HashBuild hb;
+  hb.addInput(t);
+  hb.addField(0);
+  hb.setKey("join");
+  hb.execute();
+
+  const auto &result = std::dynamic_pointer_cast<const storage::GroupKeyJoinTable>(hb.getResultHashTable());
+  ASSERT_NE(result.get(), (storage::GroupKeyJoinTable *) nullptr);
+  EXPECT_EQ(t, result->getTable());
+}
+
 }
 }
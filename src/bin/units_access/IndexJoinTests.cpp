@@ -0,0 +1,87 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/HashBuild.h"
+#include "access/HashJoinProbe.h"
+#include "access/IndexJoin.h"
+#include "access/MergeJoin.h"
+#include "access/system/QueryParser.h"
+#include "io/shortcuts.h"
+#include "storage/AbstractHashTable.h"
+#include "storage/Store.h"
+#include "testing/test.h"
+#include "testing/TableEqualityTest.h"
+
+namespace hyrise {
+namespace access {
+
+class IndexJoinTests : public AccessTest {
+ protected:
+  storage::c_atable_ptr_t mergeJoin(const storage::c_atable_ptr_t &probe, const storage::c_atable_ptr_t &base) {
+    MergeJoin mj;
+    mj.addInput(probe);
+    mj.addInput(base);
+    mj.addField(0);
+    mj.addField(0);
+    return mj.execute()->getResultTable();
+  }
+
+  // Base table with copies of its first rows in the delta
+  std::shared_ptr<storage::Store> exchangeWithDelta() {
+    auto store = std::dynamic_pointer_cast<storage::Store>(Loader::shortcuts::load("test/join_exchange.tbl"));
+    const auto area = store->appendToDelta(3);
+    for (size_t row = area.first; row < area.second; ++row)
+      store->copyRowToDelta(store, row, row, tx::START_TID);
+    return store;
+  }
+};
+
+TEST_F(IndexJoinTests, basic_index_join_test) {
+  auto t1 = Loader::shortcuts::load("test/join_transactions.tbl");
+  auto t2 = Loader::shortcuts::load("test/join_exchange.tbl");
+  auto reference = Loader::shortcuts::load("test/reference/hash_value_join_result.tbl");
+
+  IndexJoin ij;
+  ij.addInput(t1);
+  ij.addInput(t2);
+  ij.addField(0);
+  ij.addField(0);
+  ij.execute();
+
+  EXPECT_RELATION_EQ(ij.getResultTable(), reference);
+}
+
+TEST_F(IndexJoinTests, base_table_with_delta) {
+  auto t1 = Loader::shortcuts::load("test/join_transactions.tbl");
+  auto t2 = exchangeWithDelta();
+
+  Json::Value data;
+  data["fields"].append(0);
+  data["fields"].append(0);
+  auto ij = QueryParser::instance().parse("IndexJoin", data);
+  ij->addInput(t1);
+  ij->addInput(t2);
+  ij->execute();
+
+  EXPECT_RELATION_EQ(ij->getResultTable(), mergeJoin(t1, t2));
+}
+
+TEST_F(IndexJoinTests, hash_join_probe_on_group_key_index) {
+  auto t1 = Loader::shortcuts::load("test/join_transactions.tbl");
+  auto t2 = exchangeWithDelta();
+
+  HashBuild hb;
+  hb.addInput(t2);
+  hb.addField(0);
+  hb.setKey("join");
+  hb.execute();
+
+  HashJoinProbe hjp;
+  hjp.addInput(t1);
+  hjp.addField(0);
+  hjp.addInput(hb.getResultHashTable());
+  hjp.execute();
+
+  EXPECT_RELATION_EQ(hjp.getResultTable(), mergeJoin(t1, t2));
+}
+
+}
+}
@@ -1,8 +1,15 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/IndexScan.h"
 #include "access/CreateIndex.h"
+#include "access/InsertScan.h"
+#include "access/PosUpdateScan.h"
+#include "access/SimpleTableScan.h"
+#include "access/system/QueryParser.h"
+#include "access/tx/Commit.h"
 #include "helper/types.h"
+#include "storage/PointerCalculator.h"
 #include "io/shortcuts.h"
+#include "io/TransactionManager.h"
 #include "testing/test.h"
 
 namespace hyrise {
@@ -22,6 +29,28 @@ public:
     ci.execute();
   }
 
+  std::shared_ptr<PlanOperation> parse(const std::string &json) {
+    Json::Value data;
+    Json::Reader reader;
+    EXPECT_TRUE(reader.parse(json, data));
+    return QueryParser::instance().parse(data["type"].asString(), data);
+  }
+
+  void createSecondaryIndex(const std::string &fields) {
+    auto ci = parse("{\"type\": \"CreateIndex\", \"fields\": " + fields +
+                    ", \"index_name\": \"my_secondary\", \"secondary\": true}");
+    ci->addInput(t);
+    ci->execute();
+  }
+
+  storage::c_atable_ptr_t secondaryScan(const std::string &key, const tx::TXContext &ctx) {
+    auto is = parse("{\"type\": \"IndexScan\", \"fields\": [0, 3], \"index\": \"my_secondary\", \"vtype\": 0, " + key + "}");
+    is->setTXContext(ctx);
+    is->addInput(t);
+    is->execute();
+    return is->getResultTable();
+  }
+
   storage::atable_ptr_t t;
 };
 
@@ -40,5 +69,135 @@ TEST_F(IndexScanTests, basic_index_scan_test) {
   ASSERT_TABLE_EQUAL(result, reference);
 }
 
+TEST_F(IndexScanTests, secondary_index_scan) {
+  auto reference = Loader::shortcuts::load("test/reference/index_test_result.tbl");
+  createSecondaryIndex("[0, 3]");
+  const auto ctx = tx::TransactionManager::getInstance().buildContext();
+
+  ASSERT_TABLE_EQUAL(secondaryScan("\"value\": 200", ctx), reference);
+  ASSERT_TABLE_EQUAL(secondaryScan("\"value\": [200, 203]", ctx), reference);
+  EXPECT_EQ(0u, secondaryScan("\"value\": [200, 204]", ctx)->size());
+  EXPECT_EQ(5u, secondaryScan("\"value\": 200, \"value_to\": 240", ctx)->size());
+  EXPECT_EQ(1u, secondaryScan("\"value\": [200, 190], \"value_to\": 213", ctx)->size());
+}
+
+TEST_F(IndexScanTests, secondary_index_is_maintained_on_insert) {
+  auto row = Loader::shortcuts::load("test/reference/index_test_result.tbl");
+  createSecondaryIndex("[0]");
+
+  auto& txmgr = tx::TransactionManager::getInstance();
+  const auto writeCtx = txmgr.buildContext();
+  const auto readCtx = txmgr.buildContext();
+
+  InsertScan insert;
+  insert.setTXContext(writeCtx);
+  insert.addInput(t);
+  insert.setInputData(row);
+  insert.execute();
+
+  // Only the inserting transaction sees the new row before the commit
+  EXPECT_EQ(2u, secondaryScan("\"value\": 200", writeCtx)->size());
+  EXPECT_EQ(1u, secondaryScan("\"value\": 200", readCtx)->size());
+
+  Commit commit;
+  commit.addInput(t);
+  commit.setTXContext(writeCtx);
+  commit.execute();
+
+  EXPECT_EQ(2u, secondaryScan("\"value\": 200", txmgr.buildContext())->size());
+  EXPECT_EQ(1u, secondaryScan("\"value\": 200", readCtx)->size());
+}
+
+TEST_F(IndexScanTests, primary_key_is_unique_on_insert) {
+  auto reference = Loader::shortcuts::load("test/reference/index_test_result.tbl");
+  auto ci = parse("{\"type\": \"CreateIndex\", \"fields\": [0], \"index_name\": \"my_key\", \"primary_key\": true}");
+  ci->addInput(t);
+  ci->execute();
+
+  auto& txmgr = tx::TransactionManager::getInstance();
+  auto insert = [&](const storage::atable_ptr_t &row, const tx::TXContext &ctx) {
+    InsertScan is;
+    is.setTXContext(ctx);
+    is.addInput(t);
+    is.setInputData(row);
+    is.execute();
+  };
+  auto byKey = [&](const std::string &op) {
+    auto scan = parse(op == "IndexScan" ?
+        "{\"type\": \"IndexScan\", \"vtype\": 0, \"value\": 5000}" :
+        "{\"type\": \"SimpleTableScan\", \"predicates\": [{\"type\": \"EQ\", \"in\": 0, \"f\": 0, \"vtype\": 0, \"value\": 5000}]}");
+    scan->setTXContext(txmgr.buildContext());
+    scan->addInput(t);
+    scan->execute();
+    return scan->getResultTable();
+  };
+
+  EXPECT_THROW(insert(reference, txmgr.buildContext()), std::runtime_error);
+
+  auto row = Loader::shortcuts::load("test/reference/index_test_result.tbl");
+  row->setValue<hyrise_int_t>(0, 0, 5000);
+  const auto writeCtx = txmgr.buildContext();
+  insert(row, writeCtx);
+  // The key is taken as long as the inserting transaction may commit
+  EXPECT_THROW(insert(row, txmgr.buildContext()), std::runtime_error);
+
+  Commit commit;
+  commit.addInput(t);
+  commit.setTXContext(writeCtx);
+  commit.execute();
+
+  EXPECT_THROW(insert(row, txmgr.buildContext()), std::runtime_error);
+  ASSERT_EQ(1u, byKey("IndexScan")->size());
+  ASSERT_TABLE_EQUAL(byKey("IndexScan"), row);
+  ASSERT_TABLE_EQUAL(byKey("SimpleTableScan"), row);
+}
+
+TEST_F(IndexScanTests, primary_key_is_unique_on_update) {
+  auto ci = parse("{\"type\": \"CreateIndex\", \"fields\": [0], \"index_name\": \"my_key\", \"primary_key\": true}");
+  ci->addInput(t);
+  ci->execute();
+
+  auto& txmgr = tx::TransactionManager::getInstance();
+  auto update = [&](const pos_t row, const hyrise_int_t key, const tx::TXContext &ctx) {
+    PosUpdateScan us;
+    us.setTXContext(ctx);
+    us.addInput(PointerCalculator::create(t, new pos_list_t({row})));
+    Json::Value data;
+    data["col_0"] = Json::Int64(key);
+    us.setRawData(data);
+    us.execute();
+  };
+
+  const size_t before = t->size();
+  // Row 1 holds key 10, row 2 key 20
+  EXPECT_THROW(update(1, 20, txmgr.buildContext()), std::runtime_error);
+  EXPECT_EQ(before, t->size());
+
+  // The updated row frees its own key
+  const auto writeCtx = txmgr.buildContext();
+  update(1, 10, writeCtx);
+  update(2, 5000, writeCtx);
+  EXPECT_EQ(before + 2, t->size());
+  Commit commit;
+  commit.addInput(t);
+  commit.setTXContext(writeCtx);
+  commit.execute();
+
+  EXPECT_THROW(update(3, 5000, txmgr.buildContext()), std::runtime_error);
+  update(3, 20, txmgr.buildContext());
+}
+
+TEST_F(IndexScanTests, group_key_index_scan) {
+  auto reference = Loader::shortcuts::load("test/reference/index_test_result.tbl");
+  auto ci = parse("{\"type\": \"CreateIndex\", \"fields\": [0], \"index_name\": \"my_groups\", \"group_key\": true}");
+  ci->addInput(t);
+  ci->execute();
+
+  auto is = parse("{\"type\": \"IndexScan\", \"fields\": [0], \"index\": \"my_groups\", \"vtype\": 0, \"value\": 200}");
+  is->addInput(t);
+  is->execute();
+  ASSERT_TABLE_EQUAL(is->getResultTable(), reference);
+}
+
 }
 }
@@ -0,0 +1,51 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/MemoryUsage.h"
+#include "io/shortcuts.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class MemoryUsageTests : public AccessTest {};
+
+TEST_F(MemoryUsageTests, reports_columns_of_stores) {
+  auto sm = StorageManager::getInstance();
+  auto t = Loader::shortcuts::load("test/lin_xxs.tbl");
+  sm->loadTable("myTable", t);
+
+  MemoryUsage mu;
+  mu.execute();
+  const auto &result = mu.getResultTable();
+
+  size_t total = 0;
+  size_t main_rows = 0;
+  for (size_t row = 0; row < result->size(); ++row) {
+    if (result->getValue<hyrise_string_t>(0, row) != "myTable")
+      continue;
+    total += result->getValue<hyrise_int_t>(3, row);
+    if (result->getValue<hyrise_string_t>(2, row) == "main")
+      ++main_rows;
+  }
+  ASSERT_EQ(t->columnCount(), main_rows);
+  ASSERT_EQ(sm->memoryUsage()["myTable"], total);
+  sm->removeTable("myTable");
+}
+
+TEST_F(MemoryUsageTests, reports_input_tables) {
+  auto t = Loader::shortcuts::load("test/lin_xxs.tbl");
+
+  MemoryUsage mu;
+  mu.addInput(t);
+  mu.execute();
+  const auto &result = mu.getResultTable();
+
+  size_t total = 0;
+  for (size_t row = 0; row < result->size(); ++row) {
+    ASSERT_EQ("unknown/temporary", result->getValue<hyrise_string_t>(0, row));
+    total += result->getValue<hyrise_int_t>(3, row);
+  }
+  ASSERT_EQ(t->bytes(), total);
+}
+
+}
+}
@@ -0,0 +1,81 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/MergeJoin.h"
+#include "access/HashValueJoin.hpp"
+#include "access/SimpleTableScan.h"
+#include "access/SortScan.h"
+#include "access/expressions/pred_EqualsExpression.h"
+#include "io/shortcuts.h"
+#include "testing/test.h"
+#include "testing/TableEqualityTest.h"
+
+namespace hyrise {
+namespace access {
+
+class MergeJoinTests : public AccessTest {};
+
+TEST_F(MergeJoinTests, basic_merge_join_test) {
+  auto t1 = Loader::shortcuts::load("test/join_transactions.tbl");
+  auto t2 = Loader::shortcuts::load("test/join_exchange.tbl");
+  auto reference = Loader::shortcuts::load("test/reference/hash_value_join_result.tbl");
+
+  MergeJoin mj;
+  mj.addInput(t1);
+  mj.addInput(t2);
+  mj.addField(0);
+  mj.addField(0);
+  mj.execute();
+
+  EXPECT_RELATION_EQ(mj.getResultTable(), reference);
+}
+
+TEST_F(MergeJoinTests, multi_column_merge_join_with_partitions) {
+  auto t1 = Loader::shortcuts::load("test/join_transactions.tbl");
+  storage::c_atable_ptr_t t2 = Loader::shortcuts::load("test/join_exchange.tbl");
+  auto reference = Loader::shortcuts::load("test/reference/join_exchange_rates.tbl");
+
+  SimpleTableScan scan;
+  scan.addInput(t2);
+  scan.setPredicate(new EqualsExpression<storage::hyrise_string_t>(t2, 2, "USD"));
+  const auto& rates = scan.execute()->getResultTable();
+
+  MergeJoin mj;
+  mj.addInput(t1);
+  mj.addInput(rates);
+  mj.addField(0);
+  mj.addField(0);
+  mj.addField(1);
+  mj.addField(1);
+  mj.setPartitions(4);
+  mj.execute();
+
+  EXPECT_RELATION_EQ(mj.getResultTable(), reference);
+}
+
+TEST_F(MergeJoinTests, shared_dictionary_on_sorted_input) {
+  auto t = Loader::shortcuts::load("test/join_transactions.tbl");
+
+  SortScan sort;
+  sort.addInput(t);
+  sort.setSortField(1);
+  const auto& sorted = sort.execute()->getResultTable();
+
+  HashValueJoin<storage::hyrise_string_t> hvj;
+  hvj.addInput(sorted);
+  hvj.addField(1);
+  hvj.addInput(t);
+  hvj.addField(1);
+  const auto& reference = hvj.execute()->getResultTable();
+
+  MergeJoin mj;
+  mj.addInput(sorted);
+  mj.addInput(t);
+  mj.addField(1);
+  mj.addField(1);
+  mj.setPartitions(2);
+  mj.execute();
+
+  EXPECT_RELATION_EQ(mj.getResultTable(), reference);
+}
+
+}
+}
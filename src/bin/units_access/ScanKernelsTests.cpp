@@ -0,0 +1,125 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/expressions/ScanKernels.h"
+#include "storage/BitCompressedVector.h"
+#include "storage/ConcurrentFixedLengthVector.h"
+#include "storage/FixedLengthVector.h"
+#include "storage/FrameOfReferenceVector.h"
+#include "storage/RunLengthVector.h"
+#include "storage/SparseVector.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class ScanKernelsTests : public Test {
+ protected:
+  typedef BaseAttributeVector<storage::value_id_t> vector_t;
+
+  // The kernels have to agree with the filter applied to every row
+  void expectKernels(const vector_t *vector, const size_t column, const size_t rows, const ValueIdFilter &filter) {
+    storage::pos_list_t expected;
+    for (size_t row = 3; row < rows; ++row) {
+      if (filter(vector->get(column, row)))
+        expected.push_back(100 + row);
+    }
+
+    storage::pos_list_t positions {7};
+    scanValueIds(vector, column, filter, 3, rows, 100, positions);
+    ASSERT_EQ(expected.size() + 1, positions.size());
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), positions.begin() + 1));
+
+    storage::pos_list_t all {7};
+    for (size_t row = 3; row < rows; ++row)
+      all.push_back(100 + row);
+    refineValueIds(vector, column, filter, 100, all, 1);
+    ASSERT_EQ(positions, all);
+
+    std::vector<uint8_t> mask(rows - 3);
+    maskValueIds(vector, column, filter, 3, rows, mask.data());
+    for (size_t row = 3; row < rows; ++row)
+      ASSERT_EQ(filter(vector->get(column, row)), mask[row - 3] == 1);
+  }
+
+  std::vector<ValueIdFilter> filters(const storage::value_id_t values) {
+    std::vector<ValueIdFilter> result(5);
+    result[0].kind = ValueIdFilter::Equal;
+    result[0].lo = values / 2;
+    result[1].kind = ValueIdFilter::NotEqual;
+    result[1].lo = values / 3;
+    result[2].lo = values / 4;
+    result[2].hi = values - values / 4;
+    result[3].kind = ValueIdFilter::Bitmap;
+    for (storage::value_id_t id = 0; id < values / 2; ++id)
+      result[3].bits.push_back(id % 3 == 0);
+    // Empty range
+    result[4].lo = 3;
+    result[4].hi = 3;
+    return result;
+  }
+
+  template <typename Vector>
+  void fill(Vector &vector, const size_t columns, const size_t rows, const storage::value_id_t values) {
+    vector.resize(rows);
+    for (size_t row = 0; row < rows; ++row) {
+      for (size_t column = 0; column < columns; ++column)
+        vector.set(column, row, (row * 7 + column * 13) % values);
+    }
+  }
+};
+
+TEST_F(ScanKernelsTests, fixed_length_vectors) {
+  FixedLengthVector<storage::value_id_t> vector(2, 0);
+  fill(vector, 2, 500, 40);
+  for (const auto& filter : filters(40)) {
+    expectKernels(&vector, 0, 500, filter);
+    expectKernels(&vector, 1, 500, filter);
+  }
+}
+
+TEST_F(ScanKernelsTests, concurrent_vectors) {
+  ConcurrentFixedLengthVector<storage::value_id_t> vector(1, 0);
+  fill(vector, 1, 500, 40);
+  for (const auto& filter : filters(40))
+    expectKernels(&vector, 0, 500, filter);
+}
+
+TEST_F(ScanKernelsTests, bit_compressed_vectors_of_all_widths) {
+  for (uint64_t bits = 1; bits <= 32; ++bits) {
+    const storage::value_id_t values = bits == 32 ? 4096 : std::min<uint64_t>(4096, 1ull << bits);
+    BitCompressedVector<storage::value_id_t> vector(1, 0, {bits});
+    fill(vector, 1, 300, values);
+    for (const auto& filter : filters(values))
+      expectKernels(&vector, 0, 300, filter);
+  }
+}
+
+TEST_F(ScanKernelsTests, bit_compressed_vectors_with_several_columns) {
+  BitCompressedVector<storage::value_id_t> vector(3, 0, {5, 11, 3});
+  fill(vector, 3, 300, 8);
+  for (const auto& filter : filters(8)) {
+    for (size_t column = 0; column < 3; ++column)
+      expectKernels(&vector, column, 300, filter);
+  }
+}
+
+TEST_F(ScanKernelsTests, encoded_vectors) {
+  // Runs of 37 rows, ids that grow with the row and a column of mostly 5
+  std::vector<storage::value_id_t> runs, growing, sparse;
+  for (size_t row = 0; row < 5000; ++row) {
+    runs.push_back(row / 37 % 40);
+    growing.push_back(row / 3 + row % 7);
+    sparse.push_back(row % 97 == 0 ? row % 40 : 5);
+  }
+  const RunLengthVector<storage::value_id_t> run_length(runs);
+  const FrameOfReferenceVector<storage::value_id_t> frame_of_reference(growing);
+  const SparseVector<storage::value_id_t> sparse_vector(sparse, 5);
+  for (const auto& filter : filters(40)) {
+    expectKernels(&run_length, 0, 5000, filter);
+    expectKernels(&sparse_vector, 0, 5000, filter);
+  }
+  for (const auto& filter : filters(1700))
+    expectKernels(&frame_of_reference, 0, 5000, filter);
+}
+
+}
+}
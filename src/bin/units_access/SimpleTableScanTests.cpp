@@ -1,4 +1,5 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/HashBuild.h"
 #include "access/SimpleTableScan.h"
 #include "access/expressions/predicates.h"
 #include "access/UnionAll.h"
@@ -57,5 +58,65 @@ TEST_F(SimpleTableScanTests, parallelized_simple_table_scan) {
   ASSERT_EQ(100, result->getValue<storage::hyrise_int_t>(0, 0));
 }
 
+TEST_F(SimpleTableScanTests, join_filter_drops_rows_without_partner) {
+  storage::c_atable_ptr_t t = Loader::shortcuts::load("test/lin_xxs.tbl");
+
+  SimpleTableScan dimension;
+  dimension.addInput(t);
+  dimension.setPredicate(new EqualsExpression<storage::hyrise_int_t>(0, 0, 100));
+  dimension.execute();
+
+  HashBuild hb;
+  hb.addInput(dimension.getResultTable());
+  hb.addField(0);
+  hb.setKey("join");
+  hb.setJoinFilter(true);
+  hb.execute();
+
+  // The probe column shares the dictionary, so the filter is exact
+  SimpleTableScan sts;
+  sts.addInput(t);
+  sts.addInput(hb.getResultJoinFilter());
+  sts.setJoinFilterFields({0});
+  sts.execute();
+
+  const auto &result = sts.getResultTable();
+  ASSERT_EQ(1u, result->size());
+  ASSERT_EQ(100, result->getValue<storage::hyrise_int_t>(0, 0));
+}
+
+TEST_F(SimpleTableScanTests, join_filter_on_other_dictionary_keeps_partners) {
+  storage::c_atable_ptr_t t = Loader::shortcuts::load("test/lin_xxs.tbl");
+  storage::c_atable_ptr_t other = Loader::shortcuts::load("test/lin_xxs.tbl");
+
+  SimpleTableScan dimension;
+  dimension.addInput(other);
+  dimension.setPredicate(new EqualsExpression<storage::hyrise_int_t>(0, 0, 100));
+  dimension.execute();
+
+  HashBuild hb;
+  hb.addInput(dimension.getResultTable());
+  hb.addField(0);
+  hb.setKey("join");
+  hb.setJoinFilter(true);
+  hb.execute();
+
+  SimpleTableScan sts;
+  sts.addInput(t);
+  sts.addInput(hb.getResultJoinFilter());
+  sts.setJoinFilterFields({0});
+  sts.setPredicate(new GreaterThanExpression<storage::hyrise_int_t>(0, 0, 50));
+  sts.execute();
+
+  // Bloom filters may let a few rows without partner pass
+  const auto &result = sts.getResultTable();
+  ASSERT_LE(1u, result->size());
+  ASSERT_GT(t->size() / 2, result->size());
+  bool found = false;
+  for (size_t row = 0; row < result->size(); ++row)
+    found |= result->getValue<storage::hyrise_int_t>(0, row) == 100;
+  ASSERT_TRUE(found);
+}
+
 }
 }
@@ -0,0 +1,190 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/GroupByScan.h"
+#include "access/HashBuild.h"
+#include "access/HashJoinProbe.h"
+#include "access/SortScan.h"
+#include "memory/QueryArena.h"
+#include "storage/SpillingHashTable.h"
+#include "storage/TableBuilder.h"
+#include "testing/TableEqualityTest.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class SpillTests : public AccessTest {};
+
+namespace {
+
+// Table of a key column with `distinct` values and a value column
+storage::atable_ptr_t numbers(const size_t rows, const size_t distinct) {
+  storage::TableBuilder::param_list list;
+  list.append().set_type("INTEGER").set_name("key");
+  list.append().set_type("INTEGER").set_name("value");
+  auto table = storage::TableBuilder::build(list);
+  table->resize(rows);
+  for (size_t row = 0; row < rows; ++row) {
+    table->setValue<hyrise_int_t>(0, row, (row * 7919) % distinct);
+    table->setValue<hyrise_int_t>(1, row, row);
+  }
+  return table;
+}
+
+storage::c_atable_ptr_t sort(const storage::c_atable_ptr_t &table) {
+  SortScan ss;
+  ss.addInput(table);
+  ss.setSortField(0);
+  ss.execute();
+  return ss.getResultTable();
+}
+
+storage::c_ahashtable_ptr_t hash(const storage::c_atable_ptr_t &table, const std::string &key) {
+  HashBuild hb;
+  hb.addInput(table);
+  hb.addField(0);
+  hb.setKey(key);
+  hb.execute();
+  return hb.getResultHashTable();
+}
+
+storage::c_atable_ptr_t groupBy(const storage::c_atable_ptr_t &table) {
+  GroupByScan gs;
+  gs.addInput(table);
+  gs.addInput(hash(table, "groupby"));
+  gs.addField(0);
+  gs.addFunction(new SumAggregateFun(1));
+  gs.addFunction(new CountAggregateFun(1));
+  gs.execute();
+  return gs.getResultTable();
+}
+
+storage::c_atable_ptr_t join(const storage::c_ahashtable_ptr_t &build, const storage::c_atable_ptr_t &probe) {
+  HashJoinProbe hjp;
+  hjp.addInput(probe);
+  hjp.addField(0);
+  hjp.addInput(build);
+  hjp.execute();
+  return hjp.getResultTable();
+}
+
+storage::c_atable_ptr_t join(const storage::c_atable_ptr_t &build, const storage::c_atable_ptr_t &probe) {
+  return join(hash(build, "join"), probe);
+}
+
+}
+
+TEST_F(SpillTests, sort_merges_runs) {
+  const auto table = numbers(50000, 1000);
+  const auto reference = sort(table);
+
+  memory::QueryArena arena;
+  arena.setLimit(640 * 1024);
+  memory::ArenaScope scope(&arena);
+  ASSERT_TRUE(sort(table)->contentEquals(reference));
+}
+
+TEST_F(SpillTests, group_by_aggregates_partitions) {
+  const auto table = numbers(20000, 1000);
+  const auto reference = groupBy(table);
+
+  memory::QueryArena arena;
+  arena.setLimit(512 * 1024);
+  memory::ArenaScope scope(&arena);
+  ASSERT_NE(nullptr, std::dynamic_pointer_cast<const storage::SpillingHashTable>(hash(table, "groupby")));
+  const auto result = groupBy(table);
+  ASSERT_EQ(1000u, result->size());
+  EXPECT_RELATION_EQ(reference, result);
+}
+
+TEST_F(SpillTests, hash_join_probes_partitions) {
+  const auto build = numbers(20000, 20000);
+  const auto probe = numbers(2000, 20000);
+  const auto reference = join(build, probe);
+
+  memory::QueryArena arena;
+  arena.setLimit(512 * 1024);
+  memory::ArenaScope scope(&arena);
+  ASSERT_NE(nullptr, std::dynamic_pointer_cast<const storage::SpillingHashTable>(hash(build, "join")));
+  const auto result = join(build, probe);
+  ASSERT_EQ(2000u, result->size());
+  EXPECT_RELATION_EQ(reference, result);
+}
+
+TEST_F(SpillTests, sort_counts_string_payloads) {
+  storage::TableBuilder::param_list list;
+  list.append().set_type("STRING").set_name("text");
+  auto table = storage::TableBuilder::build(list);
+  table->resize(5000);
+  for (size_t row = 0; row < 5000; ++row)
+    table->setValue<hyrise_string_t>(0, row, std::to_string((row * 7919) % 5000) + std::string(200, 'x'));
+  const auto reference = sort(table);
+
+  // The pairs fit, their strings do not
+  memory::QueryArena arena;
+  arena.setLimit(512 * 1024);
+  memory::ArenaScope scope(&arena);
+  ASSERT_TRUE(sort(table)->contentEquals(reference));
+}
+
+TEST_F(SpillTests, probes_share_the_partitions_of_the_build_table) {
+  const auto build = numbers(20000, 20000);
+  const auto probe = numbers(2000, 20000);
+  const auto reference = join(build, probe);
+
+  memory::QueryArena arena;
+  arena.setLimit(512 * 1024);
+  memory::ArenaScope scope(&arena);
+  const auto hash_table = std::dynamic_pointer_cast<const storage::SpillingHashTable>(hash(build, "join"));
+  ASSERT_NE(nullptr, hash_table);
+  EXPECT_RELATION_EQ(reference, join(hash_table, probe));
+  EXPECT_RELATION_EQ(reference, join(hash_table, probe));
+
+  const auto& partitions = hash_table->partitions();
+  ASSERT_LT(1u, partitions.size());
+  size_t rows = 0;
+  for (size_t partition = 0; partition < partitions.size(); ++partition)
+    rows += partitions.count(partition);
+  ASSERT_EQ(build->size(), rows);
+}
+
+TEST_F(SpillTests, skewed_partitions_fail) {
+  // All rows have the same key and end up in one partition
+  const auto build = numbers(20000, 1);
+  const auto probe = numbers(10, 1);
+
+  memory::QueryArena arena;
+  arena.setLimit(512 * 1024);
+  memory::ArenaScope scope(&arena);
+  ASSERT_THROW(join(build, probe), std::runtime_error);
+}
+
+TEST_F(SpillTests, probe_matches_do_not_count_against_the_limit) {
+  const auto build = numbers(1000, 1000);
+  const auto probe = numbers(100000, 1000);
+
+  // Both result lists grow by doubling to 131072 positions, 1MB each.
+  // Their buffers up to 256KB share arena chunks, which are only freed
+  // once every buffer in them is, so the join peaks at about 4.7MB. The
+  // list HashTable::get returns for a probe row takes at least 24 bytes,
+  // and keeping those of all 100000 rows in the arena exceeds 6MB.
+  memory::QueryArena arena;
+  arena.setLimit(6 * 1024 * 1024);
+  memory::ArenaScope scope(&arena);
+  ASSERT_EQ(nullptr, std::dynamic_pointer_cast<const storage::SpillingHashTable>(hash(build, "join")));
+  ASSERT_EQ(100000u, join(build, probe)->size());
+}
+
+TEST_F(SpillTests, operations_fail_beyond_the_limit) {
+  const auto table = numbers(10000, 1000);
+
+  memory::QueryArena arena;
+  arena.setLimit(1024);
+  memory::ArenaScope scope(&arena);
+  SortScan ss;
+  ss.addInput(table);
+  ss.setSortField(0);
+  ASSERT_THROW(ss.execute(), memory::MemoryLimitExceeded);
+}
+
+}
+}
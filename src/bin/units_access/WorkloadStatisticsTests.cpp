@@ -0,0 +1,109 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/MergeTable.h"
+#include "access/SimpleTableScan.h"
+#include "access/expressions/predicates.h"
+#include "access/system/WorkloadStatistics.h"
+#include "io/shortcuts.h"
+#include "storage/Store.h"
+#include "testing/TableEqualityTest.h"
+#include "testing/test.h"
+
+namespace hyrise {
+namespace access {
+
+class WorkloadStatisticsTests : public AccessTest {
+public:
+  void SetUp() {
+    AccessTest::SetUp();
+    WorkloadStatistics::getInstance().clear();
+    WorkloadStatistics::getInstance().setEnabled(true);
+  }
+
+  void TearDown() {
+    WorkloadStatistics::getInstance().setEnabled(false);
+    WorkloadStatistics::getInstance().clear();
+    AccessTest::TearDown();
+  }
+};
+
+TEST_F(WorkloadStatisticsTests, scans_are_recorded_per_pattern) {
+  auto t = std::dynamic_pointer_cast<storage::Store>(Loader::shortcuts::load("test/lin_xxs.tbl"));
+  ASSERT_NE(nullptr, t);
+
+  for (size_t i = 0; i < 3; ++i) {
+    SimpleTableScan sts;
+    sts.addInput(t);
+    sts.setPredicate(new EqualsExpression<storage::hyrise_int_t>(0, i % 2, 10));
+    sts.execute();
+  }
+
+  ASSERT_EQ(2u, WorkloadStatistics::getInstance().patternCount(t));
+}
+
+TEST_F(WorkloadStatisticsTests, merge_applies_proposed_layout) {
+  auto t = std::dynamic_pointer_cast<storage::Store>(Loader::shortcuts::load("test/lin_xxs.tbl"));
+  auto reference = Loader::shortcuts::load("test/lin_xxs.tbl");
+  ASSERT_EQ(3u, t->partitionCount());
+
+  // Selective scans on the first attribute only, which is stored in a
+  // row container with seven others
+  for (size_t i = 0; i < 20; ++i) {
+    SimpleTableScan sts;
+    sts.addInput(t);
+    sts.setPredicate(new EqualsExpression<storage::hyrise_int_t>(0, 0, 10));
+    sts.execute();
+  }
+
+  const auto& layout = WorkloadStatistics::getInstance().proposeLayout(*t);
+  ASSERT_FALSE(layout.empty());
+  ASSERT_NE(WorkloadStatistics::currentLayout(*t), layout);
+
+  MergeStore ms;
+  ms.addInput(t);
+  ms.execute();
+
+  ASSERT_EQ(layout, WorkloadStatistics::currentLayout(*t));
+  ASSERT_EQ(layout.size(), t->partitionCount());
+  EXPECT_RELATION_EQ(reference, t);
+}
+
+TEST_F(WorkloadStatisticsTests, new_patterns_are_layouted_incrementally) {
+  auto t = std::dynamic_pointer_cast<storage::Store>(Loader::shortcuts::load("test/lin_xxs.tbl"));
+
+  SimpleTableScan first;
+  first.addInput(t);
+  first.setPredicate(new EqualsExpression<storage::hyrise_int_t>(0, 0, 10));
+  first.execute();
+  WorkloadStatistics::getInstance().proposeLayout(*t);
+
+  SimpleTableScan second;
+  second.addInput(t);
+  second.setPredicate(new CompoundExpression(new EqualsExpression<storage::hyrise_int_t>(0, 8, 10),
+                                             new EqualsExpression<storage::hyrise_int_t>(0, 9, 10), AND));
+  second.execute();
+  ASSERT_EQ(2u, WorkloadStatistics::getInstance().patternCount(t));
+
+  // Both patterns get a container of their own, the rest stays together
+  const WorkloadStatistics::layout_t expected {{0}, {1, 2, 3, 4, 5, 6, 7}, {8, 9}};
+  ASSERT_EQ(expected, WorkloadStatistics::getInstance().proposeLayout(*t));
+}
+
+TEST_F(WorkloadStatisticsTests, disabled_statistics_keep_layout) {
+  WorkloadStatistics::getInstance().setEnabled(false);
+  auto t = std::dynamic_pointer_cast<storage::Store>(Loader::shortcuts::load("test/lin_xxs.tbl"));
+
+  SimpleTableScan sts;
+  sts.addInput(t);
+  sts.setPredicate(new EqualsExpression<storage::hyrise_int_t>(0, 0, 10));
+  sts.execute();
+
+  MergeStore ms;
+  ms.addInput(t);
+  ms.execute();
+
+  ASSERT_EQ(0u, WorkloadStatistics::getInstance().patternCount(t));
+  ASSERT_EQ(3u, t->partitionCount());
+}
+
+}
+}
@@ -57,6 +57,8 @@ TEST_F(LayouterOpsTest, simple_op_count) {
 
   ASSERT_EQ(res->getValue<std::string>(0, 0), header);
   ASSERT_EQ(2u, res->size());
+  // The number of layouts found, not the number of layouts searched
+  ASSERT_EQ(2, res->getValue<hyrise_int_t>(1, 0));
 }
 
 
@@ -6,6 +6,7 @@
 #include "helper.h"
 #include "io/shortcuts.h"
 #include "access/radixjoin/NestedLoopEquiJoin.h"
+#include "access/RadixJoin.h"
 #include "testing/TableEqualityTest.h"
 #include <storage/TableBuilder.h>
 
@@ -754,4 +755,22 @@ TEST_F(RadixJoinTest, multi_pass_radix_cluster_parallel) {
   EXPECT_EQ(12u, merged_prx->getValueId(0,7).valueId);
 }
 
+TEST_F(RadixJoinTest, radix_join_two_passes_parallel) {
+  auto left = Loader::shortcuts::load("test/tables/hash_table_test.tbl");
+  auto right = Loader::shortcuts::load("test/tables/hash_table_test2.tbl");
+  auto reference = Loader::shortcuts::load("test/tables/hash_table_test_ref.tbl");
+
+  RadixJoin rj;
+  rj.addInput(left);
+  rj.addInput(right);
+  rj.addField(0);
+  rj.addField(0);
+  rj.setBits1(2);
+  rj.setBits2(2);
+  rj.setThreads(3);
+  rj.execute();
+
+  EXPECT_RELATION_EQ(reference, rj.getResultTable());
+}
+
 }}
@@ -4,7 +4,9 @@
 #include <io/CSVLoader.h>
 #include <io/EmptyLoader.h>
 #include <io/Loader.h>
+#include <io/shortcuts.h>
 
+#include <storage/BitCompressedVector.h>
 #include <storage/MutableVerticalTable.h>
 #include <storage/Store.h>
 
@@ -44,6 +46,17 @@ TEST_F(LoaderTests, load_vertical_table) {
   ASSERT_TRUE((bool)std::dynamic_pointer_cast<storage::MutableVerticalTable>(t)) << "t should be a vertical table";
 }
 
+TEST_F(LoaderTests, loaded_main_uses_minimal_bit_width) {
+  auto t = Loader::shortcuts::load("test/tables/employees.tbl");
+  const auto main = std::dynamic_pointer_cast<storage::Store>(t)->getMainTable();
+  for (size_t column = 0; column < main->columnCount(); ++column) {
+    const auto attr = main->getAttributeVectors(column).at(0);
+    const auto tuples = std::dynamic_pointer_cast<BitCompressedVector<value_id_t>>(attr.attribute_vector);
+    ASSERT_TRUE((bool) tuples);
+    EXPECT_EQ(bitsForValues(main->dictionaryAt(column)->size()), tuples->bitsForColumn(attr.attribute_offset));
+  }
+}
+
 TEST_F(LoaderTests, load_table_simple_empty) {
   EmptyInput input;
   CSVHeader header("test/header.tbl", CSVHeader::params().setCSVParams(csv::CSV_FORMAT));
@@ -24,6 +24,7 @@ namespace {
   class FakeIndex : public AbstractIndex {
    public:
     void shrink() {}
+    size_t bytes() const { return 0; }
   };
 
   storage::aindex_ptr_t emptyIndex() {
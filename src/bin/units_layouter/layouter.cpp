@@ -720,6 +720,82 @@ TEST_F(LayouterTests, layouter_two_queries_candidate) {
 
 }
 
+TEST_F(LayouterTests, bounded_search_matches_enumeration) {
+  std::vector<std::string> names = list_of("A")("B")("C")("D")("E");
+  layouter::Schema s(std::vector<unsigned>(names.size(), 4), 100000, names);
+
+  std::vector<unsigned> aq1 = list_of(0)(1)(2);
+  layouter::Query q1(LayouterConfiguration::access_type_fullprojection, aq1, -1.0, 1);
+  s.add(&q1);
+
+  std::vector<unsigned> aq2 = list_of(2)(4);
+  layouter::Query q2(LayouterConfiguration::access_type_outoforder, aq2, 0.2, 3);
+  s.add(&q2);
+
+  std::vector<unsigned> aq3 = list_of(1)(3);
+  layouter::Query q3(LayouterConfiguration::access_type_outoforder, aq3, 0.01, 2);
+  s.add(&q3);
+
+  layouter::BaseLayouter all;
+  all.layout(s, HYRISE_COST);
+
+  layouter::BaseLayouter bounded;
+  bounded.setMaxResults(3);
+  bounded.setThreads(2);
+  bounded.layout(s, HYRISE_COST);
+
+  ASSERT_EQ(3u, bounded.count());
+  ASSERT_LT(bounded.nbLayouts, all.nbLayouts);
+  const auto& expected = all.getNBestResults(3);
+  const auto& actual = bounded.getNBestResults(3);
+  for (size_t i = 0; i < 3; ++i)
+    ASSERT_DOUBLE_EQ(expected[i].totalCost, actual[i].totalCost);
+  ASSERT_TRUE(all.getBestResult().layout == bounded.getBestResult().layout);
+}
+
+TEST_F(LayouterTests, bounded_search_wide_table) {
+  std::vector<std::string> names;
+  for (size_t i = 0; i < 32; ++i)
+    names.push_back("A" + std::to_string(i));
+  layouter::Schema s(std::vector<unsigned>(names.size(), 4), 100000, names);
+
+  std::vector<layouter::Query> queries;
+  for (unsigned i = 0; i < 4; ++i) {
+    std::vector<unsigned> attributes = list_of(i)(i + 3)(2 * i + 1);
+    queries.push_back(layouter::Query(LayouterConfiguration::access_type_outoforder, attributes, 0.05, i + 1));
+  }
+  for (auto& q : queries)
+    s.add(&q);
+
+  layouter::CandidateLayouter cl;
+  cl.setMaxResults(1);
+  cl.layout(s, HYRISE_COST);
+
+  ASSERT_EQ(1u, cl.count());
+  size_t attributes = 0;
+  for (const auto& container : cl.getBestResult().layout.raw())
+    attributes += container.size();
+  ASSERT_EQ(names.size(), attributes);
+}
+
+TEST_F(LayouterTests, bounded_search_without_layout_fails) {
+  std::vector<std::string> names = list_of("A")("B")("C");
+  layouter::Schema s(std::vector<unsigned>(names.size(), 4), 100000, names);
+  std::vector<unsigned> aq1 = list_of(0)(1);
+  layouter::Query q1(LayouterConfiguration::access_type_fullprojection, aq1, -1.0, 1);
+  s.add(&q1);
+
+  // The subsets overlap in B, so no layout covers every attribute once
+  layouter::BaseLayouter bl;
+  bl.schema = s;
+  bl.costModel = HYRISE_COST;
+  std::vector<unsigned> ab = list_of(0)(1), bc = list_of(1)(2);
+  bl.subsets.push_back(ab);
+  bl.subsets.push_back(bc);
+  bl.setMaxResults(1);
+  ASSERT_THROW(bl.iterateThroughLayouts(), std::runtime_error);
+}
+
 TEST_F(LayouterTests, incremental_layouter_initial) {
   std::vector< std::string > names;
   names.push_back("ID");
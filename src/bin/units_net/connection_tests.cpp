@@ -0,0 +1,147 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "net/AccessLog.h"
+#include "net/AsyncConnection.h"
+
+namespace hyrise {
+namespace net {
+
+class ConnectionTests : public ::testing::Test {};
+
+TEST_F(ConnectionTests, body_grows_and_is_kept) {
+  AsyncConnection connection;
+  AsyncRequest request(&connection);
+  ASSERT_EQ(AsyncRequest::initial_body_length, request.body_capacity);
+  const std::string chunk(3000, 'x');
+  for (size_t i = 0; i < 3; ++i) {
+    request.reserveBody(chunk.size());
+    memcpy(request.body + request.body_len, chunk.data(), chunk.size());
+    request.body_len += chunk.size();
+  }
+  ASSERT_EQ(4 * AsyncRequest::initial_body_length, request.body_capacity);
+  ASSERT_EQ(chunk + chunk + chunk, std::string(request.body, request.body_len));
+
+  // The next request reuses the buffer
+  request.reset();
+  ASSERT_EQ(0u, request.body_len);
+  ASSERT_EQ(4 * AsyncRequest::initial_body_length, request.body_capacity);
+
+  request.reserveBody(2 * AsyncRequest::max_kept_buffer_length);
+  request.reset();
+  ASSERT_EQ(0u, request.body_capacity);
+  request.reserveBody(1);
+  ASSERT_EQ(AsyncRequest::initial_body_length, request.body_capacity);
+}
+
+TEST_F(ConnectionTests, announced_body_is_reserved_up_to_a_limit) {
+  AsyncConnection connection;
+  AsyncRequest request(&connection);
+  const size_t announced = 100 * 1024 * 1024;
+  ASSERT_TRUE(request.appendBody("abc", 3, announced));
+  ASSERT_EQ(AsyncRequest::max_reserved_body_length, request.body_capacity);
+  ASSERT_TRUE(request.appendBody("def", 3, announced));
+  ASSERT_EQ(AsyncRequest::max_reserved_body_length, request.body_capacity);
+  ASSERT_EQ("abcdef", std::string(request.body, request.body_len));
+  ASSERT_EQ(0u, request.error_status);
+}
+
+TEST_F(ConnectionTests, oversized_content_length_is_refused) {
+  AsyncConnection connection;
+  AsyncRequest request(&connection);
+  ASSERT_FALSE(request.appendBody("abc", 3, AsyncRequest::max_body_length + 1));
+  ASSERT_EQ(413u, request.error_status);
+  ASSERT_EQ(0u, request.body_len);
+  ASSERT_EQ(AsyncRequest::initial_body_length, request.body_capacity);
+
+  // The request is not refused again for the next one
+  request.reset();
+  ASSERT_EQ(0u, request.error_status);
+  ASSERT_TRUE(request.appendBody("abc", 3, 3));
+}
+
+TEST_F(ConnectionTests, reading_stops_when_too_many_requests_wait) {
+  AsyncConnection connection;
+  ebb_connection socket;
+  memset(&socket, 0, sizeof(socket));
+  connection.connection = &socket;
+  connection.request = connection.newRequest();
+  for (size_t i = 0; i + 1 < AsyncConnection::max_pipelined_requests; ++i)
+    connection.enqueue(connection.newRequest());
+  ASSERT_FALSE(connection.reading_paused);
+  connection.enqueue(connection.newRequest());
+  ASSERT_TRUE(connection.reading_paused);
+  ASSERT_EQ(AsyncConnection::max_pipelined_requests, connection.pipelined.size());
+
+  connection.clear();
+  ASSERT_FALSE(connection.reading_paused);
+  connection.connection = nullptr;
+}
+
+TEST_F(ConnectionTests, pipelined_requests_reuse_buffers) {
+  AsyncConnection connection;
+  AsyncRequest *first = connection.newRequest();
+  AsyncRequest *second = connection.newRequest();
+  ASSERT_NE(first, second);
+  ASSERT_EQ(&connection, second->connection);
+  first->reserveBody(10000);
+  first->body_len = 10000;
+
+  // Answering the first request makes it available again
+  connection.request = first;
+  connection.pipelined.push_back(second);
+  ASSERT_TRUE(connection.hasBody());
+  connection.reset();
+  ASSERT_EQ(nullptr, connection.request);
+  AsyncRequest *third = connection.newRequest();
+  ASSERT_EQ(first, third);
+  ASSERT_EQ(0u, third->body_len);
+  ASSERT_LE(10000u, third->body_capacity);
+
+  connection.clear();
+  ASSERT_TRUE(connection.pipelined.empty());
+}
+
+TEST_F(ConnectionTests, pool_reuses_connections) {
+  ConnectionPool pool;
+  AsyncConnection *first = pool.acquire();
+  AsyncRequest *request = first->newRequest();
+  request->reserveBody(10000);
+  request->body_len = 10000;
+  first->pipelined.push_back(request);
+  pool.release(first);
+  ASSERT_EQ(1u, pool.size());
+
+  AsyncConnection *second = pool.acquire();
+  ASSERT_EQ(first, second);
+  ASSERT_TRUE(second->pipelined.empty());
+  ASSERT_EQ(request, second->newRequest());
+  ASSERT_EQ(0u, request->body_len);
+  ASSERT_EQ(0u, pool.size());
+  pool.release(second);
+}
+
+TEST_F(ConnectionTests, access_log_format) {
+  AccessLogEntry entry;
+  inet_pton(AF_INET, "10.0.0.1", &entry.addr);
+  entry.method = EBB_POST;
+  entry.path = "/jsonQuery/";
+  entry.starttime.tv_sec = 100;
+  entry.starttime.tv_usec = 0;
+  entry.endtime.tv_sec = 100;
+  entry.endtime.tv_usec = 250000;
+  entry.sent = false;
+
+  const std::string line = AccessLog::format(entry);
+  ASSERT_EQ(0u, line.find("10.0.0.1 ["));
+  ASSERT_NE(std::string::npos, line.find("] POST /jsonQuery/ (0.250000 s) not sent"));
+
+  // Entries are written by the log's thread
+  AccessLog::getInstance().log(std::move(entry));
+  AccessLog::getInstance().flush();
+}
+
+}
+}
@@ -0,0 +1,165 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include <storage.h>
+#include <storage/BitCompressedVector.h>
+#include <storage/FixedLengthVector.h>
+#include <memory/Allocator.h>
+#include <memory/HugePageAllocator.h>
+#include <memory/NumaAllocator.h>
+#include <memory/PoolAllocator.h>
+
+namespace hyrise {
+namespace memory {
+
+class AllocatorTests : public ::hyrise::Test {};
+
+class MockAllocator : public Allocator {
+ public:
+  int allocates = 0;
+  int reallocates = 0;
+  int deallocates = 0;
+  long bytes = 0;
+
+  void *allocate(size_t sz) {
+    ++allocates;
+    bytes += sz;
+    return malloc(sz);
+  }
+
+  void *reallocate(void *old, size_t sz, size_t old_size) {
+    ++reallocates;
+    bytes += static_cast<long>(sz) - static_cast<long>(old_size);
+    return realloc(old, sz);
+  }
+
+  void deallocate(void *p, size_t sz) {
+    if (p == nullptr)
+      return;
+    ++deallocates;
+    bytes -= sz;
+    free(p);
+  }
+
+  std::string name() const {
+    return "mock";
+  }
+};
+
+typedef BitCompressedVector<uint> bum;
+
+TEST_F(AllocatorTests, vectors_keep_their_allocator) {
+  MockAllocator allocator;
+  auto e = std::vector<uint64_t> {4};
+  bum *a;
+  FixedLengthVector<value_id_t> *f;
+  {
+    AllocatorScope scope(&allocator);
+    ASSERT_EQ(&allocator, Allocator::current());
+    a = new bum(1, 10, e);
+    f = new FixedLengthVector<value_id_t>(2, 10);
+  }
+  ASSERT_NE(&allocator, Allocator::current());
+
+  // Growing after the scope ended still uses the allocator of the vector
+  const int used = allocator.allocates + allocator.reallocates;
+  a->resize(10000);
+  f->resize(10000);
+  ASSERT_LT(used, allocator.allocates + allocator.reallocates);
+  for (size_t row = 0; row < 10000; ++row) {
+    a->set(0, row, row % 16);
+    f->set(1, row, row);
+  }
+  auto c = f->copy();
+  ASSERT_EQ(9999u, c->get(1, 9999));
+
+  delete a;
+  delete f;
+  c.reset();
+  ASSERT_EQ(0, allocator.bytes);
+}
+
+TEST_F(AllocatorTests, scopes_nest_and_restore) {
+  Allocator *outer = Allocator::current();
+  {
+    AllocatorScope pool("pool");
+    ASSERT_EQ("pool", Allocator::current()->name());
+    {
+      AllocatorScope keep("");
+      ASSERT_EQ("pool", Allocator::current()->name());
+      AllocatorScope numa("numa");
+      ASSERT_EQ("numa", Allocator::current()->name());
+    }
+    ASSERT_EQ("pool", Allocator::current()->name());
+  }
+  ASSERT_EQ(outer, Allocator::current());
+  ASSERT_EQ(Allocator::get("pool"), Allocator::get("pool"));
+  ASSERT_THROW(Allocator::get("nonexistent"), std::runtime_error);
+}
+
+TEST_F(AllocatorTests, huge_pages_grow_and_shrink) {
+  HugePageAllocator allocator;
+  const size_t small = 1024;
+  const size_t large = 3 * HugePageAllocator::huge_page_size;
+
+  char *p = static_cast<char *>(allocator.allocate(small));
+  ASSERT_NE(nullptr, p);
+  memset(p, 'a', small);
+
+  // From malloc to a mapping, then growing the mapping
+  p = static_cast<char *>(allocator.reallocate(p, HugePageAllocator::huge_page_size, small));
+  ASSERT_NE(nullptr, p);
+  ASSERT_EQ('a', p[small - 1]);
+  memset(p + small, 'b', HugePageAllocator::huge_page_size - small);
+  p = static_cast<char *>(allocator.reallocate(p, large, HugePageAllocator::huge_page_size));
+  ASSERT_NE(nullptr, p);
+  ASSERT_EQ('a', p[0]);
+  ASSERT_EQ('b', p[HugePageAllocator::huge_page_size - 1]);
+  p[large - 1] = 'c';
+
+  // And back
+  p = static_cast<char *>(allocator.reallocate(p, small, large));
+  ASSERT_NE(nullptr, p);
+  ASSERT_EQ('a', p[small - 1]);
+  allocator.deallocate(p, small);
+}
+
+TEST_F(AllocatorTests, pool_reuses_blocks) {
+  PoolAllocator allocator;
+  void *p = allocator.allocate(100);
+  ASSERT_EQ(0u, allocator.cached(100));
+  allocator.deallocate(p, 100);
+  ASSERT_EQ(1u, allocator.cached(100));
+  // Same size class
+  ASSERT_EQ(p, allocator.allocate(120));
+  ASSERT_EQ(0u, allocator.cached(100));
+
+  // Moving to another class keeps the contents
+  memset(p, 'x', 120);
+  char *q = static_cast<char *>(allocator.reallocate(p, 1000, 120));
+  ASSERT_EQ('x', q[119]);
+  ASSERT_EQ(1u, allocator.cached(120));
+  allocator.deallocate(q, 1000);
+
+  // Large allocations are not pooled
+  void *large = allocator.allocate(PoolAllocator::max_class_bytes + 1);
+  allocator.deallocate(large, PoolAllocator::max_class_bytes + 1);
+  ASSERT_EQ(0u, allocator.cached(PoolAllocator::max_class_bytes + 1));
+}
+
+TEST_F(AllocatorTests, numa_round_trip) {
+  NumaAllocator allocator;
+  char *p = static_cast<char *>(allocator.allocate(4096));
+  ASSERT_NE(nullptr, p);
+  memset(p, 'n', 4096);
+  p = static_cast<char *>(allocator.reallocate(p, 3 * 4096, 4096));
+  ASSERT_NE(nullptr, p);
+  ASSERT_EQ('n', p[4095]);
+  allocator.deallocate(p, 3 * 4096);
+}
+
+}
+}
@@ -3,29 +3,34 @@
 
 #include <storage.h>
 #include <storage/BitCompressedVector.h>
+#include <memory/Allocator.h>
 
 class MockStrategyTest : public ::hyrise::Test {};
 
 
-class MockMallocStrategy {
+class MockMallocStrategy : public hyrise::memory::Allocator {
 public:
   static int allocates;
   static int reallocates;
   static int deallocates;
-  static void *allocate(size_t sz) {
+  void *allocate(size_t sz) {
     ++allocates;
     return malloc(sz);
   }
 
-  static void *reallocate(void *old, size_t sz, size_t /*old_size*/) {
+  void *reallocate(void *old, size_t sz, size_t /*old_size*/) {
     ++reallocates;
     return realloc(old, sz);
   }
 
-  static void deallocate(void *p, size_t sz) {
+  void deallocate(void *p, size_t sz) {
     ++deallocates;
     free(p);
   }
+
+  std::string name() const {
+    return "mock";
+  }
 };
 
 int MockMallocStrategy::allocates = 0;
@@ -35,6 +40,8 @@ int MockMallocStrategy::reallocates = 0;
 
 typedef BitCompressedVector<uint> bum;
 TEST_F(MockStrategyTest, base_test) {
+  MockMallocStrategy strategy;
+  hyrise::memory::AllocatorScope scope(&strategy);
   auto e = std::vector<uint64_t> {1};
   bum *a = new bum(1, 10, e);
   delete a;
@@ -4,6 +4,7 @@
 #include <limits>
 
 #include "storage/storage_types.h"
+#include "storage/AttributeVectorFactory.h"
 #include "storage/BitCompressedVector.h"
 #include "storage/FixedLengthVector.h"
 
@@ -34,6 +35,75 @@ TEST(BitCompressedTests, empty_size_does_not_change_with_reserve) {
   ASSERT_EQ(128u, tuples.capacity());
 }
 
+TEST(BitCompressedTests, smaller_reserve_keeps_values) {
+  BitCompressedVector<value_id_t> tuples(1, 1000, {1});
+  tuples.resize(1000);
+  for (size_t row = 0; row < 1000; ++row)
+    tuples.set(0, row, row % 2);
+  tuples.reserve(500);
+  ASSERT_EQ(1024u, tuples.capacity());
+  for (size_t row = 0; row < 1000; ++row)
+    ASSERT_EQ(row % 2, tuples.get(0, row));
+
+  tuples.clear();
+  tuples.resize(10);
+  tuples.set(0, 9, 1);
+  ASSERT_EQ(1u, tuples.get(0, 9));
+}
+
+TEST(BitCompressedTests, bits_for_values) {
+  EXPECT_EQ(1u, bitsForValues(0));
+  EXPECT_EQ(1u, bitsForValues(2));
+  EXPECT_EQ(2u, bitsForValues(3));
+  EXPECT_EQ(8u, bitsForValues(256));
+  EXPECT_EQ(9u, bitsForValues(257));
+  EXPECT_EQ(32u, bitsForValues(1ull << 32));
+}
+
+TEST(BitCompressedTests, rewritten_columns_keep_their_values) {
+  BitCompressedVector<value_id_t> tuples(3, 100, {2, 3, 1});
+  tuples.resize(100);
+  for (size_t row = 0; row < 100; ++row) {
+    tuples.set(0, row, row % 4);
+    tuples.set(1, row, row % 8);
+    tuples.set(2, row, row % 2);
+  }
+  EXPECT_THROW(tuples.set(1, 42, 1000), std::out_of_range);
+  tuples.rewriteColumn(1, 10);
+  tuples.set(1, 42, 1000);
+  tuples.rewriteColumn(0, 5);
+  for (size_t row = 0; row < 100; ++row) {
+    EXPECT_EQ(row % 4, tuples.get(0, row));
+    EXPECT_EQ(row == 42 ? 1000 : row % 8, tuples.get(1, row));
+    EXPECT_EQ(row % 2, tuples.get(2, row));
+  }
+}
+
+TEST(BitCompressedTests, aligned_fast_path) {
+  BitCompressedVector<value_id_t> bytes(1, 10, {8});
+  bytes.resize(10);
+  for (size_t row = 0; row < 10; ++row)
+    bytes.set(0, row, 250 - row);
+  ASSERT_NE(nullptr, bytes.aligned<uint8_t>());
+  EXPECT_EQ(nullptr, bytes.aligned<uint16_t>());
+  for (size_t row = 0; row < 10; ++row)
+    EXPECT_EQ(250 - row, bytes.aligned<uint8_t>()[row]);
+
+  BitCompressedVector<value_id_t> pair(2, 10, {8, 8});
+  EXPECT_EQ(nullptr, pair.aligned<uint8_t>());
+}
+
+TEST(AttributeVectorFactoryTests, compressed_vectors_use_minimal_width) {
+  auto fixed = AttributeVectorFactory::getAttributeVector<value_id_t>(2, 10, 1000, false);
+  EXPECT_NE(nullptr, std::dynamic_pointer_cast<FixedLengthVector<value_id_t> >(fixed));
+
+  auto compressed = std::dynamic_pointer_cast<BitCompressedVector<value_id_t> >(
+      AttributeVectorFactory::getAttributeVector<value_id_t>(2, 10, 1000, true));
+  ASSERT_NE(nullptr, compressed);
+  EXPECT_EQ(10u, compressed->bitsForColumn(0));
+  EXPECT_EQ(10u, compressed->bitsForColumn(1));
+}
+
 TEST(FixedLengthVectorTest, increment_test) {
   size_t cols = 1;
   size_t rows = 3;
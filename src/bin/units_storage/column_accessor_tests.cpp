@@ -0,0 +1,82 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include <storage/ColumnAccessor.h>
+#include <storage/PointerCalculator.h>
+#include <storage/Store.h>
+#include <storage/TableRangeView.h>
+#include <io/shortcuts.h>
+
+namespace hyrise {
+namespace storage {
+
+class ColumnAccessorTests : public ::hyrise::Test {
+ protected:
+  template <typename T>
+  void expectColumn(const c_atable_ptr_t &table, const field_t column) {
+    ColumnAccessor<T> accessor(table, column);
+    ASSERT_EQ(table->size(), accessor.size());
+
+    size_t visited = 0;
+    accessor.forEach([&](size_t row, const T &value) {
+      ASSERT_EQ(visited++, row);
+      ASSERT_EQ(table->getValue<T>(column, row), value);
+      ASSERT_EQ(value, accessor.get(row));
+    });
+    ASSERT_EQ(table->size(), visited);
+
+    pos_list_t rows;
+    for (size_t row = 0; row < table->size(); row += 2)
+      rows.push_back(table->size() - row - 1);
+    std::vector<T> values;
+    accessor.gather(rows, values);
+    ASSERT_EQ(rows.size(), values.size());
+    for (size_t i = 0; i < rows.size(); ++i)
+      ASSERT_EQ(table->getValue<T>(column, rows[i]), values[i]);
+  }
+};
+
+TEST_F(ColumnAccessorTests, main_and_delta) {
+  auto s = std::dynamic_pointer_cast<Store>(Loader::shortcuts::load("test/lin_xxs.tbl"));
+  const size_t main_size = s->getMainTable()->size();
+  s->appendToDelta(3);
+  for (size_t row = main_size; row < s->size(); ++row) {
+    for (size_t column = 0; column < s->columnCount(); ++column)
+      s->setValue<hyrise_int_t>(column, row, 1000 + row);
+  }
+
+  for (field_t column = 0; column < s->columnCount(); ++column)
+    expectColumn<hyrise_int_t>(s, column);
+}
+
+TEST_F(ColumnAccessorTests, all_types) {
+  auto t = Loader::shortcuts::load("test/alltypes.tbl");
+  expectColumn<hyrise_int_t>(t, 0);
+  expectColumn<hyrise_string_t>(t, 1);
+  expectColumn<hyrise_float_t>(t, 2);
+  ASSERT_THROW(ColumnAccessor<hyrise_string_t>(t, 0), std::runtime_error);
+}
+
+TEST_F(ColumnAccessorTests, pointer_calculator) {
+  auto s = std::dynamic_pointer_cast<Store>(Loader::shortcuts::load("test/lin_xxs.tbl"));
+  s->appendToDelta(1);
+  for (size_t column = 0; column < s->columnCount(); ++column)
+    s->setValue<hyrise_int_t>(column, s->size() - 1, 12345);
+
+  auto pc = PointerCalculator::create(s, new pos_list_t {s->size() - 1, 3, 0, 7}, new field_list_t {9, 2});
+  expectColumn<hyrise_int_t>(pc, 0);
+  expectColumn<hyrise_int_t>(pc, 1);
+  ASSERT_EQ(12345, ColumnAccessor<hyrise_int_t>(pc, 0).get(0));
+
+  auto all = PointerCalculator::create(s, nullptr, nullptr);
+  expectColumn<hyrise_int_t>(all, 4);
+}
+
+TEST_F(ColumnAccessorTests, tables_without_attribute_vectors) {
+  auto t = Loader::shortcuts::load("test/lin_xxs.tbl");
+  auto view = std::make_shared<TableRangeView>(std::const_pointer_cast<AbstractTable>(t), 20, 50);
+  expectColumn<hyrise_int_t>(view, 3);
+}
+
+}
+}
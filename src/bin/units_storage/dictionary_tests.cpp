@@ -124,3 +124,93 @@ TEST_F(DictionaryTest, order_preserving_string_exists) {
 
 }
 
+TEST_F(DictionaryTest, order_preserving_string_front_coding) {
+  OrderPreservingDictionary<std::string> dict;
+  std::vector<std::string> values;
+  for (size_t i = 0; i < 100; ++i)
+    values.push_back("customer#" + std::string(i < 10 ? "00" : "0") + std::to_string(i));
+  values.push_back(std::string(200, 'z'));
+  for (const auto& value : values)
+    dict.addValue(value);
+
+  ASSERT_EQ(values.size(), dict.size());
+  for (size_t i = 0; i < values.size(); ++i)
+    ASSERT_EQ(values[i], dict.getValueForValueId(i));
+  ASSERT_EQ(values.front(), dict.getSmallestValue());
+  ASSERT_EQ(values.back(), dict.getGreatestValue());
+
+  size_t bytes = 0;
+  for (const auto& value : values)
+    bytes += value.size();
+  ASSERT_LT(dict.bytes(), bytes);
+
+  size_t id = 0;
+  for (auto it = dict.begin(); it != dict.end(); ++it, ++id)
+    ASSERT_EQ(values[id], *it);
+  ASSERT_EQ(values.size(), id);
+}
+
+TEST_F(DictionaryTest, order_preserving_string_bounds) {
+  OrderPreservingDictionary<std::string> dict;
+  for (size_t i = 10; i < 90; i += 2)
+    dict.addValue("key" + std::to_string(i));
+
+  ASSERT_EQ(0u, dict.getValueIdForValue("a"));
+  ASSERT_EQ(0u, dict.getValueIdForValue("key10"));
+  ASSERT_EQ(1u, dict.getValueIdForValue("key11"));
+  ASSERT_EQ(20u, dict.getValueIdForValue("key50"));
+  ASSERT_EQ(21u, dict.getValueIdForValueGreater("key50"));
+  ASSERT_EQ(19u, dict.getValueIdForValueSmaller("key50"));
+  ASSERT_EQ(40u, dict.getValueIdForValue("z"));
+  ASSERT_TRUE(dict.valueExists("key88"));
+  ASSERT_FALSE(dict.valueExists("key89"));
+
+  auto range = dict.prefixRange("key3");
+  ASSERT_EQ(10u, range.first);
+  ASSERT_EQ(15u, range.second);
+  range = dict.prefixRange("nokey");
+  ASSERT_EQ(range.first, range.second);
+}
+
+TEST_F(DictionaryTest, order_preserving_sampled_lookups) {
+  OrderPreservingDictionary<int> dict;
+  for (int i = 0; i < 1000; ++i)
+    dict.addValue(i * 3);
+
+  for (int value = -1; value < 3002; ++value) {
+    const value_id_t expected = value < 0 ? 0 : std::min(1000, (value + 2) / 3);
+    ASSERT_EQ(expected, dict.getValueIdForValue(value)) << value;
+    ASSERT_EQ(value % 3 == 0 && value >= 0 && value < 3000, dict.valueExists(value)) << value;
+  }
+  ASSERT_EQ(22u, dict.getValueIdForValueGreater(63));
+  ASSERT_EQ(22u, dict.getValueIdForValueGreater(64));
+  ASSERT_EQ(20u, dict.getValueIdForValueSmaller(63));
+
+  value_id_t id = 0;
+  ASSERT_TRUE(dict.findValueId(192, id));
+  ASSERT_EQ(64u, id);
+  ASSERT_FALSE(dict.findValueId(193, id));
+}
+
+TEST_F(DictionaryTest, batch_lookups) {
+  const auto missing = std::numeric_limits<value_id_t>::max();
+  OrderPreservingDictionary<int> ordered;
+  OrderIndifferentDictionary<int> indifferent;
+  for (int i = 0; i < 500; ++i) {
+    ordered.addValue(i * 2);
+    indifferent.addValue(998 - i * 2);
+  }
+
+  const std::vector<int> values {400, 3, 0, 998, 400, 1000, -2, 130};
+  std::vector<value_id_t> ids;
+  ordered.getValueIdsForValues(values, ids);
+  ASSERT_EQ(std::vector<value_id_t>({200, missing, 0, 499, 200, missing, missing, 65}), ids);
+  indifferent.getValueIdsForValues(values, ids);
+  ASSERT_EQ(std::vector<value_id_t>({299, missing, 499, 0, 299, missing, missing, 434}), ids);
+
+  OrderPreservingDictionary<std::string> strings;
+  for (int i = 100; i < 400; ++i)
+    strings.addValue("sku-" + std::to_string(i));
+  strings.getValueIdsForValues({"sku-399", "sku-100", "sku-1000", "sku-250", "a", "sku-116"}, ids);
+  ASSERT_EQ(std::vector<value_id_t>({299, 0, missing, 150, missing, 16}), ids);
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include "helper/types.h"
+#include "storage/BitCompressedVector.h"
+#include "storage/CompressionAdvisor.h"
+#include "storage/FrameOfReferenceVector.h"
+#include "storage/RunLengthVector.h"
+#include "storage/SparseVector.h"
+#include "storage/Store.h"
+#include "storage/TableBuilder.h"
+
+namespace hyrise {
+namespace storage {
+
+class EncodedVectorTests : public Test {
+ protected:
+  void expectValues(const std::vector<value_id_t> &values, BaseAttributeVector<value_id_t> &vector) {
+    ASSERT_EQ(values.size(), vector.size());
+    for (size_t row = 0; row < values.size(); ++row)
+      ASSERT_EQ(values[row], vector.get(0, row)) << "row " << row;
+  }
+
+  // Runs of 100 rows
+  std::vector<value_id_t> sorted(const size_t rows) {
+    std::vector<value_id_t> values;
+    for (size_t row = 0; row < rows; ++row)
+      values.push_back(row / 100);
+    return values;
+  }
+
+  // Ids that grow with the row
+  std::vector<value_id_t> growing(const size_t rows) {
+    std::vector<value_id_t> values;
+    for (size_t row = 0; row < rows; ++row)
+      values.push_back(row + row % 13);
+    return values;
+  }
+
+  // Mostly 3
+  std::vector<value_id_t> constant(const size_t rows) {
+    std::vector<value_id_t> values(rows, 3);
+    for (size_t row = 0; row < rows; row += 501)
+      values[row] = row % 1000;
+    return values;
+  }
+
+  std::vector<value_id_t> random(const size_t rows) {
+    std::vector<value_id_t> values;
+    for (size_t row = 0; row < rows; ++row)
+      values.push_back((row * 7919) % 1009);
+    return values;
+  }
+};
+
+TEST_F(EncodedVectorTests, run_length) {
+  const auto values = sorted(10050);
+  RunLengthVector<value_id_t> vector(values);
+  EXPECT_EQ(101u, vector.runs());
+  EXPECT_EQ(100u, vector.begin(1));
+  EXPECT_EQ(10050u, vector.end(100));
+  expectValues(values, vector);
+  expectValues(values, *vector.copy());
+}
+
+TEST_F(EncodedVectorTests, frame_of_reference) {
+  const auto values = growing(5000);
+  FrameOfReferenceVector<value_id_t> vector(values);
+  ASSERT_EQ(5u, vector.blocks());
+  EXPECT_EQ(1027u, vector.reference(1));
+  EXPECT_EQ(11u, vector.bitsForBlock(1));
+  expectValues(values, vector);
+
+  FrameOfReferenceVector<value_id_t> same(std::vector<value_id_t>(3000, 42));
+  EXPECT_EQ(0u, same.bitsForBlock(0));
+  expectValues(std::vector<value_id_t>(3000, 42), same);
+}
+
+TEST_F(EncodedVectorTests, sparse) {
+  const auto values = constant(5000);
+  SparseVector<value_id_t> vector(values, 3);
+  EXPECT_EQ(10u, vector.exceptions().size());
+  expectValues(values, vector);
+}
+
+TEST_F(EncodedVectorTests, set_changes_the_encoding) {
+  auto values = sorted(3000);
+  const auto random_values = random(3000);
+  std::vector<std::shared_ptr<BaseAttributeVector<value_id_t> > > vectors {
+    std::make_shared<RunLengthVector<value_id_t> >(values),
+    std::make_shared<FrameOfReferenceVector<value_id_t> >(values),
+    std::make_shared<SparseVector<value_id_t> >(values, 0)
+  };
+  for (size_t row = 0; row < 3000; row += 7)
+    values[row] = random_values[row];
+  values[2999] = 0;
+  for (const auto& vector : vectors) {
+    for (size_t row = 0; row < 3000; row += 7)
+      vector->set(0, row, values[row]);
+    vector->set(0, 2999, 0);
+    expectValues(values, *vector);
+    EXPECT_THROW(vector->resize(3001), std::runtime_error);
+  }
+}
+
+TEST_F(EncodedVectorTests, advisor_picks_the_smallest_encoding) {
+  EXPECT_EQ(CompressionAdvisor::RunLength, CompressionAdvisor::advise(sorted(100000)));
+  EXPECT_EQ(CompressionAdvisor::FrameOfReference, CompressionAdvisor::advise(growing(100000)));
+  EXPECT_EQ(CompressionAdvisor::Sparse, CompressionAdvisor::advise(constant(100000)));
+  EXPECT_EQ(CompressionAdvisor::BitPacked, CompressionAdvisor::advise(random(100000)));
+  EXPECT_EQ(CompressionAdvisor::BitPacked, CompressionAdvisor::advise({}));
+
+  for (const auto encoding : {CompressionAdvisor::BitPacked, CompressionAdvisor::RunLength,
+                              CompressionAdvisor::FrameOfReference, CompressionAdvisor::Sparse}) {
+    const auto values = random(3000);
+    expectValues(values, *CompressionAdvisor::encode(values, encoding));
+  }
+}
+
+TEST_F(EncodedVectorTests, store_encodes_columns_on_merge) {
+  TableBuilder::param_list list;
+  list.append().set_type("INTEGER").set_name("sorted");
+  list.append().set_type("INTEGER").set_name("random");
+  list.appendGroup(1).appendGroup(1);
+  auto store = std::make_shared<Store>(TableBuilder::build(list));
+
+  const size_t rows = 20000;
+  const auto area = store->appendToDelta(rows);
+  pos_list_t written;
+  for (size_t row = store->deltaOffset() + area.first; row < store->deltaOffset() + area.second; ++row) {
+    store->setValue<hyrise_int_t>(0, row, row / 1000);
+    store->setValue<hyrise_int_t>(1, row, (row * 7919) % 1009);
+    written.push_back(row);
+  }
+  store->commitPositions(written, tx::UNKNOWN_CID, true);
+  store->merge();
+
+  const auto& main = store->getMainTable();
+  EXPECT_NE(nullptr, std::dynamic_pointer_cast<RunLengthVector<value_id_t> >(
+      main->getAttributeVectors(0).front().attribute_vector));
+  EXPECT_NE(nullptr, std::dynamic_pointer_cast<BitCompressedVector<value_id_t> >(
+      main->getAttributeVectors(1).front().attribute_vector));
+  for (size_t row = 0; row < rows; ++row) {
+    ASSERT_EQ(hyrise_int_t(row / 1000), store->getValue<hyrise_int_t>(0, row));
+    ASSERT_EQ(hyrise_int_t((row * 7919) % 1009), store->getValue<hyrise_int_t>(1, row));
+  }
+}
+
+}
+}
@@ -0,0 +1,91 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include "helper/types.h"
+#include "storage/GroupKeyIndex.h"
+#include "storage/GroupKeyJoinTable.h"
+#include "storage/Store.h"
+#include "storage/TableBuilder.h"
+#include "storage/TableGenerator.h"
+
+namespace hyrise {
+namespace storage {
+
+class GroupKeyIndexTests : public Test {
+ protected:
+  // Store with `rows` main rows (n % 97, n % 3) and no delta
+  std::shared_ptr<Store> filledStore(const size_t rows) {
+    TableBuilder::param_list list;
+    list.append().set_type("INTEGER").set_name("key");
+    list.append().set_type("INTEGER").set_name("small");
+    auto store = std::make_shared<Store>(TableBuilder::build(list));
+    append(store, rows);
+    store->merge();
+    return store;
+  }
+
+  void append(const std::shared_ptr<Store> &store, const size_t rows) {
+    TableGenerator(true).append_committed(store, rows, [&store](const pos_t row) {
+      store->setValue<hyrise_int_t>(0, row, row % 97);
+      store->setValue<hyrise_int_t>(1, row, row % 3);
+    });
+  }
+
+  // The index has to list the rows of every value id of the main in order
+  void expectRows(const std::shared_ptr<Store> &store, const GroupKeyIndex &index, const field_t column) {
+    const auto& main = store->getMainTable();
+    std::vector<pos_list_t> expected(index.distinct());
+    for (size_t row = 0; row < main->size(); ++row)
+      expected[main->getValueId(column, row).valueId].push_back(row);
+
+    for (value_id_t id = 0; id < index.distinct(); ++id) {
+      const auto rows = index.rows(id);
+      EXPECT_EQ(expected[id], pos_list_t(rows.first, rows.second)) << "value id " << id;
+    }
+    EXPECT_EQ(main->size(), index.positions().size());
+  }
+};
+
+TEST_F(GroupKeyIndexTests, rows_of_every_value_id) {
+  auto store = filledStore(1000);
+  const auto index = GroupKeyIndex::build(store->getMainTable(), 0);
+  ASSERT_EQ(97u, index->distinct());
+  expectRows(store, *index, 0);
+  EXPECT_EQ(nullptr, index->rows(97).first);
+}
+
+TEST_F(GroupKeyIndexTests, parallel_build) {
+  auto store = filledStore(140000);
+  expectRows(store, *GroupKeyIndex::build(store->getMainTable(), 0), 0);
+  expectRows(store, *GroupKeyIndex::build(store->getMainTable(), 1), 1);
+}
+
+TEST_F(GroupKeyIndexTests, store_rebuilds_on_merge) {
+  auto store = filledStore(100);
+  const auto before = store->groupKeyIndex(0);
+  EXPECT_EQ(before, store->groupKeyIndex(0));
+
+  append(store, 50);
+  store->merge();
+  const auto after = store->groupKeyIndex(0);
+  EXPECT_NE(before, after);
+  expectRows(store, *after, 0);
+}
+
+TEST_F(GroupKeyIndexTests, join_table_finds_main_and_delta_rows) {
+  auto store = filledStore(500);
+  append(store, 200);
+  const GroupKeyJoinTable table(store, 0);
+
+  pos_list_t expected;
+  for (size_t row = 0; row < store->size(); ++row) {
+    if (store->getValue<hyrise_int_t>(0, row) == 42)
+      expected.push_back(row);
+  }
+  EXPECT_EQ(expected, table.rows<hyrise_int_t>(42));
+  EXPECT_TRUE(table.rows<hyrise_int_t>(1000).empty());
+  EXPECT_THROW(table.rows<hyrise_string_t>("42"), std::runtime_error);
+}
+
+}
+}
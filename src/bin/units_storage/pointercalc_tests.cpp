@@ -90,3 +90,45 @@ TEST_F(PointerCalcTests, pc_on_selected_columns) {
   ASSERT_TRUE(pc->metadataAt(3)->matches(t->metadataAt(7)));
 }
 
+
+TEST_F(PointerCalcTests, nested_pcs_are_flattened) {
+  hyrise::storage::atable_ptr_t t = Loader::shortcuts::load("test/lin_xxs.tbl");
+
+  auto inner = PointerCalculator::create(t, new pos_list_t {1, 3, 5, 7}, new field_list_t {2, 4, 6});
+  auto projected = PointerCalculator::create(inner, nullptr, new field_list_t {2, 0});
+  auto selected = PointerCalculator::create(projected, new pos_list_t {3, 0});
+
+  ASSERT_EQ(t, selected->getTable());
+  ASSERT_EQ((pos_list_t {7, 1}), *selected->getPositions());
+  ASSERT_EQ(2u, selected->columnCount());
+  ASSERT_EQ(t->getValueId(6, 7).valueId, selected->getValueId(0, 0).valueId);
+  ASSERT_EQ(t->getValueId(2, 1).valueId, selected->getValueId(1, 1).valueId);
+}
+
+TEST_F(PointerCalcTests, gather_value_ids) {
+  hyrise::storage::atable_ptr_t t = Loader::shortcuts::load("test/lin_xxs.tbl");
+  auto pc = PointerCalculator::create(t, new pos_list_t {9, 2, 4, 2}, new field_list_t {3, 1});
+
+  std::vector<ValueId> value_ids;
+  pos_list_t rows {3, 0, 1};
+  for (size_t column = 0; column < pc->columnCount(); ++column) {
+    pc->gatherValueIds(column, rows, value_ids);
+    ASSERT_EQ(rows.size(), value_ids.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+      ASSERT_EQ(pc->getValueId(column, rows[i]).valueId, value_ids[i].valueId);
+      ASSERT_EQ(pc->getValueId(column, rows[i]).table, value_ids[i].table);
+    }
+  }
+}
+
+TEST_F(PointerCalcTests, copy_owns_its_lists) {
+  hyrise::storage::atable_ptr_t t = Loader::shortcuts::load("test/lin_xxs.tbl");
+  auto pc = PointerCalculator::create(t, new pos_list_t {9, 2}, new field_list_t {3, 1});
+  auto copy = std::dynamic_pointer_cast<PointerCalculator>(pc->copy());
+
+  ASSERT_NE(pc->getPositions(), copy->getPositions());
+  ASSERT_EQ(*pc->getPositions(), *copy->getPositions());
+  ASSERT_EQ(2u, copy->columnCount());
+  ASSERT_EQ(pc->getValueId(0, 1).valueId, copy->getValueId(0, 1).valueId);
+  ASSERT_EQ(pc->getValueId(1, 0).valueId, copy->getValueId(1, 0).valueId);
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+
+#include <storage/PointerCalculator.h>
+#include <storage/PositionSet.h>
+#include <io/shortcuts.h>
+
+namespace hyrise {
+namespace storage {
+
+class PositionSetTests : public ::hyrise::Test {
+ protected:
+  // Sorted positions below `span`, each taken with the given probability
+  pos_list_t randomPositions(pos_t offset, pos_t span, double probability, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::bernoulli_distribution take(probability);
+    pos_list_t positions;
+    for (pos_t i = 0; i < span; ++i) {
+      if (take(gen))
+        positions.push_back(offset + i);
+    }
+    return positions;
+  }
+};
+
+TEST_F(PositionSetTests, representation_follows_density) {
+  ASSERT_EQ(PositionSet::Range, PositionSet(pos_list_t {3, 4, 5, 6}).representation());
+  ASSERT_EQ(PositionSet::Bitmap, PositionSet(randomPositions(100, 10000, 0.5, 1)).representation());
+  ASSERT_EQ(PositionSet::Array32, PositionSet(randomPositions(100, 10000, 0.001, 2)).representation());
+  ASSERT_EQ(PositionSet::Array64, PositionSet(pos_list_t {1, 1ull << 40}).representation());
+
+  const auto& sparse = randomPositions(0, 100000, 0.001, 3);
+  ASSERT_EQ(PositionSet::Array64, PositionSet::wrap(sparse).representation());
+  ASSERT_EQ(sparse, PositionSet::wrap(sparse).toPositions());
+}
+
+TEST_F(PositionSetTests, contains_and_materialize) {
+  for (double probability : {0.0005, 0.1, 0.9, 1.0}) {
+    const auto& positions = randomPositions(70, 5000, probability, 4);
+    PositionSet set(positions);
+    ASSERT_EQ(positions.size(), set.size());
+    ASSERT_EQ(positions, set.toPositions());
+    for (pos_t p = 0; p < 5100; ++p)
+      ASSERT_EQ(std::binary_search(positions.begin(), positions.end(), p), set.contains(p));
+  }
+}
+
+TEST_F(PositionSetTests, n_way_operations_match_pairwise) {
+  const std::vector<double> probabilities {0.0005, 0.01, 0.3, 0.95, 1.0};
+  for (size_t a = 0; a < probabilities.size(); ++a) {
+    for (size_t b = 0; b < probabilities.size(); ++b) {
+      const std::vector<pos_list_t> lists {
+        randomPositions(0, 20000, probabilities[a], a),
+        randomPositions(130, 15000, probabilities[b], 10 + b),
+        randomPositions(64, 19000, 0.5, 20 + a * b)
+      };
+
+      pos_list_t intersection = lists[0];
+      pos_list_t united = lists[0];
+      std::vector<PositionSet> sets;
+      sets.reserve(lists.size());
+      std::vector<const PositionSet *> inputs;
+      for (const auto& list : lists) {
+        pos_list_t tmp;
+        std::set_intersection(intersection.begin(), intersection.end(), list.begin(), list.end(), std::back_inserter(tmp));
+        intersection.swap(tmp);
+        tmp.clear();
+        std::set_union(united.begin(), united.end(), list.begin(), list.end(), std::back_inserter(tmp));
+        united.swap(tmp);
+        sets.push_back(PositionSet::wrap(list));
+        inputs.push_back(&sets.back());
+      }
+
+      ASSERT_EQ(intersection, PositionSet::intersect(inputs).toPositions()) << a << " " << b;
+      ASSERT_EQ(united, PositionSet::unite(inputs).toPositions()) << a << " " << b;
+    }
+  }
+}
+
+TEST_F(PositionSetTests, dense_results_are_compressed) {
+  const auto& left = randomPositions(0, 1 << 16, 0.9, 5);
+  const auto& right = randomPositions(0, 1 << 16, 0.9, 6);
+  auto l = PositionSet::wrap(left);
+  auto r = PositionSet::wrap(right);
+
+  const auto& intersection = PositionSet::intersect({&l, &r});
+  ASSERT_EQ(PositionSet::Bitmap, intersection.representation());
+  ASSERT_GT(intersection.size() * sizeof(pos_t) / 32, intersection.memoryUsage());
+
+  PositionSet all(0, 1 << 16);
+  ASSERT_EQ(PositionSet::Range, PositionSet::unite({&l, &all}).representation());
+  PositionSet empty;
+  ASSERT_TRUE(PositionSet::intersect({&l, &empty}).empty());
+}
+
+TEST_F(PositionSetTests, pointer_calculator_intersect_many) {
+  auto t = Loader::shortcuts::load("test/lin_xxs.tbl");
+  PointerCalculator::pc_vector pcs {
+    PointerCalculator::create(t, new pos_list_t {0, 1, 2, 5, 8, 9}),
+    PointerCalculator::create(t, new pos_list_t {1, 2, 3, 8, 9, 50}),
+    PointerCalculator::create(t, new pos_list_t {2, 8, 9}),
+    PointerCalculator::create(t, nullptr, nullptr)
+  };
+
+  const auto& intersection = PointerCalculator::intersect_many(pcs.begin(), pcs.end());
+  ASSERT_EQ((pos_list_t {2, 8, 9}), *intersection->getPositions());
+
+  const auto& united = PointerCalculator::unite_many(pcs.begin(), pcs.end() - 1);
+  ASSERT_EQ((pos_list_t {0, 1, 2, 3, 5, 8, 9, 50}), *united->getPositions());
+  ASSERT_EQ(t->size(), PointerCalculator::unite_many(pcs.begin(), pcs.end())->size());
+}
+
+}
+}
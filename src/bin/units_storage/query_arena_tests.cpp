@@ -0,0 +1,149 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include <thread>
+
+#include "helper/types.h"
+#include "memory/QueryArena.h"
+
+namespace hyrise {
+namespace memory {
+
+using storage::pos_list_t;
+using storage::pos_t;
+
+class QueryArenaTests : public ::hyrise::Test {};
+
+TEST_F(QueryArenaTests, heap_without_scope) {
+  ASSERT_EQ(nullptr, QueryArena::current());
+  pos_list_t positions(100, 1);
+  ASSERT_EQ(1u, positions[99]);
+}
+
+TEST_F(QueryArenaTests, position_lists_use_the_arena) {
+  QueryArena arena;
+  {
+    ArenaScope scope(&arena);
+    ASSERT_EQ(&arena, QueryArena::current());
+    pos_list_t positions;
+    for (pos_t row = 0; row < 500; ++row)
+      positions.push_back(row);
+    ASSERT_EQ(1u, arena.chunks());
+    ASSERT_EQ(QueryArena::min_chunk_bytes, arena.chunkBytes());
+
+    // Large allocations use the heap
+    pos_list_t large(QueryArena::max_allocation_bytes);
+    ASSERT_EQ(1u, arena.chunks());
+  }
+  ASSERT_EQ(nullptr, QueryArena::current());
+}
+
+TEST_F(QueryArenaTests, peak_bytes_include_large_allocations) {
+  const size_t before = QueryArena::allocatedBytes();
+  {
+    QueryArena arena;
+    {
+      ArenaScope scope(&arena);
+      pos_list_t small(10);
+      ASSERT_EQ(QueryArena::min_chunk_bytes, arena.peakBytes());
+      {
+        pos_list_t large(QueryArena::max_allocation_bytes);
+        ASSERT_LT(QueryArena::min_chunk_bytes + QueryArena::max_allocation_bytes * sizeof(pos_t), arena.peakBytes());
+        ASSERT_LT(before + QueryArena::max_allocation_bytes * sizeof(pos_t), QueryArena::allocatedBytes());
+      }
+      const size_t peak = arena.peakBytes();
+      pos_list_t large(QueryArena::max_allocation_bytes);
+      ASSERT_EQ(peak, arena.peakBytes());
+    }
+  }
+  ASSERT_EQ(before, QueryArena::allocatedBytes());
+}
+
+TEST_F(QueryArenaTests, limit_stops_allocations) {
+  QueryArena arena;
+  arena.setLimit(64 * 1024);
+  ArenaScope scope(&arena);
+  ASSERT_TRUE(QueryArena::fits(64 * 1024));
+  ASSERT_FALSE(QueryArena::fits(64 * 1024 + 1));
+
+  pos_list_t positions(1000);
+  ASSERT_EQ(64 * 1024 - arena.usedBytes(), QueryArena::availableBytes());
+  ASSERT_THROW(pos_list_t(QueryArena::max_allocation_bytes), MemoryLimitExceeded);
+  ASSERT_THROW(positions.resize(8 * 1024), MemoryLimitExceeded);
+  ASSERT_EQ(1000u, positions.size());
+}
+
+TEST_F(QueryArenaTests, steps_share_the_limit_and_free_their_chunks) {
+  QueryArena query;
+  query.setLimit(256 * 1024);
+  ArenaScope scope(&query);
+  pos_list_t result(10);
+  const size_t used = query.usedBytes();
+  for (size_t step = 0; step < 10; ++step) {
+    QueryArena arena(&query);
+    ArenaScope step_scope(&arena);
+    ASSERT_EQ(256u * 1024, arena.limit());
+    pos_list_t intermediate;
+    for (pos_t row = 0; row < 2000; ++row)
+      intermediate.push_back(row);
+    ASSERT_LT(used, query.usedBytes());
+  }
+  ASSERT_EQ(used, query.usedBytes());
+}
+
+TEST_F(QueryArenaTests, intermediates_outlive_the_arena) {
+  pos_list_t *positions;
+  {
+    QueryArena arena;
+    ArenaScope scope(&arena);
+    positions = new pos_list_t(10, 42);
+  }
+  // The chunk is freed with the last allocation
+  ASSERT_EQ(42u, positions->back());
+  positions->push_back(43);
+  delete positions;
+}
+
+TEST_F(QueryArenaTests, nested_scopes) {
+  QueryArena outer, inner;
+  ArenaScope outer_scope(&outer);
+  pos_list_t a(10);
+  {
+    ArenaScope keep(nullptr);
+    ASSERT_EQ(&outer, QueryArena::current());
+    ArenaScope inner_scope(&inner);
+    ASSERT_EQ(&inner, QueryArena::current());
+    pos_list_t b(10);
+    ASSERT_EQ(1u, inner.chunks());
+  }
+  ASSERT_EQ(&outer, QueryArena::current());
+  pos_list_t c(10);
+  ASSERT_EQ(1u, outer.chunks());
+}
+
+TEST_F(QueryArenaTests, threads_hand_chunks_over) {
+  QueryArena arena;
+  std::vector<pos_list_t> results(4);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&arena, &results, i]() {
+        ArenaScope scope(&arena);
+        for (pos_t row = 0; row < 100; ++row)
+          results[i].push_back(row * i);
+      });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  for (size_t i = 0; i < results.size(); ++i)
+    ASSERT_EQ(99 * i, results[i].back());
+  ASSERT_GE(results.size(), arena.chunks());
+
+  // A later scope continues in a chunk an earlier one gave back
+  const size_t chunks = arena.chunks();
+  ArenaScope scope(&arena);
+  pos_list_t more(10);
+  ASSERT_EQ(chunks, arena.chunks());
+}
+
+}
+}
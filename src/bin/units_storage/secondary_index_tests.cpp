@@ -0,0 +1,161 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include "helper/types.h"
+#include "storage/SecondaryIndex.h"
+#include "storage/Store.h"
+#include "storage/TableBuilder.h"
+#include "storage/TableGenerator.h"
+
+namespace hyrise {
+namespace storage {
+
+class SecondaryIndexTests : public Test {
+ protected:
+  virtual void SetUp() {
+    TableBuilder::param_list list;
+    list.append().set_type("INTEGER").set_name("customer");
+    list.append().set_type("STRING").set_name("order");
+    store = std::make_shared<Store>(TableBuilder::build(list));
+    append(50);
+    store->merge();
+    index = std::make_shared<SecondaryIndex>(store, field_list_t({0, 1}));
+    store->addIndex(index);
+  }
+
+  // Appends `rows` rows (n % 7, "o" + n % 5) to the delta and indexes them
+  void append(const size_t rows) {
+    const auto area = TableGenerator(true).append_committed(store, rows, [this](const pos_t row) {
+      store->setValue<hyrise_int_t>(0, row, (row * 3) % 7);
+      store->setValue<hyrise_string_t>(1, row, "o" + std::to_string(row % 5));
+    });
+    store->indexDelta(area.first, area.second);
+  }
+
+  // Compares the index with a scan for customers in [lo, hi] and, unless
+  // empty, orders in [order_lo, order_hi]
+  void expectLookup(hyrise_int_t lo, hyrise_int_t hi, std::string order_lo = "", std::string order_hi = "") {
+    std::vector<SecondaryIndex::KeyRange> ranges {index->range<hyrise_int_t>(0, lo, hi)};
+    if (!order_lo.empty())
+      ranges.push_back(index->range<hyrise_string_t>(1, order_lo, order_hi));
+
+    pos_list_t expected;
+    for (size_t row = 0; row < store->size(); ++row) {
+      const auto customer = store->getValue<hyrise_int_t>(0, row);
+      const auto order = store->getValue<hyrise_string_t>(1, row);
+      if (customer >= lo && customer <= hi && (order_lo.empty() || (order >= order_lo && order <= order_hi)))
+        expected.push_back(row);
+    }
+    EXPECT_EQ(expected, index->lookup(ranges)) << lo << " " << hi << " " << order_lo << " " << order_hi;
+  }
+
+  void expectLookups() {
+    expectLookup(3, 3);
+    expectLookup(3, 3, "o2", "o2");
+    expectLookup(2, 4);
+    expectLookup(2, 4, "o1", "o1");
+    expectLookup(0, 6, "o1", "o3");
+    expectLookup(5, 5, "o0", "o3");
+    expectLookup(100, 100);
+    expectLookup(4, 1);
+  }
+
+  std::shared_ptr<Store> store;
+  std::shared_ptr<SecondaryIndex> index;
+};
+
+TEST_F(SecondaryIndexTests, lookups_on_main) {
+  ASSERT_EQ(50u, store->getMainTable()->size());
+  expectLookups();
+}
+
+TEST_F(SecondaryIndexTests, lookups_on_main_and_delta) {
+  append(30);
+  append(1);
+  ASSERT_EQ(31u, store->getDeltaTable()->size());
+  expectLookups();
+}
+
+TEST_F(SecondaryIndexTests, merge_rebuilds_the_index) {
+  append(30);
+  store->merge();
+  ASSERT_EQ(80u, store->getMainTable()->size());
+  expectLookups();
+
+  append(12);
+  expectLookups();
+}
+
+TEST_F(SecondaryIndexTests, index_on_existing_delta) {
+  append(20);
+  auto single = std::make_shared<SecondaryIndex>(store, field_list_t({1}));
+  store->addIndex(single);
+  append(5);
+
+  pos_list_t expected;
+  for (size_t row = 0; row < store->size(); ++row) {
+    if (store->getValue<hyrise_string_t>(1, row) == "o4")
+      expected.push_back(row);
+  }
+  EXPECT_EQ(expected, single->lookup({single->equal<hyrise_string_t>(0, "o4")}));
+}
+
+TEST_F(SecondaryIndexTests, primary_key_check) {
+  TableBuilder::param_list list;
+  list.append().set_type("INTEGER").set_name("id");
+  auto orders = std::make_shared<Store>(TableBuilder::build(list));
+  const tx::transaction_id_t tid = 42;
+  // Appends the order `id` written by `writer`, committed unless `writer`
+  // is given
+  auto add = [&](const hyrise_int_t id, const tx::transaction_id_t writer) {
+    const auto area = orders->appendToDelta(1);
+    const pos_t row = orders->deltaOffset() + area.first;
+    orders->setValue<hyrise_int_t>(0, row, id);
+    if (writer == tx::START_TID)
+      orders->commitPositions({row}, tx::UNKNOWN_CID, true);
+    else
+      orders->setTid(row, writer);
+    orders->indexDelta(area.first, area.second);
+  };
+  for (hyrise_int_t id = 0; id < 20; ++id)
+    add(id, tx::START_TID);
+  orders->merge();
+  orders->setPrimaryKey(std::make_shared<SecondaryIndex>(orders, field_list_t({0})));
+  EXPECT_THROW(orders->setPrimaryKey(std::make_shared<SecondaryIndex>(orders, field_list_t({0}))), std::runtime_error);
+
+  auto rows = orders->copy_structure_modifiable();
+  rows->resize(2);
+  auto check = [&](const hyrise_int_t first, const hyrise_int_t second) {
+    rows->setValue<hyrise_int_t>(0, 0, first);
+    rows->setValue<hyrise_int_t>(0, 1, second);
+    orders->checkPrimaryKey(rows, tid);
+  };
+
+  EXPECT_NO_THROW(check(20, 21));
+  EXPECT_THROW(check(5, 21), std::runtime_error);
+  EXPECT_THROW(check(21, 21), std::runtime_error);
+
+  // Committed and own inserts hold their key, rolled back ones do not
+  add(30, tx::START_TID);
+  add(31, tid);
+  add(32, 4711);
+  EXPECT_THROW(check(20, 30), std::runtime_error);
+  EXPECT_THROW(check(31, 20), std::runtime_error);
+  EXPECT_NO_THROW(check(32, 20));
+
+  // Deleted rows and rows the transaction deletes free their key
+  orders->commitPositions({5}, tx::UNKNOWN_CID + 1, false);
+  EXPECT_NO_THROW(check(5, 20));
+  ASSERT_EQ(tx::TX_CODE::TX_OK, orders->markForDeletion(6, tid));
+  EXPECT_NO_THROW(check(6, 20));
+  ASSERT_EQ(tx::TX_CODE::TX_OK, orders->markForDeletion(7, 4711));
+  EXPECT_THROW(check(7, 20), std::runtime_error);
+}
+
+TEST_F(SecondaryIndexTests, wrong_key_type) {
+  EXPECT_THROW(index->equal<hyrise_string_t>(0, "a"), std::runtime_error);
+  EXPECT_THROW(index->equal<hyrise_int_t>(2, 1), std::runtime_error);
+}
+
+}
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include <limits>
+
+#include "helper/types.h"
+#include "memory/QueryArena.h"
+#include "memory/SpillFile.h"
+
+namespace hyrise {
+namespace memory {
+
+class SpillFileTests : public ::hyrise::Test {};
+
+TEST_F(SpillFileTests, values_round_trip) {
+  SpillFile file;
+  const std::vector<int64_t> signs {0, -1, 1, 63, -64, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()};
+  file.writeUnsigned(0);
+  file.writeUnsigned(127);
+  file.writeUnsigned(128);
+  file.writeUnsigned(std::numeric_limits<uint64_t>::max());
+  for (const auto& value : signs)
+    file.writeSigned(value);
+  file.writeDouble(0.5);
+  file.writeString("");
+  file.writeString("spilled");
+  // Small integers take a byte
+  ASSERT_EQ(1u + 1 + 2 + 10 + 1 + 1 + 1 + 1 + 1 + 10 + 10 + 8 + 1 + 8, file.bytes());
+
+  file.rewind();
+  uint64_t u;
+  ASSERT_TRUE(file.readUnsigned(u));
+  ASSERT_EQ(0u, u);
+  ASSERT_TRUE(file.readUnsigned(u));
+  ASSERT_EQ(127u, u);
+  ASSERT_TRUE(file.readUnsigned(u));
+  ASSERT_EQ(128u, u);
+  ASSERT_TRUE(file.readUnsigned(u));
+  ASSERT_EQ(std::numeric_limits<uint64_t>::max(), u);
+  for (const auto& value : signs) {
+    int64_t s;
+    ASSERT_TRUE(file.readSigned(s));
+    ASSERT_EQ(value, s);
+  }
+  double d;
+  ASSERT_TRUE(file.readDouble(d));
+  ASSERT_EQ(0.5, d);
+  std::string str;
+  ASSERT_TRUE(file.readString(str));
+  ASSERT_EQ("", str);
+  ASSERT_TRUE(file.readString(str));
+  ASSERT_EQ("spilled", str);
+  ASSERT_FALSE(file.readUnsigned(u));
+}
+
+TEST_F(SpillFileTests, partitions_keep_ascending_positions) {
+  SpilledPartitions partitions(3);
+  for (storage::pos_t row = 0; row < 1000; ++row)
+    partitions.add(row % 3, row * 1000);
+  ASSERT_EQ(334u, partitions.count(0));
+
+  storage::pos_list_t positions;
+  partitions.read(1, positions);
+  ASSERT_EQ(333u, positions.size());
+  for (size_t i = 0; i < positions.size(); ++i)
+    ASSERT_EQ((3 * i + 1) * 1000, positions[i]);
+}
+
+TEST_F(SpillFileTests, partitions_follow_the_limit) {
+  ASSERT_EQ(1u, SpilledPartitions::partitionsFor(1024 * 1024));
+  QueryArena arena;
+  arena.setLimit(1024 * 1024);
+  ArenaScope scope(&arena);
+  ASSERT_EQ(9u, SpilledPartitions::partitionsFor(2 * 1024 * 1024));
+  ASSERT_EQ(SpilledPartitions::max_partitions, SpilledPartitions::partitionsFor(1024 * 1024 * 1024));
+}
+
+}
+}
@@ -1,6 +1,7 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "testing/test.h"
 
+#include "storage/BitCompressedVector.h"
 #include "storage/Store.h"
 #include "storage/TableGenerator.h"
 
@@ -35,5 +36,59 @@ TEST_F(StoreTests, test_write_through_fail) {
 #endif
 }
 
+TEST_F(StoreTests, gather_value_ids_from_main_and_delta) {
+  auto s = std::make_shared<Store>(tg.one_value_delta(3, 2, 0));
+  s->appendToDelta(2);
+  s->setValue<hyrise_int_t>(1, 3, 5);
+  s->setValue<hyrise_int_t>(1, 4, 7);
+
+  std::vector<ValueId> value_ids;
+  const pos_list_t rows {4, 0, 3, 2};
+  s->gatherValueIds(1, rows, value_ids);
+  ASSERT_EQ(rows.size(), value_ids.size());
+  for (size_t i = 0; i < rows.size(); ++i) {
+    ASSERT_EQ(s->getValueId(1, rows[i]).valueId, value_ids[i].valueId);
+    ASSERT_EQ(s->getValueId(1, rows[i]).table, value_ids[i].table);
+  }
+}
+
+TEST_F(StoreTests, merged_main_uses_minimal_bit_width) {
+  auto s = std::make_shared<Store>(tg.one_value_delta(3, 2, 0));
+  const auto area = s->appendToDelta(300);
+  for (size_t row = s->deltaOffset() + area.first; row < s->deltaOffset() + area.second; ++row) {
+    s->setValue<hyrise_int_t>(0, row, row);
+    s->setValue<hyrise_int_t>(1, row, row % 3);
+  }
+  s->merge();
+
+  const auto& main = s->getMainTable();
+  for (field_t column = 0; column < 2; ++column) {
+    const auto vectors = main->getAttributeVectors(column);
+    ASSERT_EQ(1u, vectors.size());
+    auto vector = std::dynamic_pointer_cast<BitCompressedVector<value_id_t> >(vectors[0].attribute_vector);
+    ASSERT_NE(nullptr, vector);
+    EXPECT_EQ(bitsForValues(main->dictionaryAt(column)->size()),
+              vector->bitsForColumn(vectors[0].attribute_offset));
+  }
+  for (size_t row = 3; row < s->size(); ++row) {
+    EXPECT_EQ(hyrise_int_t(row), s->getValue<hyrise_int_t>(0, row));
+    EXPECT_EQ(hyrise_int_t(row % 3), s->getValue<hyrise_int_t>(1, row));
+  }
+}
+
+TEST_F(StoreTests, bytes_grow_with_main_delta_and_transactions) {
+  auto s = std::make_shared<Store>(tg.one_value_delta(100, 2, 0));
+  const size_t main_bytes = s->columnBytes(0);
+  ASSERT_LT(0u, main_bytes);
+  const size_t transaction_bytes = s->transactionBytes();
+
+  s->appendToDelta(1000);
+  for (size_t row = s->deltaOffset(); row < s->size(); ++row)
+    s->setValue<hyrise_int_t>(0, row, row);
+  ASSERT_LT(main_bytes, s->columnBytes(0));
+  ASSERT_LT(transaction_bytes, s->transactionBytes());
+  ASSERT_EQ(s->columnBytes(0) + s->columnBytes(1) + s->transactionBytes() + s->indexBytes(), s->bytes());
+}
+
 }
 }
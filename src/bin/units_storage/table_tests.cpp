@@ -4,12 +4,14 @@
 #include "io/shortcuts.h"
 
 #include "storage/AbstractTable.h"
+#include "storage/BitCompressedVector.h"
 #include "storage/DictionaryFactory.h"
 #include "storage/FixedLengthVector.h"
 #include "storage/OrderIndifferentDictionary.h"
 #include "storage/OrderPreservingDictionary.h"
 #include "storage/RawTable.h"
 #include "storage/SimpleStore.h"
+#include "storage/Table.h"
 #include "storage/TableGenerator.h"
 
 namespace hyrise { namespace storage {
@@ -120,6 +122,30 @@ TEST_F(TableTests, bit_compression_test) {
   ASSERT_TRUE(main->getValueId(two,  two).valueId == 0);
 }
 
+TEST_F(TableTests, gather_value_ids_of_every_vector_type) {
+  std::vector<std::shared_ptr<BaseAttributeVector<value_id_t> > > vectors {
+    std::make_shared<FixedLengthVector<value_id_t> >(1, 100),
+    std::make_shared<BitCompressedVector<value_id_t> >(1, 100, std::vector<uint64_t> {8}),
+    std::make_shared<BitCompressedVector<value_id_t> >(1, 100, std::vector<uint64_t> {16}),
+    std::make_shared<BitCompressedVector<value_id_t> >(2, 100, std::vector<uint64_t> {3, 7})
+  };
+  pos_list_t rows {99, 0, 42, 42, 7};
+
+  for (const auto& vector : vectors) {
+    vector->resize(100);
+    for (size_t row = 0; row < 100; ++row)
+      vector->set(0, row, row % 8);
+    Table table({ColumnMetadata("col0", IntegerType)}, vector,
+                {makeDictionary<OrderIndifferentDictionary>(IntegerType)});
+
+    std::vector<ValueId> value_ids;
+    table.gatherValueIds(0, rows, value_ids);
+    ASSERT_EQ(rows.size(), value_ids.size());
+    for (size_t i = 0; i < rows.size(); ++i)
+      EXPECT_EQ(table.getValueId(0, rows[i]).valueId, value_ids[i].valueId);
+  }
+}
+
 TEST_F(TableTests, test_modifiable_table) {
   TableGenerator t;
   hyrise::storage::atable_ptr_t a = t.create_empty_table_modifiable(10, 2);
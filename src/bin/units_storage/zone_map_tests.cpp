@@ -0,0 +1,86 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "testing/test.h"
+
+#include "helper/types.h"
+#include "storage/Store.h"
+#include "storage/TableBuilder.h"
+#include "storage/TableGenerator.h"
+#include "storage/ZoneMap.h"
+
+namespace hyrise {
+namespace storage {
+
+class ZoneMapTests : public Test {
+ protected:
+  // Store with an empty main and `rows` delta rows, (row, row % 10)
+  std::shared_ptr<Store> filledStore(const size_t rows) {
+    TableBuilder::param_list list;
+    list.append().set_type("INTEGER").set_name("ts");
+    list.append().set_type("INTEGER").set_name("mod");
+    auto store = std::make_shared<Store>(TableBuilder::build(list));
+    TableGenerator(true).append_committed(store, rows, [&store](const pos_t row) {
+      store->setValue<hyrise_int_t>(0, row, row);
+      store->setValue<hyrise_int_t>(1, row, row % 10);
+    });
+    return store;
+  }
+};
+
+TEST_F(ZoneMapTests, delta_is_extended_on_write) {
+  auto store = filledStore(ZoneMap::chunk_rows + 10);
+  const auto zones = store->zoneMap(1);
+  ASSERT_EQ(2u, zones->chunkCount());
+
+  // Delta value ids are assigned in insertion order
+  const auto first = zones->synopsis(0, 0);
+  EXPECT_EQ(0u, first.min);
+  EXPECT_EQ(ZoneMap::chunk_rows - 1, first.max);
+  const auto second = zones->synopsis(0, 1);
+  EXPECT_EQ(ZoneMap::chunk_rows, second.min);
+  EXPECT_EQ(ZoneMap::chunk_rows + 9, second.max);
+  EXPECT_EQ(9u, zones->synopsis(1, 1).max);
+  EXPECT_TRUE(zones->synopsis(0, 2).empty());
+}
+
+TEST_F(ZoneMapTests, copied_rows_extend_the_delta) {
+  auto store = filledStore(10);
+  auto source = store->getDeltaTable();
+  store->appendToDelta(1);
+  store->copyRowToDelta(source, 3, 10, tx::START_TID);
+  const auto zones = store->zoneMap(1);
+  EXPECT_EQ(0u, zones->synopsis(0, 0).min);
+  EXPECT_EQ(9u, zones->synopsis(0, 0).max);
+}
+
+TEST_F(ZoneMapTests, main_is_built_with_the_store) {
+  TableBuilder::param_list list;
+  list.append().set_type("INTEGER").set_name("ts");
+  auto main = TableBuilder::build(list);
+  main->resize(ZoneMap::chunk_rows + 10);
+  for (size_t row = 0; row < main->size(); ++row)
+    main->setValue<hyrise_int_t>(0, row, row / 2);
+
+  Store store(main);
+  const auto zones = store.zoneMap(0);
+  ASSERT_EQ(2u, zones->chunkCount());
+  EXPECT_EQ(0u, zones->synopsis(0, 0).min);
+  EXPECT_EQ(ZoneMap::chunk_rows / 2 - 1, zones->synopsis(0, 0).max);
+  EXPECT_EQ(ZoneMap::chunk_rows / 2, zones->synopsis(0, 1).min);
+  EXPECT_EQ(ZoneMap::chunk_rows / 2 + 4, zones->synopsis(0, 1).max);
+}
+
+TEST_F(ZoneMapTests, main_is_rebuilt_on_merge) {
+  auto store = filledStore(100);
+  store->merge();
+  ASSERT_EQ(100u, store->getMainTable()->size());
+
+  const auto main = store->zoneMap(0);
+  ASSERT_EQ(1u, main->chunkCount());
+  EXPECT_EQ(0u, main->synopsis(0, 0).min);
+  EXPECT_EQ(99u, main->synopsis(0, 0).max);
+  EXPECT_EQ(9u, main->synopsis(1, 0).max);
+  EXPECT_EQ(0u, store->zoneMap(1)->chunkCount());
+}
+
+}
+}
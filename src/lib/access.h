@@ -14,7 +14,7 @@
 #include <access/json_converters.h>
 #include <access/Layouter.h>
 #include <access/MaterializingScan.h>
-#include <access/MergeJoin.hpp>
+#include <access/MergeJoin.h>
 #include <access/MergeTable.h>
 #include <access/PosUpdateScan.h>
 #include <access/ProjectionScan.h>
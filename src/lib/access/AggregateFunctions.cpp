@@ -1,6 +1,7 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "AggregateFunctions.h"
 #include <storage/meta_storage.h>
+#include <storage/ColumnAccessor.h>
 #include "json.h"
 
 namespace hyrise { namespace storage {
@@ -38,17 +39,12 @@ struct sum_aggregate_functor : aggregate_functor {
 template <typename R>
 void sum_aggregate_functor::operator()() {
   R result = 0;
+  auto add = [&result](size_t, const R &value) { result += value; };
 
   if (rows != nullptr) {
-    for (const auto& currentRow: *rows) {
-      result += input->getValue<R>(sourceField, currentRow);
-    }
+    ColumnAccessor<R>(input, sourceField).forEach(*rows, add);
   } else {
-    size_t input_size = input->size();
-
-    for (size_t i = 0; i < input_size; ++i) {
-      result += input->getValue<R>(sourceField, i);
-    }
+    ColumnAccessor<R>(input, sourceField).forEach(add);
   }
 
   target->setValue<R>(target->numberOfColumn(targetColumn), targetRow, result);
@@ -76,17 +72,13 @@ void average_aggregate_functor::operator()() {
   R sum = 0;
   size_t count = 0;
 
+  auto add = [&sum](size_t, const R &value) { sum += value; };
+
   if (rows != nullptr) {
-    for (const auto& currentRow: *rows) {
-      sum += input->getValue<R>(sourceField, currentRow);
-    }
+    ColumnAccessor<R>(input, sourceField).forEach(*rows, add);
     count = rows->size();
   } else {
-    const size_t input_size = input->size();
-
-    for (size_t i = 0; i < input_size; ++i) {
-      sum += input->getValue<R>(sourceField, i);
-    }
+    ColumnAccessor<R>(input, sourceField).forEach(add);
     count = input->size();
   }
   target->setValue<float>(target->numberOfColumn(targetColumn), targetRow, ((float)sum / count));
@@ -107,25 +99,19 @@ struct min_aggregate_functor : aggregate_functor {
 
   template <typename R>
   value_type operator()() {
-    R min;
+    R min = R();
+    bool first = true;
+    auto compare = [&min, &first](size_t, const R &cur) {
+      if (first || cur < min) {
+        min = cur;
+        first = false;
+      }
+    };
 
     if (rows != nullptr) {
-      min = input->getValue<R>(sourceField, rows->front());
-      for (const auto& currentRow: *rows) {
-        R cur = input->getValue<R>(sourceField, currentRow);
-	if (cur < min)
-	  min = cur;
-      }
-    }
-    else {
-      min = input->getValue<R>(sourceField, 0);
-      const size_t input_size = input->size();
-
-      for (size_t currentRow = 0; currentRow < input_size; ++currentRow) {
-        R cur = input->getValue<R>(sourceField, currentRow);
-	if (cur < min)
-	  min = cur;
-      }
+      ColumnAccessor<R>(input, sourceField).forEach(*rows, compare);
+    } else {
+      ColumnAccessor<R>(input, sourceField).forEach(compare);
     }
     target->setValue<R>(target->numberOfColumn(targetColumn), targetRow, min);
   }
@@ -141,25 +127,19 @@ struct max_aggregate_functor : aggregate_functor{
 
   template <typename R>
   value_type operator()() {
-    R max;
+    R max = R();
+    bool first = true;
+    auto compare = [&max, &first](size_t, const R &cur) {
+      if (first || cur > max) {
+        max = cur;
+        first = false;
+      }
+    };
 
     if (rows != nullptr) {
-      max = input->getValue<R>(sourceField, rows->front());
-      for (const auto& currentRow: *rows) {
-        const R cur = input->getValue<R>(sourceField, currentRow);
-	if (cur > max)
-	  max = cur;
-      }
-    }
-    else {
-      max = input->getValue<R>(sourceField, 0);
-      const size_t input_size = input->size();
-
-      for (size_t currentRow = 0; currentRow < input_size; ++currentRow) {
-        const R cur = input->getValue<R>(sourceField, currentRow);
-	if (cur > max)
-	  max = cur;
-      }
+      ColumnAccessor<R>(input, sourceField).forEach(*rows, compare);
+    } else {
+      ColumnAccessor<R>(input, sourceField).forEach(compare);
     }
     target->setValue<R>(target->numberOfColumn(targetColumn), targetRow, max);
   }
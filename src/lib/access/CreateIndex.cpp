@@ -8,6 +8,8 @@
 #include "access/system/BasicParser.h"
 #include "access/system/QueryParser.h"
 
+#include "helper/checked_cast.h"
+
 #include "io/StorageManager.h"
 
 #include "storage/AbstractTable.h"
@@ -15,7 +17,10 @@
 #include "storage/storage_types.h"
 #include "storage/PointerCalculator.h"
 #include "storage/AbstractIndex.h"
+#include "storage/GroupKeyIndex.h"
 #include "storage/InvertedIndex.h"
+#include "storage/SecondaryIndex.h"
+#include "storage/Store.h"
 
 namespace hyrise {
 namespace access {
@@ -44,11 +49,29 @@ CreateIndex::~CreateIndex() {
 void CreateIndex::executePlanOperation() {
   const auto &in = input.getTable(0);
   std::shared_ptr<AbstractIndex> _index;
-  auto column = _field_definition[0];
 
-  CreateIndexFunctor fun(in, column);
-  storage::type_switch<hyrise_basic_types> ts;
-  _index = ts(in->typeOfColumn(column), fun);
+  if (_secondary || _primary_key) {
+    // The store maintains the index, so it has to be modifiable
+    auto store = std::const_pointer_cast<storage::Store>(checked_pointer_cast<const storage::Store>(in));
+    auto index = std::make_shared<storage::SecondaryIndex>(store, _field_definition);
+    if (_primary_key)
+      store->setPrimaryKey(index);
+    else
+      store->addIndex(index);
+    _index = index;
+  } else if (_group_key) {
+    // Stores share the group key index of their main
+    const auto& store = std::dynamic_pointer_cast<const storage::Store>(in);
+    if (store)
+      _index = std::const_pointer_cast<storage::GroupKeyIndex>(store->groupKeyIndex(_field_definition[0]));
+    else
+      _index = storage::GroupKeyIndex::build(in, _field_definition[0]);
+  } else {
+    auto column = _field_definition[0];
+    CreateIndexFunctor fun(in, column);
+    storage::type_switch<hyrise_basic_types> ts;
+    _index = ts(in->typeOfColumn(column), fun);
+  }
 
   StorageManager *sm = StorageManager::getInstance();
   sm->addInvertedIndex(_index_name, _index);
@@ -57,6 +80,9 @@ void CreateIndex::executePlanOperation() {
 std::shared_ptr<PlanOperation> CreateIndex::parse(const Json::Value &data) {
   auto i = BasicParser<CreateIndex>::parse(data);
   i->setIndexName(data["index_name"].asString());
+  i->setSecondary(data.get("secondary", false).asBool());
+  i->setGroupKey(data.get("group_key", false).asBool());
+  i->setPrimaryKey(data.get("primary_key", false).asBool());
   return i;
 }
 
@@ -64,5 +90,17 @@ void CreateIndex::setIndexName(const std::string &t) {
   _index_name = t;
 }
 
+void CreateIndex::setSecondary(const bool secondary) {
+  _secondary = secondary;
+}
+
+void CreateIndex::setGroupKey(const bool group_key) {
+  _group_key = group_key;
+}
+
+void CreateIndex::setPrimaryKey(const bool primary_key) {
+  _primary_key = primary_key;
+}
+
 }
 }
@@ -14,11 +14,23 @@ public:
   void executePlanOperation();
   /// set index name in field "_index_name"
   /// set column in field "fields"
+  /// with "secondary": true, build a SecondaryIndex on all "fields" of a
+  /// store that is maintained on inserts, updates and merges
+  /// with "primary_key": true, the SecondaryIndex also becomes the
+  /// primary key of the store, see Store::setPrimaryKey
+  /// with "group_key": true, register the GroupKeyIndex of the first of
+  /// "fields", see storage/GroupKeyIndex.h
   static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
   void setIndexName(const std::string &t);
+  void setSecondary(bool secondary);
+  void setGroupKey(bool group_key);
+  void setPrimaryKey(bool primary_key);
 
 private:
   std::string _index_name;
+  bool _secondary = false;
+  bool _group_key = false;
+  bool _primary_key = false;
 };
 
 }
@@ -1,15 +1,47 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/ExpressionScan.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "access/system/QueryParser.h"
 #include "storage/DictionaryFactory.h"
+#include "storage/FixedLengthVector.h"
 #include "storage/OrderIndifferentDictionary.h"
+#include "storage/OrderPreservingDictionary.h"
 #include "storage/MutableVerticalTable.h"
 #include "storage/Table.h"
 
 namespace hyrise {
 namespace access {
 
+namespace {
+
+auto _ = QueryParser::registerPlanOperation<ExpressionScan>("ExpressionScan");
+
+const size_t batch_size = 1024;
+
+// Stores `values` as value ids in `column` of `vector`; the dictionary is
+// built from the sorted distinct values instead of one insert per row
+template <typename T>
+AbstractTable::SharedDictionaryPtr encode(const std::vector<T> &values,
+                                          FixedLengthVector<value_id_t> &vector,
+                                          const size_t column) {
+  std::vector<T> distinct(values);
+  std::sort(distinct.begin(), distinct.end());
+  distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+
+  auto dictionary = std::make_shared<OrderPreservingDictionary<T> >(distinct.size());
+  for (const auto& value : distinct)
+    dictionary->addValue(value);
+
+  for (size_t row = 0; row < values.size(); ++row)
+    vector.set(column, row, std::lower_bound(distinct.begin(), distinct.end(), values[row]) - distinct.begin());
+  return dictionary;
+}
+
+}
+
 ColumnExpression::ColumnExpression(const storage::atable_ptr_t &t) : _table(t) {
 }
 
@@ -42,6 +74,11 @@ ExpressionScan::~ExpressionScan() {
 }
 
 void ExpressionScan::executePlanOperation() {
+  if (!_computed.empty()) {
+    computeColumns();
+    return;
+  }
+
   size_t input_size = input.getTable(0)->size();
 
   metadata_list metadata;
@@ -66,6 +103,57 @@ void ExpressionScan::executePlanOperation() {
   addResult(std::make_shared<const storage::MutableVerticalTable>(vc));
 }
 
+void ExpressionScan::computeColumns() {
+  const auto& table = input.getTable(0);
+  const size_t rows = table->size();
+
+  std::vector<ColumnMetadata> metadata;
+  std::vector<ExpressionValues> columns(_computed.size());
+  for (size_t i = 0; i < _computed.size(); ++i) {
+    _computed[i].second->walk(table);
+    metadata.emplace_back(_computed[i].first, _computed[i].second->getType());
+    columns[i].type = _computed[i].second->getType();
+  }
+
+  storage::pos_list_t batch;
+  ExpressionValues values;
+  for (size_t first = 0; first < rows; first += batch_size) {
+    batch.resize(std::min(batch_size, rows - first));
+    std::iota(batch.begin(), batch.end(), first);
+    for (size_t i = 0; i < _computed.size(); ++i) {
+      _computed[i].second->evaluate(batch, values);
+      if (values.type == IntegerType)
+        columns[i].ints.insert(columns[i].ints.end(), values.ints.begin(), values.ints.end());
+      else
+        columns[i].floats.insert(columns[i].floats.end(), values.floats.begin(), values.floats.end());
+    }
+  }
+
+  auto vector = std::make_shared<FixedLengthVector<value_id_t> >(_computed.size(), rows);
+  vector->resize(rows);
+  std::vector<AbstractTable::SharedDictionaryPtr> dictionaries;
+  for (size_t i = 0; i < columns.size(); ++i) {
+    if (columns[i].type == IntegerType)
+      dictionaries.push_back(encode(columns[i].ints, *vector, i));
+    else
+      dictionaries.push_back(encode(columns[i].floats, *vector, i));
+  }
+
+  std::vector<storage::atable_ptr_t> vc;
+  vc.push_back(std::const_pointer_cast<AbstractTable>(table));
+  vc.push_back(std::make_shared<Table>(metadata, vector, dictionaries));
+  addResult(std::make_shared<const storage::MutableVerticalTable>(vc));
+}
+
+std::shared_ptr<PlanOperation> ExpressionScan::parse(const Json::Value &data) {
+  auto scan = std::make_shared<ExpressionScan>();
+  for (unsigned i = 0; i < data["expressions"].size(); ++i) {
+    const auto& computed = data["expressions"][i];
+    scan->addExpression(computed["name"].asString(), ArithmeticExpression::parse(computed["expression"]));
+  }
+  return scan;
+}
+
 const std::string ExpressionScan::vname() {
   return "ExpressionScan";
 }
@@ -76,5 +164,10 @@ void ExpressionScan::setExpression(const std::string &name,
   _column_name = name;
 }
 
+void ExpressionScan::addExpression(const std::string &name,
+                                   std::unique_ptr<ArithmeticExpression> expression) {
+  _computed.emplace_back(name, std::move(expression));
+}
+
 }
 }
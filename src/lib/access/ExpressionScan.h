@@ -2,7 +2,13 @@
 #ifndef SRC_LIB_ACCESS_EXPRESSIONSCAN_H_
 #define SRC_LIB_ACCESS_EXPRESSIONSCAN_H_
 
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "access/system/PlanOperation.h"
+#include "access/expressions/ArithmeticExpression.h"
 #include "helper/types.h"
 
 namespace hyrise {
@@ -41,18 +47,37 @@ private:
   storage::field_t _field2;
 };
 
+/// Appends computed columns to its input.
+///
+/// Expressions added with addExpression() are evaluated in batches of
+/// rows and stored as fixed length value ids with a dictionary built once
+/// per column, e.g.
+///
+///   {"type": "ExpressionScan",
+///    "expressions": [{"name": "revenue",
+///                     "expression": {"op": "*", "left": {"column": "price"},
+///                                    "right": {"op": "-", "left": {"value": 1.0},
+///                                              "right": {"column": "discount"}}}}]}
+///
+/// See ArithmeticExpression for the expression syntax.
 class ExpressionScan : public PlanOperation {
 public:
   virtual ~ExpressionScan();
 
   virtual void executePlanOperation();
+  static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
   const std::string vname();
   virtual void setExpression(const std::string &name,
                              ColumnExpression *expression);
+  void addExpression(const std::string &name,
+                     std::unique_ptr<ArithmeticExpression> expression);
 
 private:
-  ColumnExpression *_expression;
+  void computeColumns();
+
+  ColumnExpression *_expression = nullptr;
   std::string _column_name;
+  std::vector<std::pair<std::string, std::unique_ptr<ArithmeticExpression> > > _computed;
 };
 
 }
@@ -6,6 +6,7 @@
 #include "storage/DictionaryFactory.h"
 #include "storage/HashTable.h"
 #include "storage/PointerCalculator.h"
+#include "storage/SpillingHashTable.h"
 #include "storage/OrderIndifferentDictionary.h"
 #include "storage/meta_storage.h"
 
@@ -72,6 +73,15 @@ void GroupByScan::setupPlanOperation() {
 
 void GroupByScan::executePlanOperation() {
   if ((_field_definition.size() != 0) && (input.numberOfHashTables() >= 1)) {
+    if (std::dynamic_pointer_cast<const storage::SpillingHashTable>(getInputHashTable())) {
+      if (_globalAggregation && _field_definition.size() == 1)
+        return executePartitionedGroupBy<SingleJoinHashTable>();
+      if (_globalAggregation)
+        return executePartitionedGroupBy<JoinHashTable>();
+      if (_field_definition.size() == 1)
+        return executePartitionedGroupBy<SingleAggregateHashTable>();
+      return executePartitionedGroupBy<AggregateHashTable>();
+    }
     if (_globalAggregation) {
       if (_field_definition.size() == 1) {
         return executeGroupBy<SingleJoinHashTable, join_single_hash_map_t, join_single_key_t>();
@@ -161,7 +171,10 @@ void GroupByScan::addFunction(AggregateFun *fun) {
 
 void GroupByScan::splitInput() {
   hash_table_list_t hashTables = input.getHashTables();
-  if (_count > 0 && !hashTables.empty()) {
+  if (_count > 0 && !hashTables.empty() && std::dynamic_pointer_cast<const storage::SpillingHashTable>(hashTables[0])) {
+    // Every instance aggregates its share of the partitions of the whole table
+    return;
+  } else if (_count > 0 && !hashTables.empty()) {
     auto r = distribute(hashTables[0]->numKeys(), _part, _count);
 
     if ((_indexed_field_definition.size() + _named_field_definition.size()) == 1)
@@ -208,9 +221,12 @@ void GroupByScan::executeGroupBy() {
     it1 = hashTableView->getMapBegin();
     end = hashTableView->getMapEnd();
   }
+  // One list for the rows of all groups, so their lists do not pile up
+  // in the arena
+  auto pos_list = std::allocate_shared<pos_list_t>(memory::ArenaAllocator<pos_list_t>());
   for (it2 = it1; it1 != end; it1 = it2) {
     // outer loop over unique keys
-    auto pos_list = std::make_shared<pos_list_t>();
+    pos_list->clear();
     for (; (it2 != end) && (it1->first == it2->first); ++it2) {
       // inner loop, all keys equal to it1->first
       pos_list->push_back(it2->second);
@@ -222,5 +238,46 @@ void GroupByScan::executeGroupBy() {
   this->addResult(resultTab);
 }
 
+template<typename HashTableType>
+void GroupByScan::executePartitionedGroupBy() {
+  const auto& table = getInputTable(0);
+  auto resultTab = createResultTableLayout();
+
+  // The table is partitioned once for all instances of the aggregation
+  const auto& rows = std::dynamic_pointer_cast<const storage::SpillingHashTable>(getInputHashTable())->partitions();
+  const size_t partitions = rows.size();
+  const size_t parts = _count > 0 ? _count : 1;
+  const size_t part = _count > 0 ? _part : 0;
+
+  memory::QueryArena *query = memory::QueryArena::current();
+  pos_t row = 0;
+  for (size_t partition = part; partition < partitions; partition += parts) {
+    if (rows.count(partition) == 0)
+      continue;
+    storage::SpillingHashTable::checkPartition(rows.count(partition), _field_definition.size());
+
+    // The hash table of a partition is freed before the next one
+    memory::QueryArena arena(query);
+    memory::ArenaScope scope(&arena);
+
+    pos_list_t positions;
+    rows.read(partition, positions);
+    const HashTableType groups(PointerCalculator::create(table, new pos_list_t(positions)), _field_definition);
+    resultTab->resize(row + groups.numKeys());
+
+    typename HashTableType::map_const_iterator_t it1, it2, end = groups.getMapEnd();
+    auto pos_list = std::allocate_shared<pos_list_t>(memory::ArenaAllocator<pos_list_t>());
+    for (it1 = it2 = groups.getMapBegin(); it1 != end; it1 = it2) {
+      pos_list->clear();
+      for (; (it2 != end) && (it1->first == it2->first); ++it2)
+        pos_list->push_back(positions[it2->second]);
+      writeGroupResult(resultTab, pos_list, row);
+      row++;
+    }
+  }
+
+  this->addResult(resultTab);
+}
+
 }
 }
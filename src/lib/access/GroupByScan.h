@@ -54,6 +54,10 @@ private:
   /// Depending on the number of fields to group by choose the appropriate map type
   template<typename HashTableType, typename MapType, typename KeyType>
   void executeGroupBy();
+  /// Aggregates a table whose hash table exceeds the memory limit of the
+  /// query one partition at a time, see SpillingHashTable
+  template<typename HashTableType>
+  void executePartitionedGroupBy();
 
   std::vector<AggregateFun *> _aggregate_functions;
 
@@ -1,7 +1,12 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/HashBuild.h"
 
+#include "access/system/OperationData-Impl.h"
+
+#include "storage/GroupKeyJoinTable.h"
 #include "storage/HashTable.h"
+#include "storage/SpillingHashTable.h"
+#include "storage/Store.h"
 #include "storage/TableRangeView.h"
 
 namespace hyrise {
@@ -20,16 +25,32 @@ void HashBuild::executePlanOperation() {
   auto input = std::dynamic_pointer_cast<const storage::TableRangeView>(getInputTable());
   if(input)
     row_offset = input->getStart();
-  if (_key == "groupby" || _key == "selfjoin" ) {
+  // Whole tables that do not fit into the memory limit of the query are
+  // partitioned by the operations using the hash table, parts of a
+  // parallel build are hashed in memory. Probes take the matches of a
+  // row from the heap, so only the hash table counts against the limit.
+  const bool spill = !input && (_key == "groupby" || _key == "join") &&
+      !memory::QueryArena::fits(storage::SpillingHashTable::estimatedBytes(getInputTable()->size(), _field_definition.size()));
+  if (_key == "groupby" && spill) {
+    addResult(std::make_shared<storage::SpillingHashTable>(getInputTable(), _field_definition));
+  } else if (_key == "groupby" || _key == "selfjoin" ) {
     if (_field_definition.size() == 1)
         addResult(std::make_shared<SingleAggregateHashTable>(getInputTable(), _field_definition, row_offset));
       else
         addResult(std::make_shared<AggregateHashTable>(getInputTable(), _field_definition, row_offset));
   } else if (_key == "join") {
-    if (_field_definition.size() == 1)
+    // Joins on a column of a base table use the group key index of its
+    // main instead of hashing every row for the query
+    if (_field_definition.size() == 1 && std::dynamic_pointer_cast<const storage::Store>(getInputTable()))
+      addResult(std::make_shared<storage::GroupKeyJoinTable>(getInputTable(), _field_definition[0]));
+    else if (spill)
+      addResult(std::make_shared<storage::SpillingHashTable>(getInputTable(), _field_definition));
+    else if (_field_definition.size() == 1)
       addResult(std::make_shared<SingleJoinHashTable>(getInputTable(), _field_definition, row_offset));
     else
       addResult(std::make_shared<JoinHashTable>(getInputTable(), _field_definition, row_offset));
+    if (_join_filter)
+      addResult(std::make_shared<storage::JoinFilter>(getInputTable(), _field_definition));
   } else {
     throw std::runtime_error("Type in Plan operation HashBuild not supported; key: " + _key);
   }
@@ -45,6 +66,9 @@ std::shared_ptr<PlanOperation> HashBuild::parse(const Json::Value &data) {
   if (data.isMember("key")) {
     instance->setKey(data["key"].asString());
   }
+  if (data.isMember("joinFilter")) {
+    instance->setJoinFilter(data["joinFilter"].asBool());
+  }
   return instance;
 }
 
@@ -60,5 +84,13 @@ const std::string HashBuild::getKey() const {
   return _key;
 }
 
+void HashBuild::setJoinFilter(const bool join_filter) {
+  _join_filter = join_filter;
+}
+
+std::shared_ptr<const storage::JoinFilter> HashBuild::getResultJoinFilter() const {
+  return output.nthOf<storage::JoinFilter>(0);
+}
+
 }
 }
@@ -4,6 +4,8 @@
 
 #include "access/system/ParallelizablePlanOperation.h"
 
+#include "storage/JoinFilter.h"
+
 namespace hyrise {
 namespace access {
 
@@ -21,18 +23,31 @@ public:
   ///         },
   ///         "1": {
   ///             "type": "HashBuild",
-  ///             "fields" : [1]
+  ///             "fields" : [1],
+  ///             "key": "join",
+  ///             "joinFilter": true
   ///         },
   ///     },
   ///         "edges": [["0", "1"]]
   /// }
+  ///
+  /// With "joinFilter" a join hash build additionally emits a JoinFilter
+  /// over its keys that can be routed into probe side scans, see
+  /// SimpleTableScan and TableScan.
+  ///
+  /// Group by and join builds whose hash table would exceed the memory
+  /// limit of the query emit a SpillingHashTable instead, GroupByScan and
+  /// HashJoinProbe then partition their inputs to disk.
   static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
   const std::string vname();
   void setKey(const std::string &key);
   const std::string getKey() const;
+  void setJoinFilter(const bool join_filter);
+  std::shared_ptr<const storage::JoinFilter> getResultJoinFilter() const;
 
 private:
   std::string _key;
+  bool _join_filter = false;
 };
 
 }
@@ -3,8 +3,10 @@
 
 #include "access/system/QueryParser.h"
 
+#include "storage/GroupKeyJoinTable.h"
 #include "storage/HashTable.h"
 #include "storage/PointerCalculator.h"
+#include "storage/SpillingHashTable.h"
 
 #include <log4cxx/logger.h>
 
@@ -36,6 +38,13 @@ void HashJoinProbe::executePlanOperation() {
       fetchPositions<SingleAggregateHashTable>(buildTablePosList, probeTablePosList);
     else
       fetchPositions<AggregateHashTable>(buildTablePosList, probeTablePosList);
+  } else if (std::dynamic_pointer_cast<const storage::SpillingHashTable>(getInputHashTable(0))) {
+    if (_field_definition.size() == 1)
+      fetchPartitionedPositions<SingleJoinHashTable>(buildTablePosList, probeTablePosList);
+    else
+      fetchPartitionedPositions<JoinHashTable>(buildTablePosList, probeTablePosList);
+  } else if (std::dynamic_pointer_cast<const storage::GroupKeyJoinTable>(getInputHashTable(0))) {
+    fetchPositions<storage::GroupKeyJoinTable>(buildTablePosList, probeTablePosList);
   } else {
     if (_field_definition.size() == 1)
       fetchPositions<SingleJoinHashTable>(buildTablePosList, probeTablePosList);
@@ -85,7 +94,12 @@ void HashJoinProbe::fetchPositions(storage::pos_list_t *buildTablePosList,
   LOG4CXX_DEBUG(logger, "Hash Table Size:  " << hash_table->size());
 
   for (pos_t probeTableRow = 0; probeTableRow < probeTable->size(); ++probeTableRow) {
-    pos_list_t matchingRows(hash_table->get(probeTable, _field_definition, probeTableRow));
+    pos_list_t matchingRows;
+    {
+      // The matches of a row are freed right away
+      memory::HeapScope heap;
+      matchingRows = hash_table->get(probeTable, _field_definition, probeTableRow);
+    }
 
     if (!matchingRows.empty()) {
       buildTablePosList->insert(buildTablePosList->end(), matchingRows.begin(), matchingRows.end());
@@ -96,6 +110,56 @@ void HashJoinProbe::fetchPositions(storage::pos_list_t *buildTablePosList,
   LOG4CXX_DEBUG(logger, "Done Probing");
 }
 
+template<class HashTable>
+void HashJoinProbe::fetchPartitionedPositions(storage::pos_list_t *buildTablePosList,
+                                              storage::pos_list_t *probeTablePosList) {
+  const auto& buildTable = getBuildTable();
+  const auto& probeTable = getProbeTable();
+  const auto& hash_table = std::dynamic_pointer_cast<const storage::SpillingHashTable>(getInputHashTable(0));
+  const auto& buildFields = hash_table->getFields();
+
+  // The build table is partitioned once for all instances of the probe
+  const auto& buildRows = hash_table->partitions();
+  const size_t partitions = buildRows.size();
+  memory::SpilledPartitions probeRows(partitions);
+  storage::SpillingHashTable::partition(probeTable, _field_definition, probeRows);
+  LOG4CXX_DEBUG(logger, "Partitioned join into " << partitions << " partitions");
+
+  memory::QueryArena *query = memory::QueryArena::current();
+  for (size_t partition = 0; partition < partitions; ++partition) {
+    if (buildRows.count(partition) == 0 || probeRows.count(partition) == 0)
+      continue;
+    storage::SpillingHashTable::checkPartition(buildRows.count(partition), buildFields.size());
+
+    // The hash table of a partition is freed before the next one
+    memory::QueryArena arena(query);
+    memory::ArenaScope scope(&arena);
+
+    pos_list_t rows;
+    buildRows.read(partition, rows);
+    const auto part = PointerCalculator::create(buildTable, new pos_list_t(rows));
+    const HashTable partition_table(part, buildFields);
+
+    pos_list_t probe, buildMatches, probeMatches;
+    probeRows.read(partition, probe);
+    for (const auto& probeTableRow : probe) {
+      pos_list_t matchingRows;
+      {
+        memory::HeapScope heap;
+        matchingRows = partition_table.get(probeTable, _field_definition, probeTableRow);
+      }
+      for (const auto& match : matchingRows) {
+        buildMatches.push_back(rows[match] + hash_table->getRowOffset());
+        probeMatches.push_back(probeTableRow);
+      }
+    }
+
+    memory::ArenaScope result(query);
+    buildTablePosList->insert(buildTablePosList->end(), buildMatches.begin(), buildMatches.end());
+    probeTablePosList->insert(probeTablePosList->end(), probeMatches.begin(), probeMatches.end());
+  }
+}
+
 storage::atable_ptr_t HashJoinProbe::buildResultTable(storage::pos_list_t *buildTablePosList,
                                                       storage::pos_list_t *probeTablePosList) const {
   std::vector<storage::atable_ptr_t> parts;
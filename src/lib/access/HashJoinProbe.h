@@ -53,6 +53,12 @@ private:
   template<class HashTable>
   void fetchPositions(storage::pos_list_t *buildTablePosList,
                       storage::pos_list_t *probeTablePosList);
+  /// Grace hash join for a build table that does not fit into the memory
+  /// limit of the query: both tables are partitioned to disk and each
+  /// partition of the build table is hashed and probed on its own.
+  template<class HashTable>
+  void fetchPartitionedPositions(storage::pos_list_t *buildTablePosList,
+                                 storage::pos_list_t *probeTablePosList);
   /// Constructs resulting table from given build and probe tables' rows.
   storage::atable_ptr_t buildResultTable(storage::pos_list_t *buildTablePosList,
                                          storage::pos_list_t *probeTablePosList) const;
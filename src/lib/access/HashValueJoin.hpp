@@ -8,6 +8,7 @@
 
 #include <helper/types.h>
 #include <storage/AbstractTable.h>
+#include <storage/ColumnAccessor.h>
 #include <access/system/PlanOperation.h>
 #include <storage/PointerCalculator.h>
 
@@ -37,10 +38,8 @@ class HashValueJoin : public PlanOperation {
     }
 
     map_type hash;
-    std::vector<pos_t> *build_pos = new std::vector<pos_t>();
-    std::vector<pos_t> *probe_pos = new std::vector<pos_t>();
-
-    T value;
+    pos_list_t *build_pos = new pos_list_t();
+    pos_list_t *probe_pos = new pos_list_t();
 
     // always use the smaller table as the 'build' table
     hyrise::storage::c_atable_ptr_t build_table;
@@ -62,26 +61,19 @@ class HashValueJoin : public PlanOperation {
 
     // build the hash using the smaller table
 
-    size_t input_size = build_table->size();
-
-    for (pos_t row = 0; row < input_size; row++) {
-      value = build_table->getValue<T>(build_field, row);
+    storage::ColumnAccessor<T>(build_table, build_field).forEach([&hash](size_t row, const T &value) {
       hash.insert(typename map_type::value_type(value, row));
-    }
+    });
 
     // probe the hash for each row in the bigger table
-    input_size = probe_table->size();
-
-    for (size_t row = 0; row < input_size; ++row) {
-      value = probe_table->getValue<T>(probe_field, row);
-
+    storage::ColumnAccessor<T>(probe_table, probe_field).forEach([&](size_t row, const T &value) {
       std::pair<typename map_type::iterator, typename map_type::iterator> pair1 = hash.equal_range(value);
 
       for (; pair1.first != pair1.second; ++pair1.first) {
         build_pos->push_back(pair1.first->second);
         probe_pos->push_back(row);
       }
-    }
+    });
 
     // input.getTable(0) will always be the left part of our output, no matter
     // if it's the build table or not
@@ -0,0 +1,63 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/IndexJoin.h"
+
+#include "access/system/QueryParser.h"
+
+#include "storage/GroupKeyJoinTable.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/PointerCalculator.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+  auto _ = QueryParser::registerPlanOperation<IndexJoin>("IndexJoin");
+}
+
+IndexJoin::~IndexJoin() {
+}
+
+void IndexJoin::executePlanOperation() {
+  if (_field_definition.size() != 2) {
+    throw std::runtime_error("IndexJoin requires one probe and one base table field");
+  }
+
+  const auto& probe = input.getTable(0);
+  const auto& base = input.getTable(1);
+  const storage::GroupKeyJoinTable join_table(base, _field_definition[1]);
+  const field_list_t probe_fields {_field_definition[0]};
+
+  auto probe_pos = new storage::pos_list_t;
+  auto base_pos = new storage::pos_list_t;
+  for (pos_t row = 0; row < probe->size(); ++row) {
+    const auto rows = join_table.get(probe, probe_fields, row);
+    base_pos->insert(base_pos->end(), rows.begin(), rows.end());
+    probe_pos->insert(probe_pos->end(), rows.size(), row);
+  }
+
+  std::vector<storage::atable_ptr_t> parts({
+    PointerCalculator::create(probe, probe_pos),
+    PointerCalculator::create(base, base_pos)
+  });
+  addResult(std::make_shared<storage::MutableVerticalTable>(parts));
+}
+
+std::shared_ptr<PlanOperation> IndexJoin::parse(const Json::Value &data) {
+  auto instance = std::make_shared<IndexJoin>();
+  for (unsigned i = 0; i < data["fields"].size(); ++i) {
+    instance->addField(data["fields"][i]);
+  }
+  return instance;
+}
+
+void IndexJoin::accessedFields(field_list_t &fields) const {
+  if (!_field_definition.empty())
+    fields.push_back(_field_definition[0]);
+}
+
+const std::string IndexJoin::vname() {
+  return "IndexJoin";
+}
+
+}
+}
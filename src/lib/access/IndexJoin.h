@@ -0,0 +1,40 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_INDEXJOIN_H_
+#define SRC_LIB_ACCESS_INDEXJOIN_H_
+
+#include "access/system/ParallelizablePlanOperation.h"
+
+namespace hyrise {
+namespace access {
+
+/// Index nested loop equi-join of a probe table with a column of a base
+/// table.
+///
+/// The rows of the base table's main are looked up in the group key index
+/// the store keeps for the column (see storage/GroupKeyIndex.h), so no
+/// hash table is built for the query; only the delta rows are hashed.
+/// The result has the probe table's columns first, like HashJoinProbe.
+/// Parallel instances split the probe table.
+///
+/// {
+///     "type": "IndexJoin",
+///     "fields": [probe_field, base_field]
+/// }
+/// with the probe table as first and the base table as second input.
+class IndexJoin : public ParallelizablePlanOperation {
+public:
+  virtual ~IndexJoin();
+
+  void executePlanOperation();
+  static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
+  const std::string vname();
+
+protected:
+  /// Only the field of the probe table
+  void accessedFields(field_list_t &fields) const;
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_INDEXJOIN_H_
@@ -7,11 +7,17 @@
 #include "access/json_converters.h"
 #include "access/system/QueryParser.h"
 
+#include "helper/checked_cast.h"
+
 #include "io/StorageManager.h"
 
+#include "storage/GroupKeyIndex.h"
+#include "storage/GroupKeyJoinTable.h"
 #include "storage/InvertedIndex.h"
 #include "storage/meta_storage.h"
 #include "storage/PointerCalculator.h"
+#include "storage/SecondaryIndex.h"
+#include "storage/Store.h"
 
 namespace hyrise {
 namespace access {
@@ -49,6 +55,48 @@ struct ScanIndexFunctor {
   }
 };
 
+struct KeyRangeFunctor {
+  typedef storage::SecondaryIndex::KeyRange value_type;
+
+  const storage::SecondaryIndex &_index;
+  size_t _key;
+  const Json::Value &_lo;
+  const Json::Value &_hi;
+  // Value set with IndexScan::setValue, used if _lo is null
+  AbstractIndexValue *_value;
+
+  KeyRangeFunctor(const storage::SecondaryIndex &index, size_t key, const Json::Value &lo,
+                  const Json::Value &hi, AbstractIndexValue *value):
+    _index(index), _key(key), _lo(lo), _hi(hi), _value(value) {}
+
+  template<typename ValueType>
+  value_type operator()() {
+    if (_lo.isNull()) {
+      if (_value == nullptr)
+        throw std::runtime_error("IndexScan needs a value");
+      return _index.equal(_key, static_cast<IndexValue<ValueType>*>(_value)->value);
+    }
+    return _index.range(_key, json_converter::convert<ValueType>(_lo), json_converter::convert<ValueType>(_hi));
+  }
+};
+
+struct GroupKeyRowsFunctor {
+  typedef storage::pos_list_t value_type;
+
+  const storage::GroupKeyJoinTable &_table;
+  AbstractIndexValue *_value;
+
+  GroupKeyRowsFunctor(const storage::GroupKeyJoinTable &table, AbstractIndexValue *value):
+    _table(table), _value(value) {}
+
+  template<typename ValueType>
+  value_type operator()() {
+    if (_value == nullptr)
+      throw std::runtime_error("IndexScan needs a value");
+    return _table.rows(static_cast<IndexValue<ValueType>*>(_value)->value);
+  }
+};
+
 namespace {
   auto _ = QueryParser::registerPlanOperation<IndexScan>("IndexScan");
 }
@@ -58,8 +106,24 @@ IndexScan::~IndexScan() {
 }
 
 void IndexScan::executePlanOperation() {
-  StorageManager *sm = StorageManager::getInstance();
-  auto idx = sm->getInvertedIndex(_indexName);
+  std::shared_ptr<AbstractIndex> idx;
+  if (_indexName.empty()) {
+    const auto &store = checked_pointer_cast<const storage::Store>(input.getTable(0));
+    idx = store->primaryKey();
+    if (!idx)
+      throw std::runtime_error("IndexScan without an index needs a store with a primary key");
+  } else {
+    idx = StorageManager::getInstance()->getInvertedIndex(_indexName);
+  }
+
+  if (std::dynamic_pointer_cast<storage::SecondaryIndex>(idx)) {
+    addResult(PointerCalculator::create(input.getTable(0), lookupSecondary(idx)));
+    return;
+  }
+  if (std::dynamic_pointer_cast<storage::GroupKeyIndex>(idx)) {
+    addResult(PointerCalculator::create(input.getTable(0), lookupGroupKey(idx)));
+    return;
+  }
 
   // Handle type of index and value
   storage::type_switch<hyrise_basic_types> ts;
@@ -69,11 +133,55 @@ void IndexScan::executePlanOperation() {
   addResult(PointerCalculator::create(input.getTable(0), pos));
 }
 
+storage::pos_list_t *IndexScan::lookupSecondary(const std::shared_ptr<AbstractIndex> &index) {
+  const auto &secondary = *std::dynamic_pointer_cast<storage::SecondaryIndex>(index);
+  const auto &table = input.getTable(0);
+
+  Json::Value keys = _key;
+  if (!keys.isArray()) {
+    keys = Json::Value(Json::arrayValue);
+    keys.append(_key);
+  }
+
+  std::vector<storage::SecondaryIndex::KeyRange> ranges;
+  storage::type_switch<hyrise_basic_types> ts;
+  for (unsigned key = 0; key < keys.size(); ++key) {
+    const bool last = key + 1 == keys.size();
+    KeyRangeFunctor fun(secondary, key, keys[key], last && !_keyTo.isNull() ? _keyTo : keys[key], _value);
+    ranges.push_back(ts(table->typeOfColumn(secondary.fields()[key]), fun));
+  }
+
+  auto pos = new storage::pos_list_t(secondary.lookup(ranges));
+  if (const auto &store = std::dynamic_pointer_cast<const storage::Store>(table))
+    store->validatePositions(*pos, _txContext.lastCid, _txContext.tid);
+  return pos;
+}
+
+storage::pos_list_t *IndexScan::lookupGroupKey(const std::shared_ptr<AbstractIndex> &index) {
+  const auto &table = input.getTable(0);
+  const auto &store = std::dynamic_pointer_cast<const storage::Store>(table);
+
+  // Stores look up their current group key index, the registered one
+  // refers to the main before the last merge
+  storage::GroupKeyJoinTable rows(table, _field_definition[0],
+                                  store ? nullptr : std::dynamic_pointer_cast<storage::GroupKeyIndex>(index));
+  GroupKeyRowsFunctor fun(rows, _value);
+  storage::type_switch<hyrise_basic_types> ts;
+  auto pos = new storage::pos_list_t(ts(table->typeOfColumn(_field_definition[0]), fun));
+  if (store)
+    store->validatePositions(*pos, _txContext.lastCid, _txContext.tid);
+  return pos;
+}
+
 std::shared_ptr<PlanOperation> IndexScan::parse(const Json::Value &data) {
   std::shared_ptr<IndexScan> s = BasicParser<IndexScan>::parse(data);
-  storage::type_switch<hyrise_basic_types> ts;
-  CreateIndexValueFunctor civf(data);
-  s->_value = ts(data["vtype"].asUInt(), civf);
+  if (!data["value"].isArray()) {
+    storage::type_switch<hyrise_basic_types> ts;
+    CreateIndexValueFunctor civf(data);
+    s->_value = ts(data["vtype"].asUInt(), civf);
+  }
+  s->_key = data["value"];
+  s->_keyTo = data["value_to"];
   s->_indexName = data["index"].asString();
   return s;
 }
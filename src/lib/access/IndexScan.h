@@ -19,6 +19,16 @@ public:
 
 /// Scan an existing index for the result. Currently only EQ predicates
 /// allowed for the index.
+///
+/// On a SecondaryIndex, "value" may also be a list with one value for
+/// each of the first key columns, and "value_to" makes the lookup a range
+/// [value, value_to] on the last of them. Rows of a store the transaction
+/// must not see are removed from the result.
+///
+/// Without "index", the primary key of the input store is used.
+///
+/// On a GroupKeyIndex, the rows of the main are found in the group key
+/// index of the store and the delta rows by their delta value id.
 class IndexScan : public PlanOperation {
 public:
   virtual ~IndexScan();
@@ -35,8 +45,13 @@ public:
   }
 
 private:
+  storage::pos_list_t *lookupSecondary(const std::shared_ptr<AbstractIndex> &index);
+  storage::pos_list_t *lookupGroupKey(const std::shared_ptr<AbstractIndex> &index);
+
   std::string _indexName;
-  AbstractIndexValue *_value;
+  AbstractIndexValue *_value = nullptr;
+  Json::Value _key;
+  Json::Value _keyTo;
 };
 
 
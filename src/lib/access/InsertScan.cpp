@@ -1,4 +1,5 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include <mutex>
 #include <set>
 
 #include "access/InsertScan.h"
@@ -83,6 +84,14 @@ void InsertScan::executePlanOperation() {
   if (!_data)
     _data = buildFromJson();
 
+  // Stores with a primary key check and index the rows under the lock of
+  // the key, so concurrent inserts cannot both add the same key
+  std::unique_lock<std::mutex> key_lock;
+  if (store->primaryKey()) {
+    key_lock = store->lockPrimaryKey();
+    store->checkPrimaryKey(_data, _txContext.tid);
+  }
+
   // Delta Table Size
   const auto& beforSize = store->size();
 
@@ -94,6 +103,7 @@ void InsertScan::executePlanOperation() {
     store->copyRowToDelta(_data, i, writeArea.first+i, _txContext.tid);
     mods.insertPos(store, beforSize+i);
   }
+  store->indexDelta(writeArea.first, writeArea.second);
 
   auto rsp = getResponseTask();
   if (rsp != nullptr)
@@ -7,6 +7,9 @@
 namespace hyrise {
 namespace access {
 
+/// Appends rows to the delta of a store. If the store has a primary key
+/// (see Store::setPrimaryKey), the insert fails when a key is already
+/// taken.
 class InsertScan : public PlanOperation {
 public:
   virtual ~InsertScan();
@@ -49,6 +49,9 @@ void LayoutSingleTable::executePlanOperation() {
       break;
   }
 
+  // Only the requested number of layouts is searched for, the rest of
+  // the search space is pruned
+  bl->setMaxResults(_maxResults);
   bl->layout(s, HYRISE_COST);
   r = bl->getNBestResults(_maxResults);
   size = bl->count();
@@ -1,6 +1,8 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/MaterializingScan.h"
 
+#include <algorithm>
+#include <numeric>
 #include <random>
 #include <set>
 
@@ -14,6 +16,26 @@ namespace access {
 
 namespace {
   auto _ = QueryParser::registerPlanOperation<MaterializingScan>("MaterializingScan");
+
+  // Rows whose value ids are gathered at once
+  const size_t gather_batch_size = 4096;
+
+  // Copies the value ids of all rows of `in` column by column, so every
+  // column of the input is resolved once per batch instead of per cell
+  void copyValueIds(const storage::c_atable_ptr_t &in, const storage::atable_ptr_t &result) {
+    pos_list_t rows;
+    std::vector<ValueId> value_ids;
+    for (size_t start = 0; start < in->size(); start += gather_batch_size) {
+      rows.resize(std::min(gather_batch_size, in->size() - start));
+      std::iota(rows.begin(), rows.end(), start);
+      for (size_t column = 0; column < in->columnCount(); ++column) {
+        in->gatherValueIds(column, rows, value_ids);
+        for (size_t i = 0; i < rows.size(); ++i) {
+          result->setValueId(column, rows[i], value_ids[i]);
+        }
+      }
+    }
+  }
 }
 
 MaterializingScan::MaterializingScan(const bool use_memcpy) :
@@ -51,9 +73,7 @@ void MaterializingScan::executePlanOperation() {
 
   if (_num_samples == 0) {
     result->resize(in->size());
-    for (size_t row = 0; row < in->size(); row++) {
-      result->copyRowFrom(in, row, row, false, false /*_use_memcpy*/);
-    }
+    copyValueIds(in, result);
   } else {
     result->resize(_num_samples);
     for (size_t row = 0; row < _samples.size(); row++) {
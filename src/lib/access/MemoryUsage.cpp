@@ -0,0 +1,91 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/MemoryUsage.h"
+
+#include "access/system/QueryParser.h"
+
+#include "io/StorageManager.h"
+
+#include "storage/ColumnMetadata.h"
+#include "storage/Store.h"
+#include "storage/TableBuilder.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+  auto _ = QueryParser::registerTrivialPlanOperation<MemoryUsage>("MemoryUsage");
+
+  void addRow(const storage::atable_ptr_t &result, const std::string &table, const std::string &column,
+              const std::string &part, const size_t bytes) {
+    const size_t row = result->size();
+    result->resize(row + 1);
+    result->setValue<hyrise_string_t>(0, row, table);
+    result->setValue<hyrise_string_t>(1, row, column);
+    result->setValue<hyrise_string_t>(2, row, part);
+    result->setValue<hyrise_int_t>(3, row, bytes);
+  }
+
+  void addTable(const storage::atable_ptr_t &result, const storage::c_atable_ptr_t &table, const std::string &name) {
+    size_t column_bytes = 0;
+    if (const auto store = std::dynamic_pointer_cast<const storage::Store>(table)) {
+      for (field_t column = 0; column < store->columnCount(); ++column) {
+        const auto &column_name = store->metadataAt(column)->getName();
+        addRow(result, name, column_name, "main", store->getMainTable()->columnBytes(column));
+        addRow(result, name, column_name, "delta", store->getDeltaTable()->columnBytes(column));
+      }
+      addRow(result, name, "", "transactions", store->transactionBytes());
+      addRow(result, name, "", "indexes", store->indexBytes());
+      return;
+    }
+
+    for (field_t column = 0; column < table->columnCount(); ++column) {
+      const size_t bytes = table->columnBytes(column);
+      addRow(result, name, table->metadataAt(column)->getName(), "", bytes);
+      column_bytes += bytes;
+    }
+    const size_t bytes = table->bytes();
+    if (bytes > column_bytes)
+      addRow(result, name, "", "other", bytes - column_bytes);
+  }
+}
+
+void MemoryUsage::executePlanOperation() {
+  storage::TableBuilder::param_list list;
+  list.append().set_type("STRING").set_name("table");
+  list.append().set_type("STRING").set_name("column");
+  list.append().set_type("STRING").set_name("part");
+  list.append().set_type("INTEGER").set_name("bytes");
+  auto result = storage::TableBuilder::build(list);
+
+  const auto &storageManager = StorageManager::getInstance();
+  const auto &resources = storageManager->all();
+
+  if (input.numberOfTables() == 0) {
+    for (const auto &usage : storageManager->memoryUsage()) {
+      const auto resource = resources.find(usage.first);
+      if (resource == resources.end())
+        continue;
+      if (const auto table = std::dynamic_pointer_cast<const AbstractTable>(resource->second))
+        addTable(result, table, usage.first);
+      else
+        addRow(result, usage.first, "", "index", usage.second);
+    }
+  } else {
+    for (size_t i = 0; i < input.numberOfTables(); ++i) {
+      const auto &table = input.getTable(i);
+      std::string name = "unknown/temporary";
+      for (const auto &resource : resources) {
+        if (resource.second == table) {
+          name = resource.first;
+          break;
+        }
+      }
+      addTable(result, table, name);
+    }
+  }
+
+  addResult(result);
+}
+
+}
+}
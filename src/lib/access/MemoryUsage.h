@@ -0,0 +1,29 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_MEMORYUSAGE_H_
+#define SRC_LIB_ACCESS_MEMORYUSAGE_H_
+
+#include "access/system/PlanOperation.h"
+
+namespace hyrise {
+namespace access {
+
+/// Approximate bytes of the input tables or, without input, of all tables
+/// and indices of the StorageManager. Every row holds the bytes of one
+/// part of a table:
+///  - columns of stores are split into "main" and "delta"
+///  - "transactions" and "indexes" of stores have no column
+///  - "other" holds what a table allocated next to its columns, e.g.
+///    the positions of intermediate results
+///  - indices and hash tables of the StorageManager are reported as "index"
+/// {
+///     "type": "MemoryUsage"
+/// }
+class MemoryUsage : public PlanOperation {
+public:
+  void executePlanOperation();
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_MEMORYUSAGE_H_
@@ -0,0 +1,46 @@
+#include "access/MemoryUsageHandler.h"
+
+#include "json.h"
+#include "net/AsyncConnection.h"
+#include "net/AbstractConnection.h"
+#include "io/StorageManager.h"
+#include "memory/QueryArena.h"
+
+namespace hyrise {
+namespace access {
+
+bool MemoryUsageHandler::registered =
+    net::Router::registerRoute<MemoryUsageHandler>("/memory/");
+
+MemoryUsageHandler::MemoryUsageHandler(net::AbstractConnection *data)
+    : _connection_data(data) {}
+
+std::string MemoryUsageHandler::name() {
+  return "MemoryUsageHandler";
+}
+
+const std::string MemoryUsageHandler::vname() {
+  return "MemoryUsageHandler";
+}
+
+std::string MemoryUsageHandler::constructResponse() {
+  Json::Value resources(Json::objectValue);
+  Json::UInt64 total = 0;
+  for (const auto& resource : io::StorageManager::getInstance()->memoryUsage()) {
+    resources[resource.first] = Json::Value((Json::UInt64) resource.second);
+    total += resource.second;
+  }
+  Json::Value result;
+  result["resources"] = resources;
+  result["total"] = Json::Value(total);
+  result["intermediates"] = Json::Value((Json::UInt64) memory::QueryArena::allocatedBytes());
+  Json::StyledWriter writer;
+  return writer.write(result);
+}
+
+void MemoryUsageHandler::operator()() {
+  std::string response(constructResponse());
+  _connection_data->respond(response);
+}
+}
+}
@@ -0,0 +1,26 @@
+#ifndef SRC_LIB_ACCESS_MEMORYUSAGEHANDLER_H
+#define SRC_LIB_ACCESS_MEMORYUSAGEHANDLER_H
+
+#include "net/Router.h"
+
+namespace hyrise {
+namespace net { class AbstractConnection; }
+namespace access {
+
+/// Reports the bytes of all tables, indices and hash tables of the
+/// StorageManager and of the intermediates of running queries
+class MemoryUsageHandler : public net::AbstractRequestHandler {
+  static bool registered;
+  net::AbstractConnection *_connection_data;
+ public:
+  explicit MemoryUsageHandler(net::AbstractConnection *data);
+  std::string constructResponse();
+  void operator()();
+  static std::string name();
+  const std::string vname();
+};
+
+}}
+
+
+#endif
@@ -1,9 +1,12 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/MergeHashTables.h"
 
+#include "access/system/OperationData-Impl.h"
 #include "access/system/QueryParser.h"
 
+#include "storage/GroupKeyJoinTable.h"
 #include "storage/HashTable.h"
+#include "storage/JoinFilter.h"
 
 namespace hyrise {
 namespace access {
@@ -20,10 +23,17 @@ void MergeHashTables::executePlanOperation() {
   	else
   		addResult(std::make_shared<AggregateHashTable>(input.getHashTables()));
   } else if (_key == "join") {
-  	if (getInputHashTable(0)->getFieldCount() == 1)
+    // a join table on a base table is built by a single HashBuild
+    if (std::dynamic_pointer_cast<const storage::GroupKeyJoinTable>(getInputHashTable(0)))
+      addResult(getInputHashTable(0));
+  	else if (getInputHashTable(0)->getFieldCount() == 1)
   		addResult(std::make_shared<SingleJoinHashTable>(input.getHashTables()));
   	else
   		addResult(std::make_shared<JoinHashTable>(input.getHashTables()));
+    // join filters of the parallel builds are merged as well
+    const auto& filters = input.allOf<storage::JoinFilter>();
+    if (!filters.empty())
+      addResult(std::make_shared<storage::JoinFilter>(filters));
   } else {
     throw std::runtime_error("Type in Plan operation HashBuild not supported; key: " + _key);
   }
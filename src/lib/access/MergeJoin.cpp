@@ -0,0 +1,181 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/MergeJoin.h"
+
+#include <algorithm>
+
+#include "access/join_keys.h"
+#include "access/system/QueryParser.h"
+
+#include "helper/parallel_for.h"
+
+#include "storage/MutableVerticalTable.h"
+#include "storage/PointerCalculator.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+
+auto _ = QueryParser::registerPlanOperation<MergeJoin>("MergeJoin");
+
+typedef join_key_list_t key_list_t;
+typedef std::vector<std::pair<join_key_t, pos_t> > key_pos_list_t;
+
+// Number of samples drawn per partition to determine the range splitters
+const size_t samples_per_partition = 64;
+
+// Chooses up to `partitions - 1` range splitters from a sample of both
+// key lists so that the partitions are roughly equally sized
+key_list_t computeSplitters(const key_list_t &left, const key_list_t &right, const size_t partitions) {
+  key_list_t sample;
+  for (const auto* keys : { &left, &right }) {
+    const size_t step = std::max<size_t>(1, keys->size() / (samples_per_partition * partitions));
+    for (size_t i = 0; i < keys->size(); i += step)
+      sample.push_back((*keys)[i]);
+  }
+  std::sort(sample.begin(), sample.end());
+
+  key_list_t splitters;
+  if (sample.empty())
+    return splitters;
+  for (size_t p = 1; p < partitions; ++p)
+    splitters.push_back(sample[p * sample.size() / partitions]);
+  splitters.erase(std::unique(splitters.begin(), splitters.end()), splitters.end());
+  return splitters;
+}
+
+// Distributes all rows to the key range partitions, preserving the row
+// order inside each partition
+std::vector<key_pos_list_t> scatter(const key_list_t &keys, const key_list_t &splitters) {
+  std::vector<size_t> partition_of(keys.size());
+  std::vector<size_t> histogram(splitters.size() + 1, 0);
+  for (size_t row = 0; row < keys.size(); ++row) {
+    partition_of[row] = std::upper_bound(splitters.begin(), splitters.end(), keys[row]) - splitters.begin();
+    ++histogram[partition_of[row]];
+  }
+
+  std::vector<key_pos_list_t> result(histogram.size());
+  for (size_t p = 0; p < result.size(); ++p)
+    result[p].reserve(histogram[p]);
+  for (size_t row = 0; row < keys.size(); ++row)
+    result[partition_of[row]].emplace_back(keys[row], row);
+  return result;
+}
+
+void mergePartition(key_pos_list_t &left, const bool left_sorted,
+                    key_pos_list_t &right, const bool right_sorted,
+                    pos_list_t &left_pos, pos_list_t &right_pos) {
+  if (!left_sorted)
+    std::sort(left.begin(), left.end());
+  if (!right_sorted)
+    std::sort(right.begin(), right.end());
+
+  size_t l = 0, r = 0;
+  while (l < left.size() && r < right.size()) {
+    if (left[l].first < right[r].first) {
+      ++l;
+    } else if (right[r].first < left[l].first) {
+      ++r;
+    } else {
+      const join_key_t key = left[l].first;
+      size_t l_end = l, r_end = r;
+      while (l_end < left.size() && left[l_end].first == key)
+        ++l_end;
+      while (r_end < right.size() && right[r_end].first == key)
+        ++r_end;
+
+      for (size_t i = l; i < l_end; ++i) {
+        for (size_t j = r; j < r_end; ++j) {
+          left_pos.push_back(left[i].second);
+          right_pos.push_back(right[j].second);
+        }
+      }
+      l = l_end;
+      r = r_end;
+    }
+  }
+}
+
+}
+
+MergeJoin::~MergeJoin() {
+}
+
+void MergeJoin::executePlanOperation() {
+  if (!producesPositions) {
+    throw std::runtime_error("MergeJoin execute() not supported with producesPositions == false");
+  }
+  if (_field_definition.empty() || _field_definition.size() % 2 != 0) {
+    throw std::runtime_error("MergeJoin requires pairs of left and right join fields");
+  }
+
+  const auto& left = input.getTable(0);
+  const auto& right = input.getTable(1);
+
+  key_list_t left_keys, right_keys;
+  encodeJoinKeys(left, right, _field_definition, left_keys, right_keys);
+
+  // Inputs that arrive ordered on the join key are merged without sorting
+  const bool left_sorted = std::is_sorted(left_keys.begin(), left_keys.end());
+  const bool right_sorted = std::is_sorted(right_keys.begin(), right_keys.end());
+
+  const auto splitters = computeSplitters(left_keys, right_keys, std::max<size_t>(1, _partitions));
+  auto left_partitions = scatter(left_keys, splitters);
+  auto right_partitions = scatter(right_keys, splitters);
+  key_list_t().swap(left_keys);
+  key_list_t().swap(right_keys);
+
+  const size_t partitions = left_partitions.size();
+  std::vector<pos_list_t> left_results(partitions), right_results(partitions);
+
+  helper::parallelFor(partitions, partitions, [&](const size_t, const size_t p) {
+    mergePartition(left_partitions[p], left_sorted, right_partitions[p], right_sorted, left_results[p], right_results[p]);
+  });
+
+  size_t result_size = 0;
+  for (const auto& result : left_results)
+    result_size += result.size();
+
+  auto left_pos = new pos_list_t;
+  auto right_pos = new pos_list_t;
+  left_pos->reserve(result_size);
+  right_pos->reserve(result_size);
+  for (size_t p = 0; p < partitions; ++p) {
+    left_pos->insert(left_pos->end(), left_results[p].begin(), left_results[p].end());
+    right_pos->insert(right_pos->end(), right_results[p].begin(), right_results[p].end());
+  }
+
+  std::vector<storage::atable_ptr_t> parts({
+    PointerCalculator::create(left, left_pos),
+    PointerCalculator::create(right, right_pos)
+  });
+
+  addResult(std::make_shared<storage::MutableVerticalTable>(parts));
+}
+
+std::shared_ptr<PlanOperation> MergeJoin::parse(const Json::Value &data) {
+  auto instance = std::make_shared<MergeJoin>();
+  for (unsigned i = 0; i < data["fields"].size(); ++i) {
+    instance->addField(data["fields"][i]);
+  }
+  if (data.isMember("partitions")) {
+    instance->setPartitions(data["partitions"].asUInt());
+  }
+  return instance;
+}
+
+void MergeJoin::accessedFields(field_list_t &fields) const {
+  for (size_t i = 0; i < _field_definition.size(); i += 2)
+    fields.push_back(_field_definition[i]);
+}
+
+const std::string MergeJoin::vname() {
+  return "MergeJoin";
+}
+
+void MergeJoin::setPartitions(const size_t partitions) {
+  _partitions = partitions;
+}
+
+}
+}
@@ -0,0 +1,47 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_MERGEJOIN_H_
+#define SRC_LIB_ACCESS_MERGEJOIN_H_
+
+#include "access/system/PlanOperation.h"
+
+namespace hyrise {
+namespace access {
+
+/// Sort-merge equi-join on value ids.
+///
+/// Instead of materializing values, the join columns of both inputs are
+/// mapped into one shared, order-preserving code domain: if both columns
+/// use the same ordered dictionary, the value ids are used directly,
+/// otherwise a value id translation table is built per dictionary. The
+/// codes of multi-column keys are packed into a single 64 bit key. Both
+/// inputs are range-partitioned on that key and the partitions are sorted
+/// and merged in parallel. Inputs that are already ordered on the join key
+/// (e.g. SortScan results or sorted main partitions) are not sorted again.
+///
+/// Fields are given as pairs of left and right join column:
+/// {
+///     "type": "MergeJoin",
+///     "fields": [left_0, right_0, left_1, right_1, ...],
+///     "partitions": 4
+/// }
+class MergeJoin : public PlanOperation {
+public:
+  virtual ~MergeJoin();
+
+  void executePlanOperation();
+  static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
+  const std::string vname();
+  void setPartitions(size_t partitions);
+
+protected:
+  /// Only the fields of the left input
+  void accessedFields(field_list_t &fields) const;
+
+private:
+  size_t _partitions = 1;
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_MERGEJOIN_H_
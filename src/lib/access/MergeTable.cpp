@@ -2,8 +2,10 @@
 #include "access/MergeTable.h"
 
 #include "access/system/QueryParser.h"
+#include "access/system/WorkloadStatistics.h"
 
 #include "helper/checked_cast.h"
+#include "storage/MutableVerticalTable.h"
 #include "storage/Store.h"
 
 namespace hyrise {
@@ -49,6 +51,16 @@ const std::string MergeTable::vname() {
 
 namespace {
   auto _2 = QueryParser::registerPlanOperation<MergeStore>("MergeStore");
+
+  // Empty table with the columns of `main` partitioned into the
+  // containers of `layout`
+  storage::atable_ptr_t createLayoutedTable(const storage::c_atable_ptr_t &main,
+                                            const WorkloadStatistics::layout_t &layout) {
+    std::vector<storage::atable_ptr_t> containers;
+    for (const auto& fields : layout)
+      containers.push_back(main->copy_structure(&fields, false, 0, false, true));
+    return std::make_shared<storage::MutableVerticalTable>(containers);
+  }
 }
 
 MergeStore::~MergeStore() {
@@ -57,7 +69,14 @@ MergeStore::~MergeStore() {
 void MergeStore::executePlanOperation() {
   auto t = checked_pointer_cast<const storage::Store>(getInputTable());
   auto store = std::const_pointer_cast<storage::Store>(t);
-  store->merge();
+
+  auto& statistics = WorkloadStatistics::getInstance();
+  const auto& layout = statistics.isEnabled() ?
+      statistics.proposeLayout(*store) : WorkloadStatistics::layout_t();
+  if (layout.empty())
+    store->merge();
+  else
+    store->merge(createLayoutedTable(store->getMainTable(), layout));
   addResult(store);
 }
 
@@ -16,6 +16,14 @@ public:
   const std::string vname();
 };
 
+/// Merges the delta of a store into its main table.
+///
+/// If WorkloadStatistics are enabled and the recorded workload suggests a
+/// cheaper vertical partitioning, the new main table is created in that
+/// layout.
+/// {
+///     "type": "MergeStore"
+/// }
 class MergeStore : public PlanOperation {
 public:
   virtual ~MergeStore();
@@ -30,7 +30,7 @@ void MultiplyRefField::executeMultiply() {
   result->resize(stop * stopInner);
 
   // Pos list for matching Rows
-  auto pos = new std::vector<size_t>;
+  auto pos = new pos_list_t;
 
   // Nested Loop for Multiplication
   for(size_t outer=0; outer < stop; ++outer) {
@@ -1,5 +1,9 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/PosUpdateScan.h"
+
+#include <algorithm>
+#include <mutex>
+
 #include <access/system/ResponseTask.h>
 
 #include "json_converters.h"
@@ -11,6 +15,7 @@
 
 #include "storage/Store.h"
 #include "storage/PointerCalculator.h"
+#include "storage/SecondaryIndex.h"
 #include "storage/AbstractTable.h"
 #include "storage/meta_storage.h"
 
@@ -35,23 +40,31 @@ void PosUpdateScan::executePlanOperation() {
   // Cast the constness away
   auto store = std::const_pointer_cast<storage::Store>(c_store);
 
-  // Get the current maximum size
-  const auto& beforSize = store->size();
-
-  // Get the offset for inserts into the delta and the size of the delta that
-  // we need to increase by the positions we are inserting
-  auto writeArea = store->appendToDelta(c_pc->getPositions()->size());
+  const auto& positions = *(c_pc->getPositions());
 
   // Get the modification record for the current transaction
   auto& txmgr = tx::TransactionManager::getInstance();
   auto& modRecord = txmgr[_txContext.tid];
 
   // Functor we use for updating the data
-  set_json_value_functor fun(store->getDeltaTable());
+  set_json_value_functor fun(store);
   storage::type_switch<hyrise_basic_types> ts;
 
-  size_t counter = 0;
-  for(const auto& p : *(c_pc->getPositions())) {
+  // Updates of primary key columns check the new keys and index the rows
+  // under the lock of the key, like inserts
+  std::unique_lock<std::mutex> key_lock;
+  bool updates_key = false;
+  if (store->primaryKey()) {
+    const auto& key_fields = store->primaryKey()->fields();
+    for (const auto& kv : _raw_data) {
+      const auto& fld = store->numberOfColumn(kv.first);
+      updates_key |= std::find(key_fields.begin(), key_fields.end(), fld) != key_fields.end();
+    }
+  }
+  if (updates_key)
+    key_lock = store->lockPrimaryKey();
+
+  for(const auto& p : positions) {
     // First delete the old record
     bool deleteOk = store->markForDeletion(p, _txContext.tid) == hyrise::tx::TX_CODE::TX_OK;
     if(!deleteOk) {
@@ -60,13 +73,44 @@ void PosUpdateScan::executePlanOperation() {
     }
     modRecord.deletePos(store, p);
     //store->setTid(p, _txContext.tid);
+  }
 
+  if (updates_key) {
+    // The old records no longer hold their keys for this transaction
+    auto rows = store->copy_structure_modifiable();
+    rows->resize(positions.size());
+    set_json_value_functor row_fun(rows);
+    for (size_t i = 0; i < positions.size(); ++i) {
+      rows->copyRowFrom(store, positions[i], i, true);
+      for(const auto& kv : _raw_data) {
+        const auto& fld = store->numberOfColumn(kv.first);
+        row_fun.set(fld, i, kv.second);
+        ts(store->typeOfColumn(fld), row_fun);
+      }
+    }
+    try {
+      store->checkPrimaryKey(rows, _txContext.tid);
+    } catch (const std::runtime_error&) {
+      txmgr.rollbackTransaction(_txContext);
+      throw;
+    }
+  }
+
+  // Get the current maximum size
+  const auto& beforSize = store->size();
+
+  // Get the offset for inserts into the delta and the size of the delta that
+  // we need to increase by the positions we are inserting
+  auto writeArea = store->appendToDelta(positions.size());
+
+  size_t counter = 0;
+  for(const auto& p : positions) {
     // Copy the old row from the main
     store->copyRowToDelta(store, p, writeArea.first+counter, _txContext.tid);
     // Update all the necessary values
     for(const auto& kv : _raw_data) {
       const auto& fld = store->numberOfColumn(kv.first);
-      fun.set(fld, writeArea.first+counter, kv.second);
+      fun.set(fld, store->deltaOffset()+writeArea.first+counter, kv.second);
       ts(store->typeOfColumn(fld), fun);
     }
 
@@ -74,6 +118,7 @@ void PosUpdateScan::executePlanOperation() {
     modRecord.insertPos(store, beforSize+counter);
     ++counter;
   }
+  store->indexDelta(writeArea.first, writeArea.first + counter);
 
   // Update affected rows
   auto rsp = getResponseTask();
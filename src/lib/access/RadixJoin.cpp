@@ -1,26 +1,376 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/RadixJoin.h"
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#include "access/join_keys.h"
 #include "access/system/BasicParser.h"
 #include "access/system/QueryParser.h"
 
+#include "helper/noncopyable.h"
+#include "helper/parallel_for.h"
+
+#include "storage/MutableVerticalTable.h"
+#include "storage/PointerCalculator.h"
+
 namespace hyrise {
 namespace access {
 
 namespace {
-  auto _ = QueryParser::registerPlanOperation<RadixJoin>("RadixJoin");
+
+auto _ = QueryParser::registerPlanOperation<RadixJoin>("RadixJoin");
+
+struct radix_tuple_t {
+  join_key_t key;
+  pos_t pos;
+};
+
+const size_t cache_line_size = 64;
+const size_t tuples_per_line = cache_line_size / sizeof(radix_tuple_t);
+
+// Second level TLB entries of current x86 cores, bounds the fan-out of a
+// single partitioning pass
+const size_t tlb_entries = 512;
+
+// Bytes per build tuple in a partition's hash table: the tuple itself
+// plus bucket head and chain link
+const size_t hash_table_bytes_per_tuple = sizeof(radix_tuple_t) + 2 * sizeof(uint32_t);
+
+// Minimum number of input rows per automatically chosen thread
+const size_t min_rows_per_thread = 16 * 1024;
+
+const uint32_t max_radix_bits = 24;
+
+size_t cacheSize(const int name, const size_t fallback) {
+  const long size = sysconf(name);
+  return size > 0 ? size : fallback;
+}
+
+uint32_t log2Floor(size_t value) {
+  uint32_t bits = 0;
+  while (value > 1) {
+    value >>= 1;
+    ++bits;
+  }
+  return bits;
+}
+
+uint32_t log2Ceil(const size_t value) {
+  const uint32_t bits = log2Floor(value);
+  return (1ull << bits) < value ? bits + 1 : bits;
+}
+
+inline uint64_t hashKey(const join_key_t key) {
+  return key * 0x9E3779B97F4A7C15ull;
+}
+
+// Extracts `bits` radix bits starting `shift` bits below the most
+// significant bit of the hash
+inline size_t radixOf(const uint64_t hash, const uint32_t shift, const uint32_t bits) {
+  return (hash << shift) >> (64 - bits);
+}
+
+template <typename T>
+class AlignedBuffer : noncopyable {
+public:
+  explicit AlignedBuffer(const size_t size) : _data(nullptr) {
+    void *data;
+    if (posix_memalign(&data, cache_line_size, std::max<size_t>(size, 1) * sizeof(T)) != 0)
+      throw std::bad_alloc();
+    _data = static_cast<T*>(data);
+  }
+
+  ~AlignedBuffer() {
+    free(_data);
+  }
+
+  T *get() const {
+    return _data;
+  }
+
+  void swap(AlignedBuffer &other) {
+    std::swap(_data, other._data);
+  }
+
+private:
+  T *_data;
+};
+
+// Reads tuples from the encoded join keys, the position is the row
+struct KeySource {
+  const join_key_t *keys;
+  inline radix_tuple_t operator[](const size_t row) const {
+    return { keys[row], row };
+  }
+};
+
+struct TupleSource {
+  const radix_tuple_t *tuples;
+  inline radix_tuple_t operator[](const size_t row) const {
+    return tuples[row];
+  }
+};
+
+template <typename Source>
+void histogram(const Source &source, const size_t begin, const size_t end,
+               const uint32_t shift, const uint32_t bits, size_t *counts) {
+  std::fill(counts, counts + (1ull << bits), 0);
+  for (size_t row = begin; row < end; ++row)
+    ++counts[radixOf(hashKey(source[row].key), shift, bits)];
+}
+
+// Scatters rows [begin, end) to the output positions given by `offsets`.
+// Tuples are first collected in a cache line sized buffer per partition
+// and written to the output one full line at a time, so the scatter only
+// touches as many lines as there are partitions. `lines` has to hold
+// one cache line per partition.
+template <typename Source>
+void scatter(const Source &source, const size_t begin, const size_t end,
+             const uint32_t shift, const uint32_t bits,
+             size_t *offsets, radix_tuple_t *output,
+             AlignedBuffer<radix_tuple_t> &lines) {
+  const size_t fanout = 1ull << bits;
+  std::vector<uint8_t> fill(fanout, 0);
+
+  for (size_t row = begin; row < end; ++row) {
+    const radix_tuple_t tuple = source[row];
+    const size_t partition = radixOf(hashKey(tuple.key), shift, bits);
+    radix_tuple_t *line = lines.get() + partition * tuples_per_line;
+    line[fill[partition]++] = tuple;
+    if (fill[partition] == tuples_per_line) {
+      memcpy(output + offsets[partition], line, cache_line_size);
+      offsets[partition] += tuples_per_line;
+      fill[partition] = 0;
+    }
+  }
+
+  for (size_t partition = 0; partition < fanout; ++partition) {
+    memcpy(output + offsets[partition], lines.get() + partition * tuples_per_line, fill[partition] * sizeof(radix_tuple_t));
+    offsets[partition] += fill[partition];
+  }
+}
+
+// Radix partitions one join side and returns the partition boundaries,
+// partition p covers [bounds[p], bounds[p + 1]) of `output`
+std::vector<size_t> partitionSide(const join_key_list_t &keys,
+                                  const std::vector<uint32_t> &pass_bits,
+                                  const size_t threads,
+                                  AlignedBuffer<radix_tuple_t> &output) {
+  const size_t rows = keys.size();
+  const KeySource source {keys.data()};
+
+  // First pass: every thread histograms and scatters its own range of rows
+  const uint32_t bits = pass_bits.front();
+  const size_t fanout = 1ull << bits;
+  std::vector<size_t> counts(threads * fanout);
+  const size_t rows_per_thread = (rows + threads - 1) / threads;
+  auto range = [&](const size_t t) {
+    return std::make_pair(std::min(rows, t * rows_per_thread), std::min(rows, (t + 1) * rows_per_thread));
+  };
+
+  helper::parallelFor(threads, threads, [&](const size_t, const size_t t) {
+    histogram(source, range(t).first, range(t).second, 0, bits, &counts[t * fanout]);
+  });
+
+  std::vector<size_t> bounds(fanout + 1, 0);
+  size_t offset = 0;
+  for (size_t p = 0; p < fanout; ++p) {
+    bounds[p] = offset;
+    for (size_t t = 0; t < threads; ++t) {
+      const size_t count = counts[t * fanout + p];
+      counts[t * fanout + p] = offset;
+      offset += count;
+    }
+  }
+  bounds[fanout] = rows;
+
+  helper::parallelFor(threads, threads, [&](const size_t, const size_t t) {
+    AlignedBuffer<radix_tuple_t> lines(fanout * tuples_per_line);
+    scatter(source, range(t).first, range(t).second, 0, bits, &counts[t * fanout], output.get(), lines);
+  });
+
+  // Further passes refine the partitions of the previous pass
+  AlignedBuffer<radix_tuple_t> scratch(rows);
+  uint32_t shift = bits;
+  for (size_t pass = 1; pass < pass_bits.size(); ++pass) {
+    output.swap(scratch);
+    const uint32_t sub_bits = pass_bits[pass];
+    const size_t sub_fanout = 1ull << sub_bits;
+    const size_t parents = bounds.size() - 1;
+    std::vector<size_t> sub_bounds(parents * sub_fanout + 1, rows);
+    std::vector<std::vector<size_t> > offsets(threads, std::vector<size_t>(sub_fanout));
+    std::vector<std::unique_ptr<AlignedBuffer<radix_tuple_t> > > lines(threads);
+    const TupleSource tuples {scratch.get()};
+
+    helper::parallelFor(parents, threads, [&](const size_t t, const size_t parent) {
+      if (!lines[t])
+        lines[t].reset(new AlignedBuffer<radix_tuple_t>(sub_fanout * tuples_per_line));
+      const size_t begin = bounds[parent], end = bounds[parent + 1];
+      histogram(tuples, begin, end, shift, sub_bits, offsets[t].data());
+      size_t offset = begin;
+      for (size_t p = 0; p < sub_fanout; ++p) {
+        const size_t count = offsets[t][p];
+        sub_bounds[parent * sub_fanout + p] = offsets[t][p] = offset;
+        offset += count;
+      }
+      scatter(tuples, begin, end, shift, sub_bits, offsets[t].data(), output.get(), *lines[t]);
+    });
+
+    bounds.swap(sub_bounds);
+    shift += sub_bits;
+  }
+  return bounds;
+}
+
+// Joins one pair of partitions with a bucket-chained hash table on the
+// build side
+void joinPartition(const radix_tuple_t *build, const size_t build_size,
+                   const radix_tuple_t *probe, const size_t probe_size,
+                   const uint32_t radix_bits,
+                   std::vector<uint32_t> &heads, std::vector<uint32_t> &chain,
+                   pos_list_t &build_pos, pos_list_t &probe_pos) {
+  // Use the hash bits below the radix bits, these still differ inside
+  // a partition
+  const uint32_t bucket_bits = std::max<uint32_t>(1, log2Ceil(build_size));
+  const uint32_t bucket_shift = std::min<uint32_t>(radix_bits, 64 - bucket_bits);
+  const uint32_t end_of_chain = 0;
+
+  heads.assign(1ull << bucket_bits, end_of_chain);
+  chain.resize(build_size + 1);
+  for (size_t i = 0; i < build_size; ++i) {
+    const size_t bucket = radixOf(hashKey(build[i].key), bucket_shift, bucket_bits);
+    chain[i + 1] = heads[bucket];
+    heads[bucket] = i + 1;
+  }
+
+  for (size_t i = 0; i < probe_size; ++i) {
+    const join_key_t key = probe[i].key;
+    const size_t bucket = radixOf(hashKey(key), bucket_shift, bucket_bits);
+    for (uint32_t entry = heads[bucket]; entry != end_of_chain; entry = chain[entry]) {
+      if (build[entry - 1].key == key) {
+        build_pos.push_back(build[entry - 1].pos);
+        probe_pos.push_back(probe[i].pos);
+      }
+    }
+  }
+}
+
 }
 
 void RadixJoin::executePlanOperation() {
+  if (!producesPositions) {
+    throw std::runtime_error("RadixJoin execute() not supported with producesPositions == false");
+  }
+  if (_field_definition.empty() || _field_definition.size() % 2 != 0) {
+    throw std::runtime_error("RadixJoin requires pairs of left and right join fields");
+  }
+
+  const auto& left = input.getTable(0);
+  const auto& right = input.getTable(1);
+
+  join_key_list_t left_keys, right_keys;
+  encodeJoinKeys(left, right, _field_definition, left_keys, right_keys);
+
+  // The hash tables are built on the smaller input
+  const bool build_left = left_keys.size() < right_keys.size();
+  const auto& build_keys = build_left ? left_keys : right_keys;
+  const auto& probe_keys = build_left ? right_keys : left_keys;
+
+  const size_t l1_size = cacheSize(_SC_LEVEL1_DCACHE_SIZE, 32 * 1024);
+  const size_t l2_size = cacheSize(_SC_LEVEL2_CACHE_SIZE, 256 * 1024);
+
+  std::vector<uint32_t> pass_bits;
+  if (_bits1 > 0) {
+    pass_bits.push_back(_bits1);
+    if (_bits2 > 0)
+      pass_bits.push_back(_bits2);
+  } else {
+    // Enough partitions for a build partition's hash table to use at most
+    // half of the L2 cache, at most as many partitions per pass as there
+    // are TLB entries and write-combining lines fitting into L1
+    const size_t partitions = build_keys.size() * hash_table_bytes_per_tuple / (l2_size / 2) + 1;
+    uint32_t total_bits = std::min(log2Ceil(partitions), max_radix_bits);
+    const uint32_t max_pass_bits = std::max<uint32_t>(1, std::min(log2Floor(tlb_entries),
+                                                                  log2Floor(l1_size / cache_line_size)));
+    const uint32_t passes = std::max<uint32_t>(1, (total_bits + max_pass_bits - 1) / max_pass_bits);
+    for (uint32_t pass = 0; pass < passes; ++pass) {
+      const uint32_t bits = total_bits / (passes - pass);
+      pass_bits.push_back(std::max<uint32_t>(1, bits));
+      total_bits -= bits;
+    }
+  }
+  uint32_t radix_bits = 0;
+  for (const auto& bits : pass_bits)
+    radix_bits += bits;
+  if (radix_bits > max_radix_bits) {
+    throw std::runtime_error("RadixJoin supports at most 24 radix bits");
+  }
+
+  size_t threads = _threads;
+  if (threads == 0) {
+    threads = std::max<size_t>(1, std::min<size_t>(helper::maxParallelThreads(),
+                                                   (build_keys.size() + probe_keys.size()) / min_rows_per_thread));
+  }
+
+  AlignedBuffer<radix_tuple_t> build(build_keys.size()), probe(probe_keys.size());
+  const auto build_bounds = partitionSide(build_keys, pass_bits, threads, build);
+  const auto probe_bounds = partitionSide(probe_keys, pass_bits, threads, probe);
+
+  const size_t partitions = build_bounds.size() - 1;
+  std::vector<pos_list_t> build_results(threads), probe_results(threads);
+  std::vector<std::vector<uint32_t> > heads(threads), chain(threads);
+
+  helper::parallelFor(partitions, threads, [&](const size_t t, const size_t p) {
+    const size_t build_size = build_bounds[p + 1] - build_bounds[p];
+    const size_t probe_size = probe_bounds[p + 1] - probe_bounds[p];
+    if (build_size == 0 || probe_size == 0)
+      return;
+    joinPartition(build.get() + build_bounds[p], build_size,
+                  probe.get() + probe_bounds[p], probe_size,
+                  radix_bits, heads[t], chain[t], build_results[t], probe_results[t]);
+  });
+
+  size_t result_size = 0;
+  for (const auto& result : build_results)
+    result_size += result.size();
+
+  auto build_pos = new pos_list_t;
+  auto probe_pos = new pos_list_t;
+  build_pos->reserve(result_size);
+  probe_pos->reserve(result_size);
+  for (size_t t = 0; t < threads; ++t) {
+    build_pos->insert(build_pos->end(), build_results[t].begin(), build_results[t].end());
+    probe_pos->insert(probe_pos->end(), probe_results[t].begin(), probe_results[t].end());
+  }
+
+  std::vector<storage::atable_ptr_t> parts({
+    PointerCalculator::create(left, build_left ? build_pos : probe_pos),
+    PointerCalculator::create(right, build_left ? probe_pos : build_pos)
+  });
+
+  addResult(std::make_shared<storage::MutableVerticalTable>(parts));
 }
 
 std::shared_ptr<PlanOperation> RadixJoin::parse(const Json::Value &data) {
   auto instance = BasicParser<RadixJoin>::parse(data);
   instance->setBits1(data["bits1"].asUInt());
   instance->setBits2(data["bits2"].asUInt());
+  if (data.isMember("threads")) {
+    instance->setThreads(data["threads"].asUInt());
+  }
   return instance;
 }
 
+void RadixJoin::accessedFields(field_list_t &fields) const {
+  for (size_t i = 0; i < _field_definition.size(); i += 2)
+    fields.push_back(_field_definition[i]);
+}
+
 const std::string RadixJoin::vname() {
   return "RadixJoin";
 }
@@ -41,5 +391,9 @@ uint32_t RadixJoin::bits2() const {
   return _bits2;
 }
 
+void RadixJoin::setThreads(const size_t threads) {
+  _threads = threads;
+}
+
 }
 }
@@ -7,6 +7,31 @@
 namespace hyrise {
 namespace access {
 
+/// Parallel radix hash equi-join.
+///
+/// The join keys of both inputs are encoded into a shared integer domain
+/// (see join_keys.h) and copied as (key, position) tuples into cache line
+/// aligned buffers. Both sides are radix partitioned on a hash of the key
+/// in one or more passes; each pass writes through software
+/// write-combining buffers of one cache line per partition. The first pass
+/// runs data parallel over all threads, later passes refine independent
+/// partitions in parallel. Finally every pair of partitions is joined with
+/// a bucket-chained hash table that is built on the smaller side and fits
+/// into the L2 cache.
+///
+/// Without "bits1" the number of radix bits is derived from the size of
+/// the build side and the L2 cache size, and the bits are spread over as
+/// many passes as needed to keep the fan-out of a pass within the TLB and
+/// the write-combining buffers within the L1 cache. Such operators are
+/// executed as a single plan operation. If "bits1" is given, the query is
+/// expanded by the RadixJoinTransformation into the Histogram, PrefixSum,
+/// RadixCluster and NestedLoopEquiJoin pipeline instead.
+///
+/// {
+///     "type": "RadixJoin",
+///     "fields": [left_0, right_0, left_1, right_1, ...],
+///     "threads": 8
+/// }
 class RadixJoin : public PlanOperation {
 public:
   void executePlanOperation();
@@ -16,10 +41,17 @@ public:
   void setBits2(const uint32_t b);
   uint32_t bits1() const;
   uint32_t bits2() const;
+  /// Number of worker threads, 0 uses all hardware threads
+  void setThreads(const size_t threads);
+
+protected:
+  /// Only the fields of the left input
+  void accessedFields(field_list_t &fields) const;
 
 private:
-  uint32_t _bits1;
-  uint32_t _bits2;
+  uint32_t _bits1 = 0;
+  uint32_t _bits2 = 0;
+  size_t _threads = 0;
 };
 
 }
@@ -332,7 +332,7 @@ v8::Handle<v8::Value> TableGetValueIdVRange(const v8::Arguments& args) {
 v8::Handle<v8::Value> AttributeVectorGetSize(const v8::Arguments& args) {
   auto wrap = v8::Local<v8::External>::Cast(args.This()->GetInternalField(0));
   auto ptr = static_cast<AbstractAttributeVector*>(wrap->Value());
-  auto casted = dynamic_cast<FixedLengthVector<value_id_t>*>(ptr);
+  auto casted = dynamic_cast<BaseAttributeVector<value_id_t>*>(ptr);
   size_t value = casted->size();
   return v8::Integer::New(value);
 }
@@ -340,7 +340,7 @@ v8::Handle<v8::Value> AttributeVectorGetSize(const v8::Arguments& args) {
 v8::Handle<v8::Value> AttributeVectorGet(const v8::Arguments& args) {
   auto wrap = v8::Local<v8::External>::Cast(args.This()->GetInternalField(0));
   auto ptr = static_cast<AbstractAttributeVector*>(wrap->Value());
-  auto casted = dynamic_cast<FixedLengthVector<value_id_t>*>(ptr);
+  auto casted = dynamic_cast<BaseAttributeVector<value_id_t>*>(ptr);
 
   auto col = args[0]->ToInteger()->Value();
   auto row = args[1]->ToInteger()->Value();
@@ -357,7 +357,7 @@ v8::Handle<v8::Value> AttributeVectorGetRange(const v8::Arguments& args) {
 
   auto wrap = v8::Local<v8::External>::Cast(args.This()->GetInternalField(0));
   auto ptr = static_cast<AbstractAttributeVector*>(wrap->Value());
-  auto casted = dynamic_cast<FixedLengthVector<value_id_t>*>(ptr);
+  auto casted = dynamic_cast<BaseAttributeVector<value_id_t>*>(ptr);
 
   size_t col = args[0]->ToInteger()->Value();
   size_t row = args[1]->ToInteger()->Value();
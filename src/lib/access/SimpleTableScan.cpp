@@ -2,6 +2,8 @@
 #include "access/SimpleTableScan.h"
 
 #include "access/expressions/pred_buildExpression.h"
+#include "access/expressions/pred_CompiledExpression.h"
+#include "access/system/OperationData-Impl.h"
 
 #include "storage/Store.h"
 #include "storage/PointerCalculator.h"
@@ -24,41 +26,55 @@ SimpleTableScan::~SimpleTableScan() {
 }
 
 void SimpleTableScan::setupPlanOperation() {
-  _comparator->walk(input.getTables());
+  if (_comparator)
+    _comparator->walk(input.getTables());
 }
 
-void SimpleTableScan::executePositional() {
-  auto tbl = input.getTable(0);
-  storage::pos_list_t *pos_list = new pos_list_t();
+void SimpleTableScan::accessedFields(field_list_t &fields) const {
+  if (_comparator)
+    _comparator->accessedFields(fields);
+  fields.insert(fields.end(), _join_filter_fields.begin(), _join_filter_fields.end());
+}
+
+inline bool SimpleTableScan::matches(const storage::JoinFilterProbe &join_filter, const size_t row) const {
+  return (join_filter.empty() || join_filter(row)) && (!_comparator || (*_comparator)(row));
+}
 
+pos_list_t *SimpleTableScan::matchingRows(const storage::c_atable_ptr_t &table,
+                                          const storage::JoinFilterProbe &join_filter) const {
+  const size_t first = _ofDelta ? checked_pointer_cast<const storage::Store>(table)->deltaOffset() : 0;
+  if (join_filter.empty() && _comparator)
+    return _comparator->match(first, table->size());
 
-  size_t row = _ofDelta ? checked_pointer_cast<const storage::Store>(tbl)->deltaOffset() : 0;
-  for (size_t input_size=tbl->size(); row < input_size; ++row) {
-    if ((*_comparator)(row)) {
-      pos_list->push_back(row);
-    }
+  pos_list_t *rows = new pos_list_t();
+  for (size_t row = first, input_size = table->size(); row < input_size; ++row) {
+    if (matches(join_filter, row))
+      rows->push_back(row);
   }
-  addResult(PointerCalculator::create(tbl, pos_list));
+  return rows;
+}
+
+void SimpleTableScan::executePositional() {
+  auto tbl = input.getTable(0);
+  const storage::JoinFilterProbe join_filter(input.allOf<storage::JoinFilter>(), tbl, _join_filter_fields);
+  addResult(PointerCalculator::create(tbl, matchingRows(tbl, join_filter)));
 }
 
 void SimpleTableScan::executeMaterialized() {
   auto tbl = input.getTable(0);
   auto result_table = tbl->copy_structure_modifiable();
   size_t target_row = 0;
-
-  size_t row = _ofDelta ? checked_pointer_cast<const storage::Store>(tbl)->deltaOffset() : 0;
-  for (size_t input_size=tbl->size();
-       row < input_size;
-       ++row) {
-    if ((*_comparator)(row)) {
-        // TODO materializing result set will make the allocation the boundary
-      result_table->resize(target_row + 1);
-      result_table->copyRowFrom(input.getTable(0),
-                                row,
-                                target_row++,
-                                true /* Copy Value*/,
-                                false /* Use Memcpy */);
-    }
+  const storage::JoinFilterProbe join_filter(input.allOf<storage::JoinFilter>(), tbl, _join_filter_fields);
+
+  std::unique_ptr<pos_list_t> rows(matchingRows(tbl, join_filter));
+  for (const auto& row : *rows) {
+    // TODO materializing result set will make the allocation the boundary
+    result_table->resize(target_row + 1);
+    result_table->copyRowFrom(input.getTable(0),
+                              row,
+                              target_row++,
+                              true /* Copy Value*/,
+                              false /* Use Memcpy */);
   }
   addResult(result_table);
 }
@@ -77,10 +93,19 @@ std::shared_ptr<PlanOperation> SimpleTableScan::parse(const Json::Value &data) {
   if (data.isMember("materializing"))
     pop->setProducesPositions(!data["materializing"].asBool());
 
-  if (!data.isMember("predicates")) {
+  if (data.isMember("joinFilterFields")) {
+    field_list_t fields;
+    for (unsigned i = 0; i < data["joinFilterFields"].size(); ++i)
+      fields.push_back(data["joinFilterFields"][i].asUInt());
+    pop->setJoinFilterFields(fields);
+  }
+
+  if (data.isMember("predicates")) {
+    SimpleExpression *predicate = CompiledExpression::compile(data["predicates"]);
+    pop->setPredicate(predicate ? predicate : buildExpression(data["predicates"]));
+  } else if (!data.isMember("joinFilterFields")) {
     throw std::runtime_error("There is no reason for a Selection without predicates");
   }
-  pop->setPredicate(buildExpression(data["predicates"]));
 
   if (data.isMember("ofDelta")) {
     pop->_ofDelta = data["ofDelta"].asBool();
@@ -97,5 +122,9 @@ void SimpleTableScan::setPredicate(SimpleExpression *c) {
   _comparator = c;
 }
 
+void SimpleTableScan::setJoinFilterFields(const field_list_t &fields) {
+  _join_filter_fields = fields;
+}
+
 }
 }
@@ -5,9 +5,25 @@
 #include "access/system/ParallelizablePlanOperation.h"
 #include "access/expressions/pred_SimpleExpression.h"
 
+#include "storage/JoinFilter.h"
+
 namespace hyrise {
 namespace access {
 
+/// Selection on a single predicate expression.
+///
+/// Predicates that CompiledExpression supports are evaluated a batch of
+/// rows at a time on value ids.
+///
+/// Join filters produced by HashBuild ("joinFilter": true) that are routed
+/// into the scan are evaluated on "joinFilterFields" before the predicate;
+/// rows without a possible join partner are dropped early. The predicate
+/// may be omitted if join filter fields are given.
+/// {
+///     "type": "SimpleTableScan",
+///     "predicates": [...],
+///     "joinFilterFields": [0]
+/// }
 class SimpleTableScan : public ParallelizablePlanOperation {
 public:
   SimpleTableScan();
@@ -20,10 +36,19 @@ public:
   static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
   const std::string vname();
   void setPredicate(SimpleExpression *c);
+  void setJoinFilterFields(const field_list_t &fields);
+
+protected:
+  void accessedFields(field_list_t &fields) const;
 
 private:
+  bool matches(const storage::JoinFilterProbe &join_filter, const size_t row) const;
+  // Rows of the input that pass the join filter and the predicate
+  pos_list_t *matchingRows(const storage::c_atable_ptr_t &table, const storage::JoinFilterProbe &join_filter) const;
+
   SimpleExpression *_comparator;
   bool _ofDelta = false;
+  field_list_t _join_filter_fields;
 };
 
 }
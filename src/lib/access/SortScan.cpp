@@ -2,31 +2,136 @@
 #include "access/SortScan.h"
 
 #include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
 
 #include "access/system/QueryParser.h"
 
+#include "memory/SpillFile.h"
+
 #include "storage/AbstractTable.h"
+#include "storage/ColumnAccessor.h"
 #include "storage/PointerCalculator.h"
 #include "storage/Table.h"
 
 namespace hyrise {
 namespace access {
 
+namespace {
+
+// Values of sort runs in spill files
+void spill(memory::SpillFile &file, const hyrise_int_t &value) {
+  file.writeSigned(value);
+}
+
+void spill(memory::SpillFile &file, const hyrise_float_t &value) {
+  file.writeDouble(value);
+}
+
+void spill(memory::SpillFile &file, const hyrise_string_t &value) {
+  file.writeString(value);
+}
+
+void spill(memory::SpillFile &file, const ValueId &value) {
+  file.writeUnsigned(value.valueId);
+  file.writeUnsigned(value.table);
+}
+
+bool unspill(memory::SpillFile &file, hyrise_int_t &value) {
+  int64_t read;
+  if (!file.readSigned(read))
+    return false;
+  value = read;
+  return true;
+}
+
+bool unspill(memory::SpillFile &file, hyrise_float_t &value) {
+  double read;
+  if (!file.readDouble(read))
+    return false;
+  value = read;
+  return true;
+}
+
+bool unspill(memory::SpillFile &file, hyrise_string_t &value) {
+  return file.readString(value);
+}
+
+// Bytes a value holds outside of its pair, they are not taken from the
+// query arena
+template <typename T>
+size_t payloadBytes(const T &value) {
+  return 0;
+}
+
+size_t payloadBytes(const hyrise_string_t &value) {
+  return value.capacity();
+}
+
+bool unspill(memory::SpillFile &file, ValueId &value) {
+  uint64_t id, table;
+  if (!file.readUnsigned(id) || !file.readUnsigned(table))
+    return false;
+  value.valueId = id;
+  value.table = table;
+  return true;
+}
+
+}
+
 template <typename T>
 struct ExtractValue {
-  static inline T extractValue(const storage::c_atable_ptr_t &table,
-                               const size_t &col,
-                               const size_t &row) {
-    return table->getValue<T>(col, row);
+  template <typename Pairs>
+  static inline void extractValues(const storage::c_atable_ptr_t &table,
+                                   const size_t &col,
+                                   Pairs &result) {
+    storage::ColumnAccessor<T>(table, col).forEach([&result](size_t row, const T &value) {
+      result.push_back({value, row});
+    });
+  }
+
+  /// Extracts the rows from `first` until `last` or until the pairs take
+  /// `bytes`, returns the row after the last one extracted
+  template <typename Pairs>
+  static inline pos_t extractValues(const storage::c_atable_ptr_t &table,
+                                    const size_t &col,
+                                    const pos_t first,
+                                    const pos_t last,
+                                    const size_t bytes,
+                                    Pairs &result) {
+    storage::ColumnAccessor<T> accessor(table, col);
+    size_t used = 0;
+    pos_t row = first;
+    for (; row < last && used < bytes; ++row) {
+      result.push_back({accessor.get(row), row});
+      used += sizeof(typename Pairs::value_type) + payloadBytes(result.back().value);
+    }
+    return row;
   }
 };
 
 template <typename T>
 struct ExtractValueId {
-  static inline ValueId extractValue(const storage::c_atable_ptr_t &table,
-                                     const size_t &col,
-                                     const size_t &row) {
-    return table->getValueId(col, row);
+  template <typename Pairs>
+  static inline void extractValues(const storage::c_atable_ptr_t &table,
+                                   const size_t &col,
+                                   Pairs &result) {
+    extractValues(table, col, 0, table->size(), std::numeric_limits<size_t>::max(), result);
+  }
+
+  template <typename Pairs>
+  static inline pos_t extractValues(const storage::c_atable_ptr_t &table,
+                                    const size_t &col,
+                                    const pos_t first,
+                                    const pos_t last,
+                                    const size_t bytes,
+                                    Pairs &result) {
+    const pos_t end = std::min<size_t>(last, first + std::max<size_t>(bytes / sizeof(typename Pairs::value_type), 1));
+    for (pos_t row = first; row < end; ++row) {
+      result.push_back({table->getValueId(col, row), row});
+    }
+    return end;
   }
 };
 
@@ -36,6 +141,11 @@ class ColumnSorter {
       T value;
       size_t row;
   } pair_t;
+  // Pairs count against the memory limit of the query
+  typedef std::vector<pair_t, memory::ArenaAllocator<pair_t> > pairs_t;
+
+  // Fewer rows per run are not worth a file
+  static const size_t min_run_rows = 4096;
 
   const storage::c_atable_ptr_t &_t;
   field_t _f;
@@ -50,11 +160,18 @@ public:
                _asc(asc) {
   }
 
-  std::vector<pos_t>* sort() const {
-    std::vector<pair_t> result;
+  pos_list_t *sort() const {
+    const size_t rows = _t->size();
+    if (!memory::QueryArena::fits(rows * (sizeof(pair_t) + sizeof(pos_t))))
+      return sortExternal();
 
-    for (size_t row = 0; row < _t->size(); ++row) {
-      result.push_back({ExtractFunctor<T>::extractValue(_t, _f, row), row});
+    // Values with a payload, i.e. strings, may not fit even if their pairs do
+    const size_t available = memory::QueryArena::availableBytes() - rows * sizeof(pos_t);
+    pairs_t result;
+    result.reserve(rows);
+    if (ExtractFunctor<T>::extractValues(_t, _f, 0, rows, available, result) < rows) {
+      pairs_t().swap(result);
+      return sortExternal();
     }
 
     auto asc_sort = [](const pair_t& left, const pair_t& right) { 
@@ -71,15 +188,97 @@ public:
                      _asc ? asc_sort : desc_sort
                      );
 
-    auto r = new std::vector<pos_t>;
+    auto r = new pos_list_t;
     r->reserve(result.size());
     for (const pair_t& p: result)
       r->push_back(p.row);
 
     return r;
   }
+
+private:
+  // Order of the result, equal values keep the order of their rows
+  bool before(const pair_t &left, const pair_t &right) const {
+    if (_asc ? left.value < right.value : left.value > right.value)
+      return true;
+    if (_asc ? right.value < left.value : right.value > left.value)
+      return false;
+    return left.row < right.row;
+  }
+
+  static bool read(memory::SpillFile &run, pair_t &pair) {
+    uint64_t row;
+    if (!unspill(run, pair.value) || !run.readUnsigned(row))
+      return false;
+    pair.row = row;
+    return true;
+  }
+
+  /// External merge sort for tables whose values do not fit into the
+  /// memory limit of the query: runs of rows are sorted in memory,
+  /// spilled to disk and merged into the sorted positions
+  pos_list_t *sortExternal() const {
+    const size_t rows = _t->size();
+    // The sorted positions are the result and have to fit
+    const size_t result_bytes = rows * sizeof(pos_t);
+    const size_t available = memory::QueryArena::availableBytes();
+    if (available < result_bytes)
+      throw memory::MemoryLimitExceeded();
+
+    // Half of what the result leaves goes to the pairs of a run, the
+    // other half to arena chunks that grow by doubling
+    const size_t run_bytes = std::max<size_t>(min_run_rows * sizeof(pair_t), (available - result_bytes) / 2);
+    const size_t run_rows = run_bytes / sizeof(pair_t);
+    memory::QueryArena *query = memory::QueryArena::current();
+    std::vector<std::unique_ptr<memory::SpillFile> > runs;
+    for (pos_t first = 0; first < rows; ) {
+      std::unique_ptr<memory::SpillFile> run(new memory::SpillFile());
+      {
+        // The pairs of a run are freed before the next one
+        memory::QueryArena arena(query);
+        memory::ArenaScope scope(&arena);
+
+        pairs_t pairs;
+        pairs.reserve(std::min(run_rows, rows - first));
+        first = ExtractFunctor<T>::extractValues(_t, _f, first, std::min(rows, first + run_rows), run_bytes, pairs);
+        std::stable_sort(pairs.begin(), pairs.end(), [this](const pair_t& left, const pair_t& right) {
+          return before(left, right);
+        });
+        for (const pair_t& p : pairs) {
+          spill(*run, p.value);
+          run->writeUnsigned(p.row);
+        }
+      }
+      run->rewind();
+      runs.push_back(std::move(run));
+    }
+
+    // The runs are freed, the result takes their place
+    std::unique_ptr<pos_list_t> r(new pos_list_t);
+    r->reserve(rows);
+
+    // The top of the queue is the run with the next row
+    std::vector<pair_t> heads(runs.size());
+    std::priority_queue<size_t, std::vector<size_t>, std::function<bool(size_t, size_t)> > queue(
+        [this, &heads](size_t left, size_t right) { return before(heads[right], heads[left]); });
+    for (size_t run = 0; run < runs.size(); ++run) {
+      if (read(*runs[run], heads[run]))
+        queue.push(run);
+    }
+    while (!queue.empty()) {
+      const size_t run = queue.top();
+      queue.pop();
+      r->push_back(heads[run].row);
+      if (read(*runs[run], heads[run]))
+        queue.push(run);
+    }
+    return r.release();
+  }
 };
 
+template <typename T, template<typename> class ExtractFunctor>
+const size_t ColumnSorter<T, ExtractFunctor>::min_run_rows;
+
 namespace {
   auto _ = QueryParser::registerPlanOperation<SortScan>("SortScan");
 }
@@ -90,7 +289,7 @@ SortScan::~SortScan() {
 void SortScan::executePlanOperation() {
   const auto& table = input.getTable(0);
   // Sorted Position List
-  std::vector<pos_t> *sorted_pos;
+  pos_list_t *sorted_pos;
 
   // When table is not only a table but also using an ordered dictionary on sort field,
   // we can just sort by value_id
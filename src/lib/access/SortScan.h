@@ -7,6 +7,9 @@
 namespace hyrise {
 namespace access {
 
+/// Sorts the input table by one column. Tables whose sort values do not
+/// fit into the memory limit of the query are sorted externally in runs
+/// spilled to disk, see memory/SpillFile.h.
 class SortScan : public PlanOperation {
 public:
   virtual ~SortScan();
@@ -1,10 +1,14 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/TableScan.h"
 
+#include <algorithm>
+
 #include "access/expressions/ExampleExpression.h"
 #include "access/expressions/pred_SimpleExpression.h"
 #include "access/expressions/ExpressionRegistration.h"
+#include "access/system/OperationData-Impl.h"
 #include "storage/AbstractTable.h"
+#include "storage/JoinFilter.h"
 #include "storage/PointerCalculator.h"
 #include "storage/TableRangeView.h"
 #include "helper/types.h"
@@ -44,18 +48,29 @@ void TableScan::executePlanOperation() {
   else
     positions = new pos_list_t();
 
-  std::shared_ptr<PointerCalculator> result;
-
-  if(tablerange)
-    result = PointerCalculator::create(tablerange->getActualTable(), positions);
-  else
-    result = PointerCalculator::create(getInputTable(), positions);
-
-  addResult(result);
+  const auto& table = tablerange ? tablerange->getActualTable() : getInputTable();
+  const storage::JoinFilterProbe join_filter(input.allOf<storage::JoinFilter>(), table, _join_filter_fields);
+  if (!join_filter.empty()) {
+    positions->erase(std::remove_if(positions->begin(), positions->end(),
+                                    [&join_filter] (const pos_t row) { return !join_filter(row); }),
+                     positions->end());
+  }
+  addResult(PointerCalculator::create(table, positions));
 }
 
 std::shared_ptr<PlanOperation> TableScan::parse(const Json::Value& data) {
-  return std::make_shared<TableScan>(Expressions::parse(data["expression"].asString(), data));
+  auto scan = std::make_shared<TableScan>(Expressions::parse(data["expression"].asString(), data));
+  if (data.isMember("joinFilterFields")) {
+    field_list_t fields;
+    for (unsigned i = 0; i < data["joinFilterFields"].size(); ++i)
+      fields.push_back(data["joinFilterFields"][i].asUInt());
+    scan->setJoinFilterFields(fields);
+  }
+  return scan;
+}
+
+void TableScan::setJoinFilterFields(const field_list_t& fields) {
+  _join_filter_fields = fields;
 }
 
 }}
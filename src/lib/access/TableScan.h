@@ -10,6 +10,9 @@ namespace hyrise { namespace access {
 class AbstractExpression;
 
 /// Implements registration based expression scan
+///
+/// Join filters routed into the scan from HashBuild ("joinFilter": true)
+/// are applied to the matches on "joinFilterFields".
 class TableScan : public ParallelizablePlanOperation {
  public:
   /// Construct TableScan for a specific expression, take
@@ -18,11 +21,13 @@ class TableScan : public ParallelizablePlanOperation {
   /// Parse TableScan from 
   const std::string vname() { return "TableScan"; }
   static std::shared_ptr<PlanOperation> parse(const Json::Value& data);
+  void setJoinFilterFields(const field_list_t& fields);
  protected:
   void setupPlanOperation();
   void executePlanOperation();
  private:
   std::unique_ptr<AbstractExpression> _expr;
+  field_list_t _join_filter_fields;
 };
 
 }}
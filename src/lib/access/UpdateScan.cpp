@@ -1,6 +1,8 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "access/UpdateScan.h"
 
+#include "io/TransactionManager.h"
+
 #include "storage/Store.h"
 
 namespace hyrise {
@@ -28,7 +30,7 @@ void UpdateScan::executePlanOperation() {
     for (size_t i = 0; i < _data->columnCount(); i++) {
       auto src_field = _data->metadataAt(i);
 
-      for (size_t j = 0; i < input.getTable(0)->columnCount(); j++) {
+      for (size_t j = 0; j < input.getTable(0)->columnCount(); j++) {
         auto tgt_field = input.getTable(0)->metadataAt(j);
 
         if (tgt_field->matches(src_field)) {
@@ -43,34 +45,40 @@ void UpdateScan::executePlanOperation() {
     }
   }
 
-  std::map<int, int>::iterator it;
-
   auto s = std::dynamic_pointer_cast<const storage::Store>(input.getTable(0));
 
   if (!s) {
     throw std::runtime_error("Updates not supported for non delta structures");
   }
 
-  size_t delta_row = s->getDeltaTable()->size();
+  // Cast the constness away
+  auto store = std::const_pointer_cast<storage::Store>(s);
 
+  pos_list_t rows;
   for (size_t row = 0; row < input_size; ++row) {
     // Execute the predicate on the list
     if ((*_comparator)(row)) {
       if (_func != nullptr) {
         _func->updateRow(row);
       } else {
-        for (it = mapping.begin(); it != mapping.end(); it++) {
-          int src = (*it).first;
-          int tgt = (*it).second;
-
-          // Update the delta
-          s->getDeltaTable()->copyRowFrom(s, row, delta_row, true);
-          s->getDeltaTable()->copyValueFrom(_data, src, 0, tgt, delta_row++);
-        }
+        rows.push_back(row);
       }
     }
   }
 
+  // Write the updated rows through the store, so the zone maps and
+  // indexes of the delta cover them
+  const auto& beforSize = store->size();
+  auto writeArea = store->appendToDelta(rows.size());
+  auto& mods = tx::TransactionManager::getInstance()[_txContext.tid];
+  for (size_t i = 0; i < rows.size(); ++i) {
+    store->copyRowToDelta(store, rows[i], writeArea.first + i, _txContext.tid);
+    for (const auto& kv : mapping)
+      store->copyValueFrom(_data, kv.first, 0, kv.second, beforSize + i);
+    mods.insertPos(store, beforSize + i);
+  }
+  store->indexDelta(writeArea.first, writeArea.second);
+
   addResult(input.getTable(0));
 }
 
@@ -0,0 +1,323 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/expressions/ArithmeticExpression.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "storage/AbstractTable.h"
+#include "storage/ColumnAccessor.h"
+#include "storage/ColumnMetadata.h"
+
+namespace hyrise { namespace access {
+
+namespace {
+
+typedef std::unique_ptr<ArithmeticExpression> expression_ptr_t;
+
+void toFloat(ExpressionValues &values) {
+  if (values.type == FloatType)
+    return;
+  values.floats.assign(values.ints.begin(), values.ints.end());
+  values.type = FloatType;
+}
+
+void toInteger(ExpressionValues &values) {
+  if (values.type == IntegerType)
+    return;
+  values.ints.resize(values.floats.size());
+  for (size_t i = 0; i < values.floats.size(); ++i)
+    values.ints[i] = static_cast<storage::hyrise_int_t>(values.floats[i]);
+  values.type = IntegerType;
+}
+
+void convert(ExpressionValues &values, const DataType type) {
+  if (type == FloatType)
+    toFloat(values);
+  else
+    toInteger(values);
+}
+
+// Replaces the values with 1 where they are not zero
+void toTruth(ExpressionValues &values) {
+  if (values.type == FloatType) {
+    values.ints.resize(values.floats.size());
+    for (size_t i = 0; i < values.floats.size(); ++i)
+      values.ints[i] = values.floats[i] != 0;
+    values.type = IntegerType;
+  } else {
+    for (auto& value : values.ints)
+      value = value != 0;
+  }
+}
+
+DataType parseType(const std::string &name) {
+  if (name == STR_TYPE_INTEGER)
+    return IntegerType;
+  if (name == STR_TYPE_FLOAT)
+    return FloatType;
+  throw std::runtime_error("Expressions can only be cast to " STR_TYPE_INTEGER " or " STR_TYPE_FLOAT ", not " + name);
+}
+
+class ColumnReference : public ArithmeticExpression {
+ public:
+  explicit ColumnReference(const Json::Value &column) : _column(column) {}
+
+  void walk(const storage::c_atable_ptr_t &table) {
+    const storage::field_t field = _column.isString() ? table->numberOfColumn(_column.asString()) : _column.asUInt();
+    _type = table->metadataAt(field)->getType();
+    if (_type == IntegerType)
+      _ints.reset(new storage::ColumnAccessor<storage::hyrise_int_t>(table, field));
+    else if (_type == FloatType)
+      _floats.reset(new storage::ColumnAccessor<storage::hyrise_float_t>(table, field));
+    else
+      throw std::runtime_error("Expressions cannot compute on column " + table->nameOfColumn(field) + " of type " STR_TYPE_STRING);
+  }
+
+  DataType getType() const {
+    return _type;
+  }
+
+  void evaluate(const storage::pos_list_t &rows, ExpressionValues &values) const {
+    values.type = _type;
+    if (_type == IntegerType)
+      _ints->gather(rows, values.ints);
+    else
+      _floats->gather(rows, values.floats);
+  }
+
+ private:
+  Json::Value _column;
+  DataType _type;
+  std::unique_ptr<storage::ColumnAccessor<storage::hyrise_int_t> > _ints;
+  std::unique_ptr<storage::ColumnAccessor<storage::hyrise_float_t> > _floats;
+};
+
+class Constant : public ArithmeticExpression {
+ public:
+  explicit Constant(const Json::Value &value) :
+      _type(value.type() == Json::realValue ? FloatType : IntegerType),
+      _int(_type == IntegerType ? value.asInt64() : 0),
+      _float(value.asFloat()) {}
+
+  void walk(const storage::c_atable_ptr_t &table) {}
+
+  DataType getType() const {
+    return _type;
+  }
+
+  void evaluate(const storage::pos_list_t &rows, ExpressionValues &values) const {
+    values.type = _type;
+    if (_type == IntegerType)
+      values.ints.assign(rows.size(), _int);
+    else
+      values.floats.assign(rows.size(), _float);
+  }
+
+ private:
+  DataType _type;
+  storage::hyrise_int_t _int;
+  storage::hyrise_float_t _float;
+};
+
+enum Operator {
+  Add,
+  Subtract,
+  Multiply,
+  Divide,
+  Equal,
+  NotEqual,
+  Less,
+  LessEqual,
+  Greater,
+  GreaterEqual,
+  And,
+  Or
+};
+
+Operator parseOperator(const std::string &op) {
+  static const std::vector<std::pair<std::string, Operator> > operators {
+    {"+", Add}, {"-", Subtract}, {"*", Multiply}, {"/", Divide},
+    {"=", Equal}, {"!=", NotEqual}, {"<", Less}, {"<=", LessEqual},
+    {">", Greater}, {">=", GreaterEqual}, {"AND", And}, {"OR", Or}
+  };
+  for (const auto& candidate : operators) {
+    if (candidate.first == op)
+      return candidate.second;
+  }
+  throw std::runtime_error("Unknown operator in expression: " + op);
+}
+
+// Applies `op` element-wise; `result` may alias `left`
+template <typename T, typename R, typename Op>
+void combine(const std::vector<T> &left, const std::vector<T> &right, std::vector<R> &result, Op op) {
+  result.resize(left.size());
+  for (size_t i = 0; i < left.size(); ++i)
+    result[i] = op(left[i], right[i]);
+}
+
+template <typename T, typename R>
+void apply(const Operator op, const std::vector<T> &left, const std::vector<T> &right, std::vector<R> &result) {
+  switch (op) {
+    case Add: combine(left, right, result, [](T l, T r) { return l + r; }); break;
+    case Subtract: combine(left, right, result, [](T l, T r) { return l - r; }); break;
+    case Multiply: combine(left, right, result, [](T l, T r) { return l * r; }); break;
+    case Divide: combine(left, right, result, [](T l, T r) { return l / r; }); break;
+    case Equal: combine(left, right, result, [](T l, T r) { return l == r; }); break;
+    case NotEqual: combine(left, right, result, [](T l, T r) { return l != r; }); break;
+    case Less: combine(left, right, result, [](T l, T r) { return l < r; }); break;
+    case LessEqual: combine(left, right, result, [](T l, T r) { return l <= r; }); break;
+    case Greater: combine(left, right, result, [](T l, T r) { return l > r; }); break;
+    case GreaterEqual: combine(left, right, result, [](T l, T r) { return l >= r; }); break;
+    case And: combine(left, right, result, [](T l, T r) { return l && r; }); break;
+    case Or: combine(left, right, result, [](T l, T r) { return l || r; }); break;
+  }
+}
+
+class BinaryOperation : public ArithmeticExpression {
+ public:
+  BinaryOperation(const Operator op, expression_ptr_t left, expression_ptr_t right) :
+      _op(op), _left(std::move(left)), _right(std::move(right)) {}
+
+  void walk(const storage::c_atable_ptr_t &table) {
+    _left->walk(table);
+    _right->walk(table);
+    _operands = (_op == And || _op == Or) ? IntegerType :
+                (_left->getType() == FloatType || _right->getType() == FloatType) ? FloatType : IntegerType;
+    _type = _op <= Divide ? _operands : IntegerType;
+  }
+
+  DataType getType() const {
+    return _type;
+  }
+
+  void evaluate(const storage::pos_list_t &rows, ExpressionValues &values) const {
+    ExpressionValues right;
+    _left->evaluate(rows, values);
+    _right->evaluate(rows, right);
+
+    if (_op == And || _op == Or) {
+      toTruth(values);
+      toTruth(right);
+    } else {
+      convert(values, _operands);
+      convert(right, _operands);
+    }
+
+    if (_operands == FloatType) {
+      if (_type == FloatType)
+        apply(_op, values.floats, right.floats, values.floats);
+      else
+        apply(_op, values.floats, right.floats, values.ints);
+    } else {
+      if (_op == Divide && std::find(right.ints.begin(), right.ints.end(), 0) != right.ints.end())
+        throw std::runtime_error("Integer division by zero in expression");
+      apply(_op, values.ints, right.ints, values.ints);
+    }
+    values.type = _type;
+  }
+
+ private:
+  Operator _op;
+  expression_ptr_t _left;
+  expression_ptr_t _right;
+  DataType _operands;
+  DataType _type;
+};
+
+class Case : public ArithmeticExpression {
+ public:
+  Case(std::vector<std::pair<expression_ptr_t, expression_ptr_t> > cases, expression_ptr_t otherwise) :
+      _cases(std::move(cases)), _otherwise(std::move(otherwise)) {}
+
+  void walk(const storage::c_atable_ptr_t &table) {
+    _otherwise->walk(table);
+    _type = _otherwise->getType();
+    for (const auto& c : _cases) {
+      c.first->walk(table);
+      c.second->walk(table);
+      if (c.second->getType() == FloatType)
+        _type = FloatType;
+    }
+  }
+
+  DataType getType() const {
+    return _type;
+  }
+
+  void evaluate(const storage::pos_list_t &rows, ExpressionValues &values) const {
+    _otherwise->evaluate(rows, values);
+    convert(values, _type);
+
+    // Later cases are overwritten by earlier ones
+    ExpressionValues when, then;
+    for (auto c = _cases.rbegin(); c != _cases.rend(); ++c) {
+      c->first->evaluate(rows, when);
+      toTruth(when);
+      c->second->evaluate(rows, then);
+      convert(then, _type);
+      if (_type == FloatType)
+        select(when.ints, then.floats, values.floats);
+      else
+        select(when.ints, then.ints, values.ints);
+    }
+  }
+
+ private:
+  template <typename T>
+  static void select(const std::vector<storage::hyrise_int_t> &when, const std::vector<T> &then, std::vector<T> &values) {
+    for (size_t i = 0; i < values.size(); ++i)
+      values[i] = when[i] ? then[i] : values[i];
+  }
+
+  std::vector<std::pair<expression_ptr_t, expression_ptr_t> > _cases;
+  expression_ptr_t _otherwise;
+  DataType _type;
+};
+
+class Cast : public ArithmeticExpression {
+ public:
+  Cast(const DataType type, expression_ptr_t of) : _type(type), _of(std::move(of)) {}
+
+  void walk(const storage::c_atable_ptr_t &table) {
+    _of->walk(table);
+  }
+
+  DataType getType() const {
+    return _type;
+  }
+
+  void evaluate(const storage::pos_list_t &rows, ExpressionValues &values) const {
+    _of->evaluate(rows, values);
+    convert(values, _type);
+  }
+
+ private:
+  DataType _type;
+  expression_ptr_t _of;
+};
+
+}
+
+std::unique_ptr<ArithmeticExpression> ArithmeticExpression::parse(const Json::Value &data) {
+  if (data.isMember("column"))
+    return expression_ptr_t(new ColumnReference(data["column"]));
+  if (data.isMember("value"))
+    return expression_ptr_t(new Constant(data["value"]));
+  if (!data.isMember("op"))
+    throw std::runtime_error("Expression needs a column, a value or an op");
+
+  const std::string op = data["op"].asString();
+  if (op == "CASE") {
+    std::vector<std::pair<expression_ptr_t, expression_ptr_t> > cases;
+    for (unsigned i = 0; i < data["cases"].size(); ++i)
+      cases.emplace_back(parse(data["cases"][i]["when"]), parse(data["cases"][i]["then"]));
+    return expression_ptr_t(new Case(std::move(cases), parse(data["else"])));
+  }
+  if (op == "CAST")
+    return expression_ptr_t(new Cast(parseType(data["to"].asString()), parse(data["of"])));
+  return expression_ptr_t(new BinaryOperation(parseOperator(op), parse(data["left"]), parse(data["right"])));
+}
+
+}}
@@ -0,0 +1,52 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_EXPRESSIONS_ARITHMETICEXPRESSION_H_
+#define SRC_LIB_ACCESS_EXPRESSIONS_ARITHMETICEXPRESSION_H_
+
+#include <memory>
+#include <vector>
+
+#include "json.h"
+
+#include "helper/types.h"
+#include "storage/storage_types.h"
+
+namespace hyrise { namespace access {
+
+/// Values of an expression for a batch of rows, either integers or floats
+struct ExpressionValues {
+  DataType type = IntegerType;
+  std::vector<storage::hyrise_int_t> ints;
+  std::vector<storage::hyrise_float_t> floats;
+};
+
+/// Expression tree over integer and float columns that computes a new
+/// column a batch of rows at a time. Every node fills a plain vector for
+/// the whole batch, so the operators run as simple loops over arrays.
+///
+/// Trees are parsed from JSON:
+///  - {"column": 3} or {"column": "price"}
+///  - {"value": 1} (integer) or {"value": 0.5} (float)
+///  - {"op": "+", "left": ..., "right": ...} with the operators
+///    + - * / = != < <= > >= AND OR; comparisons and AND/OR yield 0 or 1
+///  - {"op": "CASE", "cases": [{"when": ..., "then": ...}], "else": ...}
+///  - {"op": "CAST", "to": "FLOAT", "of": ...}
+/// Integer operands are promoted to float if the other operand is a float.
+class ArithmeticExpression {
+ public:
+  virtual ~ArithmeticExpression() {}
+
+  /// Resolves columns and result types against the input table
+  virtual void walk(const storage::c_atable_ptr_t &table) = 0;
+
+  /// Result type, valid after walk()
+  virtual DataType getType() const = 0;
+
+  /// Computes the values for the table rows in `rows`
+  virtual void evaluate(const storage::pos_list_t &rows, ExpressionValues &values) const = 0;
+
+  static std::unique_ptr<ArithmeticExpression> parse(const Json::Value &data);
+};
+
+}}
+
+#endif  // SRC_LIB_ACCESS_EXPRESSIONS_ARITHMETICEXPRESSION_H_
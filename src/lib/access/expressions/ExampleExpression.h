@@ -6,7 +6,7 @@
 
 #include "access/expressions/AbstractExpression.h"
 #include "helper/types.h"
-#include "storage/FixedLengthVector.h"
+#include "storage/BaseAttributeVector.h"
 #include "storage/OrderPreservingDictionary.h"
 #include "storage/storage_types.h"
 
@@ -14,7 +14,7 @@ namespace hyrise { namespace access {
 
 class ExampleExpression : public AbstractExpression {
   storage::c_atable_ptr_t _table;
-  std::shared_ptr<FixedLengthVector<value_id_t>> _vector;
+  std::shared_ptr<BaseAttributeVector<value_id_t>> _vector;
   std::shared_ptr<OrderPreservingDictionary<hyrise_int_t>> _dict;
   const size_t _column;
   const hyrise_int_t _value;
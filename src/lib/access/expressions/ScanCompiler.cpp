@@ -0,0 +1,387 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifdef WITH_LLVM
+
+#include "access/expressions/ScanCompiler.h"
+
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Target/TargetMachine.h>
+
+#include "storage/BitCompressedVector.h"
+#include "storage/ConcurrentFixedLengthVector.h"
+#include "storage/FixedLengthVector.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+
+typedef BaseAttributeVector<storage::value_id_t> vector_t;
+typedef FixedLengthVector<storage::value_id_t> fixed_t;
+typedef BitCompressedVector<storage::value_id_t> compressed_t;
+typedef ConcurrentFixedLengthVector<storage::value_id_t> concurrent_t;
+
+static_assert(sizeof(storage::pos_t) == sizeof(uint64_t), "Generated scans write positions as 64 bit integers");
+
+// Readers the generated code calls for vectors it cannot read in place
+storage::value_id_t concurrentValueId(const void *vector, const uint64_t column, const uint64_t row) {
+  return static_cast<const concurrent_t *>(vector)->concurrent_t::getRef(column, row);
+}
+
+storage::value_id_t genericValueId(const void *vector, const uint64_t column, const uint64_t row) {
+  return static_cast<const vector_t *>(vector)->get(column, row);
+}
+
+const char *const concurrent_reader = "hyrise_concurrent_value_id";
+const char *const generic_reader = "hyrise_value_id";
+
+template <typename T>
+T check(llvm::Expected<T> value) {
+  if (!value)
+    throw std::runtime_error("Cannot compile scan: " + llvm::toString(value.takeError()));
+  return std::move(*value);
+}
+
+void check(llvm::Error error) {
+  if (error)
+    throw std::runtime_error("Cannot compile scan: " + llvm::toString(std::move(error)));
+}
+
+// Emits the loop of a plan into a module
+class ScanEmitter {
+ public:
+  ScanEmitter(llvm::Module &module, const ScanPlan &plan) :
+      _module(module), _plan(plan), _builder(module.getContext()) {}
+
+  void emit(const std::string &name) {
+    auto &context = _module.getContext();
+    const auto i64 = _builder.getInt64Ty();
+    const auto type = llvm::FunctionType::get(i64, {_builder.getInt8PtrTy(), i64, i64, i64,
+                                                    llvm::PointerType::getUnqual(i64)}, false);
+    const auto function = llvm::Function::Create(type, llvm::Function::ExternalLinkage, name, _module);
+    auto argument = function->arg_begin();
+    _columns = &*argument++;
+    const auto begin = &*argument++;
+    const auto end = &*argument++;
+    const auto base = &*argument++;
+    const auto rows = &*argument;
+
+    const auto entry = llvm::BasicBlock::Create(context, "entry", function);
+    const auto loop = llvm::BasicBlock::Create(context, "loop", function);
+    const auto exit = llvm::BasicBlock::Create(context, "exit", function);
+
+    // The arguments of all comparisons are loaded once
+    _builder.SetInsertPoint(entry);
+    for (size_t c = 0; c < _plan.comparisons.size(); ++c)
+      _arguments.push_back(loadArguments(c));
+    _builder.CreateCondBr(_builder.CreateICmpULT(begin, end), loop, exit);
+
+    _builder.SetInsertPoint(loop);
+    const auto row = _builder.CreatePHI(i64, 2, "row");
+    const auto count = _builder.CreatePHI(i64, 2, "count");
+    row->addIncoming(begin, entry);
+    count->addIncoming(_builder.getInt64(0), entry);
+
+    std::vector<llvm::Value *> stack;
+    for (const auto &step : _plan.steps) {
+      switch (step.first) {
+        case ScanPlan::Compare:
+          stack.push_back(compare(step.second, row));
+          break;
+        case ScanPlan::And: {
+          const auto right = stack.back();
+          stack.pop_back();
+          stack.back() = _builder.CreateAnd(stack.back(), right);
+          break;
+        }
+        case ScanPlan::Or: {
+          const auto right = stack.back();
+          stack.pop_back();
+          stack.back() = _builder.CreateOr(stack.back(), right);
+          break;
+        }
+        case ScanPlan::Not:
+          stack.back() = _builder.CreateNot(stack.back());
+          break;
+      }
+    }
+
+    // Every row is written, only the count of passing rows advances
+    _builder.CreateStore(_builder.CreateAdd(base, row), _builder.CreateGEP(i64, rows, count));
+    const auto next_count = _builder.CreateAdd(count, _builder.CreateZExt(stack.back(), i64));
+    const auto next_row = _builder.CreateAdd(row, _builder.getInt64(1));
+    row->addIncoming(next_row, loop);
+    count->addIncoming(next_count, loop);
+    _builder.CreateCondBr(_builder.CreateICmpULT(next_row, end), loop, exit);
+
+    _builder.SetInsertPoint(exit);
+    const auto result = _builder.CreatePHI(i64, 2);
+    result->addIncoming(_builder.getInt64(0), entry);
+    result->addIncoming(next_count, loop);
+    _builder.CreateRet(result);
+
+    if (llvm::verifyFunction(*function))
+      throw std::runtime_error("Generated scan " + name + " is invalid");
+  }
+
+ private:
+  struct Arguments {
+    llvm::Value *data;
+    llvm::Value *stride;
+    llvm::Value *offset;
+    llvm::Value *width;
+    llvm::Value *mask;
+    llvm::Value *lo;
+    // hi - lo for ranges
+    llvm::Value *range;
+    llvm::Value *bitmap;
+    llvm::Value *bitmap_size;
+  };
+
+  // Field of the ScanColumn of comparison c at byte offset `field`
+  llvm::Value *load(const size_t c, const size_t field, llvm::Type *type) {
+    const auto address = _builder.CreateConstInBoundsGEP1_64(_builder.getInt8Ty(), _columns,
+                                                             c * sizeof(ScanColumn) + field);
+    return _builder.CreateLoad(type, _builder.CreateBitCast(address, llvm::PointerType::getUnqual(type)));
+  }
+
+  Arguments loadArguments(const size_t c) {
+    const auto i64 = _builder.getInt64Ty();
+    const auto i32 = _builder.getInt32Ty();
+    Arguments arguments;
+    arguments.data = load(c, offsetof(ScanColumn, data), _builder.getInt8PtrTy());
+    arguments.stride = load(c, offsetof(ScanColumn, stride), i64);
+    arguments.offset = load(c, offsetof(ScanColumn, offset), i64);
+    arguments.width = load(c, offsetof(ScanColumn, width), i64);
+    arguments.mask = load(c, offsetof(ScanColumn, mask), i64);
+    arguments.lo = _builder.CreateTrunc(load(c, offsetof(ScanColumn, lo), i64), i32);
+    const auto hi = _builder.CreateTrunc(load(c, offsetof(ScanColumn, hi), i64), i32);
+    arguments.range = _builder.CreateSub(hi, arguments.lo);
+    arguments.bitmap = load(c, offsetof(ScanColumn, bitmap), _builder.getInt8PtrTy());
+    arguments.bitmap_size = load(c, offsetof(ScanColumn, bitmap_size), i64);
+    return arguments;
+  }
+
+  // Value id of comparison c in `row`
+  llvm::Value *read(const size_t c, llvm::Value *row) {
+    const auto i64 = _builder.getInt64Ty();
+    const auto i32 = _builder.getInt32Ty();
+    const auto &arguments = _arguments[c];
+    switch (_plan.comparisons[c].first) {
+      case ScanColumn::Fixed: {
+        const auto values = _builder.CreateBitCast(arguments.data, llvm::PointerType::getUnqual(i32));
+        const auto index = _builder.CreateAdd(_builder.CreateMul(row, arguments.stride), arguments.offset);
+        return _builder.CreateLoad(i32, _builder.CreateGEP(i32, values, index));
+      }
+      case ScanColumn::BitCompressed: {
+        // Same layout as BitCompressedVector::get, the value may continue
+        // in the next block
+        const auto blocks = _builder.CreateBitCast(arguments.data, llvm::PointerType::getUnqual(i64));
+        const auto position = _builder.CreateAdd(_builder.CreateMul(row, arguments.stride), arguments.offset);
+        const auto block = _builder.CreateLShr(position, 6);
+        const auto shift = _builder.CreateAnd(position, 63);
+        const auto spills = _builder.CreateICmpUGT(_builder.CreateAdd(shift, arguments.width), _builder.getInt64(64));
+        const auto first = _builder.CreateLoad(i64, _builder.CreateGEP(i64, blocks, block));
+        const auto next = _builder.CreateAdd(block, _builder.CreateZExt(spills, i64));
+        const auto second = _builder.CreateLoad(i64, _builder.CreateGEP(i64, blocks, next));
+        const auto high = _builder.CreateShl(second, _builder.CreateAnd(_builder.CreateSub(_builder.getInt64(64), shift), 63));
+        auto value = _builder.CreateLShr(first, shift);
+        value = _builder.CreateOr(value, _builder.CreateSelect(spills, high, _builder.getInt64(0)));
+        return _builder.CreateTrunc(_builder.CreateAnd(value, arguments.mask), i32);
+      }
+      case ScanColumn::Concurrent:
+        return _builder.CreateCall(reader(concurrent_reader), {arguments.data, arguments.offset, row});
+      case ScanColumn::Generic:
+        return _builder.CreateCall(reader(generic_reader), {arguments.data, arguments.offset, row});
+    }
+    throw std::runtime_error("Unknown attribute vector in scan plan");
+  }
+
+  // Whether the value id of comparison c in `row` passes its filter
+  llvm::Value *compare(const size_t c, llvm::Value *row) {
+    const auto &arguments = _arguments[c];
+    const auto id = read(c, row);
+    switch (_plan.comparisons[c].second) {
+      case ValueIdFilter::Equal:
+        return _builder.CreateICmpEQ(id, arguments.lo);
+      case ValueIdFilter::NotEqual:
+        return _builder.CreateICmpNE(id, arguments.lo);
+      case ValueIdFilter::Range:
+        return _builder.CreateICmpULT(_builder.CreateSub(id, arguments.lo), arguments.range);
+      case ValueIdFilter::Bitmap: {
+        // Value ids beyond the bitmap read its first entry and fail
+        const auto index = _builder.CreateZExt(id, _builder.getInt64Ty());
+        const auto inside = _builder.CreateICmpULT(index, arguments.bitmap_size);
+        const auto entry = _builder.CreateSelect(inside, index, _builder.getInt64(0));
+        const auto bit = _builder.CreateLoad(_builder.getInt8Ty(),
+                                             _builder.CreateGEP(_builder.getInt8Ty(), arguments.bitmap, entry));
+        return _builder.CreateAnd(inside, _builder.CreateICmpNE(bit, _builder.getInt8(0)));
+      }
+    }
+    throw std::runtime_error("Unknown filter in scan plan");
+  }
+
+  llvm::FunctionCallee reader(const char *name) {
+    const auto i64 = _builder.getInt64Ty();
+    return _module.getOrInsertFunction(name, _builder.getInt32Ty(), _builder.getInt8PtrTy(), i64, i64);
+  }
+
+  llvm::Module &_module;
+  const ScanPlan &_plan;
+  llvm::IRBuilder<> _builder;
+  llvm::Value *_columns = nullptr;
+  std::vector<Arguments> _arguments;
+};
+
+// The ORC JIT with the compiled loops, keyed by the text of their plan
+class Jit {
+ public:
+  Jit() {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+
+    auto machine = check(llvm::orc::JITTargetMachineBuilder::detectHost());
+    machine.setCodeGenOptLevel(llvm::CodeGenOpt::Aggressive);
+    _target = check(machine.createTargetMachine());
+    _jit = check(llvm::orc::LLJITBuilder().setJITTargetMachineBuilder(std::move(machine)).create());
+    _jit->getIRTransformLayer().setTransform([this](llvm::orc::ThreadSafeModule module,
+                                                    llvm::orc::MaterializationResponsibility &) {
+      module.withModuleDo([this](llvm::Module &m) { optimize(m); });
+      return llvm::Expected<llvm::orc::ThreadSafeModule>(std::move(module));
+    });
+
+    llvm::orc::SymbolMap readers;
+    readers[_jit->mangleAndIntern(concurrent_reader)] =
+        llvm::JITEvaluatedSymbol(llvm::pointerToJITTargetAddress(&concurrentValueId), llvm::JITSymbolFlags::Exported);
+    readers[_jit->mangleAndIntern(generic_reader)] =
+        llvm::JITEvaluatedSymbol(llvm::pointerToJITTargetAddress(&genericValueId), llvm::JITSymbolFlags::Exported);
+    check(_jit->getMainJITDylib().define(llvm::orc::absoluteSymbols(readers)));
+  }
+
+  ScanCompiler::scan_t scan(const ScanPlan &plan) {
+    const std::string key = plan.key();
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto &it = _scans.find(key);
+    if (it != _scans.end())
+      return it->second;
+
+    const std::string name = "scan" + std::to_string(_scans.size());
+    auto context = std::make_unique<llvm::LLVMContext>();
+    auto module = std::make_unique<llvm::Module>(name, *context);
+    module->setDataLayout(_jit->getDataLayout());
+    module->setTargetTriple(_target->getTargetTriple().str());
+    ScanEmitter(*module, plan).emit(name);
+    check(_jit->addIRModule(llvm::orc::ThreadSafeModule(std::move(module), std::move(context))));
+
+    const auto address = check(_jit->lookup(name)).getAddress();
+    const auto scan = llvm::jitTargetAddressToFunction<ScanCompiler::scan_t>(address);
+    _scans[key] = scan;
+    return scan;
+  }
+
+  size_t size() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _scans.size();
+  }
+
+ private:
+  void optimize(llvm::Module &module) {
+    llvm::LoopAnalysisManager loops;
+    llvm::FunctionAnalysisManager functions;
+    llvm::CGSCCAnalysisManager cgscc;
+    llvm::ModuleAnalysisManager modules;
+    llvm::PassBuilder builder(_target.get());
+    builder.registerModuleAnalyses(modules);
+    builder.registerCGSCCAnalyses(cgscc);
+    builder.registerFunctionAnalyses(functions);
+    builder.registerLoopAnalyses(loops);
+    builder.crossRegisterProxies(loops, functions, cgscc, modules);
+    builder.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3).run(module, modules);
+  }
+
+  std::mutex _mutex;
+  std::unique_ptr<llvm::TargetMachine> _target;
+  std::unique_ptr<llvm::orc::LLJIT> _jit;
+  std::unordered_map<std::string, ScanCompiler::scan_t> _scans;
+};
+
+Jit &jit() {
+  static Jit instance;
+  return instance;
+}
+
+}
+
+std::string ScanPlan::key() const {
+  std::string key;
+  for (const auto &comparison : comparisons) {
+    key += "FBCG"[comparison.first];
+    key += "ENRB"[comparison.second];
+  }
+  key += ':';
+  for (const auto &step : steps) {
+    switch (step.first) {
+      case Compare: key += std::to_string(step.second) + ' '; break;
+      case And: key += '&'; break;
+      case Or: key += '|'; break;
+      case Not: key += '!'; break;
+    }
+  }
+  return key;
+}
+
+void ScanCompiler::addComparison(const vector_t *vector, const size_t column, const ValueIdFilter &filter,
+                                 ScanPlan &plan, std::vector<ScanColumn> &columns) {
+  ScanColumn arguments = {};
+  ScanColumn::Vector kind = ScanColumn::Generic;
+  arguments.data = vector;
+  arguments.offset = column;
+  if (const auto fixed = dynamic_cast<const fixed_t *>(vector)) {
+    kind = ScanColumn::Fixed;
+    arguments.data = const_cast<fixed_t *>(fixed)->data();
+    arguments.stride = fixed->columns();
+  } else if (const auto compressed = dynamic_cast<const compressed_t *>(vector)) {
+    kind = ScanColumn::BitCompressed;
+    arguments.data = compressed->blocks();
+    arguments.stride = compressed->tupleWidth();
+    arguments.offset = compressed->columnOffset(column);
+    arguments.width = compressed->bitsForColumn(column);
+    arguments.mask = maxValueForBits<uint64_t>(arguments.width);
+  } else if (dynamic_cast<const concurrent_t *>(vector)) {
+    kind = ScanColumn::Concurrent;
+  }
+
+  // The loop reads the first entry of an empty bitmap
+  static const uint8_t empty = 0;
+  arguments.lo = filter.lo;
+  arguments.hi = filter.hi;
+  arguments.bitmap = filter.bits.empty() ? &empty : filter.bits.data();
+  arguments.bitmap_size = filter.bits.size();
+  plan.comparisons.emplace_back(kind, filter.kind);
+  columns.push_back(arguments);
+}
+
+ScanCompiler::scan_t ScanCompiler::scan(const ScanPlan &plan) {
+  return jit().scan(plan);
+}
+
+size_t ScanCompiler::compiledScans() {
+  return jit().size();
+}
+
+}
+}
+
+#endif  // WITH_LLVM
@@ -0,0 +1,95 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_EXPRESSIONS_SCANCOMPILER_H_
+#define SRC_LIB_ACCESS_EXPRESSIONS_SCANCOMPILER_H_
+
+#ifdef WITH_LLVM
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "access/expressions/ScanKernels.h"
+
+namespace hyrise {
+namespace access {
+
+/// Arguments of one comparison of a generated scan loop, the loop reads
+/// them in this layout
+struct ScanColumn {
+  // Attribute vectors the loop reads in place, other vectors are read
+  // through BaseAttributeVector::get
+  enum Vector {
+    Fixed,
+    BitCompressed,
+    Concurrent,
+    Generic
+  };
+
+  // The value ids of Fixed, the blocks of BitCompressed and the vector
+  // itself for Concurrent and Generic
+  const void *data;
+  // Fixed: value ids per row, BitCompressed: bits per row
+  uint64_t stride;
+  // BitCompressed: first bit of the column in a row, otherwise the column
+  uint64_t offset;
+  // BitCompressed: bit width of the column and its mask
+  uint64_t width;
+  uint64_t mask;
+  // See ValueIdFilter
+  uint64_t lo;
+  uint64_t hi;
+  const uint8_t *bitmap;
+  uint64_t bitmap_size;
+};
+
+/// Vector and filter kind of every comparison of a scan and the steps
+/// that combine them, in postfix order
+struct ScanPlan {
+  enum Step {
+    Compare,
+    And,
+    Or,
+    Not
+  };
+
+  std::vector<std::pair<ScanColumn::Vector, ValueIdFilter::Kind> > comparisons;
+  // Compare takes the index of its comparison
+  std::vector<std::pair<Step, size_t> > steps;
+
+  /// Text of the plan, the compiled loops are cached by its hash
+  std::string key() const;
+};
+
+/// Scan loops generated with LLVM at run time (build with WITH_LLVM=1).
+///
+/// A loop evaluates all comparisons of a plan on every row, reads the
+/// value ids without virtual calls from the attribute vector type of
+/// each comparison and appends the rows that pass without branches. The
+/// values, widths and filters are arguments, so one loop serves all
+/// tables with the same vector types. The loops are compiled with the
+/// ORC JIT and live as long as the process.
+class ScanCompiler {
+ public:
+  /// Writes base + row for the rows in [begin, end) that pass to rows,
+  /// which has room for end - begin rows, and returns their number
+  typedef uint64_t (*scan_t)(const ScanColumn *columns, uint64_t begin, uint64_t end, uint64_t base, uint64_t *rows);
+
+  /// Adds a comparison of `column` of `vector` with `filter` to `plan`
+  /// and its arguments to `columns`. The filter has to outlive the loop.
+  static void addComparison(const BaseAttributeVector<storage::value_id_t> *vector, size_t column,
+                            const ValueIdFilter &filter, ScanPlan &plan, std::vector<ScanColumn> &columns);
+
+  /// Returns the loop of `plan`, compiles it on first use
+  static scan_t scan(const ScanPlan &plan);
+
+  /// Number of compiled loops
+  static size_t compiledScans();
+};
+
+}
+}
+
+#endif  // WITH_LLVM
+
+#endif  // SRC_LIB_ACCESS_EXPRESSIONS_SCANCOMPILER_H_
@@ -0,0 +1,384 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/expressions/ScanKernels.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "storage/BitCompressedVector.h"
+#include "storage/ConcurrentFixedLengthVector.h"
+#include "storage/FixedLengthVector.h"
+#include "storage/FrameOfReferenceVector.h"
+#include "storage/RunLengthVector.h"
+#include "storage/SparseVector.h"
+
+namespace hyrise {
+namespace access {
+
+double ValueIdFilter::selectivity(const size_t size) const {
+  if (size == 0)
+    return 0;
+  switch (kind) {
+    case Equal: return 1.0 / size;
+    case NotEqual: return 1.0 - 1.0 / size;
+    case Range: return lo < hi ? double(hi - lo) / size : 0;
+    case Bitmap: return double(std::count(bits.begin(), bits.end(), 1)) / size;
+  }
+  return 1;
+}
+
+ValueIdFilter::Coverage ValueIdFilter::coverage(const storage::value_id_t min, const storage::value_id_t max) const {
+  if (min > max)
+    return None;
+  switch (kind) {
+    case Equal:
+      return (lo < min || lo > max) ? None : (min == max ? All : Some);
+    case NotEqual:
+      return (lo < min || lo > max) ? All : (min == max ? None : Some);
+    case Range:
+      if (lo >= hi || max < lo || min >= hi)
+        return None;
+      return (lo <= min && max < hi) ? All : Some;
+    case Bitmap: {
+      if (min >= bits.size())
+        return None;
+      const auto first = bits.begin() + min;
+      const auto last = bits.begin() + std::min<size_t>(bits.size(), size_t(max) + 1);
+      if (std::find(first, last, 1) == last)
+        return None;
+      return (max < bits.size() && std::find(first, last, 0) == last) ? All : Some;
+    }
+  }
+  return Some;
+}
+
+namespace {
+
+typedef BaseAttributeVector<storage::value_id_t> vector_t;
+typedef RunLengthVector<storage::value_id_t> run_length_t;
+typedef FrameOfReferenceVector<storage::value_id_t> frame_of_reference_t;
+typedef SparseVector<storage::value_id_t> sparse_t;
+
+// Filters
+
+struct EqualTo {
+  storage::value_id_t id;
+  bool operator()(const storage::value_id_t v) const { return v == id; }
+};
+
+struct NotEqualTo {
+  storage::value_id_t id;
+  bool operator()(const storage::value_id_t v) const { return v != id; }
+};
+
+struct InRange {
+  storage::value_id_t lo;
+  storage::value_id_t width;
+  bool operator()(const storage::value_id_t v) const { return v - lo < width; }
+};
+
+struct InBitmap {
+  const uint8_t *bits;
+  size_t size;
+  bool operator()(const storage::value_id_t v) const { return v < size && bits[v]; }
+};
+
+// Readers
+
+template <typename Vector>
+struct StaticReader {
+  const Vector *vector;
+  size_t column;
+  storage::value_id_t operator()(const size_t row) const { return vector->Vector::get(column, row); }
+};
+
+struct ConcurrentReader {
+  typedef ConcurrentFixedLengthVector<storage::value_id_t> concurrent_t;
+  const concurrent_t *vector;
+  size_t column;
+  storage::value_id_t operator()(const size_t row) const { return vector->concurrent_t::getRef(column, row); }
+};
+
+struct VirtualReader {
+  const vector_t *vector;
+  size_t column;
+  storage::value_id_t operator()(const size_t row) const { return vector->get(column, row); }
+};
+
+// Reads a single column BitCompressedVector whose width is that of W
+template <typename W>
+struct AlignedReader {
+  const W *values;
+  storage::value_id_t operator()(const size_t row) const { return values[row]; }
+};
+
+// Reads one column of a BitCompressedVector with the same layout as
+// BitCompressedVector::get. Width > 0 is the width of a vector with a
+// single column, known at compile time; Width == 0 reads any layout.
+template <uint64_t Width>
+struct PackedReader {
+  const uint64_t *blocks;
+  uint64_t tuple_width;
+  uint64_t column_offset;
+  uint64_t bits;
+
+  storage::value_id_t operator()(const size_t row) const {
+    const uint64_t width = Width ? Width : bits;
+    const uint64_t position = (Width ? Width : tuple_width) * row + (Width ? 0 : column_offset);
+    const uint64_t block = position / 64;
+    const uint64_t offset = position % 64;
+    uint64_t result = blocks[block] >> offset;
+    if (offset + width > 64)
+      result |= blocks[block + 1] << (64 - offset);
+    return width >= 64 ? result : result & ((1ull << width) - 1ull);
+  }
+};
+
+// Kernels
+
+template <typename Reader, typename Filter>
+void scan(const Reader &read, const Filter &pass, const size_t begin, const size_t end,
+          const storage::pos_t base, storage::pos_list_t &positions) {
+  for (size_t row = begin; row < end; ++row) {
+    if (pass(read(row)))
+      positions.push_back(base + row);
+  }
+}
+
+template <typename Reader, typename Filter>
+void refine(const Reader &read, const Filter &pass, const storage::pos_t base,
+            storage::pos_list_t &positions, const size_t from) {
+  size_t kept = from;
+  for (size_t i = from; i < positions.size(); ++i) {
+    const storage::pos_t position = positions[i];
+    positions[kept] = position;
+    kept += pass(read(position - base));
+  }
+  positions.resize(kept);
+}
+
+template <typename Reader, typename Filter>
+void mask(const Reader &read, const Filter &pass, const size_t begin, const size_t end, uint8_t *mask) {
+  for (size_t row = begin; row < end; ++row)
+    mask[row - begin] = pass(read(row));
+}
+
+struct ScanKernel {
+  size_t begin;
+  size_t end;
+  storage::pos_t base;
+  storage::pos_list_t &positions;
+
+  template <typename Reader, typename Filter>
+  void operator()(const Reader &read, const Filter &pass) {
+    scan(read, pass, begin, end, base, positions);
+  }
+};
+
+struct RefineKernel {
+  storage::pos_t base;
+  storage::pos_list_t &positions;
+  size_t from;
+
+  template <typename Reader, typename Filter>
+  void operator()(const Reader &read, const Filter &pass) {
+    refine(read, pass, base, positions, from);
+  }
+};
+
+struct MaskKernel {
+  size_t begin;
+  size_t end;
+  uint8_t *values;
+
+  template <typename Reader, typename Filter>
+  void operator()(const Reader &read, const Filter &pass) {
+    mask(read, pass, begin, end, values);
+  }
+};
+
+// Dispatch on the filter, then on the vector
+
+template <typename Kernel, typename Reader>
+void withFilter(const Reader &read, const ValueIdFilter &filter, Kernel &kernel) {
+  switch (filter.kind) {
+    case ValueIdFilter::Equal:
+      kernel(read, EqualTo{filter.lo});
+      break;
+    case ValueIdFilter::NotEqual:
+      kernel(read, NotEqualTo{filter.lo});
+      break;
+    case ValueIdFilter::Range:
+      kernel(read, InRange{filter.lo, filter.lo < filter.hi ? filter.hi - filter.lo : 0});
+      break;
+    case ValueIdFilter::Bitmap:
+      kernel(read, InBitmap{filter.bits.data(), filter.bits.size()});
+      break;
+  }
+}
+
+// Finds the instantiation for `width` among the widths 1 to Width
+template <uint64_t Width>
+struct PackedDispatch {
+  template <typename Kernel>
+  static void call(const uint64_t *blocks, const uint64_t width, const ValueIdFilter &filter, Kernel &kernel) {
+    if (width == Width)
+      withFilter(PackedReader<Width>{blocks, Width, 0, Width}, filter, kernel);
+    else
+      PackedDispatch<Width - 1>::call(blocks, width, filter, kernel);
+  }
+};
+
+template <>
+struct PackedDispatch<0> {
+  template <typename Kernel>
+  static void call(const uint64_t *blocks, const uint64_t width, const ValueIdFilter &filter, Kernel &kernel) {
+    withFilter(PackedReader<0>{blocks, width, 0, width}, filter, kernel);
+  }
+};
+
+template <typename Kernel>
+void withVector(const vector_t *vector, const size_t column, const ValueIdFilter &filter, Kernel &kernel) {
+  typedef FixedLengthVector<storage::value_id_t> fixed_t;
+  typedef BitCompressedVector<storage::value_id_t> compressed_t;
+  typedef ConcurrentFixedLengthVector<storage::value_id_t> concurrent_t;
+
+  if (const auto fixed = dynamic_cast<const fixed_t *>(vector)) {
+    withFilter(StaticReader<fixed_t>{fixed, column}, filter, kernel);
+  } else if (const auto compressed = dynamic_cast<const compressed_t *>(vector)) {
+    const uint64_t bits = compressed->bitsForColumn(column);
+    if (const auto bytes = compressed->aligned<uint8_t>())
+      withFilter(AlignedReader<uint8_t>{bytes}, filter, kernel);
+    else if (const auto shorts = compressed->aligned<uint16_t>())
+      withFilter(AlignedReader<uint16_t>{shorts}, filter, kernel);
+    else if (compressed->tupleWidth() == bits)
+      PackedDispatch<8 * sizeof(storage::value_id_t)>::call(compressed->blocks(), bits, filter, kernel);
+    else
+      withFilter(PackedReader<0>{compressed->blocks(), compressed->tupleWidth(), compressed->columnOffset(column), bits},
+                 filter, kernel);
+  } else if (const auto concurrent = dynamic_cast<const concurrent_t *>(vector)) {
+    withFilter(ConcurrentReader{concurrent, column}, filter, kernel);
+  } else if (const auto runs = dynamic_cast<const run_length_t *>(vector)) {
+    withFilter(StaticReader<run_length_t>{runs, column}, filter, kernel);
+  } else if (const auto frames = dynamic_cast<const frame_of_reference_t *>(vector)) {
+    withFilter(StaticReader<frame_of_reference_t>{frames, column}, filter, kernel);
+  } else if (const auto sparse = dynamic_cast<const sparse_t *>(vector)) {
+    withFilter(StaticReader<sparse_t>{sparse, column}, filter, kernel);
+  } else {
+    withFilter(VirtualReader{vector, column}, filter, kernel);
+  }
+}
+
+// Scans of encoded vectors evaluate the filter once per run, once per
+// block whose smallest and largest value id pass completely or not at
+// all, and once for the default value of sparse columns
+
+struct PositionOutput {
+  storage::pos_t base;
+  storage::pos_list_t &positions;
+
+  void fill(const size_t first, const size_t last, const bool pass) {
+    for (size_t row = first; pass && row < last; ++row)
+      positions.push_back(base + row);
+  }
+
+  template <typename Reader>
+  void check(const Reader &read, const ValueIdFilter &filter, const size_t first, const size_t last) {
+    ScanKernel kernel{first, last, base, positions};
+    withFilter(read, filter, kernel);
+  }
+};
+
+struct MaskOutput {
+  size_t begin;
+  uint8_t *values;
+
+  void fill(const size_t first, const size_t last, const bool pass) {
+    if (first < last)
+      std::memset(values + first - begin, pass, last - first);
+  }
+
+  template <typename Reader>
+  void check(const Reader &read, const ValueIdFilter &filter, const size_t first, const size_t last) {
+    MaskKernel kernel{first, last, values + first - begin};
+    withFilter(read, filter, kernel);
+  }
+};
+
+// Returns false if `vector` is not encoded
+template <typename Output>
+bool withEncoded(const vector_t *vector, const ValueIdFilter &filter, const size_t begin, const size_t end,
+                 Output &output) {
+  if (const auto runs = dynamic_cast<const run_length_t *>(vector)) {
+    for (size_t run = runs->run(begin); run < runs->runs() && runs->begin(run) < end; ++run)
+      output.fill(std::max(begin, runs->begin(run)), std::min(end, runs->end(run)), filter(runs->value(run)));
+    return true;
+  }
+
+  if (const auto frames = dynamic_cast<const frame_of_reference_t *>(vector)) {
+    const size_t block_rows = frame_of_reference_t::block_rows;
+    for (size_t block = begin / block_rows; block * block_rows < end; ++block) {
+      const size_t first = std::max(begin, block * block_rows);
+      const size_t last = std::min(end, (block + 1) * block_rows);
+      const auto coverage = filter.coverage(frames->reference(block), frames->maximum(block));
+      if (coverage == ValueIdFilter::Some)
+        output.check(StaticReader<frame_of_reference_t>{frames, 0}, filter, first, last);
+      else
+        output.fill(first, last, coverage == ValueIdFilter::All);
+    }
+    return true;
+  }
+
+  if (const auto sparse = dynamic_cast<const sparse_t *>(vector)) {
+    const auto& exceptions = sparse->exceptions();
+    const bool pass = filter(sparse->defaultValue());
+    size_t row = begin;
+    for (size_t i = std::lower_bound(exceptions.begin(), exceptions.end(), begin) - exceptions.begin();
+         i < exceptions.size() && exceptions[i] < end; ++i) {
+      output.fill(row, exceptions[i], pass);
+      output.fill(exceptions[i], exceptions[i] + 1, filter(sparse->exception(i)));
+      row = exceptions[i] + 1;
+    }
+    output.fill(row, end, pass);
+    return true;
+  }
+  return false;
+}
+
+}
+
+void scanValueIds(const vector_t *vector, const size_t column, const ValueIdFilter &filter,
+                  const size_t begin, const size_t end, const storage::pos_t base, storage::pos_list_t &positions) {
+  if (filter.empty() || begin >= end)
+    return;
+  PositionOutput output{base, positions};
+  if (withEncoded(vector, filter, begin, end, output))
+    return;
+  ScanKernel kernel{begin, end, base, positions};
+  withVector(vector, column, filter, kernel);
+}
+
+void refineValueIds(const vector_t *vector, const size_t column, const ValueIdFilter &filter,
+                    const storage::pos_t base, storage::pos_list_t &positions, const size_t from) {
+  if (filter.empty()) {
+    positions.resize(std::min(from, positions.size()));
+    return;
+  }
+  RefineKernel kernel{base, positions, from};
+  withVector(vector, column, filter, kernel);
+}
+
+void maskValueIds(const vector_t *vector, const size_t column, const ValueIdFilter &filter,
+                  const size_t begin, const size_t end, uint8_t *mask) {
+  if (filter.empty()) {
+    std::memset(mask, 0, end > begin ? end - begin : 0);
+    return;
+  }
+  MaskOutput output{begin, mask};
+  if (withEncoded(vector, filter, begin, end, output))
+    return;
+  MaskKernel kernel{begin, end, mask};
+  withVector(vector, column, filter, kernel);
+}
+
+}
+}
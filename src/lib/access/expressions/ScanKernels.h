@@ -0,0 +1,90 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_EXPRESSIONS_SCANKERNELS_H_
+#define SRC_LIB_ACCESS_EXPRESSIONS_SCANKERNELS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "helper/types.h"
+#include "storage/BaseAttributeVector.h"
+
+namespace hyrise {
+namespace access {
+
+/// Value ids a single column predicate selects in one dictionary.
+///
+/// Comparisons on ordered dictionaries become a single value id (==, !=)
+/// or a range of value ids (<, <=, >, >=, between); everything else is a
+/// bitmap over the value ids. Value ids beyond the bitmap never pass.
+struct ValueIdFilter {
+  enum Kind {
+    Equal,
+    NotEqual,
+    Range,
+    Bitmap
+  };
+
+  Kind kind = Range;
+  // The value id of Equal and NotEqual, [lo, hi) for Range
+  storage::value_id_t lo = 0;
+  storage::value_id_t hi = 0;
+  std::vector<uint8_t> bits;
+
+  bool operator()(const storage::value_id_t id) const {
+    switch (kind) {
+      case Equal: return id == lo;
+      case NotEqual: return id != lo;
+      case Range: return id - lo < hi - lo;
+      case Bitmap: return id < bits.size() && bits[id];
+    }
+    return false;
+  }
+
+  /// True if no value id passes
+  bool empty() const {
+    return kind == Range && lo >= hi;
+  }
+
+  /// Estimated share of `size` value ids that pass
+  double selectivity(const size_t size) const;
+
+  enum Coverage {
+    None,
+    Some,
+    All
+  };
+
+  /// Whether none, some or all of the value ids in [min, max] pass
+  Coverage coverage(storage::value_id_t min, storage::value_id_t max) const;
+};
+
+/// Scan loops over one column of an attribute vector.
+///
+/// The loops are instantiated for every filter kind and every attribute
+/// vector type (FixedLengthVector, ConcurrentFixedLengthVector and
+/// BitCompressedVector, with one instantiation per bit width for single
+/// column vectors and plain loads for 8 and 16 bit wide ones), so value
+/// ids are decoded and compared without virtual calls. Scans and masks
+/// over encoded vectors evaluate the filter once per run
+/// (RunLengthVector), per block (FrameOfReferenceVector) or for the
+/// default value (SparseVector). Other vectors are read through
+/// BaseAttributeVector::get. Rows are relative to the vector.
+
+/// Appends base + row for all rows in [begin, end) that pass
+void scanValueIds(const BaseAttributeVector<storage::value_id_t> *vector, size_t column, const ValueIdFilter &filter,
+                  size_t begin, size_t end, storage::pos_t base, storage::pos_list_t &positions);
+
+/// Removes the positions from positions[from] on whose row (position -
+/// base) does not pass
+void refineValueIds(const BaseAttributeVector<storage::value_id_t> *vector, size_t column, const ValueIdFilter &filter,
+                    storage::pos_t base, storage::pos_list_t &positions, size_t from);
+
+/// Sets mask[row - begin] to 1 for the rows in [begin, end) that pass, to 0
+/// for the others
+void maskValueIds(const BaseAttributeVector<storage::value_id_t> *vector, size_t column, const ValueIdFilter &filter,
+                  size_t begin, size_t end, uint8_t *mask);
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_EXPRESSIONS_SCANKERNELS_H_
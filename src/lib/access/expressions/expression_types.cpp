@@ -22,6 +22,7 @@ predicate_map_t getPredicateMap() {
   d["GT_V"] = PredicateType::GreaterThanExpressionValue;
   d["LTE_V"] = PredicateType::LessThanEqualsExpressionValue;
   d["GTE_V"] = PredicateType::GreaterThanEqualsExpressionValue;
+  d["NEQ_V"] = PredicateType::NotEqualsExpressionValue;
   d["EQ_R"] = PredicateType::EqualsExpressionRaw;
   d["LT_R"] = PredicateType::LessThanExpressionRaw;
   d["GT_R"] = PredicateType::GreaterThanExpressionRaw;
@@ -30,7 +30,8 @@ struct PredicateType {
     GreaterThanExpressionValue = 21,
     LessThanExpressionValue = 22,
     GreaterThanEqualsExpressionValue = 23,
-    LessThanEqualsExpressionValue = 24
+    LessThanEqualsExpressionValue = 24,
+    NotEqualsExpressionValue = 25
   } type;
 };
 
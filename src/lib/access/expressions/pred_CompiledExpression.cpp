@@ -0,0 +1,777 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/expressions/pred_CompiledExpression.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <boost/regex.hpp>
+
+#include "access/json_converters.h"
+#include "access/expressions/expression_types.h"
+#include "access/expressions/pred_buildExpression.h"
+#include "access/expressions/ScanKernels.h"
+#ifdef WITH_LLVM
+#include "access/expressions/ScanCompiler.h"
+#endif
+#include "storage/OrderPreservingDictionary.h"
+#include "storage/PointerCalculator.h"
+#include "storage/Store.h"
+#include "storage/meta_storage.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+
+enum Operator {
+  Equal,
+  NotEqual,
+  Less,
+  Greater,
+  LessEqual,
+  GreaterEqual,
+  Between,
+  In,
+  Like
+};
+
+struct Step {
+  enum Kind {
+    Compare,
+    And,
+    Or,
+    Not
+  } kind;
+  // Index of the comparison for Compare
+  size_t comparison;
+};
+
+const size_t batch_size = 1024;
+const size_t max_cached_programs = 1024;
+
+bool operatorOf(const PredicateType::type type, Operator &op) {
+  switch (type) {
+    case PredicateType::EqualsExpression:
+    case PredicateType::EqualsExpressionValue:
+      op = Equal;
+      return true;
+    case PredicateType::NotEqualsExpressionValue:
+      op = NotEqual;
+      return true;
+    case PredicateType::LessThanExpression:
+    case PredicateType::LessThanExpressionValue:
+      op = Less;
+      return true;
+    case PredicateType::GreaterThanExpression:
+    case PredicateType::GreaterThanExpressionValue:
+      op = Greater;
+      return true;
+    case PredicateType::LessThanEqualsExpressionValue:
+      op = LessEqual;
+      return true;
+    case PredicateType::GreaterThanEqualsExpressionValue:
+      op = GreaterEqual;
+      return true;
+    case PredicateType::BetweenExpression:
+      op = Between;
+      return true;
+    case PredicateType::InExpression:
+      op = In;
+      return true;
+    case PredicateType::LikeExpression:
+      op = Like;
+      return true;
+    default:
+      return false;
+  }
+}
+
+}
+
+struct CompiledExpression::Program {
+  struct Comparison {
+    field_t field;
+    field_name_t field_name;
+    Operator op;
+    unsigned vtype;
+    Json::Value value;
+  };
+
+  Json::Value predicates;
+  std::vector<Comparison> comparisons;
+  // Postfix order
+  std::vector<Step> steps;
+  // Number of masks needed to evaluate the steps
+  size_t depth = 0;
+  // True if the steps only combine comparisons with AND
+  bool conjunction = true;
+};
+
+struct CompiledExpression::Part {
+  // Rows [first, last) of the table
+  pos_t first;
+  pos_t last;
+  // Per comparison
+  std::vector<std::shared_ptr<AbstractAttributeVector> > holders;
+  std::vector<const BaseAttributeVector<value_id_t> *> vectors;
+  std::vector<size_t> offsets;
+  std::vector<ValueIdFilter> filters;
+  std::vector<size_t> dictionary_sizes;
+  // Synopses of the part, if the table has them
+  std::shared_ptr<const storage::ZoneMap> zones;
+#ifdef WITH_LLVM
+  // Generated loop over the part and its arguments
+  std::vector<ScanColumn> columns;
+  ScanCompiler::scan_t scan = nullptr;
+#endif
+};
+
+namespace {
+
+typedef CompiledExpression::Program program_t;
+
+// Appends the predicate tree starting at predicates[i] in postfix order
+bool compileNode(const Json::Value &predicates, unsigned &i, program_t &program) {
+  if (i >= predicates.size())
+    return false;
+  const auto& predicate = predicates[i++];
+  const auto type = parsePredicateType(predicate["type"]);
+
+  if (type == PredicateType::AND || type == PredicateType::OR) {
+    if (!compileNode(predicates, i, program) || !compileNode(predicates, i, program))
+      return false;
+    program.steps.push_back({type == PredicateType::AND ? Step::And : Step::Or, 0});
+    return true;
+  }
+  if (type == PredicateType::NOT) {
+    if (!compileNode(predicates, i, program))
+      return false;
+    program.steps.push_back({Step::Not, 0});
+    return true;
+  }
+
+  program_t::Comparison comparison;
+  if (!operatorOf(type, comparison.op) || predicate["in"].asUInt() != 0 || predicate["vtype"].asUInt() > StringType)
+    return false;
+  if (comparison.op == In && !predicate["value"].isArray())
+    return false;
+  if (comparison.op == Between && (!predicate["value"].isArray() || predicate["value"].size() != 2))
+    return false;
+  if (comparison.op == Like && (predicate["vtype"].asUInt() != StringType || !predicate["value"].isString()))
+    return false;
+  comparison.field = predicate["f"].isNumeric() ? predicate["f"].asUInt() : 0;
+  comparison.field_name = predicate["f"].isString() ? predicate["f"].asString() : "";
+  comparison.vtype = predicate["vtype"].asUInt();
+  comparison.value = predicate["value"];
+  program.steps.push_back({Step::Compare, program.comparisons.size()});
+  program.comparisons.push_back(comparison);
+  return true;
+}
+
+// First value id whose value is not less (or, if `after`, greater) than
+// `value` in an ordered dictionary
+template <typename T>
+value_id_t bound(BaseDictionary<T> *dict, const T &value, const bool after) {
+  value_id_t lo = 0, hi = dict->size();
+  while (lo < hi) {
+    const value_id_t mid = lo + (hi - lo) / 2;
+    const T current = dict->getValueForValueId(mid);
+    if (current < value || (after && !(value < current)))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+// Front coded dictionaries compare the values in place
+value_id_t bound(BaseDictionary<std::string> *dict, const std::string &value, const bool after) {
+  if (const auto ordered = dynamic_cast<OrderPreservingDictionary<std::string> *>(dict))
+    return after ? ordered->upperBound(value) : ordered->lowerBound(value);
+  return bound<std::string>(dict, value, after);
+}
+
+// Characters of `pattern` that every match starts with
+std::string literalPrefix(const std::string &pattern) {
+  if (pattern.find('|') != std::string::npos)
+    return "";
+  const size_t end = pattern.find_first_of(".[]{}()\\*+?^$");
+  std::string prefix = pattern.substr(0, end);
+  // The last character may repeat zero times
+  if (end != std::string::npos && !prefix.empty() && std::string("*?{").find(pattern[end]) != std::string::npos)
+    prefix.pop_back();
+  return prefix;
+}
+
+struct filter_builder {
+  typedef void value_type;
+
+  const program_t::Comparison &comparison;
+  AbstractDictionary *dictionary;
+  ValueIdFilter &filter;
+
+  filter_builder(const program_t::Comparison &c, AbstractDictionary *d, ValueIdFilter &f) :
+      comparison(c), dictionary(d), filter(f) {}
+
+  template <typename T>
+  void operator()() {
+    auto dict = dynamic_cast<BaseDictionary<T> *>(dictionary);
+    if (dict == nullptr)
+      throw std::runtime_error("Predicate type does not match the column type");
+    if (comparison.op == Like) {
+      like();
+      return;
+    }
+
+    std::vector<T> values;
+    if (comparison.op == In || comparison.op == Between) {
+      for (unsigned i = 0; i < comparison.value.size(); ++i)
+        values.push_back(json_converter::convert<T>(comparison.value[i]));
+    } else {
+      values.push_back(json_converter::convert<T>(comparison.value));
+    }
+
+    const value_id_t size = dict->size();
+    if (comparison.op == In) {
+      // One batch lookup instead of a search per constant
+      std::vector<value_id_t> ids;
+      dict->getValueIdsForValues(values, ids);
+      filter.kind = ValueIdFilter::Bitmap;
+      filter.bits.assign(size, 0);
+      for (const auto& id : ids) {
+        if (id < size)
+          filter.bits[id] = 1;
+      }
+      simplifyBitmap();
+      return;
+    }
+    if (!dict->isOrdered()) {
+      filter.kind = ValueIdFilter::Bitmap;
+      filter.bits.resize(size);
+      for (value_id_t id = 0; id < size; ++id)
+        filter.bits[id] = matches(dict->getValueForValueId(id), values);
+      simplifyBitmap();
+      return;
+    }
+
+    const T &value = values.front();
+    switch (comparison.op) {
+      case Equal:
+        setRange(bound(dict, value, false), bound(dict, value, true));
+        if (filter.hi - filter.lo == 1)
+          filter.kind = ValueIdFilter::Equal;
+        break;
+      case NotEqual:
+        setRange(bound(dict, value, false), bound(dict, value, true));
+        if (filter.hi - filter.lo == 1)
+          filter.kind = ValueIdFilter::NotEqual;
+        else
+          setRange(0, size);
+        break;
+      case Less: setRange(0, bound(dict, value, false)); break;
+      case LessEqual: setRange(0, bound(dict, value, true)); break;
+      case Greater: setRange(bound(dict, value, true), size); break;
+      case GreaterEqual: setRange(bound(dict, value, false), size); break;
+      case Between: setRange(bound(dict, values[0], false), bound(dict, values[1], true)); break;
+      case In:
+      case Like:
+        break;
+    }
+  }
+
+  // Matches every value of the dictionary against the regular expression
+  // once; ordered dictionaries only test the values that start with the
+  // literal prefix of the pattern
+  void like() {
+    const auto& pattern = comparison.value.asString();
+    const boost::regex regex(pattern);
+    const auto dict = dynamic_cast<BaseDictionary<std::string> *>(dictionary);
+    const value_id_t size = dict->size();
+    const auto ordered = dynamic_cast<OrderPreservingDictionary<std::string> *>(dictionary);
+    if (!ordered) {
+      filter.kind = ValueIdFilter::Bitmap;
+      filter.bits.resize(size);
+      for (value_id_t id = 0; id < size; ++id)
+        filter.bits[id] = boost::regex_match(dict->getValueForValueId(id), regex);
+      simplifyBitmap();
+      return;
+    }
+
+    const std::string prefix = literalPrefix(pattern);
+    const auto range = ordered->prefixRange(prefix);
+    if (pattern == prefix + ".*") {
+      setRange(range.first, range.second);
+      return;
+    }
+    filter.kind = ValueIdFilter::Bitmap;
+    filter.bits.assign(size, 0);
+    OrderPreservingDictionaryIterator<std::string> it(ordered, range.first);
+    for (value_id_t id = range.first; id < range.second; ++id, it.increment())
+      filter.bits[id] = boost::regex_match(it.dereference(), regex);
+    simplifyBitmap();
+  }
+
+  void setRange(const value_id_t lo, const value_id_t hi) {
+    filter.kind = ValueIdFilter::Range;
+    filter.lo = lo;
+    filter.hi = std::max(lo, hi);
+  }
+
+  // Bitmaps with at most one value id become cheaper filters
+  void simplifyBitmap() {
+    const auto count = std::count(filter.bits.begin(), filter.bits.end(), 1);
+    if (count == 0) {
+      setRange(0, 0);
+    } else if (count == 1) {
+      filter.kind = ValueIdFilter::Equal;
+      filter.lo = std::find(filter.bits.begin(), filter.bits.end(), 1) - filter.bits.begin();
+      filter.bits.clear();
+    }
+  }
+
+  template <typename T>
+  bool matches(const T &current, const std::vector<T> &values) const {
+    switch (comparison.op) {
+      case Equal: return current == values.front();
+      case NotEqual: return current != values.front();
+      case Between: return values[0] <= current && current <= values[1];
+      case Less: return current < values.front();
+      case LessEqual: return current <= values.front();
+      case Greater: return current > values.front();
+      case GreaterEqual: return current >= values.front();
+      case In: return std::find(values.begin(), values.end(), current) != values.end();
+      case Like: break;
+    }
+    return false;
+  }
+};
+
+struct ProgramCache {
+  std::mutex mutex;
+  std::map<std::string, std::shared_ptr<const program_t> > programs;
+};
+
+ProgramCache &cache() {
+  static ProgramCache programs;
+  return programs;
+}
+
+}
+
+CompiledExpression *CompiledExpression::compile(const Json::Value &predicates) {
+  const std::string key = Json::FastWriter().write(predicates);
+  auto& programs = cache();
+  {
+    std::lock_guard<std::mutex> lock(programs.mutex);
+    const auto& it = programs.programs.find(key);
+    if (it != programs.programs.end())
+      return it->second ? new CompiledExpression(it->second) : nullptr;
+  }
+
+  auto program = std::make_shared<Program>();
+  program->predicates = predicates;
+  unsigned next = 0;
+  if (!compileNode(predicates, next, *program) || next != predicates.size()) {
+    program.reset();
+  } else {
+    size_t depth = 0;
+    for (const auto& step : program->steps) {
+      if (step.kind == Step::Compare)
+        program->depth = std::max(program->depth, ++depth);
+      else if (step.kind != Step::Not)
+        --depth;
+      program->conjunction = program->conjunction && (step.kind == Step::Compare || step.kind == Step::And);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(programs.mutex);
+  if (programs.programs.size() >= max_cached_programs)
+    programs.programs.clear();
+  programs.programs[key] = program;
+  return program ? new CompiledExpression(program) : nullptr;
+}
+
+CompiledExpression::CompiledExpression(const std::shared_ptr<const Program> &program) :
+    _program(program), _skipped_chunks(0) {
+}
+
+CompiledExpression::~CompiledExpression() {
+}
+
+void CompiledExpression::walk(const std::vector<hyrise::storage::c_atable_ptr_t> &l) {
+  const auto& table = l.at(0);
+  _fields.clear();
+  _parts.clear();
+  _fallback.reset();
+  _skipped_chunks = 0;
+  for (const auto& comparison : _program->comparisons)
+    _fields.push_back(comparison.field_name.empty() ? comparison.field : table->numberOfColumn(comparison.field_name));
+
+  bool compiled = std::dynamic_pointer_cast<const PointerCalculator>(table) == nullptr;
+  const size_t rows = table->size();
+  for (size_t c = 0; compiled && c < _fields.size(); ++c) {
+    attr_vectors_t vectors;
+    try {
+      vectors = table->getAttributeVectors(_fields[c]);
+    } catch (const std::runtime_error &) {
+      compiled = false;
+      break;
+    }
+
+    // All columns have to be split into the same parts
+    pos_t first = 0;
+    size_t part = 0;
+    for (size_t v = 0; compiled && v < vectors.size() && first < rows; ++v, ++part) {
+      const auto vector = std::dynamic_pointer_cast<BaseAttributeVector<value_id_t> >(vectors[v].attribute_vector);
+      if (!vector) {
+        compiled = false;
+        break;
+      }
+      const pos_t last = std::min<pos_t>(rows, first + vector->size());
+      if (c == 0) {
+        _parts.emplace_back(new Part());
+        _parts.back()->first = first;
+        _parts.back()->last = last;
+      } else if (part >= _parts.size() || _parts[part]->first != first || _parts[part]->last != last) {
+        compiled = false;
+        break;
+      }
+
+      auto& p = *_parts[part];
+      p.holders.push_back(vectors[v].attribute_vector);
+      p.vectors.push_back(vector.get());
+      p.offsets.push_back(vectors[v].attribute_offset);
+      p.filters.emplace_back();
+      const auto dictionary = table->dictionaryAt(_fields[c], first);
+      p.dictionary_sizes.push_back(dictionary->size());
+      filter_builder builder(_program->comparisons[c], dictionary.get(), p.filters.back());
+      hyrise::storage::type_switch<hyrise_basic_types> ts;
+      ts(_program->comparisons[c].vtype, builder);
+      first = last;
+    }
+    compiled = compiled && first >= rows && part == _parts.size();
+  }
+
+  if (!compiled) {
+    _parts.clear();
+    _fallback.reset(buildExpression(_program->predicates));
+    _fallback->walk(l);
+    return;
+  }
+
+#ifdef WITH_LLVM
+  for (const auto& part : _parts) {
+    ScanPlan plan;
+    for (size_t c = 0; c < _fields.size(); ++c)
+      ScanCompiler::addComparison(part->vectors[c], part->offsets[c], part->filters[c], plan, part->columns);
+    for (const auto& step : _program->steps) {
+      switch (step.kind) {
+        case Step::Compare: plan.steps.emplace_back(ScanPlan::Compare, step.comparison); break;
+        case Step::And: plan.steps.emplace_back(ScanPlan::And, 0); break;
+        case Step::Or: plan.steps.emplace_back(ScanPlan::Or, 0); break;
+        case Step::Not: plan.steps.emplace_back(ScanPlan::Not, 0); break;
+      }
+    }
+    part->scan = ScanCompiler::scan(plan);
+  }
+#endif
+
+  const auto& store = std::dynamic_pointer_cast<const storage::Store>(table);
+  // The main is part 0, the delta only has a part if it has rows
+  if (store && !_parts.empty()) {
+    _parts[0]->zones = store->zoneMap(0);
+    if (_parts.size() > 1)
+      _parts[1]->zones = store->zoneMap(1);
+  }
+
+  _index.reset();
+  _index_comparisons.clear();
+  if (!store || _parts.empty() || !_program->conjunction)
+    return;
+  auto indexes = store->indexes();
+  if (const auto& primary = store->primaryKey())
+    indexes.insert(indexes.begin(), primary);
+  for (const auto& index : indexes) {
+    // Every key column needs an equality comparison on the ordered main
+    std::vector<size_t> comparisons;
+    for (const auto& field : index->fields()) {
+      for (size_t c = 0; c < _fields.size(); ++c) {
+        if (_fields[c] == field && _program->comparisons[c].op == Equal &&
+            _parts[0]->filters[c].kind != ValueIdFilter::Bitmap) {
+          comparisons.push_back(c);
+          break;
+        }
+      }
+    }
+    if (comparisons.size() == index->fields().size()) {
+      _index = index;
+      _index_comparisons = comparisons;
+      return;
+    }
+  }
+}
+
+void CompiledExpression::accessedFields(field_list_t &fields) const {
+  if (!_fields.empty()) {
+    fields.insert(fields.end(), _fields.begin(), _fields.end());
+  } else {
+    for (const auto& comparison : _program->comparisons)
+      fields.push_back(comparison.field);
+  }
+}
+
+pos_list_t *CompiledExpression::match(const size_t start, const size_t stop) {
+  auto positions = new pos_list_t;
+  if (_fallback) {
+    for (size_t row = start; row < stop; ++row) {
+      if ((*_fallback)(row))
+        positions->push_back(row);
+    }
+    return positions;
+  }
+
+  if (_index) {
+    delete positions;
+    return matchIndex(start, stop);
+  }
+
+  for (const auto& part : _parts) {
+    const pos_t begin = std::max<pos_t>(start, part->first);
+    const pos_t end = std::min<pos_t>(stop, part->last);
+    if (!part->zones) {
+      matchRows(*part, begin, end, *positions);
+      continue;
+    }
+
+    // Skip the chunks whose synopses rule out a match
+    const size_t chunk_rows = storage::ZoneMap::chunk_rows;
+    for (pos_t from = begin; from < end;) {
+      const size_t chunk = (from - part->first) / chunk_rows;
+      const pos_t to = std::min<pos_t>(end, part->first + (chunk + 1) * chunk_rows);
+      switch (coverage(*part, chunk)) {
+        case ValueIdFilter::None:
+          ++_skipped_chunks;
+          break;
+        case ValueIdFilter::Some:
+          matchRows(*part, from, to, *positions);
+          break;
+        case ValueIdFilter::All:
+          for (pos_t row = from; row < to; ++row)
+            positions->push_back(row);
+          break;
+      }
+      from = to;
+    }
+  }
+  return positions;
+}
+
+pos_list_t *CompiledExpression::matchIndex(const size_t start, const size_t stop) {
+  // The filters of the key comparisons are the value ids of the key in
+  // main and delta
+  std::vector<storage::SecondaryIndex::KeyRange> ranges;
+  for (const auto& c : _index_comparisons) {
+    storage::SecondaryIndex::KeyRange range;
+    const auto& main = _parts[0]->filters[c];
+    range.main_lo = main.lo;
+    range.main_hi = main.kind == ValueIdFilter::Equal ? main.lo + 1 : main.hi;
+    if (_parts.size() > 1) {
+      const auto& delta = _parts[1]->filters[c];
+      if (delta.kind == ValueIdFilter::Equal) {
+        range.delta.push_back(delta.lo);
+      } else if (delta.kind == ValueIdFilter::Range) {
+        for (value_id_t id = delta.lo; id < delta.hi; ++id)
+          range.delta.push_back(id);
+      } else {
+        for (value_id_t id = 0; id < delta.bits.size(); ++id) {
+          if (delta.bits[id])
+            range.delta.push_back(id);
+        }
+      }
+    }
+    ranges.push_back(range);
+  }
+
+  auto positions = new pos_list_t;
+  for (const auto& row : _index->lookup(ranges)) {
+    if (row >= start && row < stop && (*this)(row))
+      positions->push_back(row);
+  }
+  return positions;
+}
+
+ValueIdFilter::Coverage CompiledExpression::coverage(const Part &part, const size_t chunk) const {
+  // None < Some < All, so AND takes the minimum and OR the maximum
+  std::vector<ValueIdFilter::Coverage> stack;
+  for (const auto& step : _program->steps) {
+    switch (step.kind) {
+      case Step::Compare: {
+        const auto synopsis = part.zones->synopsis(_fields[step.comparison], chunk);
+        stack.push_back(part.filters[step.comparison].coverage(synopsis.min, synopsis.max));
+        break;
+      }
+      case Step::And: {
+        const auto right = stack.back();
+        stack.pop_back();
+        stack.back() = std::min(stack.back(), right);
+        break;
+      }
+      case Step::Or: {
+        const auto right = stack.back();
+        stack.pop_back();
+        stack.back() = std::max(stack.back(), right);
+        break;
+      }
+      case Step::Not:
+        stack.back() = static_cast<ValueIdFilter::Coverage>(ValueIdFilter::All - stack.back());
+        break;
+    }
+  }
+  return stack.back();
+}
+
+void CompiledExpression::matchRows(const Part &part, const pos_t begin, const pos_t end, pos_list_t &positions) const {
+#ifdef WITH_LLVM
+  // The loop writes every row of a batch and keeps those that pass
+  for (pos_t batch = begin; batch < end; batch += batch_size) {
+    const size_t count = std::min<pos_t>(end, batch + batch_size) - batch;
+    const size_t from = positions.size();
+    positions.resize(from + count);
+    const size_t passed = part.scan(part.columns.data(), batch - part.first, batch - part.first + count,
+                                    part.first, &positions[from]);
+    positions.resize(from + passed);
+  }
+#else
+  if (_program->conjunction)
+    matchConjunction(part, begin, end, positions);
+  else
+    matchBatches(part, begin, end, positions);
+#endif
+}
+
+#ifndef WITH_LLVM
+
+void CompiledExpression::matchConjunction(const Part &part, const pos_t begin, const pos_t end,
+                                          pos_list_t &positions) const {
+  // Scan with the most selective comparison, refine with the others
+  std::vector<size_t> order(part.filters.size());
+  std::vector<double> selectivity(part.filters.size());
+  for (size_t c = 0; c < order.size(); ++c) {
+    order[c] = c;
+    selectivity[c] = part.filters[c].selectivity(part.dictionary_sizes[c]);
+  }
+  std::stable_sort(order.begin(), order.end(), [&selectivity](size_t l, size_t r) {
+    return selectivity[l] < selectivity[r];
+  });
+
+  const size_t from = positions.size();
+  const size_t first = order.front();
+  scanValueIds(part.vectors[first], part.offsets[first], part.filters[first],
+               begin - part.first, end - part.first, part.first, positions);
+  for (size_t i = 1; i < order.size() && positions.size() > from; ++i) {
+    const size_t c = order[i];
+    refineValueIds(part.vectors[c], part.offsets[c], part.filters[c], part.first, positions, from);
+  }
+}
+
+void CompiledExpression::matchBatches(const Part &part, const pos_t begin, const pos_t end,
+                                      pos_list_t &positions) const {
+  std::vector<std::vector<uint8_t> > masks(_program->depth, std::vector<uint8_t>(batch_size));
+  for (pos_t batch = begin; batch < end; batch += batch_size) {
+    // Rows of the batch relative to the part
+    const size_t from = batch - part.first;
+    const size_t to = std::min<pos_t>(end, batch + batch_size) - part.first;
+    const size_t count = to - from;
+
+    size_t top = 0;
+    for (const auto& step : _program->steps) {
+      switch (step.kind) {
+        case Step::Compare: {
+          const size_t c = step.comparison;
+          maskValueIds(part.vectors[c], part.offsets[c], part.filters[c], from, to, masks[top++].data());
+          break;
+        }
+        case Step::And: {
+          auto& left = masks[top - 2];
+          const auto& right = masks[--top];
+          for (size_t i = 0; i < count; ++i)
+            left[i] &= right[i];
+          break;
+        }
+        case Step::Or: {
+          auto& left = masks[top - 2];
+          const auto& right = masks[--top];
+          for (size_t i = 0; i < count; ++i)
+            left[i] |= right[i];
+          break;
+        }
+        case Step::Not: {
+          auto& mask = masks[top - 1];
+          for (size_t i = 0; i < count; ++i)
+            mask[i] ^= 1;
+          break;
+        }
+      }
+    }
+
+    const auto& result = masks[0];
+    for (size_t i = 0; i < count; ++i) {
+      if (result[i])
+        positions.push_back(batch + i);
+    }
+  }
+}
+
+#endif
+
+bool CompiledExpression::operator()(size_t row) {
+  if (_fallback)
+    return (*_fallback)(row);
+
+  size_t p = 0;
+  while (p + 1 < _parts.size() && row >= _parts[p]->last)
+    ++p;
+  const auto& part = *_parts.at(p);
+
+  std::vector<bool> stack;
+  for (const auto& step : _program->steps) {
+    switch (step.kind) {
+      case Step::Compare: {
+        const auto id = part.vectors[step.comparison]->get(part.offsets[step.comparison], row - part.first);
+        stack.push_back(part.filters[step.comparison](id));
+        break;
+      }
+      case Step::And: {
+        const bool right = stack.back();
+        stack.pop_back();
+        stack.back() = stack.back() && right;
+        break;
+      }
+      case Step::Or: {
+        const bool right = stack.back();
+        stack.pop_back();
+        stack.back() = stack.back() || right;
+        break;
+      }
+      case Step::Not:
+        stack.back() = !stack.back();
+        break;
+    }
+  }
+  return stack.back();
+}
+
+size_t CompiledExpression::cachedPrograms() {
+  std::lock_guard<std::mutex> lock(cache().mutex);
+  return cache().programs.size();
+}
+
+void CompiledExpression::clearCache() {
+  std::lock_guard<std::mutex> lock(cache().mutex);
+  cache().programs.clear();
+}
+
+}
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_PRED_COMPILEDEXPRESSION_H_
+#define SRC_LIB_ACCESS_PRED_COMPILEDEXPRESSION_H_
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <json.h>
+
+#include "access/expressions/ScanKernels.h"
+#include "storage/SecondaryIndex.h"
+#include "pred_common.h"
+
+namespace hyrise {
+namespace access {
+
+///
+/// Predicate list of a scan (see buildExpression) compiled into a flat
+/// program over value ids.
+///
+/// walk() translates the values of all comparisons into ranges or sets of
+/// value ids for every part of the table, i.e. main and delta of a store.
+/// match() then evaluates the program. Built with WITH_LLVM, it runs a
+/// loop generated for the attribute vector types of the part (see
+/// ScanCompiler.h). Otherwise it interprets the program with the loops of
+/// ScanKernels.h: conjunctions scan with the most selective comparison
+/// and drop the positions that fail the others, programs with OR or NOT
+/// are evaluated for batches of rows, every comparison fills a mask and
+/// AND, OR and NOT combine the masks. Parsed programs are cached by the
+/// text of their predicates.
+///
+/// On stores, match() first compares the filters with the zone maps of
+/// main and delta and skips chunks that cannot contain a match. If a
+/// conjunction compares all key columns of an index of the store for
+/// equality, e.g. of its primary key, match() looks the rows up in the
+/// index instead and only checks the other comparisons on them.
+///
+/// LIKE runs its regular expression once per dictionary entry instead of
+/// once per row. On ordered dictionaries only the entries that start with
+/// the literal prefix of the pattern are tested, a pattern that is just a
+/// prefix followed by ".*" becomes a range of value ids.
+///
+/// Tables without attribute vectors, e.g. PointerCalculators, are scanned
+/// with the interpreted expressions of buildExpression instead.
+///
+class CompiledExpression : public SimpleExpression {
+ public:
+  struct Program;
+
+  /// Returns nullptr if the predicates use expressions that cannot be
+  /// compiled, e.g. comparisons on raw tables
+  static CompiledExpression *compile(const Json::Value &predicates);
+
+  explicit CompiledExpression(const std::shared_ptr<const Program> &program);
+  virtual ~CompiledExpression();
+
+  virtual void walk(const std::vector<hyrise::storage::c_atable_ptr_t> &l);
+  virtual void accessedFields(field_list_t &fields) const;
+  virtual pos_list_t *match(const size_t start, const size_t stop);
+  virtual bool operator()(size_t row);
+
+  /// Number of zone map chunks match() skipped because none of their
+  /// rows can match, since the last walk()
+  size_t skippedChunks() const {
+    return _skipped_chunks;
+  }
+
+  /// Number of programs in the cache
+  static size_t cachedPrograms();
+  static void clearCache();
+
+ private:
+  struct Part;
+
+  // Whether none, some or all rows of a chunk of the part's zone map match
+  ValueIdFilter::Coverage coverage(const Part &part, size_t chunk) const;
+  void matchRows(const Part &part, pos_t begin, pos_t end, pos_list_t &positions) const;
+#ifndef WITH_LLVM
+  void matchConjunction(const Part &part, pos_t begin, pos_t end, pos_list_t &positions) const;
+  void matchBatches(const Part &part, pos_t begin, pos_t end, pos_list_t &positions) const;
+#endif
+  // Rows in [start, stop) of the index lookup that pass all comparisons
+  pos_list_t *matchIndex(size_t start, size_t stop);
+
+  std::shared_ptr<const Program> _program;
+  std::unique_ptr<SimpleExpression> _fallback;
+  // Resolved field of every comparison
+  field_list_t _fields;
+  std::vector<std::unique_ptr<Part> > _parts;
+  // Index of the store used by match() and the comparison of each of its
+  // key columns
+  std::shared_ptr<const storage::SecondaryIndex> _index;
+  std::vector<size_t> _index_comparisons;
+
+  std::atomic<size_t> _skipped_chunks;
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_PRED_COMPILEDEXPRESSION_H_
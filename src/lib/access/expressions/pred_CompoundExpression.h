@@ -41,6 +41,14 @@ class CompoundExpression : public SimpleExpression {
     }
   }
 
+  virtual void accessedFields(field_list_t &fields) const {
+    lhs->accessedFields(fields);
+
+    if (!one_leg) {
+      rhs->accessedFields(fields);
+    }
+  }
+
   inline virtual bool operator()(size_t row) {
     switch (type) {
       case AND:
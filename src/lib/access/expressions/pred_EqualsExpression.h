@@ -36,11 +36,8 @@ class EqualsExpression : public SimpleFieldExpression {
     SimpleFieldExpression::walk(l);
     valueIdMap = std::dynamic_pointer_cast<BaseDictionary<T>>(table->dictionaryAt(field));
 
-    value_exists = valueIdMap->valueExists(value);
-
-    if (value_exists) {
-      lower_bound = table->getValueIdForValue(field, value);
-    }
+    lower_bound.table = 0;
+    value_exists = valueIdMap->findValueId(value, lower_bound.valueId);
   }
 
   virtual ~EqualsExpression() { }
@@ -10,9 +10,12 @@ class SimpleExpression : public hyrise::access::AbstractExpression {
  public:
   virtual void walk(const std::vector<hyrise::storage::c_atable_ptr_t> &l) = 0;
 
+  /// Appends the fields evaluated by this expression, valid after walk
+  virtual void accessedFields(field_list_t &fields) const {}
+
   virtual pos_list_t* match(const size_t start, const size_t stop) {
     auto pl = new pos_list_t;
-    for(size_t row=0; row < stop; ++row) {
+    for(size_t row=start; row < stop; ++row) {
       if (operator()(row)) {
         pl->push_back(row);
       }
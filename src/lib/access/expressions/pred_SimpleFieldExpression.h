@@ -42,6 +42,10 @@ class SimpleFieldExpression : public SimpleExpression {
     }
   }
 
+  virtual void accessedFields(field_list_t &fields) const {
+    fields.push_back(field);
+  }
+
   inline virtual bool operator()(size_t row) {
     throw std::runtime_error("Cannot call base class");
   }
@@ -28,6 +28,14 @@
     return new EXPRESSION<ValueType>(_input_index, _field, _value); \
   break;
 
+// for expressions on a range given as [lower, upper]
+#define GENERATE_EXPRESSION_WITH_BOUNDS(EXPRESSION)  case PredicateType::EXPRESSION: \
+  if (_field_name.size() > 0)                                           \
+    return new EXPRESSION<ValueType>(_input_index, _field_name, json_converter::convert<ValueType>(_value[0u]), json_converter::convert<ValueType>(_value[1u])); \
+  else                                                                  \
+    return new EXPRESSION<ValueType>(_input_index, _field, json_converter::convert<ValueType>(_value[0u]), json_converter::convert<ValueType>(_value[1u])); \
+  break;
+
 #define GENERATE_GENERIC_EXPRESSION(NAME, EXPRESSION, OPERATOR)  case PredicateType::NAME: \
   if (_field_name.size() > 0)                                           \
     return new EXPRESSION<ValueType, OPERATOR<ValueType> >(_input_index, _field_name, json_converter::convert<ValueType>(_value)); \
@@ -81,12 +89,14 @@ struct expression_factory {
       GENERATE_EXPRESSION(GreaterThanExpressionRaw);
       GENERATE_EXPRESSION_OF_TYPE(LikeExpression, hyrise_string_t);
       GENERATE_EXPRESSION_WITH_VALUE_VECTOR(InExpression);
+      GENERATE_EXPRESSION_WITH_BOUNDS(BetweenExpression);
 
       GENERATE_GENERIC_EXPRESSION(EqualsExpressionValue, GenericExpressionValue, std::equal_to);
       GENERATE_GENERIC_EXPRESSION(LessThanExpressionValue, GenericExpressionValue, std::less);
       GENERATE_GENERIC_EXPRESSION(GreaterThanExpressionValue, GenericExpressionValue, std::greater);
       GENERATE_GENERIC_EXPRESSION(LessThanEqualsExpressionValue, GenericExpressionValue, std::less_equal);
       GENERATE_GENERIC_EXPRESSION(GreaterThanEqualsExpressionValue, GenericExpressionValue, std::greater_equal);
+      GENERATE_GENERIC_EXPRESSION(NotEqualsExpressionValue, GenericExpressionValue, std::not_equal_to);
       default:
         throw std::runtime_error("Expression Type not supported");
     }
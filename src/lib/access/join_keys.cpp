@@ -0,0 +1,169 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/join_keys.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "storage/AbstractTable.h"
+#include "storage/BaseDictionary.h"
+#include "storage/OrderPreservingDictionary.h"
+#include "storage/meta_storage.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+
+const size_t max_table_ids = std::numeric_limits<table_id_t>::max() + 1;
+
+// Builds one sorted domain over all values of the given dictionaries and
+// a translation table from value id to the value's rank in that domain
+// for each dictionary. Returns the size of the domain.
+struct BuildTranslation {
+  typedef size_t value_type;
+
+  const std::vector<storage::adict_ptr_t> &dictionaries;
+  std::vector<join_key_list_t> &translations;
+
+  template <typename T>
+  size_t operator()() {
+    std::vector<T> domain;
+    for (const auto& d : dictionaries) {
+      const auto& dict = std::static_pointer_cast<BaseDictionary<T> >(d);
+      // dictionary iterators share their position when copied, so they
+      // cannot be handed to range algorithms
+      for (auto it = dict->begin(), end = dict->end(); it != end; ++it)
+        domain.push_back(*it);
+    }
+    std::sort(domain.begin(), domain.end());
+    domain.erase(std::unique(domain.begin(), domain.end()), domain.end());
+
+    // The ranks are the value ids of the domain as an ordered dictionary,
+    // translated in one batch per dictionary
+    OrderPreservingDictionary<T> ranks(domain.size());
+    for (const auto& value : domain)
+      ranks.addValue(value);
+    translations.resize(dictionaries.size());
+    std::vector<T> values;
+    std::vector<value_id_t> value_ids;
+    for (size_t i = 0; i < dictionaries.size(); ++i) {
+      const auto& dict = std::static_pointer_cast<BaseDictionary<T> >(dictionaries[i]);
+      values.resize(dict->size());
+      for (auto it = dict->begin(), end = dict->end(); it != end; ++it)
+        values[it.getValueId()] = *it;
+      ranks.getValueIdsForValues(values, value_ids);
+      translations[i].assign(value_ids.begin(), value_ids.end());
+    }
+    return domain.size();
+  }
+};
+
+// Value ids of one join column together with the dictionaries of all
+// table ids that occur in it
+struct ColumnValueIds {
+  std::vector<ValueId> value_ids;
+  std::vector<storage::adict_ptr_t> dictionaries;
+
+  ColumnValueIds(const storage::c_atable_ptr_t &table, const field_t column) :
+      value_ids(table->size()), dictionaries(max_table_ids) {
+    for (size_t row = 0; row < value_ids.size(); ++row) {
+      value_ids[row] = table->getValueId(column, row);
+      auto& dictionary = dictionaries[value_ids[row].table];
+      if (dictionary == nullptr)
+        dictionary = table->dictionaryByTableId(column, value_ids[row].table);
+    }
+  }
+};
+
+// Encodes one pair of join columns into the shared code domain and
+// returns the size of that domain.
+size_t encodeColumnPair(const storage::c_atable_ptr_t &left, const field_t left_column,
+                        const storage::c_atable_ptr_t &right, const field_t right_column,
+                        join_key_list_t &left_codes, join_key_list_t &right_codes) {
+  const DataType type = left->typeOfColumn(left_column);
+  if (type != right->typeOfColumn(right_column))
+    throw std::runtime_error("Join requires join columns of the same type");
+
+  ColumnValueIds sides[2] = { ColumnValueIds(left, left_column), ColumnValueIds(right, right_column) };
+  join_key_list_t *codes[2] = { &left_codes, &right_codes };
+
+  // index into `dictionaries` per side and table id
+  std::vector<storage::adict_ptr_t> dictionaries;
+  std::vector<size_t> dictionary_index[2] = { std::vector<size_t>(max_table_ids), std::vector<size_t>(max_table_ids) };
+  for (size_t side = 0; side < 2; ++side) {
+    for (size_t table_id = 0; table_id < max_table_ids; ++table_id) {
+      const auto& dictionary = sides[side].dictionaries[table_id];
+      if (dictionary == nullptr)
+        continue;
+      auto known = std::find(dictionaries.begin(), dictionaries.end(), dictionary);
+      dictionary_index[side][table_id] = known - dictionaries.begin();
+      if (known == dictionaries.end())
+        dictionaries.push_back(dictionary);
+    }
+  }
+
+  // Both columns share one order-preserving dictionary: value ids already
+  // are the codes
+  if (dictionaries.size() == 1 && dictionaries.front()->isOrdered()) {
+    for (size_t side = 0; side < 2; ++side) {
+      const auto& value_ids = sides[side].value_ids;
+      codes[side]->resize(value_ids.size());
+      for (size_t row = 0; row < value_ids.size(); ++row)
+        (*codes[side])[row] = value_ids[row].valueId;
+    }
+    return dictionaries.front()->size();
+  }
+
+  std::vector<join_key_list_t> translations;
+  BuildTranslation builder {dictionaries, translations};
+  const size_t domain_size = storage::type_switch<hyrise_basic_types>()(type, builder);
+
+  for (size_t side = 0; side < 2; ++side) {
+    const auto& value_ids = sides[side].value_ids;
+    codes[side]->resize(value_ids.size());
+    for (size_t row = 0; row < value_ids.size(); ++row) {
+      const auto& translation = translations[dictionary_index[side][value_ids[row].table]];
+      (*codes[side])[row] = translation[value_ids[row].valueId];
+    }
+  }
+  return domain_size;
+}
+
+size_t bitsForDomain(const size_t domain_size) {
+  size_t bits = 1;
+  while (bits < 64 && (1ull << bits) < domain_size)
+    ++bits;
+  return bits;
+}
+
+}
+
+void encodeJoinKeys(const storage::c_atable_ptr_t &left,
+                    const storage::c_atable_ptr_t &right,
+                    const field_list_t &fields,
+                    join_key_list_t &left_keys,
+                    join_key_list_t &right_keys) {
+  left_keys.assign(left->size(), 0);
+  right_keys.assign(right->size(), 0);
+
+  size_t key_bits = 0;
+  for (size_t i = 0; i + 1 < fields.size(); i += 2) {
+    join_key_list_t left_codes, right_codes;
+    const size_t domain_size = encodeColumnPair(left, fields[i], right, fields[i + 1], left_codes, right_codes);
+    const size_t bits = bitsForDomain(domain_size);
+    key_bits += bits;
+    if (key_bits > 64) {
+      throw std::runtime_error("Join key domain exceeds 64 bits");
+    }
+
+    const join_key_t shift = bits == 64 ? 0 : bits;
+    for (size_t row = 0; row < left_keys.size(); ++row)
+      left_keys[row] = (left_keys[row] << shift) | left_codes[row];
+    for (size_t row = 0; row < right_keys.size(); ++row)
+      right_keys[row] = (right_keys[row] << shift) | right_codes[row];
+  }
+}
+
+}
+}
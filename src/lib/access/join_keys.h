@@ -0,0 +1,35 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_JOIN_KEYS_H_
+#define SRC_LIB_ACCESS_JOIN_KEYS_H_
+
+#include <vector>
+
+#include "helper/types.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace access {
+
+typedef uint64_t join_key_t;
+typedef std::vector<join_key_t> join_key_list_t;
+
+/// Encodes the join columns of both inputs into one shared,
+/// order-preserving integer domain. Equal values receive equal keys on
+/// both sides, so joins can compare keys instead of values. Columns that
+/// share a single ordered dictionary use their value ids directly;
+/// otherwise every dictionary gets a value id translation table. The
+/// codes of multi-column keys are packed into one 64 bit key, fields are
+/// given as pairs of left and right column.
+///
+/// Throws if the column types of a pair differ or the packed key would
+/// need more than 64 bits.
+void encodeJoinKeys(const storage::c_atable_ptr_t &left,
+                    const storage::c_atable_ptr_t &right,
+                    const field_list_t &fields,
+                    join_key_list_t &left_keys,
+                    join_key_list_t &right_keys);
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_JOIN_KEYS_H_
@@ -4,6 +4,7 @@
 
 #include "access/system/ParallelizablePlanOperation.h"
 
+#include "storage/BitCompressedVector.h"
 #include "storage/FixedLengthVector.h"
 #include "storage/OrderPreservingDictionary.h"
 #include "storage/PointerCalculator.h"
@@ -11,12 +12,28 @@
 namespace hyrise {
 namespace access {
 
-// Extracts the AV from the table at given column
+// Extracts the AV from the table at given column. The data of input
+// tables is read through BaseAttributeVector; bit compressed and encoded
+// vectors, e.g. of loaded tables and merged mains, are decoded into a
+// FixedLengthVector if one is requested.
 template<typename Table, typename VectorType=FixedLengthVector<value_id_t>>
 inline std::pair<std::shared_ptr<VectorType>, size_t> _getDataVector(const Table &tab,
                                                                      const size_t column = 0) {
   const auto &avs = tab->getAttributeVectors(column);
-  const auto data = std::dynamic_pointer_cast<VectorType>(avs.at(0).attribute_vector);
+  auto data = std::dynamic_pointer_cast<VectorType>(avs.at(0).attribute_vector);
+  const auto vector = std::dynamic_pointer_cast<BaseAttributeVector<value_id_t>>(avs.at(0).attribute_vector);
+  if (data == nullptr && vector != nullptr) {
+    // Encoded vectors store a single column
+    const auto compressed = std::dynamic_pointer_cast<BitCompressedVector<value_id_t>>(vector);
+    const size_t columns = compressed ? compressed->columns() : 1;
+    auto fixed = std::make_shared<FixedLengthVector<value_id_t>>(columns, vector->size());
+    fixed->resize(vector->size());
+    for (size_t row = 0; row < vector->size(); ++row) {
+      for (size_t c = 0; c < columns; ++c)
+        fixed->set(c, row, vector->get(c, row));
+    }
+    data = std::dynamic_pointer_cast<VectorType>(fixed);
+  }
   assert(data != nullptr);
   return {data, avs.at(0).attribute_offset};
 }
@@ -86,7 +103,7 @@ void Histogram::executeHistogram() {
   // check if tab is PointerCalculator; if yes, get underlying table and actual rows and columns
   auto p = std::dynamic_pointer_cast<const PointerCalculator>(tab);
   if (p) {
-    auto ipair = getDataVector(p->getActualTable(), p->getTableColumnForColumn(field));
+    auto ipair = getDataVector<BaseAttributeVector<value_id_t> >(p->getActualTable(), p->getTableColumnForColumn(field));
     const auto &ivec = ipair.first;
     const auto &dict = std::dynamic_pointer_cast<OrderPreservingDictionary<T>>(tab->dictionaryAt(p->getTableColumnForColumn(field)));
     const auto &offset = ipair.second;
@@ -104,7 +121,7 @@ void Histogram::executeHistogram() {
       auto pc = mvt->containerAt(field);
       auto p = std::dynamic_pointer_cast<const PointerCalculator>(pc);
       if(p){
-        auto ipair = getDataVector(p->getActualTable(), p->getTableColumnForColumn(field));
+        auto ipair = getDataVector<BaseAttributeVector<value_id_t> >(p->getActualTable(), p->getTableColumnForColumn(field));
         const auto &ivec = ipair.first;
         const auto &dict = std::dynamic_pointer_cast<OrderPreservingDictionary<T>>(tab->dictionaryAt(p->getTableColumnForColumn(field)));
         const auto &offset = ipair.second;
@@ -119,7 +136,7 @@ void Histogram::executeHistogram() {
       }
     } else {
       // else; we expect a raw table
-      auto ipair = getDataVector(tab, field);
+      auto ipair = getDataVector<BaseAttributeVector<value_id_t> >(tab, field);
       const auto &ivec = ipair.first;
       const auto &dict = std::dynamic_pointer_cast<OrderPreservingDictionary<T>>(tab->dictionaryAt(field));
       const auto &offset =  ipair.second;
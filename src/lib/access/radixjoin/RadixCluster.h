@@ -78,7 +78,7 @@ void RadixCluster::executeClustering() {
   // check if tab is PointerCalculator; if yes, get underlying table and actual rows and columns
   auto p = std::dynamic_pointer_cast<const PointerCalculator>(tab);
   if (p) {
-    auto ipair = getDataVector(p->getActualTable());
+    auto ipair = getDataVector<BaseAttributeVector<value_id_t> >(p->getActualTable());
     const auto &ivec = ipair.first;
 
     const auto &dict = std::dynamic_pointer_cast<OrderPreservingDictionary<T>>(tab->dictionaryAt(p->getTableColumnForColumn(field)));
@@ -104,7 +104,7 @@ void RadixCluster::executeClustering() {
       auto pc = mvt->containerAt(field);
       auto p = std::dynamic_pointer_cast<const PointerCalculator>(pc);
       if(p){
-        auto ipair = getDataVector(p->getActualTable());
+        auto ipair = getDataVector<BaseAttributeVector<value_id_t> >(p->getActualTable());
         const auto &ivec = ipair.first;
 
         const auto &dict = std::dynamic_pointer_cast<OrderPreservingDictionary<T>>(tab->dictionaryAt(p->getTableColumnForColumn(field)));
@@ -126,7 +126,7 @@ void RadixCluster::executeClustering() {
         throw std::runtime_error("Histogram only supports MutableVerticalTable of PointerCalculators; found other AbstractTable than PointerCalculator inside od MutableVerticalTable.");
       }
     } else {
-      auto ipair = getDataVector(tab);
+      auto ipair = getDataVector<BaseAttributeVector<value_id_t> >(tab);
       const auto &ivec = ipair.first;
       const auto &dict = std::dynamic_pointer_cast<OrderPreservingDictionary<T>>(tab->dictionaryAt(field));
       const auto &offset = field + ipair.second;
@@ -278,6 +278,11 @@ void RadixJoinTransformation::distributePartitions(
 }
 
 void RadixJoinTransformation::transform(Json::Value &op, const std::string &operatorId, Json::Value &query){
+  // Without explicit radix bits the RadixJoin operator partitions and
+  // joins by itself
+  if (!op.isMember("bits1"))
+    return;
+
   int probe_par = op["probe_par"].asInt();
   int hash_par = op["hash_par"].asInt();
   int join_par = op["join_par"].asInt();
@@ -88,7 +88,8 @@ void JsonTable::executePlanOperation() {
 			result->resize(rows);
 
 
-		set_string_value_functor fun(_useStoreFlag ? std::dynamic_pointer_cast<storage::Store>(result)->getDeltaTable() : result);
+		// The main of a new store is empty, so rows of the store are rows of its delta
+		set_string_value_functor fun(result);
 		hyrise::storage::type_switch<hyrise_basic_types> ts;
 
 
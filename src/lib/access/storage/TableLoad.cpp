@@ -7,6 +7,8 @@
 #include "io/shortcuts.h"
 #include "io/StorageManager.h"
 
+#include "memory/Allocator.h"
+
 #include "log4cxx/logger.h"
 
 namespace hyrise {
@@ -29,6 +31,7 @@ TableLoad::~TableLoad() {
 void TableLoad::executePlanOperation() {
   StorageManager *sm = StorageManager::getInstance();
   if (!sm->exists(_table_name)) {
+    memory::AllocatorScope allocator(_allocator);
 
     // Load Raw Table
     if (_raw) {
@@ -79,6 +82,7 @@ std::shared_ptr<PlanOperation> TableLoad::parse(const Json::Value &data) {
   if (data.isMember("delimiter")) {
     s->setDelimiter(data["delimiter"].asString());
   }
+  s->setAllocator(data["allocator"].asString());
   return s;
 }
 
@@ -119,5 +123,9 @@ void TableLoad::setDelimiter(const std::string &d) {
   _hasDelimiter = true;
 }
 
+void TableLoad::setAllocator(const std::string &allocator) {
+  _allocator = allocator;
+}
+
 }
 }
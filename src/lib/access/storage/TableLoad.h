@@ -29,6 +29,9 @@ public:
   void setUnsafe(const bool unsafe);
   void setRaw(const bool raw);
   void setDelimiter(const std::string &d);
+  /// Name of the memory::Allocator of the table's attribute vectors,
+  /// the current one if empty
+  void setAllocator(const std::string &allocator);
 
 private:
   std::string _table_name;
@@ -36,6 +39,7 @@ private:
   std::string _file_name;
   std::string _header_string;
   std::string _delimiter;
+  std::string _allocator;
   bool _hasDelimiter;
   bool _binary;
   bool _unsafe;
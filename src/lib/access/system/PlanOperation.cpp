@@ -5,12 +5,14 @@
 #include <thread>
 
 #include "access/system/ResponseTask.h"
+#include "access/system/WorkloadStatistics.h"
 #include "helper/epoch.h"
 #include "helper/PapiTracer.h"
 #include "io/StorageManager.h"
 #include "storage/AbstractResource.h"
 #include "storage/AbstractHashTable.h"
 #include "storage/AbstractTable.h"
+#include "storage/Store.h"
 #include "storage/TableRangeView.h"
 
 #include "boost/lexical_cast.hpp"
@@ -105,6 +107,30 @@ void PlanOperation::setupPlanOperation() {
 }
 
 
+void PlanOperation::accessedFields(field_list_t &fields) const {
+  fields.insert(fields.end(), _field_definition.begin(), _field_definition.end());
+}
+
+void PlanOperation::recordWorkload() {
+  if (input.numberOfTables() == 0)
+    return;
+
+  const auto& table = input.getTable(0);
+  storage::c_atable_ptr_t store = table;
+  // Parallel instances work on a range of the store
+  if (const auto& view = std::dynamic_pointer_cast<const storage::TableRangeView>(table))
+    store = view->getActualTable();
+  if (std::dynamic_pointer_cast<const storage::Store>(store) == nullptr)
+    return;
+
+  field_list_t fields;
+  accessedFields(fields);
+  double selectivity = 1.0;
+  if (output.numberOfTables() > 0 && table->size() > 0)
+    selectivity = static_cast<double>(output.getTable(0)->size()) / table->size();
+  WorkloadStatistics::getInstance().recordAccess(store, fields, selectivity);
+}
+
 void PlanOperation::refreshInput() {
   size_t numberOfDependencies = _dependencies.size();
   for (size_t i = 0; i < numberOfDependencies; ++i) {
@@ -136,6 +162,11 @@ void PlanOperation::operator()() noexcept {
 const PlanOperation * PlanOperation::execute() {
   epoch_t startTime = get_epoch_nanoseconds();
 
+  // Intermediates are allocated from the arena of the query
+  const auto responseTask = getResponseTask();
+  const auto arena = responseTask ? responseTask->getArena() : nullptr;
+  memory::ArenaScope arenaScope(arena.get());
+
   refreshInput();
 
   setupPlanOperation();
@@ -150,6 +181,9 @@ const PlanOperation * PlanOperation::execute() {
 
   teardownPlanOperation();
 
+  if (WorkloadStatistics::getInstance().isEnabled())
+    recordWorkload();
+
   epoch_t endTime = get_epoch_nanoseconds();
   std::string threadId = boost::lexical_cast<std::string>(std::this_thread::get_id());
 
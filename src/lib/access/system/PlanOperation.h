@@ -39,6 +39,13 @@ class PlanOperation : public OutputTask {
   virtual void executePlanOperation() = 0;
   virtual void teardownPlanOperation() {}
 
+  /// Appends the fields of the first input read by this operation; they
+  /// are recorded in the WorkloadStatistics if the first input is a
+  /// store. Defaults to the field definition.
+  virtual void accessedFields(field_list_t &fields) const;
+
+  void recordWorkload();
+
   /* Returns true when none of the dependencies have OpFail state */
   bool allDependenciesSuccessful();
 
@@ -34,6 +34,8 @@ bool registered = net::Router::registerRoute<RequestParseTask>(
     "/query/",
     net::Router::route_t::CATCH_ALL);
 
+bool registered_batch = net::Router::registerRoute<RequestParseTask>("/batch/");
+
 RequestParseTask::RequestParseTask(net::AbstractConnection* connection)
     : _connection(connection),
       _responseTask(std::make_shared<ResponseTask>(connection)),
@@ -66,6 +68,181 @@ std::string hash(const std::string &v) {
   return std::string(reinterpret_cast<const char*>(hash.data()), 20);
 }
 
+namespace {
+
+// Deserializes the plan of `request_data` into `tasks` running in `ctx`
+// and lets `response` answer once all of them finished. Returns the
+// priority of the query.
+int prepareQuery(Json::Value &request_data,
+                 const std::string &plan_hash,
+                 const tx::TXContext &ctx,
+                 const bool autocommit,
+                 const std::shared_ptr<ResponseTask> &response,
+                 std::vector<std::shared_ptr<Task> > &tasks) {
+  std::shared_ptr<Task> result = nullptr;
+  int priority = Task::DEFAULT_PRIORITY;
+  int sessionId = 0;
+
+  if(request_data.isMember("priority"))
+    priority = request_data["priority"].asInt();
+  if(request_data.isMember("sessionId"))
+    sessionId = request_data["sessionId"].asInt();
+  // Bytes the intermediates of the query may take, beyond them hash
+  // joins, aggregations and sorts spill to disk
+  if(request_data.isMember("memoryLimit"))
+    response->getArena()->setLimit(request_data["memoryLimit"].asUInt64());
+  response->setPriority(priority);
+  response->setSessionId(sessionId);
+  try {
+    tasks = QueryParser::instance().deserialize(
+              QueryTransformationEngine::getInstance()->transform(request_data),
+              &result);
+
+  } catch (const std::exception &ex) {
+    // clean up, so we don't end up with a whole mess due to thrown exceptions
+    LOG4CXX_ERROR(_logger, "Received\n:" << request_data);
+    LOG4CXX_ERROR(_logger, "Exception thrown during query deserialization:\n" << ex.what());
+    response->addErrorMessage(std::string("RequestParseTask: ") + ex.what());
+    tasks.clear();
+    result = nullptr;
+  }
+
+  if (autocommit && result != nullptr) {
+    auto commit = std::make_shared<Commit>();
+    commit->setOperatorId("__autocommit");
+    commit->setPlanOperationName("Commit");
+    commit->addDependency(result);
+    result = commit;
+    tasks.push_back(commit);
+  }
+
+
+  if (result != nullptr) {
+    response->addDependency(result);
+  } else {
+    LOG4CXX_ERROR(_logger, "Json did not yield tasks");
+  }
+
+  for (const auto & func: tasks) {
+    if (auto task = std::dynamic_pointer_cast<PlanOperation>(func)) {
+      task->setPriority(priority);
+      task->setSessionId(sessionId);
+      task->setPlanId(plan_hash);
+      task->setTXContext(ctx);
+      task->setId(ctx.tid);
+      response->registerPlanOperation(task);
+      if (!task->hasSuccessors()) {
+        // The response has to depend on all tasks, ie. we don't
+        // want to respond before all tasks finished running, even
+        // if they don't contribute to the result. This prevents
+        // dangling tasks
+        response->addDependency(task);
+      }
+    }
+  }
+  return priority;
+}
+
+// Runs `tasks` on the calling thread in the order of their dependencies
+void executeSequentially(const std::vector<std::shared_ptr<Task> > &tasks) {
+  int number_of_tasks = tasks.size();
+  std::vector<bool> isExecuted(number_of_tasks, false);
+  int executedTasks = 0;
+  while(executedTasks < number_of_tasks){
+    for(int i = 0; i < number_of_tasks; i++){
+      if(!isExecuted[i] && tasks[i]->isReady()){
+        (*tasks[i])();
+        tasks[i]->notifyDoneObservers();
+        executedTasks++;
+        isExecuted[i] = true;
+      }
+    }
+  }
+}
+
+// Keeps the response of one query of a batch instead of sending it
+class BatchResponse : public net::AbstractConnection {
+ public:
+  std::string getBody() const { return ""; }
+  std::string getPath() const { return ""; }
+  bool hasBody() const { return false; }
+  void respond(const std::string &message, size_t status, const std::string &contentType) {
+    _message = message;
+  }
+
+  // The response without the newline of the writer
+  std::string message() const {
+    return _message.substr(0, _message.find_last_not_of('\n') + 1);
+  }
+
+ private:
+  std::string _message;
+};
+
+}
+
+void RequestParseTask::executeBatch(const std::string &queries_string,
+                                    const std::map<std::string, std::string> &body_data,
+                                    const tx::TXContext &ctx) {
+  Json::Value queries;
+  Json::Reader reader;
+  if (!reader.parse(queries_string, queries) || !queries.isArray()) {
+    LOG4CXX_ERROR(_logger, "Failed to parse batch: " << queries_string);
+    _responseTask->addErrorMessage("RequestParseTask: queries need to be an array of plans");
+    _responseTask->setQueryStart(_queryStart);
+    (*_responseTask)();
+    _responseTask.reset();
+    return;
+  }
+
+  const bool recordPerformance = getOrDefault(body_data, "performance", "false") == "true";
+  const bool autocommit = getOrDefault(body_data, "autocommit", "false") == "true";
+  const long limit = atol(getOrDefault(body_data, "limit", "0").c_str());
+  const long offset = atol(getOrDefault(body_data, "offset", "0").c_str());
+  LOG4CXX_DEBUG(_query_logger, queries);
+
+  std::string results;
+  bool failed = false;
+  for (Json::ArrayIndex i = 0; i < queries.size(); ++i) {
+    BatchResponse batch_response;
+    auto response = std::make_shared<ResponseTask>(&batch_response);
+    response->setTxContext(ctx);
+    response->setRecordPerformanceData(recordPerformance);
+    if (limit > 0)
+      response->setTransmitLimit(limit);
+    if (offset > 0)
+      response->setTransmitOffset(offset);
+
+    // Only the last query commits, so all of them run in one transaction
+    std::vector<std::shared_ptr<Task> > tasks;
+    prepareQuery(queries[i], hash(Json::FastWriter().write(queries[i])), ctx,
+                 autocommit && i + 1 == queries.size(), response, tasks);
+    executeSequentially(tasks);
+    response->setQueryStart(_queryStart);
+    (*response)();
+
+    if (!results.empty())
+      results += ",";
+    results += batch_response.message();
+
+    // Later queries may depend on the failed one
+    if (response->getState() == OpFail || !response->getErrorMessages().empty()) {
+      failed = true;
+      break;
+    }
+  }
+
+  // With autocommit the transaction ends with the batch, a failed batch
+  // must not leave it running
+  if (failed && autocommit && tx::TransactionManager::isRunningTransaction(ctx.tid)) {
+    LOG4CXX_DEBUG(_logger, "Rolling back transaction " << ctx.tid << " of failed batch");
+    tx::TransactionManager::rollbackTransaction(ctx);
+  }
+
+  _connection->respond("{\"results\":[" + results + "]}\n");
+  _responseTask.reset();
+}
+
 void RequestParseTask::operator()() {
   assert((_responseTask != nullptr) && "Response needs to be set");
   const auto& scheduler = SharedScheduler::getInstance().getScheduler();
@@ -76,7 +253,6 @@ void RequestParseTask::operator()() {
   std::vector<std::shared_ptr<Task> > tasks;
 
   int priority = Task::DEFAULT_PRIORITY;
-  int sessionId = 0;
 
   if (_connection->hasBody()) {
     // The body is a wellformed HTTP Post body, with key value pairs
@@ -103,6 +279,13 @@ void RequestParseTask::operator()() {
     Json::Value request_data;
     Json::Reader reader;
 
+    // Several queries executed one after the other
+    auto queries_it = body_data.find("queries");
+    if (ctx && queries_it != body_data.end()) {
+      executeBatch(urldecode(queries_it->second), body_data, *ctx);
+      return;
+    }
+
     const std::string& query_string = urldecode(body_data["query"]);
 
     if (ctx && reader.parse(query_string, request_data)) {
@@ -116,64 +299,10 @@ void RequestParseTask::operator()() {
 
       LOG4CXX_DEBUG(_query_logger, request_data);
 
-      const std::string& final_hash = hash(query_string);
-      std::shared_ptr<Task> result = nullptr;
-
-      if(request_data.isMember("priority"))
-        priority = request_data["priority"].asInt();
-      if(request_data.isMember("sessionId"))
-        sessionId = request_data["sessionId"].asInt();
-      _responseTask->setPriority(priority);
-      _responseTask->setSessionId(sessionId);
-      _responseTask->setRecordPerformanceData(recordPerformance);
-      try {
-        tasks = QueryParser::instance().deserialize(
-                  QueryTransformationEngine::getInstance()->transform(request_data),
-                  &result);
-
-      } catch (const std::exception &ex) {
-        // clean up, so we don't end up with a whole mess due to thrown exceptions
-        LOG4CXX_ERROR(_logger, "Received\n:" << request_data);
-        LOG4CXX_ERROR(_logger, "Exception thrown during query deserialization:\n" << ex.what());
-        _responseTask->addErrorMessage(std::string("RequestParseTask: ") + ex.what());
-        tasks.clear();
-        result = nullptr;
-      }
-
       auto autocommit_it = body_data.find("autocommit");
-      if (autocommit_it != body_data.end() && (autocommit_it->second == "true")) {
-        auto commit = std::make_shared<Commit>();
-        commit->setOperatorId("__autocommit");
-        commit->setPlanOperationName("Commit");
-        commit->addDependency(result);
-        result = commit;
-        tasks.push_back(commit);
-      }
-
-
-      if (result != nullptr) {
-        _responseTask->addDependency(result);
-      } else {
-        LOG4CXX_ERROR(_logger, "Json did not yield tasks");
-      }
-
-      for (const auto & func: tasks) {
-        if (auto task = std::dynamic_pointer_cast<PlanOperation>(func)) {
-          task->setPriority(priority);
-          task->setSessionId(sessionId);
-          task->setPlanId(final_hash);
-          task->setTXContext(*ctx);
-	  task->setId((*ctx).tid);
-	  _responseTask->registerPlanOperation(task);
-          if (!task->hasSuccessors()) {
-            // The response has to depend on all tasks, ie. we don't
-            // want to respond before all tasks finished running, even
-            // if they don't contribute to the result. This prevents
-            // dangling tasks
-            _responseTask->addDependency(task);
-          }
-        }
-      }
+      const bool autocommit = autocommit_it != body_data.end() && (autocommit_it->second == "true");
+      _responseTask->setRecordPerformanceData(recordPerformance);
+      priority = prepareQuery(request_data, hash(query_string), *ctx, autocommit, _responseTask, tasks);
     } else {
       LOG4CXX_ERROR(_logger, "Failed to parse: "
                     << urldecode(body_data["query"]) << "\n"
@@ -202,19 +331,7 @@ void RequestParseTask::operator()() {
                                     boost::lexical_cast<std::string>(std::this_thread::get_id()) };
     }
 
-    int number_of_tasks = tasks.size();
-    std::vector<bool> isExecuted(number_of_tasks, false);
-    int executedTasks = 0;
-    while(executedTasks < number_of_tasks){
-      for(int i = 0; i < number_of_tasks; i++){
-        if(!isExecuted[i] && tasks[i]->isReady()){
-          (*tasks[i])();
-          tasks[i]->notifyDoneObservers();
-          executedTasks++;
-          isExecuted[i] = true;
-        }
-      }
-    }
+    executeSequentially(tasks);
     _responseTask->setQueryStart(_queryStart);
     (*_responseTask)();
     _responseTask.reset();  // yield responsibility
@@ -2,10 +2,12 @@
 #ifndef SRC_LIB_ACCESS_REQUESTPARSETASK_H_
 #define SRC_LIB_ACCESS_REQUESTPARSETASK_H_
 
+#include <map>
 #include <string>
 #include <memory>
 
 #include "helper/epoch.h"
+#include "io/TXContext.h"
 #include "net/Router.h"
 #include "net/AbstractConnection.h"
 
@@ -14,12 +16,24 @@ namespace access {
 
 class ResponseTask;
 
+/// Parses the plan of a query and schedules its plan operations.
+///
+/// A body with `queries` instead of `query` holds a batch: an array of
+/// plans executed one after the other by this task in one transaction,
+/// that of `session_context` if given. With `autocommit` the last query
+/// commits it. The response holds the responses of all queries in
+/// `results`, execution stops after the first failing one and, with
+/// `autocommit`, rolls the transaction back.
 class RequestParseTask : public net::AbstractRequestHandler {
  private:
   net::AbstractConnection *_connection;
   std::shared_ptr<ResponseTask> _responseTask;
   epoch_t _queryStart;
 
+  void executeBatch(const std::string &queries,
+                    const std::map<std::string, std::string> &body_data,
+                    const tx::TXContext &ctx);
+
  public:
   explicit RequestParseTask(net::AbstractConnection *connection);
   virtual ~RequestParseTask();
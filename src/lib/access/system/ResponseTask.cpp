@@ -182,6 +182,8 @@ void ResponseTask::operator()() {
 
         std::string threadId = boost::lexical_cast<std::string>(std::this_thread::get_id());
         responseElement["executingThread"] = Json::Value(threadId);
+        // Most memory the intermediates of the query took at the same time
+        responseElement["peakIntermediateBytes"] = Json::Value((Json::UInt64) getArena()->peakBytes());
         json_perf.append(responseElement);
 
         response["performanceData"] = json_perf;
@@ -211,6 +213,10 @@ void ResponseTask::operator()() {
 
   Json::FastWriter fw;
   connection->respond(fw.write(response));
+
+  // Chunks are freed as soon as the intermediates using them are gone
+  std::lock_guard<std::mutex> guard(arenaMutex);
+  _arena.reset();
 }
 
 }
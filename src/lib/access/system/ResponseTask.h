@@ -6,9 +6,11 @@
 #include <mutex>
 
 #include "helper/epoch.h"
+#include "helper/Settings.h"
 #include "access/system/OutputTask.h"
 #include "net/AbstractConnection.h"
 #include "io/TXContext.h"
+#include "memory/QueryArena.h"
 
 namespace hyrise {
 namespace access {
@@ -36,10 +38,16 @@ class ResponseTask : public Task {
 
   bool _recordPerformanceData = true;
 
+  // Intermediates of the query's plan operations, released once the
+  // response is sent
+  std::mutex arenaMutex;
+  std::shared_ptr<memory::QueryArena> _arena;
+
  public:
   explicit ResponseTask(net::AbstractConnection *connection) :
-      connection(connection) {
+      connection(connection), _arena(std::make_shared<memory::QueryArena>()) {
         _affectedRows = 0;
+        _arena->setLimit(Settings::getInstance()->getQueryMemoryLimit());
   }
 
   virtual ~ResponseTask() {}
@@ -83,6 +91,13 @@ class ResponseTask : public Task {
     _affectedRows += inc;
   }
 
+  /// Arena the plan operations of the query allocate intermediates from,
+  /// nullptr after the response was sent
+  std::shared_ptr<memory::QueryArena> getArena() {
+    std::lock_guard<std::mutex> guard(arenaMutex);
+    return _arena;
+  }
+
   performance_vector_t& getPerformanceData() {
     return performance_data;
   }
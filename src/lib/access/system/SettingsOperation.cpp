@@ -2,9 +2,12 @@
 #include "access/system/SettingsOperation.h"
 
 #include "access/system/QueryParser.h"
+#include "access/system/WorkloadStatistics.h"
 
 #include "helper/Settings.h"
 
+#include "memory/Allocator.h"
+
 namespace hyrise {
 namespace access {
 
@@ -19,12 +22,34 @@ SettingsOperation::~SettingsOperation() {
 }
 
 void SettingsOperation::executePlanOperation() {
-  Settings::getInstance()->setThreadpoolSize(_threadpoolSize);
+  if (_setThreadpoolSize)
+    Settings::getInstance()->setThreadpoolSize(_threadpoolSize);
+  if (_adaptiveLayout >= 0)
+    WorkloadStatistics::getInstance().setEnabled(_adaptiveLayout == 1);
+  if (_minLayoutImprovement >= 0.0)
+    WorkloadStatistics::getInstance().setMinImprovement(_minLayoutImprovement);
+  if (!_allocator.empty()) {
+    // Throws for unknown allocators
+    memory::Allocator::get(_allocator);
+    Settings::getInstance()->setAllocator(_allocator);
+  }
+  if (_setQueryMemoryLimit)
+    Settings::getInstance()->setQueryMemoryLimit(_queryMemoryLimit);
 }
 
 std::shared_ptr<PlanOperation> SettingsOperation::parse(const Json::Value &data) {
   std::shared_ptr<SettingsOperation> settingsOp = std::make_shared<SettingsOperation>();
-  settingsOp->setThreadpoolSize(data["threadpoolSize"].asUInt());
+  // Only the given settings are changed
+  if (data.isMember("threadpoolSize"))
+    settingsOp->setThreadpoolSize(data["threadpoolSize"].asUInt());
+  if (data.isMember("adaptiveLayout"))
+    settingsOp->setAdaptiveLayout(data["adaptiveLayout"].asBool());
+  if (data.isMember("minLayoutImprovement"))
+    settingsOp->setMinLayoutImprovement(data["minLayoutImprovement"].asDouble());
+  if (data.isMember("allocator"))
+    settingsOp->setAllocator(data["allocator"].asString());
+  if (data.isMember("queryMemoryLimit"))
+    settingsOp->setQueryMemoryLimit(data["queryMemoryLimit"].asUInt64());
   return settingsOp;
 }
 
@@ -34,6 +59,24 @@ const std::string SettingsOperation::vname() {
 
 void SettingsOperation::setThreadpoolSize(const size_t newSize) {
   _threadpoolSize = newSize;
+  _setThreadpoolSize = true;
+}
+
+void SettingsOperation::setAdaptiveLayout(const bool enabled) {
+  _adaptiveLayout = enabled ? 1 : 0;
+}
+
+void SettingsOperation::setMinLayoutImprovement(const double improvement) {
+  _minLayoutImprovement = improvement;
+}
+
+void SettingsOperation::setAllocator(const std::string &allocator) {
+  _allocator = allocator;
+}
+
+void SettingsOperation::setQueryMemoryLimit(const size_t bytes) {
+  _queryMemoryLimit = bytes;
+  _setQueryMemoryLimit = true;
 }
 
 }
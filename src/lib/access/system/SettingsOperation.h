@@ -9,6 +9,14 @@ namespace access {
 
 /// This operation is used to configure global settings as long as dedicated
 /// units handling such decisions are not implemented.
+/// {
+///     "type": "SettingsOperation",
+///     "threadpoolSize": 4,
+///     "adaptiveLayout": true,
+///     "minLayoutImprovement": 0.1,
+///     "allocator": "hugepage",
+///     "queryMemoryLimit": 1073741824
+/// }
 class SettingsOperation : public PlanOperation {
 public:
   SettingsOperation();
@@ -18,9 +26,24 @@ public:
   static std::shared_ptr<PlanOperation> parse(const Json::Value &data);
   const std::string vname();
   void setThreadpoolSize(const size_t newSize);
+  /// Enables the collection of WorkloadStatistics and layout changes
+  /// during merges
+  void setAdaptiveLayout(const bool enabled);
+  void setMinLayoutImprovement(const double improvement);
+  /// Default memory::Allocator of new attribute vectors
+  void setAllocator(const std::string &allocator);
+  /// Default memory limit of the intermediates of new queries in bytes,
+  /// 0 for none
+  void setQueryMemoryLimit(const size_t bytes);
 
 private:
   size_t _threadpoolSize;
+  bool _setThreadpoolSize = false;
+  int _adaptiveLayout = -1;
+  double _minLayoutImprovement = -1.0;
+  std::string _allocator;
+  size_t _queryMemoryLimit = 0;
+  bool _setQueryMemoryLimit = false;
 };
 
 }
@@ -0,0 +1,230 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "access/system/WorkloadStatistics.h"
+
+#include <algorithm>
+
+#include "helper/Environment.h"
+#include "layouter/incremental.h"
+#include "storage/Store.h"
+
+namespace hyrise {
+namespace access {
+
+namespace {
+
+// Accessed attributes and whether all rows were read
+typedef std::pair<layouter::subset_t, bool> pattern_key_t;
+
+struct AccessPattern {
+  size_t count = 0;
+  double selectivity = 0.0;
+};
+
+typedef std::map<pattern_key_t, AccessPattern> pattern_map_t;
+
+// The layouter does not know attribute sizes yet, compare
+// LayoutSingleTable
+const unsigned attribute_width = 4;
+
+void describe(const pattern_key_t &key, const AccessPattern &pattern, layouter::Query &query) {
+  query.weight = pattern.count;
+  query.parameter = key.second ? -1.0 : pattern.selectivity / pattern.count;
+}
+
+layouter::Query *makeQuery(const pattern_key_t &key, const AccessPattern &pattern) {
+  auto query = new layouter::Query(key.second ?
+                                   layouter::LayouterConfiguration::access_type_fullprojection :
+                                   layouter::LayouterConfiguration::access_type_outoforder,
+                                   key.first, 0.0, 0);
+  describe(key, pattern, *query);
+  return query;
+}
+
+// Splits the containers of `layout` into runs of adjacent attributes so
+// the partitioning can be applied without reordering columns
+WorkloadStatistics::layout_t adjacentContainers(const layouter::Layout::internal_layout_t &layout) {
+  WorkloadStatistics::layout_t result;
+  for (auto container : layout) {
+    std::sort(container.begin(), container.end());
+    for (size_t i = 0; i < container.size(); ++i) {
+      if (i == 0 || container[i] != container[i - 1] + 1)
+        result.push_back(field_list_t());
+      result.back().push_back(container[i]);
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+double layoutCost(layouter::BaseLayouter &layouter, const WorkloadStatistics::layout_t &layout) {
+  layouter::Layout::internal_layout_t containers;
+  for (const auto& fields : layout)
+    containers.push_back(layouter::subset_t(fields.begin(), fields.end()));
+  const auto& cost = layouter.getCost(layouter::Layout(containers));
+  double total = 0.0;
+  for (const auto& c : cost)
+    total += c;
+  return total;
+}
+
+}
+
+struct WorkloadStatistics::TableWorkload {
+  std::weak_ptr<const AbstractTable> table;
+  pattern_map_t patterns;
+
+  // Layouter state, guarded by layouter_mutex
+  std::mutex layouter_mutex;
+  std::unique_ptr<layouter::IncrementalCandidateLayouter> layouter;
+  // Patterns in the order of the queries in the layouter's schema
+  std::vector<pattern_key_t> layouted;
+  // The layouter keeps pointers to incrementally added queries
+  std::vector<std::unique_ptr<layouter::Query> > incremental_queries;
+  size_t full_layout_patterns = 0;
+  size_t full_layout_rows = 0;
+};
+
+WorkloadStatistics::WorkloadStatistics() : _enabled(getEnv("HYRISE_ADAPTIVE_LAYOUT", "0") == "1"),
+                                           _min_improvement(0.1) {
+}
+
+WorkloadStatistics &WorkloadStatistics::getInstance() {
+  static WorkloadStatistics statistics;
+  return statistics;
+}
+
+void WorkloadStatistics::setEnabled(const bool enabled) {
+  _enabled = enabled;
+}
+
+void WorkloadStatistics::setMinImprovement(const double improvement) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _min_improvement = improvement;
+}
+
+void WorkloadStatistics::recordAccess(const storage::c_atable_ptr_t &store,
+                                      const field_list_t &fields,
+                                      const double selectivity) {
+  if (fields.empty())
+    return;
+
+  layouter::subset_t attributes(fields.begin(), fields.end());
+  std::sort(attributes.begin(), attributes.end());
+  attributes.erase(std::unique(attributes.begin(), attributes.end()), attributes.end());
+  const bool full = selectivity >= 1.0;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _tables.find(store.get());
+  if (it == _tables.end() || it->second->table.expired()) {
+    // Either a new store or the address of a dropped one was reused
+    for (auto dropped = _tables.begin(); dropped != _tables.end();) {
+      if (dropped->second->table.expired())
+        dropped = _tables.erase(dropped);
+      else
+        ++dropped;
+    }
+    auto workload = std::make_shared<TableWorkload>();
+    workload->table = store;
+    it = _tables.insert(std::make_pair(store.get(), workload)).first;
+  }
+
+  auto& pattern = it->second->patterns[pattern_key_t(attributes, full)];
+  ++pattern.count;
+  pattern.selectivity += std::min(selectivity, 1.0);
+}
+
+WorkloadStatistics::layout_t WorkloadStatistics::proposeLayout(const storage::Store &store) {
+  std::shared_ptr<TableWorkload> workload;
+  pattern_map_t patterns;
+  double min_improvement;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _tables.find(&store);
+    if (it == _tables.end() || it->second->table.expired())
+      return layout_t();
+    workload = it->second;
+    patterns = workload->patterns;
+    min_improvement = _min_improvement;
+  }
+  if (patterns.empty())
+    return layout_t();
+
+  const auto& main = store.getMainTable();
+  const size_t rows = main->size();
+  std::lock_guard<std::mutex> lock(workload->layouter_mutex);
+
+  // The incremental layouter only adds queries to its last layout; start
+  // over when the workload or the table grew or shrank considerably
+  if (workload->layouter == nullptr ||
+      patterns.size() > 2 * workload->full_layout_patterns ||
+      rows > 2 * workload->full_layout_rows || 2 * rows < workload->full_layout_rows) {
+    std::vector<std::string> names;
+    for (size_t column = 0; column < main->columnCount(); ++column)
+      names.push_back(main->nameOfColumn(column));
+    layouter::Schema schema(std::vector<unsigned>(names.size(), attribute_width), rows, names);
+
+    workload->layouted.clear();
+    workload->incremental_queries.clear();
+    for (const auto& kv : patterns) {
+      // the schema copies the query
+      std::unique_ptr<layouter::Query> query(makeQuery(kv.first, kv.second));
+      schema.add(query.get());
+      workload->layouted.push_back(kv.first);
+    }
+
+    workload->layouter.reset(new layouter::IncrementalCandidateLayouter());
+    workload->layouter->setMaxResults(1);
+    workload->layouter->layout(schema, HYRISE_COST);
+    workload->full_layout_patterns = patterns.size();
+    workload->full_layout_rows = rows;
+  } else {
+    auto& queries = workload->layouter->schema.queries;
+    for (size_t i = 0; i < workload->layouted.size(); ++i)
+      describe(workload->layouted[i], patterns[workload->layouted[i]], *queries[i]);
+
+    for (const auto& kv : patterns) {
+      if (std::find(workload->layouted.begin(), workload->layouted.end(), kv.first) != workload->layouted.end())
+        continue;
+      workload->incremental_queries.emplace_back(makeQuery(kv.first, kv.second));
+      workload->layouter->incrementalLayout(workload->incremental_queries.back().get());
+      workload->layouted.push_back(kv.first);
+    }
+  }
+
+  const auto& proposed = adjacentContainers(workload->layouter->getBestResult().layout.raw());
+  const auto& current = currentLayout(store);
+  if (proposed == current)
+    return layout_t();
+
+  const double current_cost = layoutCost(*workload->layouter, current);
+  const double proposed_cost = layoutCost(*workload->layouter, proposed);
+  if (proposed_cost > current_cost * (1.0 - min_improvement))
+    return layout_t();
+  return proposed;
+}
+
+WorkloadStatistics::layout_t WorkloadStatistics::currentLayout(const storage::Store &store) {
+  const auto& main = store.getMainTable();
+  layout_t layout;
+  field_t column = 0;
+  for (size_t partition = 0; partition < main->partitionCount(); ++partition) {
+    layout.push_back(field_list_t());
+    for (size_t i = 0; i < main->partitionWidth(partition); ++i)
+      layout.back().push_back(column++);
+  }
+  return layout;
+}
+
+size_t WorkloadStatistics::patternCount(const storage::c_atable_ptr_t &store) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto it = _tables.find(store.get());
+  return it == _tables.end() ? 0 : it->second->patterns.size();
+}
+
+void WorkloadStatistics::clear() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _tables.clear();
+}
+
+}
+}
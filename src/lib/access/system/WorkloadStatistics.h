@@ -0,0 +1,84 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_ACCESS_SYSTEM_WORKLOADSTATISTICS_H_
+#define SRC_LIB_ACCESS_SYSTEM_WORKLOADSTATISTICS_H_
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "helper/types.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+class Store;
+}
+
+namespace access {
+
+/// Collects the attribute accesses of executed plan operations per store
+/// and derives vertical partitionings for them.
+///
+/// Every access is recorded as the set of attributes an operation reads
+/// together with its selectivity; accesses with the same attributes and
+/// kind (full projection or out of order) are aggregated into one weighted
+/// query of the layouter's cost model. When a store is merged, the
+/// aggregated workload is fed into an IncrementalCandidateLayouter that is
+/// kept per store: new access patterns are added incrementally, a full
+/// candidate layout is only computed initially and after the workload or
+/// the table changed considerably. The proposed layout is applied by
+/// MergeStore if it is cheaper than the current layout by at least the
+/// configured improvement.
+///
+/// Collection is disabled by default and enabled with the environment
+/// variable HYRISE_ADAPTIVE_LAYOUT=1 or the SettingsOperation.
+class WorkloadStatistics {
+public:
+  typedef std::vector<field_list_t> layout_t;
+
+  static WorkloadStatistics &getInstance();
+
+  bool isEnabled() const {
+    return _enabled;
+  }
+  void setEnabled(const bool enabled);
+
+  /// Minimum relative cost reduction a new layout has to achieve,
+  /// defaults to 0.1
+  void setMinImprovement(const double improvement);
+
+  /// Records that `fields` of `store` were read with the given selectivity
+  void recordAccess(const storage::c_atable_ptr_t &store, const field_list_t &fields, const double selectivity);
+
+  /// Returns the vertical partitioning that the collected workload
+  /// suggests for the main table of `store`, or an empty layout if it is
+  /// not beneficial to change the current one. Containers only hold
+  /// adjacent attributes, so the column order of the store is kept.
+  layout_t proposeLayout(const storage::Store &store);
+
+  /// Partitioning of the main table of `store`
+  static layout_t currentLayout(const storage::Store &store);
+
+  /// Number of distinct access patterns recorded for `store`
+  size_t patternCount(const storage::c_atable_ptr_t &store);
+
+  /// Drops all statistics
+  void clear();
+
+private:
+  struct TableWorkload;
+
+  WorkloadStatistics();
+
+  std::atomic<bool> _enabled;
+  double _min_improvement;
+  std::mutex _mutex;
+  std::map<const AbstractTable *, std::shared_ptr<TableWorkload> > _tables;
+};
+
+}
+}
+
+#endif  // SRC_LIB_ACCESS_SYSTEM_WORKLOADSTATISTICS_H_
@@ -7,6 +7,9 @@ Settings::Settings() : threadpoolSize(1) {
   // Initiate the class based on Enviroment Variables
   setDBPath(getEnv("HYRISE_DB_PATH", ""));
   setScriptPath(getEnv("HYRISE_SCRIPT_PATH", ""));
+  setAllocator(getEnv("HYRISE_ALLOCATOR", "malloc"));
+  setQueryMemoryLimit(std::stoull(getEnv("HYRISE_QUERY_MEMORY_LIMIT", "0")));
+  setSpillDirectory(getEnv("HYRISE_SPILL_DIRECTORY", "/tmp"));
 
 }
 
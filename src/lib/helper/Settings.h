@@ -23,6 +23,13 @@ class Settings {
 
   ADD_MEMBER(std::string, ScriptPath);
   ADD_MEMBER(std::string, DBPath);
+  // Name of the allocator of new attribute vectors, see memory/Allocator.h
+  ADD_MEMBER(std::string, Allocator);
+  // Bytes the intermediates of a query may take, 0 for no limit, see
+  // memory/QueryArena.h
+  ADD_MEMBER(size_t, QueryMemoryLimit);
+  // Directory of the files queries beyond their limit spill to
+  ADD_MEMBER(std::string, SpillDirectory);
 
   Settings();
 
@@ -0,0 +1,58 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_HELPER_PARALLEL_FOR_H_
+#define SRC_LIB_HELPER_PARALLEL_FOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hyrise { namespace helper {
+
+/// Threads parallelFor uses at most, one per hardware thread
+inline size_t maxParallelThreads() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/// Runs work(thread, i) for every i < count on at most `threads` threads,
+/// one of them the calling thread; fewer if there are fewer items or
+/// hardware threads. Threads take the next item from a shared counter.
+/// `thread` is below `threads` and calls with the same `thread` never run
+/// at the same time, so it can index per thread state. The first
+/// exception thrown by `work` is rethrown once all threads are done.
+///
+/// Plan operations use it to parallelize their own work: waiting for
+/// tasks of the shared scheduler from inside a task can deadlock.
+template <typename Work>
+void parallelFor(const size_t count, const size_t threads, Work work) {
+  const size_t used = std::min(std::min(threads, count), maxParallelThreads());
+  std::atomic<size_t> next(0);
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto worker = [&](const size_t thread) {
+    try {
+      for (size_t i = next++; i < count; i = next++)
+        work(thread, i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error)
+        error = std::current_exception();
+      next = count;
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (size_t thread = 1; thread < used; ++thread)
+    pool.emplace_back(worker, thread);
+  worker(0);
+  for (auto& thread : pool)
+    thread.join();
+  if (error)
+    std::rethrow_exception(error);
+}
+
+} } // namespace hyrise::helper
+
+#endif  // SRC_LIB_HELPER_PARALLEL_FOR_H_
@@ -8,6 +8,8 @@
 #include <memory>
 #include <vector>
 
+#include "memory/QueryArena.h"
+
 class AbstractResource;
 class AbstractTable;
 class AbstractIndex;
@@ -92,7 +94,8 @@ typedef size_t field_t;
 typedef std::string field_name_t;
 typedef std::vector<field_name_t> field_name_list_t;
 
-typedef std::vector<pos_t> pos_list_t;
+// Positions of intermediate results use the arena of the query
+typedef std::vector<pos_t, hyrise::memory::ArenaAllocator<pos_t> > pos_list_t;
 typedef std::vector<field_t> field_list_t;
 }
 
@@ -1,18 +1,23 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include "io/Loader.h"
 
+#include <set>
+
 #include <log4cxx/logger.h>
 
 #include "io/EmptyLoader.h"
 #include "io/LoaderException.h"
+#include "memory/Allocator.h"
 #include "storage/AbstractTable.h"
 #include "storage/AbstractMergeStrategy.h"
+#include "storage/BitCompressedVector.h"
 #include "storage/SequentialHeapMerger.h"
 #include "storage/SimpleStore.h"
 #include "storage/Store.h"
 #include "storage/TableFactory.h"
 #include "storage/TableGenerator.h"
 #include "storage/MutableVerticalTable.h"
+#include "storage/Table.h"
 
 using namespace hyrise;
 
@@ -25,6 +30,7 @@ param_member_impl(Loader::params, AbstractTableFactory *, Factory)
 param_member_impl(Loader::params, bool, ModifiableMutableVerticalTable)
 param_member_impl(Loader::params, bool, ReturnsMutableVerticalTable)
 param_member_impl(Loader::params, bool, Compressed)
+param_member_impl(Loader::params, std::string, Allocator)
 param_member_impl(Loader::params, hyrise::storage::c_atable_ptr_t, ReferenceTable)
 
 Loader::params::params() :
@@ -34,7 +40,8 @@ Loader::params::params() :
   BasePath(""),
   ModifiableMutableVerticalTable(false),
   ReturnsMutableVerticalTable(false),
-  Compressed(false),
+  Compressed(true),
+  Allocator(""),
   ReferenceTable()
 {}
 
@@ -43,7 +50,8 @@ Loader::params::params(const Loader::params &other) :
   BasePath(other.getBasePath()),
   ModifiableMutableVerticalTable(other.getModifiableMutableVerticalTable()),
   ReturnsMutableVerticalTable(other.getReturnsMutableVerticalTable()),
-  Compressed(other.getCompressed()) {
+  Compressed(other.getCompressed()),
+  Allocator(other.getAllocator()) {
   if (other.Input != nullptr) Input = other.Input->clone();
   if (other.Header != nullptr) Header = other.Header->clone();
   if (other.ReferenceTable != nullptr) ReferenceTable = other.ReferenceTable;
@@ -60,6 +68,7 @@ Loader::params &Loader::params::operator= (const Loader::params &other) {
     setReturnsMutableVerticalTable(other.getReturnsMutableVerticalTable());
     setModifiableMutableVerticalTable(other.getModifiableMutableVerticalTable());
     setCompressed(other.getCompressed());
+    setAllocator(other.getAllocator());
     setReferenceTable(other.getReferenceTable());
   }
   // by convention, always return *this
@@ -76,6 +85,7 @@ Loader::params *Loader::params::clone() const {
   p->setModifiableMutableVerticalTable(ModifiableMutableVerticalTable);
   p->setReferenceTable(ReferenceTable);
   p->setCompressed(Compressed);
+  p->setAllocator(Allocator);
   return p;
 }
 
@@ -84,7 +94,40 @@ Loader::params::~params() {
   if (Input != nullptr) delete Header;
 }
 
+namespace {
+
+// Stores every container of a loaded main in a bit compressed vector with
+// the minimal width for the dictionary of each column. Inputs write the
+// columns from parallel threads, so they load into fixed length vectors.
+void compressMain(const hyrise::storage::atable_ptr_t &main) {
+  const auto vertical = std::dynamic_pointer_cast<storage::MutableVerticalTable>(main);
+  std::set<AbstractTable *> done;
+  for (size_t column = 0; column < main->columnCount(); ++column) {
+    const auto table = std::dynamic_pointer_cast<Table>(vertical ? vertical->containerAt(column) : main);
+    if (table == nullptr || !done.insert(table.get()).second)
+      continue;
+
+    std::vector<uint64_t> bits;
+    for (size_t col = 0; col < table->columnCount(); ++col)
+      bits.push_back(bitsForValues(table->dictionaryAt(col)->size()));
+
+    const size_t rows = table->size();
+    auto packed = std::make_shared<BitCompressedVector<value_id_t>>(table->columnCount(), rows, bits);
+    packed->resize(rows);
+    for (size_t col = 0; col < table->columnCount(); ++col)
+      for (size_t row = 0; row < rows; ++row)
+        packed->set(col, row, table->getValueId(col, row).valueId);
+    table->setAttributes(packed);
+  }
+}
+
+}  // namespace
+
 std::shared_ptr<AbstractTable> Loader::load(const params &args) {
+  // All vectors of the table, including the main of its store, use the
+  // allocator of the parameters
+  hyrise::memory::AllocatorScope allocator(args.getAllocator());
+
   AbstractHeader *header = args.getHeader();
   AbstractTableFactory *factory = args.getFactory();
   AbstractInput *input = args.getInput();
@@ -130,6 +173,13 @@ std::shared_ptr<AbstractTable> Loader::load(const params &args) {
 
   LOG4CXX_DEBUG(logger, "Data done");
 
+  if (!args.getModifiableMutableVerticalTable() && !input->needs_store_wrap() && args.getCompressed()) {
+    // The input built the main itself, its widths are known once loaded
+    const auto store = std::dynamic_pointer_cast<storage::Store>(result);
+    if (store)
+      compressMain(store->getMainTable());
+  }
+
   if (!args.getModifiableMutableVerticalTable() && input->needs_store_wrap()) {
     auto s = std::make_shared<storage::Store>(result);
     TableMerger *merger = new TableMerger(new DefaultMergeStrategy(), new SequentialHeapMerger(), args.getCompressed());
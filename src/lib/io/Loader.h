@@ -35,8 +35,11 @@ private:
   param_member(bool, ModifiableMutableVerticalTable);
   /// Return result without wrapping in Store
   param_member(bool, ReturnsMutableVerticalTable);
-  /// Use bitcompressed table
+  /// Store the main with the minimal bit width per column (default)
   param_member(bool, Compressed);
+  /// Allocator of the attribute vectors of the table, see
+  /// memory/Allocator.h (default: the one of Settings)
+  param_member(std::string, Allocator);
   /// Reference table used for type detection
   param_member(hyrise::storage::c_atable_ptr_t , ReferenceTable);
 public:
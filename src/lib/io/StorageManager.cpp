@@ -18,6 +18,7 @@
 #include "helper/Environment.h"
 #include "io/Loader.h"
 #include "io/CSVLoader.h"
+#include "storage/AbstractHashTable.h"
 #include "storage/AbstractIndex.h"
 #include "storage/AbstractTable.h"
 #include "storage/ColumnMetadata.h"
@@ -100,6 +101,19 @@ std::vector<std::string> StorageManager::getTableNames() const {
   return ret;
 }
 
+std::map<std::string, size_t> StorageManager::memoryUsage() const {
+  std::map<std::string, size_t> result;
+  for (const auto &resource : all()) {
+    if (const auto table = std::dynamic_pointer_cast<AbstractTable>(resource.second))
+      result[resource.first] = table->bytes();
+    else if (const auto index = std::dynamic_pointer_cast<AbstractIndex>(resource.second))
+      result[resource.first] = index->bytes();
+    else if (const auto hash_table = std::dynamic_pointer_cast<AbstractHashTable>(resource.second))
+      result[resource.first] = hash_table->bytes();
+  }
+  return result;
+}
+
 void StorageManager::removeAll() {
   ResourceManager::clear();
 }
@@ -79,6 +79,10 @@ class StorageManager : public ResourceManager {
   /// Retrieve all table names
   std::vector<std::string> getTableNames() const;
 
+  /// Approximate bytes of every table, index and hash table by name,
+  /// see AbstractTable::bytes
+  std::map<std::string, size_t> memoryUsage() const;
+
   /// Prints all Resources
   void printResources() const;
 
@@ -3,12 +3,16 @@
 #include "layout_utils.h"
 #include "matrix.h"
 
+#include "helper/parallel_for.h"
+
 #include <algorithm>
+#include <atomic>
 #include <float.h>
 #include <functional>
 #include <limits.h>
 #include <math.h>
 #include <map>
+#include <mutex>
 #include <sstream>
 #include <unordered_map>
 #include <list>
@@ -425,7 +429,15 @@ Schema Schema::baseCopy() const {
   return result;
 }
 
-BaseLayouter::BaseLayouter(): nbLayouts(0) {
+BaseLayouter::BaseLayouter(): nbLayouts(0), _maxResults(0), _threads(0) {
+}
+
+void BaseLayouter::setMaxResults(size_t n) {
+  _maxResults = n;
+}
+
+void BaseLayouter::setThreads(size_t n) {
+  _threads = n;
 }
 
 void BaseLayouter::layout(Schema s, std::string cM) {
@@ -662,7 +674,12 @@ std::vector<std::vector<subset_t> > BaseLayouter::iterateThroughLayoutSubsetsFas
   
 void BaseLayouter::iterateThroughLayouts() {
   std::sort(subsets.begin(), subsets.end(), subset_t_lt);
-  
+
+  if (_maxResults > 0) {
+    searchLayouts();
+    return;
+  }
+
   if (subsets.size() == 1) {
     Layout l;
     l.add(subsets[0]);
@@ -716,6 +733,269 @@ void BaseLayouter::iterateThroughLayouts() {
   }
 }
 
+namespace {
+
+// Computes Schema::costForSubset for all subsets. Queries keep
+// intermediate state while calculating costs, so every thread works on
+// its own copies.
+std::vector<double> subsetCosts(const std::vector<subset_t> &subsets, const Schema &schema,
+                                const std::string &costModel, size_t threads) {
+  std::vector<double> cost(subsets.size(), 0.0);
+  std::vector<std::vector<Query> > queries(threads);
+  for (auto& local : queries)
+    for (const auto* q : schema.queries)
+      local.push_back(*q);
+
+  hyrise::helper::parallelFor(subsets.size(), threads, [&](size_t thread, size_t i) {
+    for (auto& q : queries[thread])
+      cost[i] += q.containerCost(subsets[i], schema, costModel);
+  });
+  return cost;
+}
+
+/*
+  Branch-and-bound search for the cheapest partitionings of the
+  attributes into the given subsets.
+
+  The cost of a layout is the sum of the cost of its containers. Every
+  step picks the lowest uncovered attribute and tries all subsets
+  containing it that do not overlap the partial layout, so every
+  layout is visited once. A partial layout is pruned if its cost plus
+  a lower bound for the uncovered attributes exceeds the cost of the
+  worst of the best layouts found so far; the bound is shared between
+  threads. The lower bound charges each uncovered attribute with the
+  smallest share of the cost of a subset containing it.
+
+  Layouts of equal cost are ranked like in the exhaustive enumeration,
+  by number of containers first and by their subsets second, so the
+  result does not depend on the number of threads.
+*/
+class BoundedSearch {
+ public:
+  struct Candidate {
+    double cost;
+    std::vector<size_t> subsets;
+
+    bool operator<(const Candidate &other) const {
+      if (cost != other.cost)
+        return cost < other.cost;
+      if (subsets.size() != other.subsets.size())
+        return subsets.size() < other.subsets.size();
+      return subsets < other.subsets;
+    }
+  };
+
+  BoundedSearch(const std::vector<subset_t> &subsets, const std::vector<double> &cost,
+                size_t nbAttributes, size_t maxResults) :
+      _cost(cost), _maxResults(maxResults), _bound(std::numeric_limits<double>::infinity()),
+      _boundContainers(0), _evaluated(0) {
+    std::vector<unsigned> ids;
+    for (const auto& s : subsets)
+      ids.insert(ids.end(), s.begin(), s.end());
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    // Layouts have to cover exactly nbAttributes attributes
+    _feasible = ids.size() == nbAttributes;
+
+    _attributes.resize(subsets.size());
+    _containing.resize(ids.size());
+    _minShare.assign(ids.size(), std::numeric_limits<double>::infinity());
+    for (size_t i = 0; i < subsets.size(); ++i) {
+      for (const auto& id : subsets[i]) {
+        const size_t a = std::lower_bound(ids.begin(), ids.end(), id) - ids.begin();
+        _attributes[i].push_back(a);
+        _containing[a].push_back(i);
+        _minShare[a] = std::min(_minShare[a], cost[i] / subsets[i].size());
+      }
+    }
+  }
+
+  // Splits the search into at least minTasks partial layouts if possible
+  std::vector<std::vector<size_t> > split(size_t minTasks) const {
+    std::vector<std::vector<size_t> > tasks(_feasible ? 1 : 0);
+    for (size_t depth = 0; depth < 3 && tasks.size() < minTasks; ++depth) {
+      std::vector<std::vector<size_t> > next;
+      for (const auto& prefix : tasks) {
+        std::vector<char> covered(_containing.size(), 0);
+        for (const auto& s : prefix)
+          mark(covered, s, 1);
+        const size_t a = nextUncovered(covered, 0);
+        if (a == covered.size()) {
+          next.push_back(prefix);
+          continue;
+        }
+        for (const auto& s : _containing[a]) {
+          if (fits(covered, s)) {
+            next.push_back(prefix);
+            next.back().push_back(s);
+          }
+        }
+      }
+      tasks.swap(next);
+    }
+    return tasks;
+  }
+
+  void run(const std::vector<size_t> &prefix) {
+    std::vector<char> covered(_containing.size(), 0);
+    double cost = 0.0;
+    double lowerBound = 0.0;
+    for (const auto& share : _minShare)
+      lowerBound += share;
+    for (const auto& s : prefix) {
+      mark(covered, s, 1);
+      cost += _cost[s];
+      lowerBound -= shareOf(s);
+    }
+
+    std::vector<size_t> chosen(prefix);
+    if (!pruned(cost + lowerBound, minContainers(covered, chosen)))
+      search(covered, 0, chosen, cost, lowerBound);
+  }
+
+  // The best layouts, cheapest first
+  std::vector<Candidate> results() {
+    std::sort_heap(_best.begin(), _best.end());
+    return _best;
+  }
+
+  size_t evaluated() const {
+    return _evaluated;
+  }
+
+ private:
+  void search(std::vector<char> &covered, size_t from, std::vector<size_t> &chosen, double cost, double lowerBound) {
+    const size_t a = nextUncovered(covered, from);
+    if (a == covered.size()) {
+      ++_evaluated;
+      offer(cost, chosen);
+      return;
+    }
+
+    for (const auto& s : _containing[a]) {
+      if (!fits(covered, s))
+        continue;
+      const double c = cost + _cost[s];
+      const double l = lowerBound - shareOf(s);
+      mark(covered, s, 1);
+      chosen.push_back(s);
+      if (!pruned(c + l, minContainers(covered, chosen)))
+        search(covered, a + 1, chosen, c, l);
+      chosen.pop_back();
+      mark(covered, s, 0);
+    }
+  }
+
+  void offer(double cost, const std::vector<size_t> &chosen) {
+    Candidate candidate = {cost, chosen};
+    // Containers keep the order of the subsets, like in the exhaustive
+    // enumeration
+    std::sort(candidate.subsets.begin(), candidate.subsets.end());
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_best.size() < _maxResults) {
+      _best.push_back(candidate);
+      std::push_heap(_best.begin(), _best.end());
+    } else if (candidate < _best.front()) {
+      std::pop_heap(_best.begin(), _best.end());
+      _best.back() = candidate;
+      std::push_heap(_best.begin(), _best.end());
+    }
+    if (_best.size() == _maxResults) {
+      _boundContainers = _best.front().subsets.size();
+      _bound = _best.front().cost;
+    }
+  }
+
+  // Whether a partial layout with at least the given cost and number of
+  // containers cannot be among the best layouts. The bound only
+  // decreases, so a stale bound just prunes less.
+  bool pruned(double minCost, size_t minContainers) {
+    // Tolerate rounding errors of the incrementally computed bound
+    if (minCost > _bound.load() * (1.0 + 1e-9))
+      return true;
+    if (minCost < _bound.load() * (1.0 - 1e-9))
+      return false;
+
+    // Layouts as expensive as the bound may still win by having fewer
+    // containers
+    std::lock_guard<std::mutex> lock(_mutex);
+    return minCost > _bound * (1.0 + 1e-9) || minContainers > _boundContainers;
+  }
+
+  size_t minContainers(const std::vector<char> &covered, const std::vector<size_t> &chosen) const {
+    return chosen.size() + (nextUncovered(covered, 0) < covered.size() ? 1 : 0);
+  }
+
+  double shareOf(size_t s) const {
+    double share = 0.0;
+    for (const auto& a : _attributes[s])
+      share += _minShare[a];
+    return share;
+  }
+
+  bool fits(const std::vector<char> &covered, size_t s) const {
+    for (const auto& a : _attributes[s])
+      if (covered[a])
+        return false;
+    return true;
+  }
+
+  void mark(std::vector<char> &covered, size_t s, char value) const {
+    for (const auto& a : _attributes[s])
+      covered[a] = value;
+  }
+
+  size_t nextUncovered(const std::vector<char> &covered, size_t from) const {
+    while (from < covered.size() && covered[from])
+      ++from;
+    return from;
+  }
+
+  const std::vector<double> &_cost;
+  const size_t _maxResults;
+  bool _feasible;
+  // Dense attribute indices of every subset
+  std::vector<std::vector<size_t> > _attributes;
+  // Subsets containing an attribute
+  std::vector<std::vector<size_t> > _containing;
+  std::vector<double> _minShare;
+
+  std::mutex _mutex;
+  // Max-heap of the best layouts found so far
+  std::vector<Candidate> _best;
+  std::atomic<double> _bound;
+  size_t _boundContainers;
+  std::atomic<size_t> _evaluated;
+};
+
+}
+
+void BaseLayouter::searchLayouts() {
+  size_t threads = _threads;
+  if (threads == 0)
+    threads = hyrise::helper::maxParallelThreads();
+
+  const auto& cost = subsetCosts(subsets, schema, costModel, std::max<size_t>(1, std::min(threads, subsets.size())));
+  BoundedSearch search(subsets, cost, schema.nbAttributes, _maxResults);
+  const auto& tasks = search.split(4 * threads);
+  hyrise::helper::parallelFor(tasks.size(), std::min(threads, tasks.size()), [&](size_t, size_t i) {
+    search.run(tasks[i]);
+  });
+
+  const auto& best = search.results();
+  if (best.empty())
+    throw std::runtime_error("No layout of the subsets covers every attribute exactly once");
+  for (const auto& candidate : best) {
+    Layout l;
+    for (const auto& s : candidate.subsets)
+      l.add(subsets[s]);
+    Result r(l, getCost(l));
+    results.push_back(r);
+  }
+  nbLayouts += search.evaluated();
+}
+
 void BaseLayouter::generateLayouts(Layout layout, size_t iter) {
   // only continue if we are save
   if (iter >= subsets.size()) {
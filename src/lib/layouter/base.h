@@ -262,6 +262,21 @@ class BaseLayouter {
 
   void iterateThroughLayouts();
 
+  /*
+    Limits the results to the n cheapest layouts. Instead of
+    enumerating all layouts, iterateThroughLayouts then performs a
+    parallel branch-and-bound search over the subsets that prunes
+    every partial layout whose cost plus a lower bound for the
+    uncovered attributes exceeds the cost of the n-th best layout
+    found so far. The search throws if no layout of the subsets covers
+    every attribute exactly once. 0 enumerates all layouts.
+  */
+  void setMaxResults(size_t n);
+
+  // Number of threads for the bounded search, 0 uses all hardware
+  // threads
+  void setThreads(size_t n);
+
   void generateLayouts(Layout l, size_t iter);
 
   bool tryToAddSubset(const Layout &l, const subset_t &subset) const;
@@ -295,6 +310,11 @@ class BaseLayouter {
 
   void iterateLayoutSubsets(subset_t input, Layout::internal_layout_t subsets);
 
+  void searchLayouts();
+
+  size_t _maxResults;
+  size_t _threads;
+
 
   Layout::internal_layout_t eliminateInvalidSubsets(subset_t reference, Layout::internal_layout_t input);
 
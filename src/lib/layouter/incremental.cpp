@@ -148,6 +148,8 @@ void IncrementalCandidateLayouter::incrementalLayout(Query *q) {
   // Now we instantiate a new base layouter and find all
   // matching layouts
   CandidateLayouter bl;
+  bl.setMaxResults(1);
+  bl.setThreads(_threads);
   Schema mappedSchema = buildSchema(qa, q);
 
   bl.layout(mappedSchema, HYRISE_COST);
@@ -0,0 +1,99 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "memory/Allocator.h"
+
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+#include "helper/Settings.h"
+#include "memory/HugePageAllocator.h"
+#include "memory/MallocStrategy.h"
+#include "memory/NumaAllocator.h"
+#include "memory/PoolAllocator.h"
+
+namespace hyrise {
+namespace memory {
+
+namespace {
+
+class MallocAllocator : public Allocator {
+ public:
+  void *allocate(size_t bytes) {
+    return MallocStrategy::allocate(bytes);
+  }
+
+  void *reallocate(void *old, size_t bytes, size_t old_bytes) {
+    return MallocStrategy::reallocate(old, bytes, old_bytes);
+  }
+
+  void deallocate(void *p, size_t bytes) {
+    MallocStrategy::deallocate(p, bytes);
+  }
+
+  std::string name() const {
+    return "malloc";
+  }
+};
+
+Allocator *create(const std::string &name) {
+  if (name == "malloc")
+    return new MallocAllocator();
+  if (name == "hugepage")
+    return new HugePageAllocator();
+  if (name == "pool")
+    return new PoolAllocator();
+  if (name == "numa")
+    return new NumaAllocator();
+  if (name.compare(0, 5, "numa:") == 0) {
+    size_t end = 0;
+    int node = -1;
+    try {
+      node = std::stoi(name.substr(5), &end);
+    } catch (const std::logic_error &) {
+      end = 0;
+    }
+    if (end > 0 && end == name.size() - 5 && node >= 0)
+      return new NumaAllocator(node);
+  }
+  throw std::runtime_error("Unknown allocator '" + name + "'");
+}
+
+thread_local Allocator *scoped = nullptr;
+
+}
+
+Allocator *Allocator::get(const std::string &name) {
+  static std::mutex mutex;
+  static std::map<std::string, Allocator *> allocators;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& allocator = allocators[name];
+  if (allocator == nullptr) {
+    try {
+      allocator = create(name);
+    } catch (...) {
+      allocators.erase(name);
+      throw;
+    }
+  }
+  return allocator;
+}
+
+Allocator *Allocator::current() {
+  return scoped ? scoped : get(Settings::getInstance()->getAllocator());
+}
+
+AllocatorScope::AllocatorScope(Allocator *allocator) : _previous(scoped) {
+  scoped = allocator;
+}
+
+AllocatorScope::AllocatorScope(const std::string &name) : _previous(scoped) {
+  if (!name.empty())
+    scoped = Allocator::get(name);
+}
+
+AllocatorScope::~AllocatorScope() {
+  scoped = _previous;
+}
+
+}
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_MEMORY_ALLOCATOR_H_
+#define SRC_LIB_MEMORY_ALLOCATOR_H_
+
+#include <cstddef>
+#include <string>
+
+#include "helper/noncopyable.h"
+
+namespace hyrise {
+namespace memory {
+
+///
+/// Allocates the memory of attribute vectors (FixedLengthVector and
+/// BitCompressedVector). A vector keeps the allocator that was current
+/// when it was created and returns its memory to it.
+///
+/// Allocators are looked up by name:
+///  - "malloc": MallocStrategy, the default
+///  - "hugepage": HugePageAllocator, huge page backed mappings for large
+///    columns that grow with mremap
+///  - "numa" or "numa:<node>": NumaAllocator, memory of the local or of
+///    the given NUMA node
+///  - "pool": PoolAllocator, size classes for small intermediate vectors
+///
+/// The current allocator of a thread is the one of its innermost
+/// AllocatorScope, e.g. of a table loaded with Loader::params::setAllocator,
+/// or else the one named by Settings::setAllocator.
+///
+class Allocator {
+ public:
+  virtual ~Allocator() {}
+
+  /// Returns nullptr if the memory cannot be allocated
+  virtual void *allocate(size_t bytes) = 0;
+  /// Grows or shrinks `old`, which has `old_bytes`, to `bytes` and keeps
+  /// its contents; `old` may be nullptr
+  virtual void *reallocate(void *old, size_t bytes, size_t old_bytes) = 0;
+  /// `bytes` have to be the bytes `p` was allocated with
+  virtual void deallocate(void *p, size_t bytes) = 0;
+
+  virtual std::string name() const = 0;
+
+  /// Allocator named `name`, throws std::runtime_error for unknown names.
+  /// Allocators live until the process ends.
+  static Allocator *get(const std::string &name);
+
+  /// Allocator new vectors of the calling thread use
+  static Allocator *current();
+};
+
+/// Makes an allocator the current one of the calling thread until the
+/// scope ends
+class AllocatorScope : private noncopyable {
+ public:
+  explicit AllocatorScope(Allocator *allocator);
+  /// Keeps the current allocator for an empty name
+  explicit AllocatorScope(const std::string &name);
+  ~AllocatorScope();
+
+ private:
+  Allocator *_previous;
+};
+
+}
+}
+
+#endif  // SRC_LIB_MEMORY_ALLOCATOR_H_
@@ -0,0 +1,79 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "memory/HugePageAllocator.h"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "memory/MallocStrategy.h"
+
+namespace hyrise {
+namespace memory {
+
+namespace {
+
+void *map(const size_t bytes) {
+  void *p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+  if (p == MAP_FAILED) {
+    // No reserved huge pages, ask for transparent ones
+    p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+      return nullptr;
+#ifdef MADV_HUGEPAGE
+    madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+  }
+  return p;
+}
+
+}
+
+const size_t HugePageAllocator::huge_page_size;
+
+void *HugePageAllocator::allocate(size_t bytes) {
+  if (!mapped(bytes))
+    return MallocStrategy::allocate(bytes);
+  return map(mappedBytes(bytes));
+}
+
+void *HugePageAllocator::reallocate(void *old, size_t bytes, size_t old_bytes) {
+  if (old == nullptr)
+    return allocate(bytes);
+  if (!mapped(bytes) && !mapped(old_bytes))
+    return MallocStrategy::reallocate(old, bytes, old_bytes);
+
+  if (mapped(bytes) && mapped(old_bytes)) {
+    if (mappedBytes(bytes) == mappedBytes(old_bytes))
+      return old;
+    void *p = mremap(old, mappedBytes(old_bytes), mappedBytes(bytes), MREMAP_MAYMOVE);
+    return p == MAP_FAILED ? nullptr : p;
+  }
+
+  // From malloc to a mapping or back
+  void *p = allocate(bytes);
+  if (p == nullptr)
+    return nullptr;
+  std::memcpy(p, old, std::min(bytes, old_bytes));
+  deallocate(old, old_bytes);
+  return p;
+}
+
+void HugePageAllocator::deallocate(void *p, size_t bytes) {
+  if (p == nullptr)
+    return;
+  if (!mapped(bytes))
+    MallocStrategy::deallocate(p, bytes);
+  else
+    munmap(p, mappedBytes(bytes));
+}
+
+std::string HugePageAllocator::name() const {
+  return "hugepage";
+}
+
+}
+}
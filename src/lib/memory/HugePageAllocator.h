@@ -0,0 +1,40 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_MEMORY_HUGEPAGEALLOCATOR_H_
+#define SRC_LIB_MEMORY_HUGEPAGEALLOCATOR_H_
+
+#include "memory/Allocator.h"
+
+namespace hyrise {
+namespace memory {
+
+///
+/// Maps allocations of at least one huge page (2 MB) anonymously, with
+/// MAP_HUGETLB if the system reserved huge pages and otherwise with a
+/// transparent huge page hint (MADV_HUGEPAGE). Mappings grow with mremap,
+/// so large columns are not copied when they grow. Smaller allocations use
+/// MallocStrategy.
+///
+class HugePageAllocator : public Allocator {
+ public:
+  static const size_t huge_page_size = 2 * 1024 * 1024;
+
+  void *allocate(size_t bytes);
+  void *reallocate(void *old, size_t bytes, size_t old_bytes);
+  void deallocate(void *p, size_t bytes);
+  std::string name() const;
+
+  /// Whether allocations of `bytes` are mapped
+  static bool mapped(size_t bytes) {
+    return bytes >= huge_page_size;
+  }
+
+  /// Bytes of the mapping for an allocation of `bytes`
+  static size_t mappedBytes(size_t bytes) {
+    return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+  }
+};
+
+}
+}
+
+#endif  // SRC_LIB_MEMORY_HUGEPAGEALLOCATOR_H_
@@ -0,0 +1,68 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "memory/NumaAllocator.h"
+
+#include <stdexcept>
+
+#ifdef WITH_NUMA
+#include <numa.h>
+#endif
+
+#include "memory/MallocStrategy.h"
+
+namespace hyrise {
+namespace memory {
+
+namespace {
+
+// libnuma cannot map empty allocations
+size_t nonEmpty(const size_t bytes) {
+  return bytes == 0 ? 1 : bytes;
+}
+
+}
+
+NumaAllocator::NumaAllocator(int node) : _node(node), _numa(false) {
+#ifdef WITH_NUMA
+  _numa = numa_available() >= 0;
+  if (_numa && _node > numa_max_node())
+    throw std::runtime_error("NUMA node " + std::to_string(_node) + " does not exist");
+#endif
+}
+
+void *NumaAllocator::allocate(size_t bytes) {
+#ifdef WITH_NUMA
+  if (_numa)
+    return _node < 0 ? numa_alloc_local(nonEmpty(bytes)) : numa_alloc_onnode(nonEmpty(bytes), _node);
+#endif
+  return MallocStrategy::allocate(bytes);
+}
+
+void *NumaAllocator::reallocate(void *old, size_t bytes, size_t old_bytes) {
+  if (old == nullptr)
+    return allocate(bytes);
+#ifdef WITH_NUMA
+  // Keeps the memory policy of the old allocation
+  if (_numa)
+    return numa_realloc(old, nonEmpty(old_bytes), nonEmpty(bytes));
+#endif
+  return MallocStrategy::reallocate(old, bytes, old_bytes);
+}
+
+void NumaAllocator::deallocate(void *p, size_t bytes) {
+  if (p == nullptr)
+    return;
+#ifdef WITH_NUMA
+  if (_numa) {
+    numa_free(p, nonEmpty(bytes));
+    return;
+  }
+#endif
+  MallocStrategy::deallocate(p, bytes);
+}
+
+std::string NumaAllocator::name() const {
+  return _node < 0 ? "numa" : "numa:" + std::to_string(_node);
+}
+
+}
+}
@@ -0,0 +1,38 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_MEMORY_NUMAALLOCATOR_H_
+#define SRC_LIB_MEMORY_NUMAALLOCATOR_H_
+
+#include "memory/Allocator.h"
+
+namespace hyrise {
+namespace memory {
+
+///
+/// Allocates memory bound to one NUMA node with libnuma, or to the node
+/// of the allocating thread if no node is given. Allocations are rounded
+/// to pages, so the allocator is meant for large columns. Without NUMA
+/// support (WITH_NUMA) or on systems without NUMA it uses MallocStrategy.
+///
+class NumaAllocator : public Allocator {
+ public:
+  /// -1 for the node of the allocating thread
+  explicit NumaAllocator(int node = -1);
+
+  void *allocate(size_t bytes);
+  void *reallocate(void *old, size_t bytes, size_t old_bytes);
+  void deallocate(void *p, size_t bytes);
+  std::string name() const;
+
+  int node() const {
+    return _node;
+  }
+
+ private:
+  const int _node;
+  bool _numa;
+};
+
+}
+}
+
+#endif  // SRC_LIB_MEMORY_NUMAALLOCATOR_H_
@@ -0,0 +1,102 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "memory/PoolAllocator.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "memory/MallocStrategy.h"
+
+namespace hyrise {
+namespace memory {
+
+const size_t PoolAllocator::min_class_bytes;
+const size_t PoolAllocator::max_class_bytes;
+const size_t PoolAllocator::max_cached_bytes;
+
+PoolAllocator::PoolAllocator() : _classes(classes()) {
+}
+
+PoolAllocator::~PoolAllocator() {
+  for (auto& size_class : _classes) {
+    for (const auto& block : size_class.blocks)
+      MallocStrategy::deallocate(block, 0);
+  }
+}
+
+size_t PoolAllocator::classes() {
+  return sizeClass(max_class_bytes) + 1;
+}
+
+size_t PoolAllocator::sizeClass(size_t bytes) {
+  if (bytes > max_class_bytes)
+    return classes();
+  size_t result = 0;
+  for (size_t class_bytes = min_class_bytes; class_bytes < bytes; class_bytes *= 2)
+    ++result;
+  return result;
+}
+
+void *PoolAllocator::allocate(size_t bytes) {
+  const size_t c = sizeClass(bytes);
+  if (c >= _classes.size())
+    return MallocStrategy::allocate(bytes);
+
+  auto& size_class = _classes[c];
+  {
+    std::lock_guard<std::mutex> lock(size_class.mutex);
+    if (!size_class.blocks.empty()) {
+      void *block = size_class.blocks.back();
+      size_class.blocks.pop_back();
+      return block;
+    }
+  }
+  return MallocStrategy::allocate(min_class_bytes << c);
+}
+
+void *PoolAllocator::reallocate(void *old, size_t bytes, size_t old_bytes) {
+  if (old == nullptr)
+    return allocate(bytes);
+  const size_t c = sizeClass(bytes);
+  const size_t old_c = sizeClass(old_bytes);
+  if (c == old_c && c < _classes.size())
+    return old;
+  if (c >= _classes.size() && old_c >= _classes.size())
+    return MallocStrategy::reallocate(old, bytes, old_bytes);
+
+  void *p = allocate(bytes);
+  if (p == nullptr)
+    return nullptr;
+  std::memcpy(p, old, std::min(bytes, old_bytes));
+  deallocate(old, old_bytes);
+  return p;
+}
+
+void PoolAllocator::deallocate(void *p, size_t bytes) {
+  if (p == nullptr)
+    return;
+  const size_t c = sizeClass(bytes);
+  if (c < _classes.size()) {
+    auto& size_class = _classes[c];
+    std::lock_guard<std::mutex> lock(size_class.mutex);
+    if ((size_class.blocks.size() + 1) * (min_class_bytes << c) <= max_cached_bytes) {
+      size_class.blocks.push_back(p);
+      return;
+    }
+  }
+  MallocStrategy::deallocate(p, bytes);
+}
+
+size_t PoolAllocator::cached(size_t bytes) {
+  const size_t c = sizeClass(bytes);
+  if (c >= _classes.size())
+    return 0;
+  std::lock_guard<std::mutex> lock(_classes[c].mutex);
+  return _classes[c].blocks.size();
+}
+
+std::string PoolAllocator::name() const {
+  return "pool";
+}
+
+}
+}
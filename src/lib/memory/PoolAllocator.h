@@ -0,0 +1,52 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_MEMORY_POOLALLOCATOR_H_
+#define SRC_LIB_MEMORY_POOLALLOCATOR_H_
+
+#include <mutex>
+#include <vector>
+
+#include "memory/Allocator.h"
+
+namespace hyrise {
+namespace memory {
+
+///
+/// Keeps freed blocks of small vectors, e.g. of intermediate results, in
+/// size classes of powers of two from 64 bytes to 64 KB and hands them out
+/// again instead of calling malloc. Every class keeps at most
+/// max_cached_bytes. Larger allocations use MallocStrategy.
+///
+class PoolAllocator : public Allocator {
+ public:
+  static const size_t min_class_bytes = 64;
+  static const size_t max_class_bytes = 64 * 1024;
+  static const size_t max_cached_bytes = 16 * 1024 * 1024;
+
+  PoolAllocator();
+  ~PoolAllocator();
+
+  void *allocate(size_t bytes);
+  void *reallocate(void *old, size_t bytes, size_t old_bytes);
+  void deallocate(void *p, size_t bytes);
+  std::string name() const;
+
+  /// Blocks cached for allocations of `bytes`
+  size_t cached(size_t bytes);
+
+ private:
+  struct SizeClass {
+    std::mutex mutex;
+    std::vector<void *> blocks;
+  };
+
+  // Size class of `bytes`, classes() for allocations that are not pooled
+  static size_t sizeClass(size_t bytes);
+  static size_t classes();
+
+  std::vector<SizeClass> _classes;
+};
+
+}
+}
+
+#endif  // SRC_LIB_MEMORY_POOLALLOCATOR_H_
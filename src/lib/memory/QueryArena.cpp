@@ -0,0 +1,277 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "memory/QueryArena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+namespace hyrise {
+namespace memory {
+
+struct QueryArena::Chunk {
+  // One for the arena and one for every live allocation
+  std::atomic<size_t> references;
+  size_t used;
+  size_t bytes;
+  Account *account;
+};
+
+struct QueryArena::Account {
+  // One for every arena, chunk and live large allocation
+  std::atomic<size_t> references;
+  std::atomic<size_t> bytes;
+  std::atomic<size_t> peak;
+  std::atomic<size_t> limit;
+};
+
+const size_t QueryArena::min_chunk_bytes;
+const size_t QueryArena::max_chunk_bytes;
+const size_t QueryArena::max_allocation_bytes;
+
+namespace {
+
+// Keeps allocations 16 byte aligned
+const size_t alignment = 16;
+
+size_t aligned(const size_t bytes) {
+  return (bytes + alignment - 1) & ~(alignment - 1);
+}
+
+// Every allocation starts with the chunk it belongs to, nullptr for the
+// heap. Large allocations of an arena start with its account, marked by
+// the lowest bit, and their size.
+const size_t header_bytes = alignment;
+const uintptr_t account_tag = 1;
+const size_t chunk_header_bytes = aligned(sizeof(QueryArena::Chunk));
+
+thread_local QueryArena *current_arena = nullptr;
+thread_local QueryArena::Chunk *current_chunk = nullptr;
+
+std::atomic<size_t> allocated_bytes(0);
+
+char *data(QueryArena::Chunk *chunk) {
+  return reinterpret_cast<char *>(chunk) + chunk_header_bytes;
+}
+
+void release(QueryArena::Account *account) {
+  if (account->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    delete account;
+}
+
+// Counts `bytes` against the limit of the account before they are allocated
+void charge(QueryArena::Account *account, const size_t bytes) {
+  const size_t total = account->bytes += bytes;
+  const size_t limit = account->limit;
+  if (limit != 0 && total > limit) {
+    account->bytes -= bytes;
+    throw MemoryLimitExceeded();
+  }
+  account->references.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes += bytes;
+  size_t peak = account->peak;
+  while (total > peak && !account->peak.compare_exchange_weak(peak, total)) {}
+}
+
+void uncharge(QueryArena::Account *account, const size_t bytes) {
+  allocated_bytes -= bytes;
+  account->bytes -= bytes;
+  release(account);
+}
+
+void release(QueryArena::Chunk *chunk) {
+  if (chunk->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    QueryArena::Account *account = chunk->account;
+    const size_t bytes = chunk->bytes;
+    free(chunk);
+    uncharge(account, bytes);
+  }
+}
+
+}
+
+QueryArena::QueryArena() : _account(new Account()), _chunkBytes(0) {
+  _account->references = 1;
+}
+
+QueryArena::QueryArena(QueryArena *parent) : QueryArena() {
+  if (parent != nullptr) {
+    release(_account);
+    _account = parent->_account;
+    _account->references.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+QueryArena::~QueryArena() {
+  for (const auto& chunk : _chunks)
+    release(chunk);
+  release(_account);
+}
+
+void *QueryArena::allocate(size_t bytes) {
+  const size_t size = header_bytes + aligned(bytes);
+  QueryArena *arena = current_arena;
+  if (arena == nullptr || bytes > max_allocation_bytes) {
+    if (arena != nullptr)
+      charge(arena->_account, size);
+    void *p = malloc(size);
+    if (p == nullptr) {
+      if (arena != nullptr)
+        uncharge(arena->_account, size);
+      return nullptr;
+    }
+    uintptr_t *header = static_cast<uintptr_t *>(p);
+    if (arena == nullptr) {
+      header[0] = 0;
+    } else {
+      header[0] = reinterpret_cast<uintptr_t>(arena->_account) | account_tag;
+      header[1] = size;
+    }
+    return static_cast<char *>(p) + header_bytes;
+  }
+
+  Chunk *chunk = current_chunk;
+  if (chunk == nullptr || chunk->used + size > chunk->bytes) {
+    chunk = arena->take(size);
+    if (chunk == nullptr)
+      return nullptr;
+    current_chunk = chunk;
+  }
+  char *p = data(chunk) + chunk->used;
+  chunk->used += size;
+  chunk->references.fetch_add(1, std::memory_order_relaxed);
+  *reinterpret_cast<Chunk **>(p) = chunk;
+  return p + header_bytes;
+}
+
+void QueryArena::deallocate(void *p) {
+  if (p == nullptr)
+    return;
+  char *header = static_cast<char *>(p) - header_bytes;
+  const uintptr_t owner = *reinterpret_cast<uintptr_t *>(header);
+  if (owner == 0) {
+    free(header);
+  } else if (owner & account_tag) {
+    Account *account = reinterpret_cast<Account *>(owner & ~account_tag);
+    const size_t size = reinterpret_cast<uintptr_t *>(header)[1];
+    free(header);
+    uncharge(account, size);
+  } else {
+    release(reinterpret_cast<Chunk *>(owner));
+  }
+}
+
+QueryArena *QueryArena::current() {
+  return current_arena;
+}
+
+size_t QueryArena::chunks() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _chunks.size();
+}
+
+size_t QueryArena::chunkBytes() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _chunkBytes;
+}
+
+size_t QueryArena::peakBytes() const {
+  return _account->peak;
+}
+
+size_t QueryArena::usedBytes() const {
+  return _account->bytes;
+}
+
+void QueryArena::setLimit(size_t bytes) {
+  _account->limit = bytes;
+}
+
+size_t QueryArena::limit() const {
+  return _account->limit;
+}
+
+bool QueryArena::fits(size_t bytes) {
+  return bytes <= availableBytes();
+}
+
+size_t QueryArena::availableBytes() {
+  const QueryArena *arena = current_arena;
+  if (arena == nullptr || arena->limit() == 0)
+    return std::numeric_limits<size_t>::max();
+  const size_t used = arena->usedBytes();
+  return used < arena->limit() ? arena->limit() - used : 0;
+}
+
+size_t QueryArena::allocatedBytes() {
+  return allocated_bytes;
+}
+
+QueryArena::Chunk *QueryArena::take(size_t bytes) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  // Chunks other threads stopped using, the full ones stay in _chunks only
+  while (!_open.empty()) {
+    Chunk *chunk = _open.back();
+    _open.pop_back();
+    if (chunk->used + bytes <= chunk->bytes)
+      return chunk;
+  }
+
+  size_t chunk_bytes = std::min(max_chunk_bytes, min_chunk_bytes << std::min<size_t>(_chunks.size(), 6));
+  // Smaller chunks close to the limit
+  const size_t limit = _account->limit;
+  const size_t used = _account->bytes;
+  if (limit != 0)
+    chunk_bytes = std::min(chunk_bytes, used < limit ? limit - used : 0);
+  chunk_bytes = std::max(bytes, chunk_bytes);
+
+  charge(_account, chunk_bytes);
+  Chunk *chunk = static_cast<Chunk *>(malloc(chunk_header_bytes + chunk_bytes));
+  if (chunk == nullptr) {
+    uncharge(_account, chunk_bytes);
+    return nullptr;
+  }
+  new(&chunk->references) std::atomic<size_t>(1);
+  chunk->used = 0;
+  chunk->bytes = chunk_bytes;
+  chunk->account = _account;
+  _chunks.push_back(chunk);
+  _chunkBytes += chunk_bytes;
+  return chunk;
+}
+
+void QueryArena::giveBack(Chunk *chunk) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _open.push_back(chunk);
+}
+
+ArenaScope::ArenaScope(QueryArena *arena) : _previousArena(current_arena), _previousChunk(current_chunk) {
+  if (arena != nullptr && arena != current_arena) {
+    current_arena = arena;
+    current_chunk = nullptr;
+  }
+}
+
+ArenaScope::~ArenaScope() {
+  if (current_arena != _previousArena) {
+    if (current_chunk != nullptr)
+      current_arena->giveBack(current_chunk);
+    current_arena = _previousArena;
+    current_chunk = _previousChunk;
+  }
+}
+
+// The chunk stays with the thread and is used again after the scope
+HeapScope::HeapScope() : _previousArena(current_arena), _previousChunk(current_chunk) {
+  current_arena = nullptr;
+  current_chunk = nullptr;
+}
+
+HeapScope::~HeapScope() {
+  current_arena = _previousArena;
+  current_chunk = _previousChunk;
+}
+
+}
+}
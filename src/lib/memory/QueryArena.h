@@ -0,0 +1,206 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_MEMORY_QUERYARENA_H_
+#define SRC_LIB_MEMORY_QUERYARENA_H_
+
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "helper/noncopyable.h"
+
+namespace hyrise {
+namespace memory {
+
+/// Thrown when a query needs more memory than the limit of its arena
+class MemoryLimitExceeded : public std::bad_alloc {
+ public:
+  const char *what() const noexcept {
+    return "Memory limit of the query exceeded";
+  }
+};
+
+///
+/// Memory of the intermediate results of one query, e.g. position lists
+/// and hash table probes. Threads executing the query's plan operations
+/// open an ArenaScope and bump allocate from a chunk only they use, so
+/// worker threads do not contend on the heap. A chunk is freed once the
+/// arena and all allocations from it are gone, so intermediates that
+/// outlive the query stay valid.
+///
+/// Containers use the arena through ArenaAllocator, which falls back to
+/// the heap outside of an ArenaScope.
+///
+/// With a limit, allocations that would take the arena beyond it throw
+/// MemoryLimitExceeded. Operators check fits() beforehand and spill their
+/// input to disk instead, see SpillFile.
+///
+class QueryArena : private noncopyable {
+ public:
+  /// Chunks start small for short queries and double up to max_chunk_bytes
+  static const size_t min_chunk_bytes = 16 * 1024;
+  static const size_t max_chunk_bytes = 1024 * 1024;
+  /// Larger allocations use the heap
+  static const size_t max_allocation_bytes = 256 * 1024;
+
+  /// Block of memory a single thread at a time bump allocates from
+  struct Chunk;
+  /// Bytes of an arena, outlives it as long as large allocations do
+  struct Account;
+
+  QueryArena();
+  /// Arena of one step of a query, e.g. a partition of spilled input,
+  /// that counts against the limit of `parent`. Its chunks are freed as
+  /// soon as the arena and the step's intermediates are gone.
+  explicit QueryArena(QueryArena *parent);
+  ~QueryArena();
+
+  /// Allocates from the arena of the calling thread's innermost
+  /// ArenaScope, or from the heap without one. Returns nullptr if the
+  /// memory cannot be allocated and throws MemoryLimitExceeded if the
+  /// limit of the arena does not allow it.
+  static void *allocate(size_t bytes);
+  /// Frees memory of any arena or of the heap from any thread, also after
+  /// its arena was destroyed
+  static void deallocate(void *p);
+
+  /// Arena of the calling thread, nullptr if there is none
+  static QueryArena *current();
+
+  /// Number and total bytes of the chunks the arena allocated
+  size_t chunks() const;
+  size_t chunkBytes() const;
+
+  /// Most bytes the chunks and large allocations of the arena took at
+  /// the same time
+  size_t peakBytes() const;
+  /// Bytes the chunks and large allocations of the arena take now
+  size_t usedBytes() const;
+
+  /// Bytes the arena may take at the same time, 0 for no limit. Arenas
+  /// of steps share the limit of their parent.
+  void setLimit(size_t bytes);
+  size_t limit() const;
+
+  /// Whether `bytes` more fit into the limit of the calling thread's
+  /// arena, always true without arena or limit
+  static bool fits(size_t bytes);
+  /// Bytes left below the limit of the calling thread's arena
+  static size_t availableBytes();
+
+  /// Bytes of the chunks and large allocations of all arenas
+  static size_t allocatedBytes();
+
+ private:
+  friend class ArenaScope;
+
+  // Chunk with room for `bytes` the calling thread allocates from next
+  Chunk *take(size_t bytes);
+  // Lets another thread continue allocating from `chunk`
+  void giveBack(Chunk *chunk);
+
+  Account *_account;
+  mutable std::mutex _mutex;
+  std::vector<Chunk *> _chunks;
+  std::vector<Chunk *> _open;
+  size_t _chunkBytes;
+};
+
+/// Makes an arena the one of the calling thread until the scope ends,
+/// nullptr keeps the current arena
+class ArenaScope : private noncopyable {
+ public:
+  explicit ArenaScope(QueryArena *arena);
+  ~ArenaScope();
+
+ private:
+  QueryArena *_previousArena;
+  QueryArena::Chunk *_previousChunk;
+};
+
+/// Makes the calling thread allocate from the heap until the scope ends.
+/// Temporaries created and freed for every row, e.g. hash table probes,
+/// would otherwise pile up in the thread's chunk for the whole operation.
+class HeapScope : private noncopyable {
+ public:
+  HeapScope();
+  ~HeapScope();
+
+ private:
+  QueryArena *_previousArena;
+  QueryArena::Chunk *_previousChunk;
+};
+
+/// Standard allocator of intermediate containers, see QueryArena
+template <typename T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  template <typename U>
+  struct rebind {
+    typedef ArenaAllocator<U> other;
+  };
+
+  ArenaAllocator() {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U> &) {}
+
+  T *allocate(size_t n, const void * = nullptr) {
+    void *p = QueryArena::allocate(n * sizeof(T));
+    if (p == nullptr)
+      throw std::bad_alloc();
+    return static_cast<T *>(p);
+  }
+
+  void deallocate(T *p, size_t) {
+    QueryArena::deallocate(p);
+  }
+
+  size_t max_size() const {
+    return std::numeric_limits<size_t>::max() / sizeof(T);
+  }
+
+  template <typename U, typename... Args>
+  void construct(U *p, Args&&... args) {
+    ::new(static_cast<void *>(p)) U(std::forward<Args>(args)...);
+  }
+
+  template <typename U>
+  void destroy(U *p) {
+    p->~U();
+  }
+
+  T *address(T &x) const {
+    return &x;
+  }
+
+  const T *address(const T &x) const {
+    return &x;
+  }
+};
+
+// All allocators free memory of any arena
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T> &, const ArenaAllocator<U> &) {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &, const ArenaAllocator<U> &) {
+  return false;
+}
+
+}
+}
+
+#endif  // SRC_LIB_MEMORY_QUERYARENA_H_
@@ -0,0 +1,153 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "memory/SpillFile.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "helper/Settings.h"
+#include "memory/QueryArena.h"
+
+namespace hyrise {
+namespace memory {
+
+namespace {
+
+std::runtime_error spillError(const std::string &message) {
+  return std::runtime_error(message + ": " + strerror(errno));
+}
+
+}
+
+SpillFile::SpillFile(const std::string &directory) : _file(nullptr), _bytes(0) {
+  std::string path = (directory.empty() ? Settings::getInstance()->getSpillDirectory() : directory) + "/hyrise-spill-XXXXXX";
+  std::vector<char> name(path.begin(), path.end());
+  name.push_back('\0');
+  const int fd = mkstemp(name.data());
+  if (fd < 0)
+    throw spillError("Cannot create spill file " + path);
+  unlink(name.data());
+  _file = fdopen(fd, "w+b");
+  if (_file == nullptr) {
+    close(fd);
+    throw spillError("Cannot open spill file " + path);
+  }
+}
+
+SpillFile::~SpillFile() {
+  fclose(_file);
+}
+
+void SpillFile::writeUnsigned(uint64_t value) {
+  while (value >= 0x80) {
+    putc(static_cast<int>((value & 0x7f) | 0x80), _file);
+    value >>= 7;
+    ++_bytes;
+  }
+  putc(static_cast<int>(value), _file);
+  ++_bytes;
+}
+
+void SpillFile::writeSigned(int64_t value) {
+  writeUnsigned((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void SpillFile::writeDouble(double value) {
+  fwrite(&value, sizeof(value), 1, _file);
+  _bytes += sizeof(value);
+}
+
+void SpillFile::writeString(const std::string &value) {
+  writeUnsigned(value.size());
+  fwrite(value.data(), 1, value.size(), _file);
+  _bytes += value.size();
+}
+
+void SpillFile::rewind() {
+  if (fflush(_file) != 0 || ferror(_file))
+    throw spillError("Cannot write spill file");
+  if (fseek(_file, 0, SEEK_SET) != 0)
+    throw spillError("Cannot rewind spill file");
+}
+
+bool SpillFile::readUnsigned(uint64_t &value) {
+  int c = getc(_file);
+  if (c == EOF)
+    return false;
+  value = 0;
+  for (size_t shift = 0; ; shift += 7) {
+    if (shift > 63)
+      throw std::runtime_error("Corrupt spill file");
+    value |= static_cast<uint64_t>(c & 0x7f) << shift;
+    if (!(c & 0x80))
+      return true;
+    if ((c = getc(_file)) == EOF)
+      throw std::runtime_error("Truncated spill file");
+  }
+}
+
+bool SpillFile::readSigned(int64_t &value) {
+  uint64_t encoded;
+  if (!readUnsigned(encoded))
+    return false;
+  value = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+  return true;
+}
+
+bool SpillFile::readDouble(double &value) {
+  return fread(&value, sizeof(value), 1, _file) == 1;
+}
+
+bool SpillFile::readString(std::string &value) {
+  uint64_t size;
+  if (!readUnsigned(size))
+    return false;
+  value.resize(size);
+  if (size != 0 && fread(&value[0], 1, size, _file) != size)
+    throw std::runtime_error("Truncated spill file");
+  return true;
+}
+
+size_t SpillFile::bytes() const {
+  return _bytes;
+}
+
+const size_t SpilledPartitions::max_partitions;
+
+SpilledPartitions::SpilledPartitions(size_t partitions) : _last(partitions, 0), _counts(partitions, 0) {
+  for (size_t partition = 0; partition < partitions; ++partition)
+    _files.emplace_back(new SpillFile());
+}
+
+size_t SpilledPartitions::partitionsFor(size_t bytes) {
+  const size_t available = QueryArena::availableBytes();
+  if (available == std::numeric_limits<size_t>::max())
+    return 1;
+  // A partition's hash table may take a quarter of what is available, the
+  // rest is left to the results of the partitions and to arena chunks
+  // that grow by doubling
+  const size_t partitions = bytes / std::max<size_t>(available / 4, 1) + 1;
+  return std::min(max_partitions, std::max<size_t>(partitions, 2));
+}
+
+size_t SpilledPartitions::size() const {
+  return _files.size();
+}
+
+void SpilledPartitions::add(size_t partition, uint64_t position) {
+  _files[partition]->writeUnsigned(position - _last[partition]);
+  _last[partition] = position;
+  ++_counts[partition];
+}
+
+size_t SpilledPartitions::count(size_t partition) const {
+  return _counts[partition];
+}
+
+}
+}
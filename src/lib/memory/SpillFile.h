@@ -0,0 +1,101 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_MEMORY_SPILLFILE_H_
+#define SRC_LIB_MEMORY_SPILLFILE_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "helper/noncopyable.h"
+
+namespace hyrise {
+namespace memory {
+
+///
+/// Temporary file operators move parts of their input to when it does not
+/// fit into the memory limit of the query, see QueryArena. The file is
+/// unlinked right after it was created, so it disappears with the
+/// process. Values are written in a compact binary format: integers as
+/// variable length quantities of 7 bits per byte, signed ones zigzag
+/// encoded, strings prefixed with their length.
+///
+/// A spill file is written first and read after rewind().
+///
+class SpillFile : private noncopyable {
+ public:
+  /// Creates the file in `directory` or, if empty, in the spill
+  /// directory of the Settings
+  explicit SpillFile(const std::string &directory = "");
+  ~SpillFile();
+
+  void writeUnsigned(uint64_t value);
+  void writeSigned(int64_t value);
+  void writeDouble(double value);
+  void writeString(const std::string &value);
+
+  /// Starts reading at the beginning of the file
+  void rewind();
+
+  /// Return false at the end of the file
+  bool readUnsigned(uint64_t &value);
+  bool readSigned(int64_t &value);
+  bool readDouble(double &value);
+  bool readString(std::string &value);
+
+  /// Bytes written to the file
+  size_t bytes() const;
+
+ private:
+  FILE *_file;
+  size_t _bytes;
+};
+
+/// Positions of a table hash partitioned to one spill file per partition.
+/// Positions are added in ascending order and stored as deltas. Once all
+/// positions were added, several threads may read the partitions.
+class SpilledPartitions : private noncopyable {
+ public:
+  /// Partitions never exceed this, each one keeps a file open
+  static const size_t max_partitions = 64;
+
+  explicit SpilledPartitions(size_t partitions);
+
+  /// Number of partitions so that each one of `bytes` in memory is likely
+  /// to fit into the memory left for the calling thread's query
+  static size_t partitionsFor(size_t bytes);
+
+  size_t size() const;
+
+  void add(size_t partition, uint64_t position);
+
+  /// Appends the positions of `partition` to `positions`, can be called
+  /// any number of times after all positions were added
+  template <typename Positions>
+  void read(size_t partition, Positions &positions) const {
+    std::lock_guard<std::mutex> lock(_read_mutex);
+    SpillFile &file = *_files[partition];
+    file.rewind();
+    uint64_t position = 0, delta;
+    while (file.readUnsigned(delta)) {
+      position += delta;
+      positions.push_back(position);
+    }
+  }
+
+  /// Number of positions added to `partition`
+  size_t count(size_t partition) const;
+
+ private:
+  std::vector<std::unique_ptr<SpillFile> > _files;
+  std::vector<uint64_t> _last;
+  std::vector<size_t> _counts;
+  mutable std::mutex _read_mutex;
+};
+
+}
+}
+
+#endif  // SRC_LIB_MEMORY_SPILLFILE_H_
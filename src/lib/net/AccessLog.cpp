@@ -0,0 +1,99 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "net/AccessLog.h"
+
+#include <arpa/inet.h>
+#include <ctime>
+
+#include "ebb/ebb.h"
+
+namespace hyrise {
+namespace net {
+
+AccessLog &AccessLog::getInstance() {
+  static AccessLog log(stdout);
+  return log;
+}
+
+AccessLog::AccessLog(FILE *file) : _file(file), _logged(0), _writtenCount(0), _stop(false) {
+  _thread = std::thread(&AccessLog::run, this);
+}
+
+AccessLog::~AccessLog() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _added.notify_one();
+  _thread.join();
+}
+
+void AccessLog::log(AccessLogEntry &&entry) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.push_back(std::move(entry));
+    ++_logged;
+  }
+  _added.notify_one();
+}
+
+void AccessLog::flush() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  const size_t logged = _logged;
+  _written.wait(lock, [this, logged]() { return _writtenCount >= logged; });
+}
+
+std::string AccessLog::format(const AccessLogEntry &entry) {
+  const char *method = "";
+  switch (entry.method) {
+    case EBB_GET:
+      method = "GET";
+      break;
+    case EBB_POST:
+      method = "POST";
+      break;
+    default:
+      break;
+  }
+
+  char address[INET_ADDRSTRLEN];
+  inet_ntop(AF_INET, &entry.addr, address, sizeof(address));
+
+  struct tm timeinfo;
+  char timestr[80];
+  const time_t endtime = entry.endtime.tv_sec;
+  localtime_r(&endtime, &timeinfo);
+  strftime(timestr, sizeof(timestr), "%Y-%m-%d %H:%M:%S %z", &timeinfo);
+
+  float duration = entry.endtime.tv_sec + entry.endtime.tv_usec / 1000000.0 - entry.starttime.tv_sec - entry.starttime.tv_usec / 1000000.0;
+
+  char line[160];
+  snprintf(line, sizeof(line), "%s [%s] %s ", address, timestr, method);
+  std::string result(line);
+  result += entry.path;
+  snprintf(line, sizeof(line), " (%f s)%s", duration, entry.sent ? "" : " not sent");
+  return result + line;
+}
+
+void AccessLog::run() {
+  std::vector<AccessLogEntry> batch;
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true) {
+    _added.wait(lock, [this]() { return _stop || !_entries.empty(); });
+    if (_entries.empty())
+      return;
+    batch.swap(_entries);
+    lock.unlock();
+
+    for (const auto &entry : batch)
+      fprintf(_file, "%s\n", format(entry).c_str());
+    fflush(_file);
+
+    lock.lock();
+    _writtenCount += batch.size();
+    batch.clear();
+    _written.notify_all();
+  }
+}
+
+}
+}
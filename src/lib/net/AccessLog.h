@@ -0,0 +1,66 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_NET_ACCESSLOG_H_
+#define SRC_LIB_NET_ACCESSLOG_H_
+
+#include <netinet/in.h>
+#include <sys/time.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hyrise {
+namespace net {
+
+/// One answered request
+struct AccessLogEntry {
+  struct in_addr addr;
+  int method;
+  std::string path;
+  struct timeval starttime;
+  struct timeval endtime;
+  bool sent;
+};
+
+/// Writes one line per request to stdout from a thread of its own, so the
+/// event loops never wait for the terminal or the formatting of times.
+/// Entries are collected in batches and written in the order they were
+/// added.
+class AccessLog {
+ public:
+  static AccessLog &getInstance();
+
+  AccessLog(const AccessLog &) = delete;
+  AccessLog &operator=(const AccessLog &) = delete;
+  ~AccessLog();
+
+  void log(AccessLogEntry &&entry);
+
+  /// Returns once all entries logged so far were written
+  void flush();
+
+  /// Line written for `entry`, without newline
+  static std::string format(const AccessLogEntry &entry);
+
+ private:
+  explicit AccessLog(FILE *file);
+  void run();
+
+  FILE *_file;
+  std::mutex _mutex;
+  std::condition_variable _added;
+  std::condition_variable _written;
+  std::vector<AccessLogEntry> _entries;
+  size_t _logged;
+  size_t _writtenCount;
+  bool _stop;
+  std::thread _thread;
+};
+
+}
+}
+
+#endif  // SRC_LIB_NET_ACCESSLOG_H_
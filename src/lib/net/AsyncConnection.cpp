@@ -6,9 +6,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stddef.h>
-#include <ctime>
+#include <algorithm>
 #include <memory>
+#include <new>
 
+#include "net/AccessLog.h"
+#include "net/EventLoops.h"
 #include "net/Router.h"
 #include "taskscheduler/SharedScheduler.h"
 #include "access/system/RequestParseTask.h"
@@ -17,14 +20,38 @@
 namespace hyrise {
 namespace net {
 
+const size_t AsyncRequest::initial_body_length;
+const size_t AsyncRequest::max_kept_buffer_length;
+const size_t AsyncRequest::max_reserved_body_length;
+const size_t AsyncRequest::max_body_length;
+const size_t AsyncConnection::max_kept_requests;
+const size_t AsyncConnection::max_pipelined_requests;
+const size_t ConnectionPool::max_pooled;
+
+namespace {
+
+// Frees the connection, or returns it to the pool of its loop
+void release(AsyncConnection *connection_data) {
+  if (connection_data->pool != nullptr)
+    connection_data->pool->release(connection_data);
+  else
+    delete connection_data;
+}
+
+}
+
 ebb_connection *new_connection(ebb_server *server, struct sockaddr_in *addr) {
-  ebb_connection *connection = (ebb_connection *)malloc(sizeof(ebb_connection));
+  EventLoop *event_loop = (EventLoop *)server->data;
+  ConnectionPool *pool = event_loop != nullptr ? &event_loop->pool : nullptr;
+
+  ebb_connection *connection = pool != nullptr ? pool->acquireSocket() : (ebb_connection *)malloc(sizeof(ebb_connection));
   if (connection == nullptr) {
     return nullptr;
   }
 
-  AsyncConnection *connection_data = new AsyncConnection;
+  AsyncConnection *connection_data = pool != nullptr ? pool->acquire() : new AsyncConnection;
   connection_data->addr = *addr;
+  connection_data->pool = pool;
   
   // Initializes the connection
   ebb_connection_init(connection);
@@ -33,6 +60,7 @@ ebb_connection *new_connection(ebb_server *server, struct sockaddr_in *addr) {
   connection->on_close = on_close;
   connection->on_timeout = on_timeout;
 
+  connection_data->connection = connection;
   connection_data->ev_loop = server->loop;
   connection_data->ev_write.data = connection_data;
 
@@ -44,9 +72,11 @@ int on_timeout(ebb_connection *connection) {
 }
 
 ebb_request *new_request(ebb_connection *connection) {
-  ebb_request *request = (ebb_request *)malloc(sizeof(ebb_request));
+  AsyncConnection *connection_data = (AsyncConnection *)connection->data;
+  AsyncRequest *request_data = connection_data->newRequest();
+  ebb_request *request = &request_data->request;
   ebb_request_init(request);
-  request->data = connection;
+  request->data = request_data;
   request->on_complete = request_complete;
   request->on_path = request_path;
   request->on_body = request_body;
@@ -54,136 +84,265 @@ ebb_request *new_request(ebb_connection *connection) {
 }
 
 void request_complete(ebb_request *request) {
-  ebb_connection *connection = (ebb_connection *)request->data;
-  AsyncConnection *connection_data = (AsyncConnection *)connection->data;
-  connection_data->connection = connection;
-  connection_data->request = request;
-  gettimeofday(&connection_data->starttime, nullptr);
-  connection_data->keep_alive_flag = ebb_request_should_keep_alive(request);
-
-  ev_async_init(&connection_data->ev_write, write_cb);
-  ev_async_start(connection_data->ev_loop, &connection_data->ev_write);
-
-  // Try to route to appropriate handler based on path
-  const AbstractRequestHandlerFactory *handler_factory;
-  try {
-    handler_factory = Router::route(connection_data->path);
-  } catch (const RouterException &exc) {
-    std::string exception_message(exc.what());
-    connection_data->respond("Could not route request, std::exception was: \n"
-                             + exception_message);
+  AsyncRequest *request_data = (AsyncRequest *)request->data;
+  // Refused requests were enqueued when their body was refused
+  if (request_data->error_status != 0)
     return;
-  }
-
-  std::shared_ptr<Task> task = handler_factory->create(connection_data);
-  task->setPriority(Task::HIGH_PRIORITY); // give RequestParseTask high priority
-  SharedScheduler::getInstance().getScheduler()->schedule(task);
-  connection_data->waiting_for_response = true;
+  request_data->keep_alive_flag = ebb_request_should_keep_alive(request);
+  request_data->connection->enqueue(request_data);
 }
 
 void continue_responding(ebb_connection *connection) {
   AsyncConnection *connection_data = (AsyncConnection *)connection->data;
-  if (connection_data->keep_alive_flag == false) {
+  if (connection_data->request->keep_alive_flag == false) {
     ebb_connection_schedule_close(connection);
   }
   else {
     // clear connection for next request
     connection_data->reset();
+    if (!connection_data->pipelined.empty()) {
+      AsyncRequest *next = connection_data->pipelined.front();
+      connection_data->pipelined.pop_front();
+      connection_data->resumeReading();
+      connection_data->dispatch(next);
+    }
   }
 }
 
 void request_path(ebb_request *request, const char *at, size_t length) {
-  ebb_connection *connection = (ebb_connection *)request->data;
-  AsyncConnection *connection_data = (AsyncConnection *)connection->data;
+  AsyncRequest *request_data = (AsyncRequest *)request->data;
 
-  connection_data->path = (char *)malloc(length + 1);
-  strncpy(connection_data->path, at, length);
-  connection_data->path[length] = '\0';
+  request_data->path = (char *)malloc(length + 1);
+  strncpy(request_data->path, at, length);
+  request_data->path[length] = '\0';
 }
 
 void request_body(ebb_request *request, const char *at, size_t length) {
-  ebb_connection *connection = (ebb_connection *)request->data;
-  AsyncConnection *connection_data = (AsyncConnection *)connection->data;
+  AsyncRequest *request_data = (AsyncRequest *)request->data;
+  if (request_data->error_status != 0)
+    return;
 
-  if (!connection_data->body) {
-    connection_data->body = (char *)malloc(length);
-    connection_data->body_len = 0;
-  } else {
-    connection_data->body = (char *)realloc(connection_data->body, connection_data->body_len + length);
+  // The rest of a refused body is not read, the connection is closed
+  // after the error was sent
+  if (!request_data->appendBody(at, length, request->content_length)) {
+    AsyncConnection *connection_data = request_data->connection;
+    connection_data->refused = true;
+    connection_data->pauseReading();
+    request_data->keep_alive_flag = false;
+    connection_data->enqueue(request_data);
   }
-  memcpy(connection_data->body + connection_data->body_len, at, length);
-  connection_data->body_len += length;
 }
 
 void write_cb(struct ev_loop *loop, struct ev_async *w, int revents) {
   AsyncConnection *conn = (AsyncConnection *) w->data;
 
-  char *method = (char *) "";
-  switch (conn->request->method) {
-    case EBB_GET:
-      method = (char *)"GET";
-      break;
-    case EBB_POST:
-      method = (char *)"POST";
-      break;
-    default:
-      break;
-  }
-
-  struct timeval endtime;
-  gettimeofday(&endtime, nullptr);
-  float duration = endtime.tv_sec + endtime.tv_usec / 1000000.0 - conn->starttime.tv_sec - conn->starttime.tv_usec / 1000000.0;
-
-  time_t rawtime;
-  struct tm *timeinfo;
-  char timestr[80];
-  time(&rawtime);
-  timeinfo = localtime(&rawtime);
-  strftime(timestr, sizeof(timestr), "%Y-%m-%d %H:%M:%S %z", timeinfo);
+  AccessLogEntry entry;
+  entry.addr = conn->addr.sin_addr;
+  entry.method = conn->request->request.method;
+  entry.path = conn->request->path;
+  entry.starttime = conn->starttime;
+  gettimeofday(&entry.endtime, nullptr);
+  entry.sent = conn->connection != nullptr;
 
   // Handle the actual writing
   if (conn->connection != nullptr) {
     ebb_connection_write(conn->connection, conn->write_buffer, conn->write_buffer_len, continue_responding);
-    printf("%s [%s] %s %s (%f s)\n", inet_ntoa(conn->addr.sin_addr), timestr, method, conn->path, duration);
-  } else {
-    printf("%s [%s] %s %s (%f s) not sent\n", inet_ntoa(conn->addr.sin_addr), timestr, method, conn->path, duration);
   }
+  AccessLog::getInstance().log(std::move(entry));
   ev_async_stop(conn->ev_loop, &conn->ev_write);
   conn->waiting_for_response = false;
   // When connection is nullptr, `continue_responding` won't fire since we never sent data to the client,
   // thus, we'll need to clean up manually here, while connection has already been cleaned up in on `on_close`
-  if (conn->connection == nullptr) delete conn;
+  if (conn->connection == nullptr) release(conn);
 }
 
 void on_close(ebb_connection *connection) {
   AsyncConnection *connection_data = (AsyncConnection *)connection->data;
   connection_data->connection = nullptr;
-  free(connection);
+  if (connection_data->pool != nullptr)
+    connection_data->pool->releaseSocket(connection);
+  else
+    free(connection);
   if (!connection_data->waiting_for_response)
-    delete connection_data;
+    release(connection_data);
+}
+
+AsyncRequest::AsyncRequest(AsyncConnection *connection) :
+    connection(connection),
+    path(nullptr),
+    body((char *)malloc(initial_body_length)), body_len(0), body_capacity(body ? initial_body_length : 0),
+    keep_alive_flag(false), error_status(0) {
+}
+
+AsyncRequest::~AsyncRequest() {
+  free(path);
+  free(body);
+}
+
+void AsyncRequest::reset() {
+  free(path); path = nullptr;
+  body_len = 0;
+  error_status = 0;
+  // Keep the buffer for the next request unless it grew large
+  if (body_capacity > max_kept_buffer_length) {
+    free(body); body = nullptr; body_capacity = 0;
+  }
+}
+
+bool AsyncRequest::reserveBody(size_t length) {
+  if (body_len + length <= body_capacity)
+    return true;
+  size_t capacity = std::max<size_t>(body_capacity, initial_body_length);
+  while (capacity < body_len + length)
+    capacity *= 2;
+  char *grown = (char *)realloc(body, capacity);
+  if (grown == nullptr)
+    return false;
+  body = grown;
+  body_capacity = capacity;
+  return true;
+}
+
+bool AsyncRequest::appendBody(const char *at, size_t length, size_t announced) {
+  if (announced > max_body_length || body_len + length > max_body_length) {
+    error_status = 413;
+    return false;
+  }
+
+  // Up to max_reserved_body_length of an announced body at once
+  size_t reserved = length;
+  if (body_len == 0 && announced > length)
+    reserved = std::max(length, std::min(announced, max_reserved_body_length));
+  if (!reserveBody(reserved)) {
+    error_status = 500;
+    return false;
+  }
+  memcpy(body + body_len, at, length);
+  body_len += length;
+  return true;
 }
 
 AsyncConnection::AsyncConnection() :
+    connection(nullptr),
     request(nullptr),
-    path(nullptr),
-    body(nullptr), body_len(0), write_buffer(nullptr) {
+    write_buffer(nullptr), write_buffer_len(0), write_buffer_capacity(0),
+    pool(nullptr) {
 }
 
 AsyncConnection::~AsyncConnection() {
-  reset();
+  free(write_buffer);
 }
 
 void AsyncConnection::reset() {
-  free(path); path = nullptr;
-  free(body); body_len = 0; body = nullptr;
-  free(request); request = nullptr;
-  free(write_buffer); write_buffer = nullptr;
+  if (request != nullptr) {
+    request->reset();
+    _spare.push_back(request);
+    request = nullptr;
+  }
+  write_buffer_len = 0;
+  // Keep the buffer for the next response unless it grew large
+  if (write_buffer_capacity > AsyncRequest::max_kept_buffer_length) {
+    free(write_buffer); write_buffer = nullptr; write_buffer_capacity = 0;
+  }
   waiting_for_response = false;
 }
 
+void AsyncConnection::clear() {
+  reset();
+  pipelined.clear();
+  reading_paused = false;
+  refused = false;
+  if (_requests.size() > max_kept_requests)
+    _requests.resize(max_kept_requests);
+  _spare.clear();
+  for (const auto &kept : _requests) {
+    kept->reset();
+    _spare.push_back(kept.get());
+  }
+}
+
+AsyncRequest *AsyncConnection::newRequest() {
+  if (!_spare.empty()) {
+    AsyncRequest *request = _spare.back();
+    _spare.pop_back();
+    return request;
+  }
+  _requests.emplace_back(new AsyncRequest(this));
+  return _requests.back().get();
+}
+
+void AsyncConnection::dispatch(AsyncRequest *next) {
+  request = next;
+  gettimeofday(&starttime, nullptr);
+  waiting_for_response = true;
+
+  ev_async_init(&ev_write, write_cb);
+  ev_async_start(ev_loop, &ev_write);
+
+  if (request->error_status == 413) {
+    respond("Request body exceeds " + std::to_string(AsyncRequest::max_body_length) + " bytes", 413);
+    return;
+  } else if (request->error_status != 0) {
+    respond("Could not allocate the request body", request->error_status);
+    return;
+  }
+
+  // Try to route to appropriate handler based on path
+  const AbstractRequestHandlerFactory *handler_factory;
+  try {
+    handler_factory = Router::route(request->path);
+  } catch (const RouterException &exc) {
+    std::string exception_message(exc.what());
+    respond("Could not route request, std::exception was: \n"
+            + exception_message);
+    return;
+  }
+
+  // Called from the callbacks of libebb, which must not be left by
+  // exceptions
+  try {
+    std::shared_ptr<Task> task = handler_factory->create(this);
+    task->setPriority(Task::HIGH_PRIORITY); // give RequestParseTask high priority
+    SharedScheduler::getInstance().getScheduler()->schedule(task);
+  } catch (const std::bad_alloc &) {
+    request->keep_alive_flag = false;
+    respond("Could not allocate the request", 500);
+  }
+}
+
+void AsyncConnection::enqueue(AsyncRequest *next) {
+  // Pipelined requests are answered in order
+  if (request == nullptr) {
+    dispatch(next);
+    return;
+  }
+  pipelined.push_back(next);
+  if (pipelined.size() >= max_pipelined_requests)
+    pauseReading();
+}
+
+void AsyncConnection::pauseReading() {
+  if (connection != nullptr && !reading_paused) {
+    ev_io_stop(ev_loop, &connection->read_watcher);
+    reading_paused = true;
+  }
+}
+
+void AsyncConnection::resumeReading() {
+  // Connections with a refused request are closed instead
+  if (connection != nullptr && reading_paused && !refused && pipelined.size() < max_pipelined_requests) {
+    ev_io_start(ev_loop, &connection->read_watcher);
+    reading_paused = false;
+  }
+}
+
 void AsyncConnection::respond(const std::string &message, size_t status, const std::string & contentType) {
   if (connection != nullptr) { // when the connection was closed, don't bother allocating here
-    write_buffer = (char *)malloc(max_header_length + message.size());
+    if (write_buffer_capacity < max_header_length + message.size()) {
+      free(write_buffer);
+      write_buffer_capacity = max_header_length + message.size();
+      write_buffer = (char *)malloc(write_buffer_capacity);
+    }
     write_buffer_len = 0;
 
     // Copy the http status code
@@ -192,7 +351,7 @@ void AsyncConnection::respond(const std::string &message, size_t status, const s
                                  status,
                                  contentType.c_str(),
                                  message.size(),
-                                 keep_alive_flag ? "Keep-Alive" : "Close");
+                                 request->keep_alive_flag ? "Keep-Alive" : "Close");
 
     memcpy(write_buffer + write_buffer_len, message.c_str(), message.size());
     write_buffer_len += message.size();
@@ -205,15 +364,60 @@ void AsyncConnection::send_response() {
 }
 
 bool AsyncConnection::hasBody() const{
-  return body_len > 0;
+  return request->body_len > 0;
 }
 
 std::string AsyncConnection::getPath() const {
-  return path;
+  return request->path;
 }
 
 std::string AsyncConnection::getBody() const{
-  return std::string(body, body_len);
+  return std::string(request->body, request->body_len);
+}
+
+ConnectionPool::~ConnectionPool() {
+  for (const auto &connection : _connections)
+    delete connection;
+  for (const auto &connection : _sockets)
+    free(connection);
+}
+
+AsyncConnection *ConnectionPool::acquire() {
+  if (_connections.empty())
+    return new AsyncConnection;
+  AsyncConnection *connection = _connections.back();
+  _connections.pop_back();
+  return connection;
+}
+
+void ConnectionPool::release(AsyncConnection *connection) {
+  if (_connections.size() >= max_pooled) {
+    delete connection;
+    return;
+  }
+  connection->clear();
+  connection->connection = nullptr;
+  _connections.push_back(connection);
+}
+
+ebb_connection *ConnectionPool::acquireSocket() {
+  if (_sockets.empty())
+    return (ebb_connection *)malloc(sizeof(ebb_connection));
+  ebb_connection *connection = _sockets.back();
+  _sockets.pop_back();
+  return connection;
+}
+
+void ConnectionPool::releaseSocket(ebb_connection *connection) {
+  if (_sockets.size() >= max_pooled) {
+    free(connection);
+    return;
+  }
+  _sockets.push_back(connection);
+}
+
+size_t ConnectionPool::size() const {
+  return _connections.size();
 }
 
 
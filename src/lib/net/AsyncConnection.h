@@ -7,7 +7,10 @@
 #include <cstdlib>
 #include <ev.h>
 
+#include <deque>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "net/AbstractConnection.h"
 
@@ -18,34 +21,138 @@
 namespace hyrise {
 namespace net {
 
+class AsyncConnection;
+class ConnectionPool;
+
+/// A request of a connection. Clients may pipeline requests, those are
+/// parsed while earlier ones are still executed and wait for their turn.
+struct AsyncRequest {
+  /// Bytes of the body buffer allocated up front, it grows by doubling
+  static const size_t initial_body_length = 4096;
+  /// Larger buffers are freed with the request instead of being reused
+  static const size_t max_kept_buffer_length = 1024 * 1024;
+  /// Bytes reserved for an announced body at most, the buffer of a
+  /// longer body grows as its bytes arrive
+  static const size_t max_reserved_body_length = 1024 * 1024;
+  /// Longest body accepted, longer requests are answered with 413
+  static const size_t max_body_length = 256 * 1024 * 1024;
+
+  ebb_request request;
+  AsyncConnection *connection;
+  char *path;
+
+  char *body;
+  size_t body_len;
+  size_t body_capacity;
+
+  bool keep_alive_flag;
+  /// Status the request is answered with instead of being executed, 0 if
+  /// it is executed
+  size_t error_status;
+
+  explicit AsyncRequest(AsyncConnection *connection);
+  ~AsyncRequest();
+  AsyncRequest(const AsyncRequest &) = delete;
+  AsyncRequest &operator=(const AsyncRequest &) = delete;
+  /// Clears the request for the next one, keeping its buffers
+  void reset();
+  /// Makes room for `length` more bytes of the body, returns false if
+  /// the buffer could not be grown
+  bool reserveBody(size_t length);
+  /// Appends the next bytes of a body of `announced` bytes. Sets
+  /// error_status and returns false if the body is too long or its
+  /// buffer could not be grown.
+  bool appendBody(const char *at, size_t length, size_t announced);
+};
+
+/// Connection of a client, answers its requests one after the other in
+/// the order they were received
 class AsyncConnection : public AbstractConnection {
  public:
+  /// Requests a connection keeps for reuse at most
+  static const size_t max_kept_requests = 4;
+  /// Complete requests waiting to be answered before the connection
+  /// stops reading from its client
+  static const size_t max_pipelined_requests = 16;
+
   ev_async ev_write;
   struct ev_loop *ev_loop;
   ebb_connection *connection;
-  ebb_request *request;
   struct sockaddr_in addr;
   struct timeval starttime;
-  char *path;
 
-  char *body;
-  size_t body_len;
+  /// Request being answered, nullptr if there is none
+  AsyncRequest *request;
+  /// Complete requests waiting for the current one to be answered
+  std::deque<AsyncRequest *> pipelined;
 
   char *write_buffer;
   size_t write_buffer_len;
+  size_t write_buffer_capacity;
+
+  /// Pool of the event loop the connection belongs to, nullptr if none
+  ConnectionPool *pool;
 
-  bool keep_alive_flag;
   bool waiting_for_response = false;
+  /// Whether reading was stopped until pipelined requests are answered
+  bool reading_paused = false;
+  /// Whether a request was refused, the connection is closed after its
+  /// answer
+  bool refused = false;
 
   AsyncConnection();
   ~AsyncConnection();
+  /// Finishes the current request
   void reset();
+  /// Forgets all requests, e.g. before the connection is reused
+  void clear();
+  /// Request to parse the next one of the client into
+  AsyncRequest *newRequest();
+  /// Answers `request` next
+  void dispatch(AsyncRequest *request);
+  /// Answers `request` once the requests before it are answered
+  void enqueue(AsyncRequest *request);
+  /// Stops and resumes parsing requests of the client
+  void pauseReading();
+  void resumeReading();
   virtual std::string getBody() const;
   virtual bool hasBody() const;
   virtual std::string getPath() const;
   virtual void respond(const std::string &message, size_t status=200, const std::string& contentType="application/json");
  private:
   virtual void send_response();
+
+  std::vector<std::unique_ptr<AsyncRequest> > _requests;
+  std::vector<AsyncRequest *> _spare;
+};
+
+///
+/// Connections and their buffers an event loop reuses instead of
+/// allocating them for every client. A pool is only used by the thread
+/// of its loop, all connection callbacks run there.
+///
+class ConnectionPool {
+ public:
+  /// Idle connections the pool keeps at most
+  static const size_t max_pooled = 1024;
+
+  ConnectionPool() {}
+  ConnectionPool(const ConnectionPool &) = delete;
+  ConnectionPool &operator=(const ConnectionPool &) = delete;
+  ~ConnectionPool();
+
+  AsyncConnection *acquire();
+  void release(AsyncConnection *connection);
+
+  ebb_connection *acquireSocket();
+  void releaseSocket(ebb_connection *connection);
+
+  /// Number of idle connections
+  size_t size() const;
+
+ private:
+  std::vector<AsyncConnection *> _connections;
+  std::vector<ebb_connection *> _sockets;
 };
 
 ebb_connection *new_connection(ebb_server *server, struct sockaddr_in *addr);
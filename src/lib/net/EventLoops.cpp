@@ -0,0 +1,148 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "net/EventLoops.h"
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace hyrise {
+namespace net {
+
+namespace {
+
+void stop_cb(struct ev_loop *loop, struct ev_async *w, int revents) {
+  EventLoop *event_loop = (EventLoop *) w->data;
+  ebb_server_unlisten(&event_loop->server);
+  ev_async_stop(loop, w);
+}
+
+// Bound socket for `port`, -1 if the port is in use
+int bind_socket(size_t port, bool reuse_port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0)
+    return -1;
+
+  int flags = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &flags, sizeof(flags));
+#ifdef SO_REUSEPORT
+  if (reuse_port)
+    setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &flags, sizeof(flags));
+#endif
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (bind(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+}
+
+EventLoops::EventLoops(size_t count) {
+  if (count == 0)
+    throw std::runtime_error("At least one event loop is needed");
+  for (size_t i = 0; i < count; ++i) {
+    std::unique_ptr<EventLoop> event_loop(new EventLoop());
+    event_loop->loop = (i == 0) ? ev_default_loop(0) : ev_loop_new(EVFLAG_AUTO);
+    event_loop->loops = this;
+    ebb_server_init(&event_loop->server, event_loop->loop);
+    event_loop->server.new_connection = new_connection;
+    event_loop->server.data = event_loop.get();
+    ev_async_init(&event_loop->stop, stop_cb);
+    event_loop->stop.data = event_loop.get();
+    _loops.push_back(std::move(event_loop));
+  }
+}
+
+EventLoops::~EventLoops() {
+  for (auto &event_loop : _loops) {
+    if (event_loop->thread.joinable())
+      event_loop->thread.join();
+  }
+  for (size_t i = 1; i < _loops.size(); ++i)
+    ev_loop_destroy(_loops[i]->loop);
+  ev_default_destroy();
+}
+
+bool EventLoops::listen(size_t port) {
+  if (_loops.size() == 1)
+    return ebb_server_listen_on_port(&_loops[0]->server, port) != -1;
+
+  // Another server listening with SO_REUSEPORT would accept our
+  // connections, so make sure nobody uses the port yet
+  int probe = bind_socket(port, false);
+  if (probe < 0)
+    return false;
+  close(probe);
+
+  std::vector<int> fds;
+#ifdef SO_REUSEPORT
+  for (size_t i = 0; i < _loops.size(); ++i) {
+    int fd = bind_socket(port, true);
+    if (fd < 0) {
+      for (const auto &bound : fds)
+        close(bound);
+      return false;
+    }
+    fds.push_back(fd);
+  }
+#else
+  int fd = bind_socket(port, false);
+  if (fd < 0)
+    return false;
+  fds.push_back(fd);
+  for (size_t i = 1; i < _loops.size(); ++i)
+    fds.push_back(dup(fd));
+#endif
+
+  for (size_t i = 0; i < _loops.size(); ++i) {
+    if (ebb_server_listen_on_fd(&_loops[i]->server, fds[i]) < 0) {
+      for (size_t j = 0; j < i; ++j)
+        ebb_server_unlisten(&_loops[j]->server);
+      for (size_t j = i; j < fds.size(); ++j)
+        close(fds[j]);
+      return false;
+    }
+  }
+  return true;
+}
+
+void EventLoops::run() {
+  for (auto &event_loop : _loops)
+    ev_async_start(event_loop->loop, &event_loop->stop);
+  for (size_t i = 1; i < _loops.size(); ++i) {
+    EventLoop *event_loop = _loops[i].get();
+    event_loop->thread = std::thread([event_loop]() { ev_run(event_loop->loop, 0); });
+  }
+  ev_run(_loops[0]->loop, 0);
+  for (size_t i = 1; i < _loops.size(); ++i)
+    _loops[i]->thread.join();
+}
+
+void EventLoops::unlisten() {
+  for (auto &event_loop : _loops)
+    ev_async_send(event_loop->loop, &event_loop->stop);
+}
+
+size_t EventLoops::size() const {
+  return _loops.size();
+}
+
+void unlisten(ebb_server *server) {
+  EventLoop *event_loop = (EventLoop *) server->data;
+  if (event_loop != nullptr)
+    event_loop->loops->unlisten();
+  else
+    ebb_server_unlisten(server);
+}
+
+}
+}
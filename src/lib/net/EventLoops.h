@@ -0,0 +1,74 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_NET_EVENTLOOPS_H_
+#define SRC_LIB_NET_EVENTLOOPS_H_
+
+#include <ev.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "net/AsyncConnection.h"
+
+#include "ebb/ebb.h"
+
+namespace hyrise {
+namespace net {
+
+class EventLoops;
+
+/// Event loop of one network thread with its own server and listening
+/// socket. Connections it accepts are parsed and answered on its thread
+/// only.
+struct EventLoop {
+  struct ev_loop *loop;
+  ebb_server server;
+  ev_async stop;
+  ConnectionPool pool;
+  EventLoops *loops;
+  std::thread thread;
+};
+
+///
+/// Network threads of the server. Every loop listens on the same port
+/// with a socket of its own opened with SO_REUSEPORT, so the kernel
+/// distributes new connections among the loops and accepting, parsing
+/// and writing responses scale with the number of loops. Without
+/// SO_REUSEPORT the loops share one listening socket.
+///
+/// The first loop is libev's default loop and runs on the thread calling
+/// run().
+///
+class EventLoops {
+ public:
+  explicit EventLoops(size_t count);
+  EventLoops(const EventLoops &) = delete;
+  EventLoops &operator=(const EventLoops &) = delete;
+  ~EventLoops();
+
+  /// Starts all loops listening on `port`, returns false if the port is
+  /// in use
+  bool listen(size_t port);
+
+  /// Runs the loops until they stopped listening and all of their
+  /// connections were closed
+  void run();
+
+  /// Stops all loops from accepting connections, can be called from any
+  /// thread
+  void unlisten();
+
+  size_t size() const;
+
+ private:
+  std::vector<std::unique_ptr<EventLoop> > _loops;
+};
+
+/// Stops the loops of `server` from listening, or only `server` if it
+/// does not belong to EventLoops
+void unlisten(ebb_server *server);
+
+}
+}
+
+#endif  // SRC_LIB_NET_EVENTLOOPS_H_
@@ -1,6 +1,7 @@
 #include "net/ShutdownHandler.h"
 #include <iostream>
 #include "net/AsyncConnection.h"
+#include "net/EventLoops.h"
 #include "ebb/ebb.h"
 
 namespace hyrise {
@@ -21,7 +22,7 @@ const std::string ShutdownHandler::vname() {
 void ShutdownHandler::operator()() {
   if (auto ac = dynamic_cast<AsyncConnection*>(_connection)) {
     ac->respond("shutting down");
-    ebb_server_unlisten(ac->connection->server);
+    unlisten(ac->connection->server);
   }
 }
 
@@ -12,6 +12,9 @@ class AbstractAttributeVector {
   virtual void *data() = 0;
   virtual void setNumRows(size_t s) = 0;
 
+  // Bytes the vector allocated for its values
+  virtual size_t bytes() const = 0;
+
 };
 
 #endif  // SRC_LIB_STORAGE_ABSTRACTATTRIBUTEVECTOR_H_
@@ -21,6 +21,9 @@ public:
   virtual std::shared_ptr<AbstractDictionary> copy_empty() = 0;
   virtual size_t size() = 0;
 
+  // Approximate bytes of the values and lookup structures
+  virtual size_t bytes() const = 0;
+
   virtual void shrink() = 0;
 
 };
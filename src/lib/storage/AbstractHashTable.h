@@ -34,6 +34,10 @@ public:
   virtual size_t getFieldCount() const = 0;
 
   virtual uint64_t numKeys() const = 0;
+
+  /// Approximate bytes the hash table allocated, views on another hash
+  /// table count nothing
+  virtual size_t bytes() const = 0;
 };
 
 #endif  // SRC_LIB_STORAGE_ABSTRACTHASHTABLE_H_
@@ -8,6 +8,8 @@
 #ifndef SRC_LIB_STORAGE_ABSTRACTINDEX_H_
 #define SRC_LIB_STORAGE_ABSTRACTINDEX_H_
 
+#include <cstddef>
+
 #include <storage/AbstractResource.h>
 
 class AbstractIndex : public AbstractResource {
@@ -19,6 +21,9 @@ public:
   virtual ~AbstractIndex();
 
   virtual void shrink() = 0;
+
+  /// Approximate bytes the index allocated
+  virtual size_t bytes() const = 0;
 };
 
 #endif  // SRC_LIB_STORAGE_ABSTRACTINDEX_H_
@@ -149,6 +149,13 @@ void AbstractTable::copyRowFrom(const hyrise::storage::c_atable_ptr_t& source, c
  }
 }
 
+void AbstractTable::gatherValueIds(const size_t column, const pos_list_t &rows, std::vector<ValueId> &valueIds) const {
+  valueIds.resize(rows.size());
+  for (size_t i = 0; i < rows.size(); ++i) {
+    valueIds[i] = getValueId(column, rows[i]);
+  }
+}
+
 void AbstractTable::setValueId(const size_t column, const size_t row, const ValueId valueId) {
   throw std::runtime_error("Setting valueIds not supported");
 }
@@ -306,6 +313,13 @@ const attr_vectors_t AbstractTable::getAttributeVectors(size_t column) const {
   throw std::runtime_error("getAttributeVectors not implemented");
 }
 
+size_t AbstractTable::bytes() const {
+  size_t result = 0;
+  for (size_t column = 0; column < columnCount(); ++column)
+    result += columnBytes(column);
+  return result;
+}
+
 void AbstractTable::debugStructure(size_t level) const {
   std::cout << std::string(level, '\t') << "AbstractTable " << this << std::endl;
 }
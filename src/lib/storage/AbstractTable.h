@@ -222,6 +222,19 @@ public:
   virtual ValueId getValueId(size_t column, size_t row) const = 0;
 
 
+  /**
+   * Returns the value-IDs of a column at several rows.
+   * Equivalent to calling getValueId for every row, but the column is
+   * resolved only once; derived classes read their attribute vectors
+   * directly.
+   *
+   * @param column   Column number of the cells.
+   * @param rows     Row numbers of the cells.
+   * @param valueIds Resized to the number of rows, receives the value-IDs.
+   */
+  virtual void gatherValueIds(size_t column, const pos_list_t &rows, std::vector<ValueId> &valueIds) const;
+
+
   /**
    * Sets the value ID of a cell.
    * @note Should be implemented in derived classes or throws runtime error!
@@ -296,9 +309,10 @@ public:
     ValueId valueId;
     valueId.table = table_id;
 
-    if (map->valueExists(value)) {
-      valueId.valueId = map->getValueIdForValue(value);
-    } else if (create) {
+    if (map->findValueId(value, valueId.valueId))
+      return valueId;
+
+    if (create) {
       valueId.valueId = map->addValue(value);
       /*if (map->isOrdered()) {
         throw std::runtime_error("Cannot insert value in an ordered dictionary");
@@ -333,9 +347,10 @@ public:
     ValueId valueId;
     valueId.table = table_id;
 
-    if (map->valueExists(value)) {
-      valueId.valueId = map->getValueIdForValue(value);
-    } else if (create) {
+    if (map->findValueId(value, valueId.valueId))
+      return valueId;
+
+    if (create) {
       /*if (map->isOrdered()) {
         throw std::runtime_error("Cannot insert value in an ordered dictionary");
         }*/
@@ -376,11 +391,8 @@ public:
     ValueId valueId;
     valueId.table = 0;
 
-    if (map->valueExists(value)) {
-      valueId.valueId = map->getValueIdForValue(value);
-    } else {
+    if (!map->findValueId(value, valueId.valueId))
       valueId.valueId = map->addValue(value);
-    }
 
     //return valueId;
     //ValueId valueId = getValueIdForValue(column, value, true);
@@ -532,6 +544,19 @@ public:
   */
   virtual const attr_vectors_t getAttributeVectors(size_t column) const;
 
+  /**
+   * Approximate bytes the attribute vectors and dictionaries of a column
+   * allocated. Attribute vectors of several columns are split evenly,
+   * views and position lists count nothing for the columns they reference.
+   */
+  virtual size_t columnBytes(size_t column) const = 0;
+
+  /**
+   * Approximate bytes of all columns and of the table's own structures,
+   * e.g. position lists or transaction vectors.
+   */
+  virtual size_t bytes() const;
+
   virtual void debugStructure(size_t level=0) const;
 
   unique_id getUuid() const;
@@ -2,6 +2,7 @@
 #ifndef SRC_LIB_STORAGE_ATTRIBUTEVECTORFACTORY_H_
 #define SRC_LIB_STORAGE_ATTRIBUTEVECTORFACTORY_H_
 
+#include <algorithm>
 #include <memory>
 
 #include <storage/BaseAttributeVector.h>
@@ -11,13 +12,18 @@
 class AttributeVectorFactory {
 public:
 
+  /// Returns a vector for `columns` columns. Compressed vectors store
+  /// every column with the minimal bit width for `distinct_values`
+  /// values.
   template <typename T>
   static std::shared_ptr<BaseAttributeVector<T>> getAttributeVector(size_t columns = 1,
       size_t rows = 0,
       int distinct_values = 1,
   bool compressed = false) {
-
-    return std::make_shared<FixedLengthVector<T> >(columns, rows);
+    if (!compressed)
+      return std::make_shared<FixedLengthVector<T> >(columns, rows);
+    const uint64_t bits = bitsForValues(std::max(distinct_values, 1));
+    return std::make_shared<BitCompressedVector<T> >(columns, rows, std::vector<uint64_t>(columns, bits));
   }
 
   template <typename T>
@@ -2,6 +2,11 @@
 #ifndef SRC_LIB_STORAGE_BASEDICTIONARY_H_
 #define SRC_LIB_STORAGE_BASEDICTIONARY_H_
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
 #include <storage/storage_types.h>
 #include <storage/AbstractDictionary.h>
 #include <storage/DictionaryIterator.h>
@@ -31,6 +36,29 @@ public:
   virtual bool isValueIdValid(value_id_t value_id) = 0;
   virtual bool valueExists(const T &value) const = 0;
 
+  /*
+   * Sets value_id to the value id of value if the value exists, with a
+   * single lookup instead of valueExists() and getValueIdForValue().
+   */
+  virtual bool findValueId(const T &value, value_id_t &value_id) const {
+    if (!valueExists(value))
+      return false;
+    value_id = getValueIdForValue(value);
+    return true;
+  }
+
+  /*
+   * Translates all values at once, e.g. of IN lists or join keys. Values
+   * that do not exist get the largest value id.
+   */
+  virtual void getValueIdsForValues(const std::vector<T> &values, std::vector<value_id_t> &value_ids) const {
+    value_ids.resize(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (!findValueId(values[i], value_ids[i]))
+        value_ids[i] = std::numeric_limits<value_id_t>::max();
+    }
+  }
+
   virtual void reserve(size_t size) = 0;
   virtual size_t size() = 0;
 
@@ -43,6 +71,16 @@ public:
   virtual DictionaryIterator<T> begin() = 0;
   virtual DictionaryIterator<T> end() = 0;
 
+protected:
+  // Positions of `values` in ascending order of the values
+  static std::vector<size_t> ascendingOrder(const std::vector<T> &values) {
+    std::vector<size_t> order(values.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (!std::is_sorted(values.begin(), values.end()))
+      std::sort(order.begin(), order.end(), [&values](size_t l, size_t r) { return values[l] < values[r]; });
+    return order;
+  }
+
 };
 
 #endif  // SRC_LIB_STORAGE_BASEDICTIONARY_H_
@@ -12,7 +12,7 @@
 #include <stdexcept>
 #include <type_traits>
 
-#include "memory/MallocStrategy.h"
+#include "memory/Allocator.h"
 #include "storage/BaseAttributeVector.h"
 
 #ifndef WORD_LENGTH
@@ -27,12 +27,24 @@ T maxValueForBits(const std::size_t bits) {
   if (bits == sizeof(T) * 8) return static_cast<T>(-1);
   else return (1ull << bits) -1;
 }
+// Compute the minimal bit width to store the numbers 0 to values - 1, at
+// least one bit.
+inline uint64_t bitsForValues(const uint64_t values) {
+  uint64_t bits = 1;
+  while (bits < 64 && (1ull << bits) < values)
+    ++bits;
+  return bits;
+}
+
 /*
   can only save positive numbers
+
+  The bit width of every column is chosen when the vector is built, e.g.
+  from the dictionary of a merged main. Values that do not fit it are
+  rejected.
 */
 template <typename T>
 class BitCompressedVector : public BaseAttributeVector<T> {
-  using Strategy = MallocStrategy;
   // Typedef for the data
   typedef uint64_t storage_t;
   typedef std::vector<uint64_t> bit_size_list_t;
@@ -57,19 +69,23 @@ class BitCompressedVector : public BaseAttributeVector<T> {
   // The bits used for each column
   bit_size_list_t _bits;
 
+  // Allocator that was current when the vector was created
+  hyrise::memory::Allocator *_allocator;
+
 public:
   typedef T value_type;
 
   BitCompressedVector(size_t columns,
                       size_t rows,
-                      std::vector<uint64_t> bits={}): _data(nullptr), _size(0), _allocatedBlocks(0), _columns(columns), _bits(bits) {
+                      std::vector<uint64_t> bits={}): _data(nullptr), _size(0), _allocatedBlocks(0), _columns(columns), _bits(bits),
+      _allocator(hyrise::memory::Allocator::current()) {
     // When bits is unset, behave like a fixed length vector
     if (bits.size() == 0) { _bits = std::vector<uint64_t>(_columns, sizeof(T) * 8); }
     reserve(rows);
   }
 
   virtual ~BitCompressedVector() {
-    Strategy::deallocate(_data, _allocatedBlocks * sizeof(storage_t));
+    _allocator->deallocate(_data, _allocatedBlocks * sizeof(storage_t));
   }
 
   void *data() {
@@ -105,10 +121,8 @@ public:
 
   void set(size_t column, size_t row, T value) {
     checkAccess(column, row);
-#ifdef EXPENSIVE_ASSERTIONS
-    if (value > maxValueForBits<T>(_bits[column]))
+    if (_bits[column] < sizeof(T) * 8 && value > maxValueForBits<T>(_bits[column]))
       throw std::out_of_range("trying to insert value larger than can be stored");
-#endif
     auto offset = _blockOffset(row);
     auto colOffset = _offsetForColumn(column);
     auto block = _blockPosition(row) + (offset + colOffset) / _bit_width;
@@ -133,25 +147,20 @@ public:
   /*
     Reserve memory for the given number of rows. memory will only be
     allocated if the number of rows requires a larger number of blocks
-    than before and it can only be incremented.
+    than before and it can only be incremented. The allocator grows the
+    memory in place if it can.
    */
   void reserve(size_t rows) {
-    if (rows > 0 && _blocks(rows) > _blocks(_allocatedBlocks)) {
-      // Allocate the new memory, copy the old memory and swap the
-      // data
+    if (rows > 0 && _blocks(rows) > _allocatedBlocks) {
       assert(_blocks(rows) > 0);
-      storage_t *newMemory = _allocate(_blocks(rows));
-      if (_allocatedBlocks > 0)
-        std::memcpy(newMemory, _data, _allocatedBlocks * sizeof(storage_t));
-
-      std::swap(_data, newMemory);
-
-      // Only deallocate if there was something allocated
-      if (newMemory != nullptr)
-        Strategy::deallocate(newMemory, _allocatedBlocks * sizeof(storage_t));
-
-      // set new allocarted blocks
-      _allocatedBlocks = _blocks(rows);
+      const uint64_t blocks = _blocks(rows);
+      auto data = static_cast<storage_t *>(_allocator->reallocate(_data, blocks * sizeof(storage_t),
+                                                                   _allocatedBlocks * sizeof(storage_t)));
+      if (data == nullptr)
+        throw std::bad_alloc();
+      std::memset(data + _allocatedBlocks, 0, (blocks - _allocatedBlocks) * sizeof(storage_t));
+      _data = data;
+      _allocatedBlocks = blocks;
     }
   }
 
@@ -161,8 +170,9 @@ public:
    */
   void clear() {
     _size = 0;
-    Strategy::deallocate(_data, _allocatedBlocks * sizeof(storage_t));
+    _allocator->deallocate(_data, _allocatedBlocks * sizeof(storage_t));
     _data = nullptr;
+    _allocatedBlocks = 0;
   }
 
   size_t size() {
@@ -183,12 +193,73 @@ public:
     return (_allocatedBlocks * _bit_width) / _tupleWidth();
   }
 
+  size_t bytes() const {
+    return _allocatedBlocks * sizeof(storage_t);
+  }
+
+  /*
+    Layout of the packed rows for loops that decode many rows at once:
+    the value of (column, row) starts at bit
+    tupleWidth() * row + columnOffset(column) of blocks()
+   */
+  const storage_t *blocks() const {
+    return _data;
+  }
+
+  uint64_t tupleWidth() const {
+    return _tupleWidth();
+  }
+
+  uint64_t columnOffset(size_t column) const {
+    return _offsetForColumn(column);
+  }
+
+  size_t columns() const {
+    return _columns;
+  }
+
+  uint64_t bitsForColumn(size_t column) const {
+    return _bits[column];
+  }
+
+  /*
+    Changes the bit width of a column. The rows [0, size()) are packed
+    again with the new width, values that do not fit it are truncated.
+    The data is replaced, so this is only called while the vector is not
+    shared yet, e.g. while its table is built or merged.
+   */
   void rewriteColumn(const size_t column, const size_t bits) {
-    //uint64_t oldBits = _bits[column];
-    _bits[column] = bits;
-    if (_size > 0) {
-      throw std::runtime_error("Bad rewrite");
+    if (bits == _bits[column])
+      return;
+    if (_allocatedBlocks == 0 || _tupleWidth() == 0) {
+      _bits[column] = bits;
+      return;
+    }
+
+    BitCompressedVector packed(_columns, 0, _bits);
+    packed._allocator = _allocator;
+    packed._bits[column] = bits;
+    packed.reserve(capacity());
+    packed._size = _size;
+    for (size_t row = 0; row < _size; ++row) {
+      for (size_t c = 0; c < _columns; ++c)
+        packed.set(c, row, c == column ? get(c, row) & maxValueForBits<uint64_t>(bits) : get(c, row));
     }
+    std::swap(_data, packed._data);
+    std::swap(_allocatedBlocks, packed._allocatedBlocks);
+    std::swap(_bits, packed._bits);
+  }
+
+  /*
+    Fast path for vectors with a single column whose width is that of W,
+    e.g. 8 or 16 bits: the value of row r is aligned<W>()[r]. Returns
+    nullptr for any other layout. The blocks are stored little endian.
+   */
+  template <typename W>
+  const W *aligned() const {
+    if (_columns != 1 || _bits[0] != sizeof(W) * 8)
+      return nullptr;
+    return reinterpret_cast<const W *>(_data);
   }
 
   std::shared_ptr<BaseAttributeVector<T>> copy() {
@@ -256,21 +327,6 @@ private:
     }
     return sum;
   }
-
-  /*
-  * Allocate memory given by the number of blocks
-  */
-  inline storage_t *_allocate(uint64_t numBlocks) {
-
-    auto data = static_cast<storage_t *>(Strategy::allocate(numBlocks * sizeof(storage_t)));
-    if (data == nullptr) {
-      Strategy::deallocate(data, numBlocks * sizeof(storage_t));
-      throw std::bad_alloc();
-    }
-    std::memset(data, 0, numBlocks * sizeof(storage_t));
-    return data;
-  }
-
 };
 
 #endif  // SRC_LIB_STORAGE_BITCOMPRESSEDVECTOR_H_
@@ -0,0 +1,265 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_COLUMNACCESSOR_H_
+#define SRC_LIB_STORAGE_COLUMNACCESSOR_H_
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "storage/AbstractTable.h"
+#include "storage/BaseAttributeVector.h"
+#include "storage/BitCompressedVector.h"
+#include "storage/ConcurrentFixedLengthVector.h"
+#include "storage/FixedLengthVector.h"
+#include "storage/OrderPreservingDictionary.h"
+#include "storage/PointerCalculator.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+
+/// Typed read access to one column of a table.
+///
+/// getValue<T> resolves the value id and the dictionary of every cell
+/// through several virtual calls. The accessor resolves the column once
+/// into segments of consecutive rows, one per attribute vector returned by
+/// getAttributeVectors() (e.g. main and delta of a store), each with its
+/// dictionary. Position lists and field mappings of a PointerCalculator are
+/// applied on top. Loops over many rows decode value ids and values with
+/// calls bound to the concrete attribute vector and dictionary types.
+///
+/// Tables without attribute vectors are read through getValue<T>.
+template <typename T>
+class ColumnAccessor {
+public:
+  ColumnAccessor(const c_atable_ptr_t &table, const field_t column) :
+      _table(table), _column(column), _positions(nullptr) {
+    if (const auto& pc = std::dynamic_pointer_cast<const PointerCalculator>(table)) {
+      // PointerCalculators refer to their base table directly
+      if (std::dynamic_pointer_cast<const PointerCalculator>(pc->getTable()))
+        return;
+      _base = pc->getTable();
+      _base_column = pc->getTableColumnForColumn(column);
+      _positions = pc->getPositions();
+    } else {
+      _base = table;
+      _base_column = column;
+    }
+
+    attr_vectors_t vectors;
+    try {
+      vectors = _base->getAttributeVectors(_base_column);
+    } catch (const std::runtime_error &) {
+      return;
+    }
+
+    const size_t rows = _base->size();
+    pos_t first = 0;
+    for (const auto& v : vectors) {
+      if (first >= rows)
+        break;
+      Segment segment;
+      segment.holder = v.attribute_vector;
+      segment.vector = std::dynamic_pointer_cast<BaseAttributeVector<value_id_t> >(v.attribute_vector).get();
+      if (segment.vector == nullptr) {
+        _segments.clear();
+        return;
+      }
+      segment.kind = kindOf(segment.vector);
+      segment.offset = v.attribute_offset;
+      segment.dictionary = std::dynamic_pointer_cast<BaseDictionary<T> >(_base->dictionaryAt(_base_column, first)).get();
+      if (segment.dictionary == nullptr)
+        throw std::runtime_error("Column type does not match the accessor");
+      segment.ordered = dynamic_cast<OrderPreservingDictionary<T> *>(segment.dictionary);
+      segment.first = first;
+      // Delta vectors may hold more rows than the table
+      segment.last = std::min<pos_t>(rows, first + segment.vector->size());
+      _segments.push_back(segment);
+      first = segment.last;
+    }
+    if (first < rows)
+      _segments.clear();
+  }
+
+  /// Number of rows of the table
+  size_t size() const {
+    return _table->size();
+  }
+
+  T get(const pos_t row) const {
+    if (_segments.empty())
+      return _table->getValue<T>(_column, row);
+    const pos_t base = baseRow(row);
+    const auto& segment = _segments[segmentOf(base)];
+    const value_id_t valueId = segment.vector->get(segment.offset, base - segment.first);
+    return segment.dictionary->getValueForValueId(valueId);
+  }
+
+  /// Calls f(row, value) for all rows in ascending order
+  template <typename F>
+  void forEach(F f) const {
+    if (_segments.empty()) {
+      for (size_t row = 0; row < _table->size(); ++row)
+        f(row, _table->getValue<T>(_column, row));
+    } else if (_positions == nullptr) {
+      visit(_table->size(), [](size_t i) { return i; }, f);
+    } else {
+      const auto& positions = *_positions;
+      visit(positions.size(), [&positions](size_t i) { return positions[i]; }, f);
+    }
+  }
+
+  /// Calls f(i, value) for the value of each row rows[i] in the order of
+  /// `rows`
+  template <typename F>
+  void forEach(const pos_list_t &rows, F f) const {
+    if (_segments.empty()) {
+      for (size_t i = 0; i < rows.size(); ++i)
+        f(i, _table->getValue<T>(_column, rows[i]));
+    } else if (_positions == nullptr) {
+      visit(rows.size(), [&rows](size_t i) { return rows[i]; }, f);
+    } else {
+      const auto& positions = *_positions;
+      visit(rows.size(), [&rows, &positions](size_t i) { return positions[rows[i]]; }, f);
+    }
+  }
+
+  /// Replaces `values` with the values of `rows`
+  void gather(const pos_list_t &rows, std::vector<T> &values) const {
+    values.resize(rows.size());
+    forEach(rows, [&values](size_t i, const T &value) { values[i] = value; });
+  }
+
+private:
+  enum VectorKind {
+    Fixed,
+    BitCompressed,
+    Concurrent,
+    Other
+  };
+
+  struct Segment {
+    std::shared_ptr<AbstractAttributeVector> holder;
+    BaseAttributeVector<value_id_t> *vector;
+    VectorKind kind;
+    size_t offset;
+    BaseDictionary<T> *dictionary;
+    OrderPreservingDictionary<T> *ordered;
+    // Rows [first, last) of the base table
+    pos_t first;
+    pos_t last;
+  };
+
+  // Qualified calls are bound statically and can be inlined into the loops
+  template <typename Vector>
+  struct StaticVector {
+    static value_id_t get(const BaseAttributeVector<value_id_t> *vector, const size_t column, const size_t row) {
+      return static_cast<const Vector *>(vector)->Vector::get(column, row);
+    }
+  };
+
+  struct ConcurrentVector {
+    static value_id_t get(const BaseAttributeVector<value_id_t> *vector, const size_t column, const size_t row) {
+      typedef ConcurrentFixedLengthVector<value_id_t> vector_t;
+      return static_cast<const vector_t *>(vector)->vector_t::getRef(column, row);
+    }
+  };
+
+  struct VirtualVector {
+    static value_id_t get(const BaseAttributeVector<value_id_t> *vector, const size_t column, const size_t row) {
+      return vector->get(column, row);
+    }
+  };
+
+  struct OrderedDictionary {
+    static T get(const Segment &segment, const value_id_t valueId) {
+      return segment.ordered->OrderPreservingDictionary<T>::getValueForValueId(valueId);
+    }
+  };
+
+  struct VirtualDictionary {
+    static T get(const Segment &segment, const value_id_t valueId) {
+      return segment.dictionary->getValueForValueId(valueId);
+    }
+  };
+
+  static VectorKind kindOf(const BaseAttributeVector<value_id_t> *vector) {
+    if (dynamic_cast<const FixedLengthVector<value_id_t> *>(vector))
+      return Fixed;
+    if (dynamic_cast<const BitCompressedVector<value_id_t> *>(vector))
+      return BitCompressed;
+    if (dynamic_cast<const ConcurrentFixedLengthVector<value_id_t> *>(vector))
+      return Concurrent;
+    return Other;
+  }
+
+  pos_t baseRow(const pos_t row) const {
+    return _positions == nullptr ? row : (*_positions)[row];
+  }
+
+  size_t segmentOf(const pos_t row) const {
+    size_t segment = 0;
+    while (segment + 1 < _segments.size() && row >= _segments[segment].last)
+      ++segment;
+    return segment;
+  }
+
+  // Calls f(i, value) for the base rows rowOf(i) of all i < count, switching
+  // to the loop for the concrete types once per run of rows in a segment
+  template <typename RowOf, typename F>
+  void visit(const size_t count, RowOf rowOf, F &f) const {
+    size_t begin = 0;
+    while (begin < count) {
+      const auto& segment = _segments[segmentOf(rowOf(begin))];
+      size_t end = begin + 1;
+      while (end < count && rowOf(end) >= segment.first && rowOf(end) < segment.last)
+        ++end;
+
+      switch (segment.kind) {
+        case Fixed:
+          visitSegment<StaticVector<FixedLengthVector<value_id_t> > >(segment, begin, end, rowOf, f);
+          break;
+        case BitCompressed:
+          visitSegment<StaticVector<BitCompressedVector<value_id_t> > >(segment, begin, end, rowOf, f);
+          break;
+        case Concurrent:
+          visitSegment<ConcurrentVector>(segment, begin, end, rowOf, f);
+          break;
+        default:
+          visitSegment<VirtualVector>(segment, begin, end, rowOf, f);
+      }
+      begin = end;
+    }
+  }
+
+  template <typename Vector, typename RowOf, typename F>
+  void visitSegment(const Segment &segment, const size_t begin, const size_t end, RowOf &rowOf, F &f) const {
+    if (segment.ordered != nullptr)
+      visitRun<Vector, OrderedDictionary>(segment, begin, end, rowOf, f);
+    else
+      visitRun<Vector, VirtualDictionary>(segment, begin, end, rowOf, f);
+  }
+
+  template <typename Vector, typename Dictionary, typename RowOf, typename F>
+  void visitRun(const Segment &segment, const size_t begin, const size_t end, RowOf &rowOf, F &f) const {
+    for (size_t i = begin; i < end; ++i) {
+      const value_id_t valueId = Vector::get(segment.vector, segment.offset, rowOf(i) - segment.first);
+      f(i, Dictionary::get(segment, valueId));
+    }
+  }
+
+  c_atable_ptr_t _table;
+  field_t _column;
+  c_atable_ptr_t _base;
+  field_t _base_column;
+  // Positions of a PointerCalculator in its base table, all rows if null
+  const pos_list_t *_positions;
+  // Empty if the column is read through getValue
+  std::vector<Segment> _segments;
+};
+
+}
+}
+
+#endif  // SRC_LIB_STORAGE_COLUMNACCESSOR_H_
@@ -0,0 +1,152 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/CompressionAdvisor.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "storage/BitCompressedVector.h"
+#include "storage/FrameOfReferenceVector.h"
+#include "storage/MutableVerticalTable.h"
+#include "storage/RunLengthVector.h"
+#include "storage/SparseVector.h"
+#include "storage/Table.h"
+
+namespace hyrise {
+namespace storage {
+
+namespace {
+
+typedef FrameOfReferenceVector<value_id_t> for_t;
+
+// Smaller columns stay bit packed
+const size_t min_rows = for_t::block_rows;
+
+size_t words(const uint64_t bits) {
+  return (bits + 63) / 64 * sizeof(uint64_t);
+}
+
+// Value ids of `column` of `vector`
+std::vector<value_id_t> decode(const std::shared_ptr<BaseAttributeVector<value_id_t> > &vector, const size_t column) {
+  std::vector<value_id_t> values(vector->size());
+  for (size_t row = 0; row < values.size(); ++row)
+    values[row] = vector->get(column, row);
+  return values;
+}
+
+size_t compressTable(const atable_ptr_t &table) {
+  if (auto vertical = std::dynamic_pointer_cast<MutableVerticalTable>(table)) {
+    size_t encoded = 0;
+    for (size_t container = 0; container < vertical->partitionCount(); ++container)
+      encoded += compressTable(vertical->getContainer(container));
+    return encoded;
+  }
+
+  auto base = std::dynamic_pointer_cast<Table>(table);
+  if (!base || base->columnCount() != 1)
+    return 0;
+  const auto vectors = base->getAttributeVectors(0);
+  auto vector = std::dynamic_pointer_cast<BaseAttributeVector<value_id_t> >(vectors.front().attribute_vector);
+  if (!vector)
+    return 0;
+
+  const auto values = decode(vector, vectors.front().attribute_offset);
+  const auto encoding = CompressionAdvisor::advise(values);
+  if (encoding == CompressionAdvisor::BitPacked)
+    return 0;
+  base->setAttributes(CompressionAdvisor::encode(values, encoding));
+  return 1;
+}
+
+}
+
+std::vector<CompressionAdvisor::Estimate> CompressionAdvisor::estimate(const std::vector<value_id_t> &values) {
+  value_id_t max = 0;
+  size_t runs = 0;
+  for (size_t row = 0; row < values.size(); ++row) {
+    max = std::max(max, values[row]);
+    runs += row == 0 || values[row] != values[row - 1];
+  }
+
+  // Rows that do not have the most frequent value id
+  std::vector<size_t> counts(size_t(max) + 1);
+  for (const auto value : values)
+    ++counts[value];
+  const size_t exceptions = values.size() - (values.empty() ? 0 : *std::max_element(counts.begin(), counts.end()));
+
+  size_t blocks = 0;
+  for (size_t first = 0; first < values.size(); first += for_t::block_rows) {
+    const size_t last = std::min(values.size(), first + for_t::block_rows);
+    const auto range = std::minmax_element(values.begin() + first, values.begin() + last);
+    const uint64_t difference = *range.second - *range.first;
+    blocks += words((last - first) * (difference == 0 ? 0 : bitsForValues(difference + 1))) +
+        2 * sizeof(value_id_t) + sizeof(uint8_t) + sizeof(uint64_t);
+  }
+
+  return {
+    {BitPacked, words(values.size() * bitsForValues(size_t(max) + 1))},
+    {RunLength, runs * (sizeof(value_id_t) + sizeof(size_t))},
+    {FrameOfReference, blocks},
+    {Sparse, sizeof(value_id_t) + exceptions * (sizeof(value_id_t) + sizeof(size_t))}
+  };
+}
+
+CompressionAdvisor::Encoding CompressionAdvisor::advise(const std::vector<value_id_t> &values) {
+  if (values.size() < min_rows)
+    return BitPacked;
+  const auto estimates = estimate(values);
+  auto best = estimates.front();
+  for (const auto& estimate : estimates) {
+    if (estimate.bytes < best.bytes)
+      best = estimate;
+  }
+  // Bit packed vectors are read without searching, so another encoding
+  // has to save a quarter of their memory
+  return best.bytes * 4 <= estimates.front().bytes * 3 ? best.encoding : BitPacked;
+}
+
+std::shared_ptr<BaseAttributeVector<value_id_t> > CompressionAdvisor::encode(const std::vector<value_id_t> &values,
+                                                                             const Encoding encoding) {
+  switch (encoding) {
+    case BitPacked: {
+      const value_id_t max = values.empty() ? 0 : *std::max_element(values.begin(), values.end());
+      auto vector = std::make_shared<BitCompressedVector<value_id_t> >(
+          1, values.size(), std::vector<uint64_t>(1, bitsForValues(size_t(max) + 1)));
+      vector->resize(values.size());
+      for (size_t row = 0; row < values.size(); ++row)
+        vector->set(0, row, values[row]);
+      return vector;
+    }
+    case RunLength:
+      return std::make_shared<RunLengthVector<value_id_t> >(values);
+    case FrameOfReference:
+      return std::make_shared<FrameOfReferenceVector<value_id_t> >(values);
+    case Sparse: {
+      std::vector<size_t> counts;
+      for (const auto value : values) {
+        if (value >= counts.size())
+          counts.resize(size_t(value) + 1);
+        ++counts[value];
+      }
+      const value_id_t default_value = counts.empty() ? 0 : std::max_element(counts.begin(), counts.end()) - counts.begin();
+      return std::make_shared<SparseVector<value_id_t> >(values, default_value);
+    }
+  }
+  throw std::runtime_error("Unknown encoding");
+}
+
+size_t CompressionAdvisor::compress(const atable_ptr_t &table) {
+  return compressTable(table);
+}
+
+std::string CompressionAdvisor::name(const Encoding encoding) {
+  switch (encoding) {
+    case BitPacked: return "BitPacked";
+    case RunLength: return "RunLength";
+    case FrameOfReference: return "FrameOfReference";
+    case Sparse: return "Sparse";
+  }
+  return "Unknown";
+}
+
+}
+}
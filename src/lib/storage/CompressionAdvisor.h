@@ -0,0 +1,60 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_COMPRESSIONADVISOR_H_
+#define SRC_LIB_STORAGE_COMPRESSIONADVISOR_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "helper/types.h"
+
+#include "storage/BaseAttributeVector.h"
+
+namespace hyrise {
+namespace storage {
+
+/// Chooses the attribute vector of every main column when a store merges.
+///
+/// Columns stay bit packed (BitCompressedVector) unless another encoding
+/// is estimated to need at most three quarters of the memory: run length
+/// encoding for sorted and clustered columns, frame of reference encoding
+/// for value ids that grow with the row and sparse encoding for columns
+/// of mostly one value. Only columns of at least 1024 rows stored
+/// in an attribute vector of their own are encoded, columns that share a
+/// vertical partition keep the layout of the table.
+class CompressionAdvisor {
+ public:
+  enum Encoding {
+    BitPacked,
+    RunLength,
+    FrameOfReference,
+    Sparse
+  };
+
+  struct Estimate {
+    Encoding encoding;
+    size_t bytes;
+  };
+
+  /// Estimated memory of `values` in every encoding, BitPacked first
+  static std::vector<Estimate> estimate(const std::vector<value_id_t> &values);
+
+  /// Encoding for `values`
+  static Encoding advise(const std::vector<value_id_t> &values);
+
+  /// Attribute vector with the values in `encoding`
+  static std::shared_ptr<BaseAttributeVector<value_id_t> > encode(const std::vector<value_id_t> &values,
+                                                                  Encoding encoding);
+
+  /// Replaces the attribute vector of every column of `table` that has
+  /// one of its own with the advised encoding, returns the number of
+  /// columns that are no longer bit packed
+  static size_t compress(const atable_ptr_t &table);
+
+  static std::string name(Encoding encoding);
+};
+
+}
+}
+
+#endif  // SRC_LIB_STORAGE_COMPRESSIONADVISOR_H_
@@ -42,6 +42,10 @@ class ConcurrentFixedLengthVector : public AbstractFixedLengthVector<T> {
     return _values.size() / _columns;
   }
 
+  virtual size_t bytes() const override {
+    return _values.capacity() * sizeof(T);
+  }
+
   virtual void setNumRows(std::size_t num) override { NOT_IMPLEMENTED }
 
   virtual std::shared_ptr<BaseAttributeVector<T>> copy() override {
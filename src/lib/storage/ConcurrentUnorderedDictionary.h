@@ -4,6 +4,7 @@
 #include "helper/not_implemented.h"
 #include "storage/BaseDictionary.h"
 #include "storage/DictionaryIterator.h"
+#include "storage/memory_usage.h"
 #include "tbb/concurrent_vector.h"
 #include "tbb/concurrent_unordered_map.h"
 template <typename T>
@@ -79,6 +80,12 @@ class ConcurrentUnorderedDictionary : public BaseDictionary<T> {
   virtual std::size_t size() override {
     return _values.size();
   }
+  virtual std::size_t bytes() const override {
+    std::size_t result = _values.capacity() * sizeof(T);
+    for (const auto& value : _values)
+      result += hyrise::storage::heapBytes(value);
+    return result + hyrise::storage::mapBytes(_index_unordered) + hyrise::storage::mapBytes(_index);
+  }
   virtual bool isOrdered() override {
     return false;
   }
@@ -0,0 +1,92 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_ENCODEDATTRIBUTEVECTOR_H_
+#define SRC_LIB_STORAGE_ENCODEDATTRIBUTEVECTOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "storage/BaseAttributeVector.h"
+
+/*
+  Base of the attribute vectors a main column is encoded into after a
+  merge (RunLengthVector, FrameOfReferenceVector and SparseVector).
+
+  Encoded vectors store a single column and are built once from all of
+  its values. set() changes the encoding in place and is much slower
+  than writing to a bit packed vector; encoded vectors cannot grow.
+*/
+template <typename T>
+class EncodedAttributeVector : public BaseAttributeVector<T> {
+public:
+  typedef T value_type;
+
+  explicit EncodedAttributeVector(size_t rows) : _rows(rows) {
+  }
+
+  virtual ~EncodedAttributeVector() {
+  }
+
+  void *data() {
+    throw std::runtime_error("Direct data access not allowed");
+  }
+
+  void setNumRows(size_t s) {
+    fixedSize();
+  }
+
+  // Encoded vectors never grow, reserving their size again is a no-op
+  void reserve(size_t rows) {
+    if (rows > _rows)
+      fixedSize();
+  }
+
+  void resize(size_t rows) {
+    if (rows != _rows)
+      fixedSize();
+  }
+
+  uint64_t capacity() {
+    return _rows;
+  }
+
+  void clear() {
+    fixedSize();
+  }
+
+  size_t size() {
+    return _rows;
+  }
+
+  // Value ids of encoded vectors keep their width
+  void rewriteColumn(const size_t column, const size_t bits) {
+  }
+
+  // Name of the encoding, e.g. for plans and statistics
+  virtual std::string encoding() const = 0;
+
+protected:
+  inline void checkAccess(const size_t& column, const size_t& row) const {
+#ifdef EXPENSIVE_ASSERTIONS
+    if (column != 0) {
+      throw std::out_of_range("Trying to access column '"
+                              + std::to_string(column) + "' of an encoded vector");
+    }
+    if (row >= _rows) {
+      throw std::out_of_range("Trying to access rows '"
+                              + std::to_string(row) + "' where only '"
+                              + std::to_string(_rows) + "' available");
+    }
+#endif
+  }
+
+  size_t _rows;
+
+private:
+  void fixedSize() const {
+    throw std::runtime_error(encoding() + " attribute vectors cannot be resized");
+  }
+};
+
+#endif  // SRC_LIB_STORAGE_ENCODEDATTRIBUTEVECTOR_H_
@@ -13,7 +13,7 @@
 #include <stdexcept>
 #include <sstream>
 
-#include "memory/MallocStrategy.h"
+#include "memory/Allocator.h"
 #include "storage/BaseAttributeVector.h"
 
 
@@ -32,19 +32,21 @@ class FixedLengthVector : public AbstractFixedLengthVector<T> {
   size_t _allocated_bytes;
 
   std::mutex _allocate_mtx;
-  using Strategy = MallocStrategy;
+  // Allocator that was current when the vector was created
+  hyrise::memory::Allocator *_allocator;
  public:
   typedef T value_type;
   
   FixedLengthVector(size_t columns,  size_t rows)  :
-      _values(nullptr), _rows(0), _columns(columns), _allocated_bytes(0) {
+      _values(nullptr), _rows(0), _columns(columns), _allocated_bytes(0),
+      _allocator(hyrise::memory::Allocator::current()) {
     if (rows > 0) {
       reserve(rows);
     }
   }
 
   virtual ~FixedLengthVector() {
-    Strategy::deallocate(_values, _allocated_bytes);
+    _allocator->deallocate(_values, _allocated_bytes);
   }
 
   void *data() {
@@ -83,6 +85,10 @@ class FixedLengthVector : public AbstractFixedLengthVector<T> {
     return _rows;
   }
 
+  size_t columns() const {
+    return _columns;
+  }
+
   void resize(size_t rows) {
     reserve(rows);
     _rows = rows;
@@ -95,8 +101,13 @@ class FixedLengthVector : public AbstractFixedLengthVector<T> {
     return _allocated_bytes / (sizeof(value_type) * _columns);
   }
 
+  size_t bytes() const {
+    return _allocated_bytes;
+  }
+
   std::shared_ptr<BaseAttributeVector<T>> copy() {
-    auto copy = std::make_shared<FixedLengthVector<T>>(_columns, _rows);
+    auto copy = std::make_shared<FixedLengthVector<T>>(_columns, 0);
+    copy->_allocator = _allocator;
     copy->_rows = _rows;
     copy->allocate(_allocated_bytes);
     memcpy(copy->_values, _values, _allocated_bytes);
@@ -135,16 +146,18 @@ class FixedLengthVector : public AbstractFixedLengthVector<T> {
     std::lock_guard<std::mutex> guard(_allocate_mtx);
 
     if (bytes != _allocated_bytes) {
-      void *new_values = Strategy::reallocate(_values, bytes, _allocated_bytes);
-    
-      if (bytes > _allocated_bytes)
-        memset(((char*) new_values) + _allocated_bytes, 0, bytes - _allocated_bytes);
+      void *new_values = _allocator->reallocate(_values, bytes, _allocated_bytes);
 
       if (new_values == nullptr) {
-        Strategy::deallocate(_values, _allocated_bytes);
+        _allocator->deallocate(_values, _allocated_bytes);
+        _values = nullptr;
+        _allocated_bytes = 0;
         throw std::bad_alloc();
       }
 
+      if (bytes > _allocated_bytes)
+        memset(((char*) new_values) + _allocated_bytes, 0, bytes - _allocated_bytes);
+
       _values = static_cast<T*>(new_values);
       _allocated_bytes = bytes;
     }
@@ -0,0 +1,147 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_FRAMEOFREFERENCEVECTOR_H_
+#define SRC_LIB_STORAGE_FRAMEOFREFERENCEVECTOR_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "storage/BitCompressedVector.h"
+#include "storage/EncodedAttributeVector.h"
+
+/*
+  Frame of reference encoded column for value ids that grow with the row,
+  e.g. of ids or timestamps.
+
+  The rows are split into blocks of block_rows rows. Every block stores
+  its smallest value id, the reference, and the differences of its rows
+  to it packed with the minimal bit width for the block. Scans compare
+  the smallest and largest value id of a block to the predicate and only
+  decode blocks that pass partially.
+*/
+template <typename T>
+class FrameOfReferenceVector : public EncodedAttributeVector<T> {
+public:
+  typedef T value_type;
+
+  static const size_t block_rows = 1024;
+
+  explicit FrameOfReferenceVector(const std::vector<T> &values) : EncodedAttributeVector<T>(values.size()) {
+    encode(values);
+  }
+
+  T get(size_t column, size_t row) const {
+    this->checkAccess(column, row);
+    const size_t block = row / block_rows;
+    const uint64_t bits = _bits[block];
+    if (bits == 0)
+      return _references[block];
+    const uint64_t position = _offsets[block] + (row % block_rows) * bits;
+    const uint64_t word = position / 64;
+    const uint64_t offset = position % 64;
+    uint64_t result = _words[word] >> offset;
+    if (offset + bits > 64)
+      result |= _words[word + 1] << (64 - offset);
+    return _references[block] + (result & maxValueForBits<uint64_t>(bits));
+  }
+
+  // Values that do not fit the block of the row encode the whole vector
+  // again
+  void set(size_t column, size_t row, T value) {
+    this->checkAccess(column, row);
+    const size_t block = row / block_rows;
+    const uint64_t bits = _bits[block];
+    if (value < _references[block] || (uint64_t) value - _references[block] > maxValueForBits<uint64_t>(bits)) {
+      std::vector<T> values(this->_rows);
+      for (size_t r = 0; r < values.size(); ++r)
+        values[r] = get(0, r);
+      values[row] = value;
+      encode(values);
+      return;
+    }
+    write(_offsets[block] + (row % block_rows) * bits, bits, (uint64_t) value - _references[block]);
+    _maximums[block] = std::max(_maximums[block], value);
+  }
+
+  size_t blocks() const {
+    return _references.size();
+  }
+
+  // Smallest value id of `block`
+  T reference(size_t block) const {
+    return _references[block];
+  }
+
+  // Largest value id of `block`
+  T maximum(size_t block) const {
+    return _maximums[block];
+  }
+
+  uint64_t bitsForBlock(size_t block) const {
+    return _bits[block];
+  }
+
+  std::string encoding() const {
+    return "FrameOfReference";
+  }
+
+  size_t bytes() const {
+    return _words.size() * sizeof(uint64_t) +
+        blocks() * (2 * sizeof(T) + sizeof(uint8_t) + sizeof(uint64_t));
+  }
+
+  std::shared_ptr<BaseAttributeVector<T>> copy() {
+    return std::make_shared<FrameOfReferenceVector>(*this);
+  }
+
+private:
+  void encode(const std::vector<T> &values) {
+    _references.clear();
+    _maximums.clear();
+    _bits.clear();
+    _offsets.clear();
+    _words.clear();
+
+    uint64_t position = 0;
+    for (size_t first = 0; first < values.size(); first += block_rows) {
+      const size_t last = std::min(values.size(), first + block_rows);
+      const auto range = std::minmax_element(values.begin() + first, values.begin() + last);
+      const T reference = *range.first;
+      const uint64_t difference = (uint64_t) *range.second - reference;
+      const uint8_t bits = difference == 0 ? 0 : bitsForValues(difference + 1);
+
+      _references.push_back(reference);
+      _maximums.push_back(*range.second);
+      _bits.push_back(bits);
+      _offsets.push_back(position);
+
+      _words.resize((position + (last - first) * bits + 63) / 64);
+      for (size_t row = first; row < last; ++row, position += bits)
+        write(position, bits, (uint64_t) values[row] - reference);
+    }
+  }
+
+  void write(const uint64_t position, const uint64_t bits, const uint64_t value) {
+    if (bits == 0)
+      return;
+    const uint64_t mask = maxValueForBits<uint64_t>(bits);
+    const uint64_t word = position / 64;
+    const uint64_t offset = position % 64;
+    _words[word] = (_words[word] & ~(mask << offset)) | (value << offset);
+    if (offset + bits > 64)
+      _words[word + 1] = (_words[word + 1] & ~(mask >> (64 - offset))) | (value >> (64 - offset));
+  }
+
+  std::vector<T> _references;
+  std::vector<T> _maximums;
+  std::vector<uint8_t> _bits;
+  // First bit of every block in _words
+  std::vector<uint64_t> _offsets;
+  std::vector<uint64_t> _words;
+};
+
+template <typename T>
+const size_t FrameOfReferenceVector<T>::block_rows;
+
+#endif  // SRC_LIB_STORAGE_FRAMEOFREFERENCEVECTOR_H_
@@ -0,0 +1,375 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_FRONTCODEDDICTIONARY_H_
+#define SRC_LIB_STORAGE_FRONTCODEDDICTIONARY_H_
+
+#include <assert.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "storage/BaseDictionary.h"
+#include "storage/BaseIterator.h"
+#include "storage/DictionaryIterator.h"
+#include "storage/storage_types.h"
+
+template <typename T>
+class OrderPreservingDictionary;
+
+template <typename T>
+class OrderPreservingDictionaryIterator;
+
+/*
+ * Order preserving dictionary for strings, front coded in one contiguous
+ * heap instead of a vector of strings.
+ *
+ * The values are stored in blocks of block_size values. The first value
+ * of a block is stored as its length and its characters, every other
+ * value as the length of the prefix it shares with the value before it,
+ * the length of the rest and the characters of the rest; lengths are
+ * variable byte encoded. Lookups binary search the first values of the
+ * blocks and decode a single block. The first eight characters of every
+ * block's first value are also kept as an integer in a separate array, so
+ * the search only reads the heap for blocks that share them.
+ *
+ * Decoding has to rebuild the value from the values before it in its
+ * block, so getValueForValueId returns a new string; decode() reuses the
+ * buffer of a given string instead.
+ */
+template <>
+class OrderPreservingDictionary<std::string> : public BaseDictionary<std::string> {
+public:
+  typedef std::string value_type;
+
+  static const size_t block_size = 16;
+
+  OrderPreservingDictionary() : _size(0) {
+  }
+
+  explicit OrderPreservingDictionary(size_t size) : _size(0) {
+    reserve(size);
+  }
+
+  virtual ~OrderPreservingDictionary() {}
+
+  void shrink() {
+    _heap.shrink_to_fit();
+    _blocks.shrink_to_fit();
+    _keys.shrink_to_fit();
+  }
+
+  value_id_t addValue(std::string value) {
+#ifdef EXPENSIVE_ASSERTIONS
+    if (_size > 0 && value <= _last)
+      throw std::runtime_error("Can't insert value smaller or equal to last value");
+#endif
+    if (_size % block_size == 0) {
+      _blocks.push_back(_heap.size());
+      _keys.push_back(key(value));
+      writeLength(value.size());
+      _heap.insert(_heap.end(), value.begin(), value.end());
+    } else {
+      const size_t shared = std::mismatch(_last.begin(), _last.begin() + std::min(_last.size(), value.size()),
+                                          value.begin()).first - _last.begin();
+      writeLength(shared);
+      writeLength(value.size() - shared);
+      _heap.insert(_heap.end(), value.begin() + shared, value.end());
+    }
+    _last.swap(value);
+    return _size++;
+  }
+
+  std::string getValueForValueId(value_id_t value_id) {
+    std::string value;
+    decode(value_id, value);
+    return value;
+  }
+
+  /// Sets `value` to the value of `value_id`
+  void decode(value_id_t value_id, std::string &value) const {
+#ifdef EXPENSIVE_ASSERTIONS
+    if (value_id >= _size)
+      throw std::out_of_range("Trying to access value_id larger than available values");
+#endif
+    size_t position = blockPosition(value_id / block_size);
+    for (size_t id = value_id - value_id % block_size; id <= value_id; ++id)
+      position = next(position, id % block_size == 0, value);
+  }
+
+  /// Position of the first value of `block` in the heap
+  size_t blockPosition(size_t block) const {
+    return _blocks[block];
+  }
+
+  /// Decodes the value that starts at `position` of the heap, the first
+  /// of its block if `head`, into `value`, which has to hold the value
+  /// before it otherwise. Returns the position of the next value.
+  size_t next(size_t position, const bool head, std::string &value) const {
+    const size_t shared = head ? 0 : readLength(position);
+    const size_t rest = readLength(position);
+    value.resize(shared);
+    value.append(_heap.data() + position, rest);
+    return position + rest;
+  }
+
+  /// First value id whose value is not less than `value`
+  value_id_t lowerBound(const std::string &value) const {
+    return bound(value, false);
+  }
+
+  /// First value id whose value is greater than `value`
+  value_id_t upperBound(const std::string &value) const {
+    return bound(value, true);
+  }
+
+  /// Value ids [first, second) of the values that start with `prefix`
+  std::pair<value_id_t, value_id_t> prefixRange(const std::string &prefix) const {
+    const value_id_t first = lowerBound(prefix);
+    // The first value after all values with the prefix is not less than
+    // the prefix with its last character incremented
+    std::string after = prefix;
+    while (!after.empty() && (unsigned char) after.back() == 0xff)
+      after.pop_back();
+    if (after.empty())
+      return {first, _size};
+    ++after.back();
+    return {first, std::max(first, lowerBound(after))};
+  }
+
+  value_id_t getValueIdForValue(const std::string &value) const {
+    return lowerBound(value);
+  }
+
+  bool findValueId(const std::string &value, value_id_t &value_id) const {
+    bool found = false;
+    value_id = bound(value, false, 0, &found);
+    return found;
+  }
+
+  /// Looks the values up in ascending order, every search starts at the
+  /// block of the value id found before it
+  void getValueIdsForValues(const std::vector<std::string> &values, std::vector<value_id_t> &value_ids) const {
+    value_ids.resize(values.size());
+    size_t block = 0;
+    for (const auto& i : ascendingOrder(values)) {
+      bool found = false;
+      const value_id_t id = bound(values[i], false, block, &found);
+      value_ids[i] = found ? id : std::numeric_limits<value_id_t>::max();
+      block = id / block_size;
+    }
+  }
+
+  value_id_t getValueIdForValueSmaller(std::string other) {
+    const value_id_t index = lowerBound(other);
+    assert(index > 0);
+    return index - 1;
+  }
+
+  value_id_t getValueIdForValueGreater(std::string other) {
+    return upperBound(other);
+  }
+
+  const std::string getSmallestValue() {
+    assert(_size > 0);
+    return getValueForValueId(0);
+  }
+
+  const std::string getGreatestValue() {
+    assert(_size > 0);
+    return _last;
+  }
+
+  bool isValueIdValid(value_id_t value_id) {
+    return value_id < _size;
+  }
+
+  bool valueExists(const std::string &value) const {
+    value_id_t value_id;
+    return findValueId(value, value_id);
+  }
+
+  void reserve(size_t size) {
+    _blocks.reserve((size + block_size - 1) / block_size);
+    _keys.reserve((size + block_size - 1) / block_size);
+  }
+
+  size_t size() {
+    return _size;
+  }
+
+  /// Bytes of the heap, the block offsets and the keys
+  size_t bytes() const {
+    return _heap.size() + _blocks.size() * (sizeof(size_t) + sizeof(uint64_t));
+  }
+
+  std::shared_ptr<AbstractDictionary> copy() {
+    throw std::runtime_error("Dictionaries cannot be copied");
+  }
+
+  std::shared_ptr<AbstractDictionary> copy_empty() {
+    return std::make_shared<OrderPreservingDictionary<std::string> >();
+  }
+
+  bool isOrdered() {
+    return true;
+  }
+
+  typedef DictionaryIterator<std::string> iterator;
+
+  iterator begin();
+  iterator end();
+
+private:
+  void writeLength(size_t length) {
+    while (length >= 0x80) {
+      _heap.push_back(char(length | 0x80));
+      length >>= 7;
+    }
+    _heap.push_back(char(length));
+  }
+
+  size_t readLength(size_t &position) const {
+    size_t length = 0;
+    for (size_t shift = 0;; shift += 7) {
+      const unsigned char byte = _heap[position++];
+      length |= size_t(byte & 0x7f) << shift;
+      if (byte < 0x80)
+        return length;
+    }
+  }
+
+  // First eight characters of `value` in big endian order, zero padded;
+  // keys compare like the values unless they are equal
+  static uint64_t key(const std::string &value) {
+    uint64_t result = 0;
+    for (size_t i = 0; i < sizeof(uint64_t); ++i)
+      result = (result << 8) | (i < value.size() ? (unsigned char) value[i] : 0);
+    return result;
+  }
+
+  // Compares the first value of `block` with `value`, whose key is
+  // `value_key`, without copying it
+  int compareHead(const size_t block, const std::string &value, const uint64_t value_key) const {
+    if (_keys[block] != value_key)
+      return _keys[block] < value_key ? -1 : 1;
+    size_t position = _blocks[block];
+    const size_t length = readLength(position);
+    const int result = std::memcmp(_heap.data() + position, value.data(), std::min(length, value.size()));
+    if (result != 0)
+      return result;
+    return length < value.size() ? -1 : (length > value.size() ? 1 : 0);
+  }
+
+  // First value id whose value is not less (or, if `after`, greater) than
+  // `value`, which is known to be in `first_block` or after it. Sets
+  // `found` if the value id has the value.
+  value_id_t bound(const std::string &value, const bool after, const size_t first_block = 0,
+                   bool *found = nullptr) const {
+    // Last block whose first value is less than (or not greater than)
+    // `value`; the bound is in this block or starts the next one
+    const uint64_t value_key = key(value);
+    size_t lo = first_block, hi = _blocks.size();
+    while (lo < hi) {
+      const size_t mid = lo + (hi - lo) / 2;
+      const int order = compareHead(mid, value, value_key);
+      if (order < 0 || (after && order == 0))
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+    if (lo > first_block) {
+      const size_t block = lo - 1;
+      const size_t last = std::min(_size, (block + 1) * block_size);
+      std::string current;
+      size_t position = _blocks[block];
+      for (size_t id = block * block_size; id < last; ++id) {
+        position = next(position, id == block * block_size, current);
+        const int order = current.compare(value);
+        if (order > 0 || (!after && order == 0)) {
+          if (found)
+            *found = order == 0;
+          return id;
+        }
+      }
+    }
+    if (found)
+      *found = !after && lo < _blocks.size() && compareHead(lo, value, value_key) == 0;
+    return std::min(_size, lo * block_size);
+  }
+
+  std::vector<char> _heap;
+  // Position of the first value of every block in the heap
+  std::vector<size_t> _blocks;
+  // key() of the first value of every block
+  std::vector<uint64_t> _keys;
+  size_t _size;
+  std::string _last;
+};
+
+/*
+ * Iterator over a front coded dictionary, decodes every value from the
+ * one before it.
+ */
+template <>
+class OrderPreservingDictionaryIterator<std::string> : public BaseIterator<std::string> {
+  typedef OrderPreservingDictionary<std::string> dictionary_type;
+
+public:
+  const dictionary_type *_dictionary;
+  size_t _index;
+
+  OrderPreservingDictionaryIterator(const dictionary_type *dictionary, size_t index) :
+      _dictionary(dictionary), _index(index), _decoded(0), _position(0), _valid(false) {}
+
+  virtual ~OrderPreservingDictionaryIterator() { }
+
+  void increment() {
+    ++_index;
+  }
+
+  bool equal(const std::shared_ptr<BaseIterator<std::string>>& other) const {
+    const auto& it = std::dynamic_pointer_cast<OrderPreservingDictionaryIterator<std::string>>(other);
+    return _dictionary == it->_dictionary && _index == it->_index;
+  }
+
+  std::string &dereference() const {
+    if (!_valid || _decoded != _index) {
+      if (_valid && _decoded + 1 == _index) {
+        _position = _dictionary->next(_position, _index % dictionary_type::block_size == 0, _value);
+      } else {
+        _position = _dictionary->blockPosition(_index / dictionary_type::block_size);
+        for (size_t id = _index - _index % dictionary_type::block_size; id <= _index; ++id)
+          _position = _dictionary->next(_position, id % dictionary_type::block_size == 0, _value);
+      }
+      _decoded = _index;
+      _valid = true;
+    }
+    return _value;
+  }
+
+  value_id_t getValueId() const {
+    return _index;
+  }
+
+private:
+  mutable std::string _value;
+  mutable size_t _decoded;
+  mutable size_t _position;
+  mutable bool _valid;
+};
+
+inline OrderPreservingDictionary<std::string>::iterator OrderPreservingDictionary<std::string>::begin() {
+  return iterator(std::make_shared<OrderPreservingDictionaryIterator<std::string>>(this, 0));
+}
+
+inline OrderPreservingDictionary<std::string>::iterator OrderPreservingDictionary<std::string>::end() {
+  return iterator(std::make_shared<OrderPreservingDictionaryIterator<std::string>>(this, _size));
+}
+
+#endif  // SRC_LIB_STORAGE_FRONTCODEDDICTIONARY_H_
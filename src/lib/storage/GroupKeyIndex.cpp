@@ -0,0 +1,107 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/GroupKeyIndex.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "helper/parallel_for.h"
+
+#include "storage/AbstractDictionary.h"
+#include "storage/AbstractTable.h"
+#include "storage/BaseAttributeVector.h"
+#include "storage/memory_usage.h"
+
+namespace hyrise {
+namespace storage {
+
+namespace {
+
+// Rows one thread counts and scatters at least
+const size_t min_rows_per_thread = 1 << 16;
+
+}
+
+std::shared_ptr<GroupKeyIndex> GroupKeyIndex::build(const c_atable_ptr_t &table, const field_t column) {
+  std::shared_ptr<GroupKeyIndex> index(new GroupKeyIndex);
+  index->_dictionary = table->dictionaryAt(column);
+  if (!index->_dictionary)
+    throw std::runtime_error("GroupKeyIndex needs a dictionary encoded column");
+
+  attr_vectors_t vectors;
+  try {
+    vectors = table->getAttributeVectors(column);
+  } catch (const std::runtime_error &) {
+  }
+  std::shared_ptr<BaseAttributeVector<value_id_t> > vector;
+  if (vectors.size() == 1)
+    vector = std::dynamic_pointer_cast<BaseAttributeVector<value_id_t> >(vectors.front().attribute_vector);
+  const size_t offset = vector ? vectors.front().attribute_offset : 0;
+  auto id = [&](const size_t row) {
+    return vector ? vector->get(offset, row) : table->getValueId(column, row).valueId;
+  };
+
+  const size_t rows = table->size();
+  const size_t distinct = index->_dictionary->size();
+  // Every thread keeps a histogram over all value ids, so high cardinality
+  // columns are sorted by fewer threads
+  const size_t threads = std::max<size_t>(1, std::min<size_t>({helper::maxParallelThreads(),
+                                                               rows / min_rows_per_thread,
+                                                               rows / std::max<size_t>(distinct, 1)}));
+  const size_t rows_per_thread = (rows + threads - 1) / threads;
+  auto range = [&](const size_t t) {
+    return std::make_pair(std::min(rows, t * rows_per_thread), std::min(rows, (t + 1) * rows_per_thread));
+  };
+
+  // Every thread counts the value ids of its rows
+  std::vector<size_t> counts(threads * distinct);
+  helper::parallelFor(threads, threads, [&](const size_t, const size_t t) {
+    const auto r = range(t);
+    size_t *count = counts.data() + t * distinct;
+    for (size_t row = r.first; row < r.second; ++row)
+      ++count[id(row)];
+  });
+
+  // The rows of a value id are ordered by thread, so every thread starts
+  // its part of value id v after the parts of the threads before it
+  index->_offsets.resize(distinct + 1);
+  size_t sum = 0;
+  for (size_t v = 0; v < distinct; ++v) {
+    index->_offsets[v] = sum;
+    for (size_t t = 0; t < threads; ++t) {
+      const size_t count = counts[t * distinct + v];
+      counts[t * distinct + v] = sum;
+      sum += count;
+    }
+  }
+  index->_offsets[distinct] = sum;
+
+  index->_positions.resize(rows);
+  helper::parallelFor(threads, threads, [&](const size_t, const size_t t) {
+    const auto r = range(t);
+    size_t *next = counts.data() + t * distinct;
+    for (size_t row = r.first; row < r.second; ++row)
+      index->_positions[next[id(row)]++] = row;
+  });
+  return index;
+}
+
+GroupKeyIndex::~GroupKeyIndex() {
+}
+
+void GroupKeyIndex::shrink() {
+  _positions.shrink_to_fit();
+}
+
+size_t GroupKeyIndex::bytes() const {
+  // The dictionary belongs to the table
+  return vectorBytes(_offsets) + vectorBytes(_positions);
+}
+
+std::pair<const pos_t *, const pos_t *> GroupKeyIndex::rows(const value_id_t id) const {
+  if (id >= distinct())
+    return {nullptr, nullptr};
+  return {_positions.data() + _offsets[id], _positions.data() + _offsets[id + 1]};
+}
+
+}
+}
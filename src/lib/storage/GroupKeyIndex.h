@@ -0,0 +1,67 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_GROUPKEYINDEX_H_
+#define SRC_LIB_STORAGE_GROUPKEYINDEX_H_
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "helper/types.h"
+
+#include "storage/AbstractIndex.h"
+
+namespace hyrise {
+namespace storage {
+
+/// Rows of every value id of one dictionary encoded column.
+///
+/// The rows of value id v are positions()[offsets()[v]] up to
+/// positions()[offsets()[v + 1]], in ascending order. The index is built
+/// with a parallel counting sort over the attribute vector and is only
+/// valid for the dictionary it was built on; stores build it for their
+/// main and rebuild it on merge, see Store::groupKeyIndex.
+class GroupKeyIndex : public AbstractIndex {
+ public:
+  /// Index of `column` of `table`, which has to have a single dictionary
+  /// for the column, e.g. the main of a store
+  static std::shared_ptr<GroupKeyIndex> build(const c_atable_ptr_t &table, field_t column);
+
+  virtual ~GroupKeyIndex();
+
+  void shrink();
+
+  size_t bytes() const;
+
+  /// Number of value ids
+  size_t distinct() const {
+    return _offsets.size() - 1;
+  }
+
+  /// First and last row of value id `id`
+  std::pair<const pos_t *, const pos_t *> rows(value_id_t id) const;
+
+  const std::vector<size_t> &offsets() const {
+    return _offsets;
+  }
+
+  const std::vector<pos_t> &positions() const {
+    return _positions;
+  }
+
+  /// Dictionary the value ids refer to
+  const std::shared_ptr<AbstractDictionary> &dictionary() const {
+    return _dictionary;
+  }
+
+ private:
+  GroupKeyIndex() {}
+
+  std::vector<size_t> _offsets;
+  std::vector<pos_t> _positions;
+  std::shared_ptr<AbstractDictionary> _dictionary;
+};
+
+}
+}
+
+#endif  // SRC_LIB_STORAGE_GROUPKEYINDEX_H_
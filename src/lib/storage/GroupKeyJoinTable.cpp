@@ -0,0 +1,91 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/GroupKeyJoinTable.h"
+
+#include "storage/AbstractTable.h"
+#include "storage/memory_usage.h"
+#include "storage/meta_storage.h"
+#include "storage/Store.h"
+
+namespace hyrise {
+namespace storage {
+
+namespace {
+
+struct probe_functor {
+  typedef pos_list_t value_type;
+
+  const GroupKeyJoinTable &join_table;
+  const c_atable_ptr_t &table;
+  const field_t column;
+  const pos_t row;
+
+  probe_functor(const GroupKeyJoinTable &j, const c_atable_ptr_t &t, const field_t c, const pos_t r) :
+      join_table(j), table(t), column(c), row(r) {}
+
+  template <typename T>
+  value_type operator()() {
+    return join_table.rows(table->getValue<T>(column, row));
+  }
+};
+
+}
+
+GroupKeyJoinTable::GroupKeyJoinTable(const c_atable_ptr_t &table, const field_t column,
+                                     const std::shared_ptr<const GroupKeyIndex> &groups) :
+    _table(table), _column(column), _groups(groups) {
+  const auto& store = std::dynamic_pointer_cast<const Store>(table);
+  if (!store) {
+    if (!_groups)
+      _groups = GroupKeyIndex::build(table, column);
+    return;
+  }
+
+  if (!_groups)
+    _groups = store->groupKeyIndex(column);
+  const auto& delta = store->getDeltaTable();
+  _delta_dictionary = delta->dictionaryAt(column);
+  const pos_t offset = store->deltaOffset();
+  for (size_t row = 0; row < delta->size(); ++row)
+    _delta[delta->getValueId(column, row).valueId].push_back(offset + row);
+}
+
+GroupKeyJoinTable::~GroupKeyJoinTable() {
+}
+
+size_t GroupKeyJoinTable::size() const {
+  return _table->size();
+}
+
+size_t GroupKeyJoinTable::bytes() const {
+  return mapBytes(_delta);
+}
+
+pos_list_t GroupKeyJoinTable::get(const c_atable_ptr_t &table, const field_list_t &columns, const pos_t row) const {
+  probe_functor fun(*this, table, columns.at(0), row);
+  type_switch<hyrise_basic_types> ts;
+  return ts(_table->typeOfColumn(_column), fun);
+}
+
+c_atable_ptr_t GroupKeyJoinTable::getTable() const {
+  return _table;
+}
+
+field_list_t GroupKeyJoinTable::getFields() const {
+  return {_column};
+}
+
+size_t GroupKeyJoinTable::getFieldCount() const {
+  return 1;
+}
+
+uint64_t GroupKeyJoinTable::numKeys() const {
+  return _groups->distinct() + _delta.size();
+}
+
+std::string GroupKeyJoinTable::stats() const {
+  return "Group key index with " + std::to_string(_groups->distinct()) + " main value ids / " +
+      std::to_string(_delta.size()) + " delta value ids";
+}
+
+}
+}
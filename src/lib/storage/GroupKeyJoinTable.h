@@ -0,0 +1,87 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_GROUPKEYJOINTABLE_H_
+#define SRC_LIB_STORAGE_GROUPKEYJOINTABLE_H_
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "helper/types.h"
+
+#include "storage/AbstractHashTable.h"
+#include "storage/BaseDictionary.h"
+#include "storage/GroupKeyIndex.h"
+
+namespace hyrise {
+namespace storage {
+
+/// Join hash table on one column of a base table that looks up the rows
+/// of the main in its GroupKeyIndex instead of hashing them.
+///
+/// Stores share the group key index of their main between queries, only
+/// the rows of the delta are hashed by their delta value id when the
+/// table is created. Like every join hash table it is valid until the
+/// next merge of the store.
+class GroupKeyJoinTable : public AbstractHashTable {
+ public:
+  /// Join table on `column` of `table`, a store or a table with a single
+  /// dictionary for the column. Uses `groups` or, if null, the group key
+  /// index of the store's main or a new one.
+  GroupKeyJoinTable(const c_atable_ptr_t &table, field_t column,
+                    const std::shared_ptr<const GroupKeyIndex> &groups = nullptr);
+  virtual ~GroupKeyJoinTable();
+
+  /// Rows whose value in the column is `value`, ascending
+  template <typename T>
+  pos_list_t rows(const T &value) const;
+
+  /// Number of rows in the table
+  size_t size() const;
+  pos_list_t get(const c_atable_ptr_t &table, const field_list_t &columns, pos_t row) const;
+  c_atable_ptr_t getTable() const;
+  field_list_t getFields() const;
+  size_t getFieldCount() const;
+  uint64_t numKeys() const;
+  /// Bytes of the delta positions, the group key index belongs to the store
+  size_t bytes() const;
+  std::string stats() const;
+
+ private:
+  c_atable_ptr_t _table;
+  const field_t _column;
+  std::shared_ptr<const GroupKeyIndex> _groups;
+
+  std::shared_ptr<AbstractDictionary> _delta_dictionary;
+  // Table positions of the delta rows of every delta value id
+  std::unordered_map<value_id_t, pos_list_t> _delta;
+};
+
+template <typename T>
+pos_list_t GroupKeyJoinTable::rows(const T &value) const {
+  auto main = std::dynamic_pointer_cast<BaseDictionary<T> >(_groups->dictionary());
+  if (!main)
+    throw std::runtime_error("Key type does not match the type of the join column");
+
+  pos_list_t result;
+  value_id_t id;
+  if (main->findValueId(value, id)) {
+    const auto range = _groups->rows(id);
+    result.assign(range.first, range.second);
+  }
+
+  if (_delta_dictionary) {
+    auto delta = std::static_pointer_cast<BaseDictionary<T> >(_delta_dictionary);
+    if (delta->findValueId(value, id)) {
+      const auto it = _delta.find(id);
+      if (it != _delta.end())
+        result.insert(result.end(), it->second.begin(), it->second.end());
+    }
+  }
+  return result;
+}
+
+}
+}
+
+#endif  // SRC_LIB_STORAGE_GROUPKEYJOINTABLE_H_
@@ -14,6 +14,7 @@
 
 #include "storage/AbstractHashTable.h"
 #include "storage/AbstractTable.h"
+#include "storage/memory_usage.h"
 #include "storage/storage_types.h"
 
 template<class MAP, class KEY> class HashTableView;
@@ -114,13 +115,20 @@ public:
   }
 };
 
+// Hash tables of a query count against its memory limit
+template <typename KEY, typename HASH>
+struct hash_map {
+  typedef std::unordered_multimap<KEY, pos_t, HASH, std::equal_to<KEY>,
+                                  hyrise::memory::ArenaAllocator<std::pair<const KEY, pos_t> > > type;
+};
+
 // Multi Keys
-typedef std::unordered_multimap<aggregate_key_t, pos_t, GroupKeyHash<aggregate_key_t> > aggregate_hash_map_t;
-typedef std::unordered_multimap<join_key_t, pos_t, GroupKeyHash<join_key_t> > join_hash_map_t;
+typedef hash_map<aggregate_key_t, GroupKeyHash<aggregate_key_t> >::type aggregate_hash_map_t;
+typedef hash_map<join_key_t, GroupKeyHash<join_key_t> >::type join_hash_map_t;
 
 // Single Keys
-typedef std::unordered_multimap<aggregate_single_key_t, pos_t, SingleGroupKeyHash<aggregate_single_key_t> > aggregate_single_hash_map_t;
-typedef std::unordered_multimap<join_single_key_t, pos_t, SingleGroupKeyHash<join_single_key_t> > join_single_hash_map_t;
+typedef hash_map<aggregate_single_key_t, SingleGroupKeyHash<aggregate_single_key_t> >::type aggregate_single_hash_map_t;
+typedef hash_map<join_single_key_t, SingleGroupKeyHash<join_single_key_t> >::type join_single_hash_map_t;
 
 /// HashTable based on a map; key specifies the key for the given map
 template<class MAP, class KEY> class HashTable;
@@ -219,6 +227,10 @@ public:
     return _map.size();
   }
 
+  virtual size_t bytes() const {
+    return hyrise::storage::mapBytes(_map) + _map.bucket_count() * sizeof(void *);
+  }
+
   /// Get positions for values given in the table by row and columns.
   virtual pos_list_t get(const hyrise::storage::c_atable_ptr_t &table,
                          const field_list_t &columns,
@@ -330,6 +342,10 @@ public:
     return std::distance(_begin, _end);
   }
 
+  size_t bytes() const {
+    return 0;
+  }
+
   /// Get positions for values in the table cells of given row and columns.
   /// TODO: check whether copy to new unordered_map and search via equal_range is faster
   virtual pos_list_t get(
@@ -92,6 +92,20 @@ size_t HorizontalTable::partitionWidth(const size_t slice) const {
   return _parts[0]->partitionWidth(slice);
 }
 
+size_t HorizontalTable::columnBytes(const size_t column) const {
+  size_t result = 0;
+  for (const auto& part : _parts)
+    result += part->columnBytes(column);
+  return result;
+}
+
+size_t HorizontalTable::bytes() const {
+  size_t result = 0;
+  for (const auto& part : _parts)
+    result += part->bytes();
+  return result;
+}
+
 hyrise::storage::atable_ptr_t HorizontalTable::copy() const {
   throw std::runtime_error("Not implemented");
 }
@@ -34,6 +34,8 @@ class HorizontalTable : public AbstractTable {
   size_t partitionWidth(size_t slice) const override;
   table_id_t subtableCount() const override;
   atable_ptr_t copy() const override;
+  size_t columnBytes(size_t column) const override;
+  size_t bytes() const override;
   void debugStructure(size_t level=0) const override;
  private:
   size_t partForRow(size_t row) const;
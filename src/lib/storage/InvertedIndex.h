@@ -12,13 +12,15 @@
 #include "storage/storage_types.h"
 #include "storage/AbstractIndex.h"
 #include "storage/AbstractTable.h"
+#include "storage/ColumnAccessor.h"
+#include "storage/memory_usage.h"
 
 #include <memory>
 
 template<typename T>
 class InvertedIndex : public AbstractIndex {
 private:
-  typedef std::map<T, pos_list_t> inverted_index_t;
+  typedef std::map<T, std::vector<pos_t> > inverted_index_t;
   inverted_index_t _index;
 
 public:
@@ -29,19 +31,20 @@ for (auto & e : _index)
       e.second.shrink_to_fit();
   }
 
+  size_t bytes() const {
+    return hyrise::storage::mapBytes(_index);
+  }
+
   explicit InvertedIndex(const hyrise::storage::c_atable_ptr_t& in, field_t column) {
     if (in != nullptr) {
-      for (size_t row = 0; row < in->size(); ++row) {
-        T tmp = in->getValue<T>(column, row);
+      hyrise::storage::ColumnAccessor<T>(in, column).forEach([this](size_t row, const T &tmp) {
         typename inverted_index_t::iterator find = _index.find(tmp);
         if (find == _index.end()) {
-          pos_list_t pos;
-          pos.push_back(row);
-          _index[tmp] = pos;
+          _index[tmp].push_back(row);
         } else {
           find->second.push_back(row);
         }
-      }
+      });
     }
   };
 
@@ -51,7 +54,7 @@ for (auto & e : _index)
   pos_list_t getPositionsForKey(T key) {
     typename inverted_index_t::iterator it = _index.find(key);
     if (it != _index.end()) {
-      return it->second;
+      return pos_list_t(it->second.begin(), it->second.end());
     } else {
       pos_list_t empty;
       return empty;
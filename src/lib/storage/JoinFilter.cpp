@@ -0,0 +1,184 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/JoinFilter.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "storage/AbstractDictionary.h"
+#include "storage/AbstractTable.h"
+#include "storage/HashTable.h"
+
+namespace hyrise {
+namespace storage {
+
+namespace {
+
+const size_t words_per_block = 8;
+const size_t bits_per_block = words_per_block * 64;
+// Gives a false positive rate of about one percent
+const size_t bits_per_key = 10;
+const size_t bits_per_key_hash = 3;
+
+// 64 bit finalizer of MurmurHash3; the value hashes of integer columns
+// are the values themselves and need to be mixed before use
+inline uint64_t mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+inline size_t blockOf(const uint64_t mixed, const size_t blocks) {
+  // Taking the low bits allows to fold a filter to half its size
+  return (mixed >> 32) & (blocks - 1);
+}
+
+inline size_t bitOf(const uint64_t mixed, const size_t i) {
+  return (mixed >> (9 * i)) & (bits_per_block - 1);
+}
+
+}
+
+JoinFilter::JoinFilter(const c_atable_ptr_t &table, const field_list_t &fields) : _field_count(fields.size()) {
+  const size_t rows = table->size();
+  size_t blocks = 1;
+  while (blocks * bits_per_block < rows * bits_per_key)
+    blocks <<= 1;
+  _blocks.assign(blocks * words_per_block, 0);
+
+  for (size_t row = 0; row < rows; ++row)
+    insertHash(hashOf(table, fields, row));
+
+  if (fields.size() != 1)
+    return;
+
+  // A value id bitmap is only exact if all value ids refer to the same
+  // dictionary
+  std::vector<value_id_t> value_ids(rows);
+  for (size_t row = 0; row < rows; ++row) {
+    const ValueId vid = table->getValueId(fields[0], row);
+    if (vid.table != 0)
+      return;
+    value_ids[row] = vid.valueId;
+  }
+  _dictionary = table->dictionaryByTableId(fields[0], 0);
+  _value_ids.assign(_dictionary->size() / 64 + 1, 0);
+  for (const auto& value_id : value_ids)
+    _value_ids[value_id / 64] |= 1ull << (value_id % 64);
+}
+
+JoinFilter::JoinFilter(const std::vector<std::shared_ptr<const JoinFilter> > &filters) : _field_count(0) {
+  if (filters.empty()) {
+    throw std::runtime_error("JoinFilter union requires at least one filter");
+  }
+  _field_count = filters.front()->_field_count;
+  _dictionary = filters.front()->_dictionary;
+
+  size_t words = filters.front()->_blocks.size();
+  for (const auto& filter : filters) {
+    if (filter->_field_count != _field_count) {
+      throw std::runtime_error("JoinFilter union requires filters on the same number of fields");
+    }
+    words = std::min(words, filter->_blocks.size());
+    if (filter->_dictionary != _dictionary)
+      _dictionary = nullptr;
+  }
+
+  // Larger filters are folded to the size of the smallest one
+  _blocks.assign(words, 0);
+  for (const auto& filter : filters) {
+    for (size_t i = 0; i < filter->_blocks.size(); ++i)
+      _blocks[i % words] |= filter->_blocks[i];
+  }
+
+  if (_dictionary != nullptr) {
+    for (const auto& filter : filters) {
+      _value_ids.resize(std::max(_value_ids.size(), filter->_value_ids.size()), 0);
+      for (size_t i = 0; i < filter->_value_ids.size(); ++i)
+        _value_ids[i] |= filter->_value_ids[i];
+    }
+  }
+}
+
+JoinFilter::~JoinFilter() {
+}
+
+size_t JoinFilter::hashOf(const c_atable_ptr_t &table, const field_list_t &fields, const pos_t row) const {
+  if (fields.size() == 1)
+    return hash_value(table, fields[0], table->getValueId(fields[0], row));
+
+  // compare GroupKeyHash
+  size_t seed = 0;
+  for (const auto& field : fields) {
+    seed ^= hash_value(table, field, table->getValueId(field, row)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+  return seed;
+}
+
+void JoinFilter::insertHash(const size_t hash) {
+  const uint64_t mixed = mix(hash);
+  uint64_t *block = &_blocks[blockOf(mixed, blockCount()) * words_per_block];
+  for (size_t i = 0; i < bits_per_key_hash; ++i) {
+    const size_t bit = bitOf(mixed, i);
+    block[bit / 64] |= 1ull << (bit % 64);
+  }
+}
+
+bool JoinFilter::containsHash(const size_t hash) const {
+  const uint64_t mixed = mix(hash);
+  const uint64_t *block = &_blocks[blockOf(mixed, blockCount()) * words_per_block];
+  for (size_t i = 0; i < bits_per_key_hash; ++i) {
+    const size_t bit = bitOf(mixed, i);
+    if ((block[bit / 64] & (1ull << (bit % 64))) == 0)
+      return false;
+  }
+  return true;
+}
+
+bool JoinFilter::sharesDictionary(const c_atable_ptr_t &table, const field_t field) const {
+  return _dictionary != nullptr && table->dictionaryByTableId(field, 0) == _dictionary;
+}
+
+bool JoinFilter::mayContain(const c_atable_ptr_t &table, const field_list_t &fields, const pos_t row) const {
+  return mayContain(table, fields, row, fields.size() == 1 && sharesDictionary(table, fields[0]));
+}
+
+bool JoinFilter::mayContain(const c_atable_ptr_t &table, const field_list_t &fields, const pos_t row,
+                            const bool shared_dictionary) const {
+  if (fields.size() != _field_count) {
+    throw std::runtime_error("JoinFilter probed with a different number of fields than it was built on");
+  }
+  if (shared_dictionary) {
+    const ValueId vid = table->getValueId(fields[0], row);
+    if (vid.table == 0) {
+      return vid.valueId / 64 < _value_ids.size() && (_value_ids[vid.valueId / 64] & (1ull << (vid.valueId % 64))) != 0;
+    }
+  }
+  return containsHash(hashOf(table, fields, row));
+}
+
+size_t JoinFilter::getFieldCount() const {
+  return _field_count;
+}
+
+size_t JoinFilter::blockCount() const {
+  return _blocks.size() / words_per_block;
+}
+
+bool JoinFilter::hasValueIdBitmap() const {
+  return _dictionary != nullptr;
+}
+
+JoinFilterProbe::JoinFilterProbe(const join_filter_list_t &filters, const c_atable_ptr_t &table,
+                                 const field_list_t &fields) : _table(table), _fields(fields) {
+  if (fields.empty())
+    return;
+  _filters = filters;
+  for (const auto& filter : _filters)
+    _shared_dictionaries.push_back(fields.size() == 1 && filter->sharesDictionary(table, fields[0]));
+}
+
+}
+}
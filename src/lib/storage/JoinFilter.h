@@ -0,0 +1,97 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_JOINFILTER_H_
+#define SRC_LIB_STORAGE_JOINFILTER_H_
+
+#include <memory>
+#include <vector>
+
+#include "helper/types.h"
+#include "storage/AbstractResource.h"
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+
+/// Compact, lossy summary of the join keys of a hash join's build side.
+///
+/// Probe side scans use it to drop rows that cannot find a join partner
+/// before they are validated and probed. The filter never rejects a row
+/// whose key occurs on the build side, but may accept rows that have no
+/// partner. Keys are summarized in a blocked Bloom filter over the value
+/// hashes used by the join hash tables, where every key sets its bits in
+/// one cache line. If the build side is a single column whose value ids
+/// all stem from one dictionary, a bitmap over that dictionary's value ids
+/// is kept as well and answers probes on columns that share the
+/// dictionary exactly.
+class JoinFilter : public AbstractResource {
+public:
+  /// Summarizes the keys in `fields` of all rows of `table`
+  JoinFilter(const c_atable_ptr_t &table, const field_list_t &fields);
+
+  /// Union of the given filters, e.g. of parallel build instances
+  explicit JoinFilter(const std::vector<std::shared_ptr<const JoinFilter> > &filters);
+
+  virtual ~JoinFilter();
+
+  /// Returns false only if the key of `row` in `fields` of `table` does
+  /// not occur on the build side
+  bool mayContain(const c_atable_ptr_t &table, const field_list_t &fields, const pos_t row) const;
+
+  /// Whether probes on `field` of `table` can be answered by the value id
+  /// bitmap; lets callers skip the per-row dictionary check
+  bool sharesDictionary(const c_atable_ptr_t &table, const field_t field) const;
+
+  /// Same as mayContain with the result of sharesDictionary precomputed
+  bool mayContain(const c_atable_ptr_t &table, const field_list_t &fields, const pos_t row,
+                  const bool shared_dictionary) const;
+
+  size_t getFieldCount() const;
+
+  /// Number of 512 bit blocks of the Bloom filter
+  size_t blockCount() const;
+
+  bool hasValueIdBitmap() const;
+
+private:
+  size_t hashOf(const c_atable_ptr_t &table, const field_list_t &fields, const pos_t row) const;
+  void insertHash(const size_t hash);
+  bool containsHash(const size_t hash) const;
+
+  size_t _field_count;
+  std::vector<uint64_t> _blocks;
+  adict_ptr_t _dictionary;
+  std::vector<uint64_t> _value_ids;
+};
+
+typedef std::vector<std::shared_ptr<const JoinFilter> > join_filter_list_t;
+
+/// Conjunction of all join filters routed into a probe side scan, bound
+/// to the scanned table and its key fields
+class JoinFilterProbe {
+public:
+  JoinFilterProbe(const join_filter_list_t &filters, const c_atable_ptr_t &table, const field_list_t &fields);
+
+  bool empty() const {
+    return _filters.empty();
+  }
+
+  /// True if `row` may have a join partner for every filter
+  bool operator()(const pos_t row) const {
+    for (size_t i = 0; i < _filters.size(); ++i) {
+      if (!_filters[i]->mayContain(_table, _fields, row, _shared_dictionaries[i]))
+        return false;
+    }
+    return true;
+  }
+
+private:
+  join_filter_list_t _filters;
+  c_atable_ptr_t _table;
+  field_list_t _fields;
+  std::vector<bool> _shared_dictionaries;
+};
+
+}
+}
+
+#endif  // SRC_LIB_STORAGE_JOINFILTER_H_
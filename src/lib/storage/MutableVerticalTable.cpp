@@ -111,6 +111,11 @@ ValueId MutableVerticalTable::getValueId(const size_t column, const size_t row)
   return containerAt(column)->getValueId(tmp, row);
 }
 
+void MutableVerticalTable::gatherValueIds(const size_t column, const pos_list_t &rows,
+                                          std::vector<ValueId> &valueIds) const {
+  containerAt(column)->gatherValueIds(offset_in_container[column], rows, valueIds);
+}
+
 void MutableVerticalTable::setValueId(const size_t column, const size_t row, const ValueId valueId) {
   containerAt(column)->setValueId(offset_in_container[column], row, valueId);
 }
@@ -219,6 +224,10 @@ table_id_t MutableVerticalTable::subtableCount() const {
   return 1;
 }
 
+size_t MutableVerticalTable::columnBytes(const size_t column) const {
+  return containers[container_for_column[column]]->columnBytes(offset_in_container[column]);
+}
+
 atable_ptr_t MutableVerticalTable::copy() const {
   // copy containers
   std::vector< atable_ptr_t > cs;
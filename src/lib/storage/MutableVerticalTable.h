@@ -43,6 +43,7 @@ public:
   size_t size() const override;
   size_t columnCount() const override;
   ValueId getValueId(size_t column, size_t row) const override;
+  void gatherValueIds(size_t column, const pos_list_t &rows, std::vector<ValueId> &valueIds) const override;
   void setValueId(size_t column, size_t row, ValueId valueId) override;
   void reserve(size_t nr_of_values) override;
   void resize(size_t rows) override;
@@ -53,6 +54,7 @@ public:
   atable_ptr_t copy_structure(abstract_dictionary_callback, abstract_attribute_vector_callback) const override;
   table_id_t subtableCount() const override;
   atable_ptr_t copy() const override;
+  size_t columnBytes(size_t column) const override;
   const attr_vectors_t getAttributeVectors(size_t column) const override;
   void debugStructure(size_t level=0) const override;
 
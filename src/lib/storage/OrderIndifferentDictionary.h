@@ -13,6 +13,7 @@
 #include "storage/storage_types.h"
 #include "storage/BaseDictionary.h"
 #include "storage/DictionaryIterator.h"
+#include "storage/memory_usage.h"
 
 // FIXME should be aware of allocator
 template <typename T>
@@ -87,6 +88,10 @@ public:
     return _value_list.size();
   }
 
+  size_t bytes() const {
+    return hyrise::storage::vectorBytes(_value_list) + hyrise::storage::mapBytes(_index);
+  }
+
   std::shared_ptr<AbstractDictionary> copy() {
     // FIXME
     auto res = std::make_shared<OrderIndifferentDictionary<T> >();
@@ -130,11 +135,20 @@ public:
     return _index.count(v) == 1;
   }
 
+  virtual bool findValueId(const T &value, value_id_t &value_id) const {
+    const auto it = _index.find(value);
+    if (it == _index.end())
+      return false;
+    value_id = it->second;
+    return true;
+  }
+
   virtual value_id_t getValueIdForValue(const T &value) const {
-    if (_index.count(value) == 0) {
+    const auto it = _index.find(value);
+    if (it == _index.end()) {
       throw std::out_of_range("Value not found");
     }
-    return _index.at(value);
+    return it->second;
   }
 
   value_id_t getValueIdForValueSmaller(T other) {
@@ -5,24 +5,36 @@
 #include <assert.h>
 #include <algorithm>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <vector>
 
 #include "helper/checked_cast.h"
 #include "storage/BaseDictionary.h"
 #include "storage/BaseIterator.h"
 #include "storage/DictionaryIterator.h"
+#include "storage/memory_usage.h"
 #include "storage/storage_types.h"
 
 template <typename T>
 class OrderPreservingDictionaryIterator;
 
+/*
+ * Sorted dictionary. Every sample_rate-th value is also kept in a small
+ * array of samples; lookups binary search the samples, which stay in the
+ * cache, and then a single window of sample_rate values.
+ */
 template <typename T>
 class OrderPreservingDictionary : public BaseDictionary<T> {
 public:
   typedef std::vector<T> vector_type;
   typedef std::shared_ptr<vector_type> shared_vector_type;
+
+  static const size_t sample_rate = 64;
+
 private:
   shared_vector_type _values;
+  std::vector<T> _samples;
 
 protected:
 
@@ -47,6 +59,7 @@ public:
 
   void shrink() {
     _values->shrink_to_fit();
+    _samples.shrink_to_fit();
   }
 
   /**
@@ -60,6 +73,8 @@ public:
     if ((_values->size() > 0) && (value <= _values->back()))
       throw std::runtime_error("Can't insert value smaller or equal to last value");
 #endif
+    if (_values->size() % sample_rate == 0)
+      _samples.push_back(value);
     _values->push_back(value);
     return _values->size() - 1;
   }
@@ -79,24 +94,48 @@ public:
   }
       
   value_id_t getValueIdForValue(const T &value) const {
-    auto binary_search = std::lower_bound(_values->begin(), _values->end(), value);
-    size_t index = binary_search - _values->begin();
-    return index;
+    return bound(value, false);
   }
 
   value_id_t getValueIdForValueSmaller(T other) {
-    auto binary_search = std::lower_bound(_values->begin(), _values->end(), other);
-    size_t index = binary_search - _values->begin();
-    
+    size_t index = bound(other, false);
+
     assert(index > 0);
     return index - 1;
   }
 
   value_id_t getValueIdForValueGreater(T other) {
-    auto binary_search = std::upper_bound(_values->begin(), _values->end(), other);
-    size_t index = binary_search - _values->begin();
-    
-    return index;
+    return bound(other, true);
+  }
+
+  bool findValueId(const T &value, value_id_t &value_id) const {
+    const value_id_t index = bound(value, false);
+    if (index >= _values->size() || value < (*_values)[index])
+      return false;
+    value_id = index;
+    return true;
+  }
+
+  /**
+   * Looks the values up in ascending order, every search gallops from
+   * the value id found before it.
+   */
+  void getValueIdsForValues(const std::vector<T> &values, std::vector<value_id_t> &value_ids) const {
+    const auto& sorted = *_values;
+    const size_t size = sorted.size();
+    value_ids.resize(values.size());
+    size_t first = 0;
+    for (const auto& i : BaseDictionary<T>::ascendingOrder(values)) {
+      const T &value = values[i];
+      size_t lo = first, hi = first, step = 1;
+      while (hi < size && sorted[hi] < value) {
+        lo = hi + 1;
+        hi += step;
+        step *= 2;
+      }
+      first = std::lower_bound(sorted.begin() + lo, sorted.begin() + std::min(hi, size), value) - sorted.begin();
+      value_ids[i] = first < size && !(value < sorted[first]) ? first : std::numeric_limits<value_id_t>::max();
+    }
   }
 
   const T getSmallestValue() {
@@ -114,17 +153,23 @@ public:
   }
 
   bool valueExists(const T &value) const {
-    return binary_search(_values->begin(), _values->end(), value);
+    value_id_t value_id;
+    return findValueId(value, value_id);
   }
 
   void reserve(size_t size) {
     _values->reserve(size);
+    _samples.reserve(size / sample_rate + 1);
   }
   
   size_t size() {
     return _values->size();
   }
 
+  size_t bytes() const {
+    return hyrise::storage::vectorBytes(*_values) + hyrise::storage::vectorBytes(_samples);
+  }
+
   std::shared_ptr<AbstractDictionary> copy() {
     throw std::runtime_error("Dictionaries cannot be copied");
   }
@@ -147,8 +192,25 @@ public:
     return iterator(std::make_shared<OrderPreservingDictionaryIterator<T>>(_values, _values->size()));
   }
 
+private:
+  // First value id whose value is not less (or, if `after`, greater) than
+  // `value`
+  value_id_t bound(const T &value, const bool after) const {
+    const size_t sample = (after ? std::upper_bound(_samples.begin(), _samples.end(), value) :
+                           std::lower_bound(_samples.begin(), _samples.end(), value)) - _samples.begin();
+    if (sample == 0)
+      return 0;
+    // The value before the window is the sample, which is already known to
+    // be less (or not greater)
+    const auto begin = _values->begin() + (sample - 1) * sample_rate + 1;
+    const auto end = _values->begin() + std::min(_values->size(), sample * sample_rate);
+    return (after ? std::upper_bound(begin, end, value) : std::lower_bound(begin, end, value)) - _values->begin();
+  }
 };
 
+template <typename T>
+const size_t OrderPreservingDictionary<T>::sample_rate;
+
 
 /*
  * This is the Iterator class that is used by the dictionary. It has a
@@ -191,4 +253,7 @@ public:
 
 };
 
+// Strings are front coded
+#include "storage/FrontCodedDictionary.h"
+
 #endif  // SRC_LIB_STORAGE_ORDERPRESERVINGDICTIONARY_H_
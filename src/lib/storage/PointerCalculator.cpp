@@ -2,12 +2,14 @@
 #include "storage/PointerCalculator.h"
 
 #include <iostream>
+#include <numeric>
 #include <string>
 #include <unordered_set>
 
 #include "helper/checked_cast.h"
 #include "helper/PositionsIntersect.h"
 
+#include "storage/PositionSet.h"
 #include "storage/PrettyPrinter.h"
 #include "storage/Store.h"
 #include "storage/TableRangeView.h"
@@ -20,30 +22,73 @@ T* copy_vec(T* orig) {
   return new T(begin(*orig), end(*orig));
 }
 
+namespace {
+
+// Positions of a pointer calculator as a set; sparse position lists are
+// referenced, not copied
+PositionSet positionSetOf(const PointerCalculator &pc) {
+  const auto *positions = pc.getPositions();
+  if (positions == nullptr)
+    return PositionSet(0, pc.getTable()->size());
+  assert(std::is_sorted(begin(*positions), end(*positions)) && "Position lists have to be sorted");
+  return PositionSet::wrap(*positions);
+}
+
+pos_list_t *combine(PointerCalculator::pc_vector::const_iterator it, PointerCalculator::pc_vector::const_iterator it_end,
+                    bool intersect) {
+  std::vector<PositionSet> sets;
+  std::vector<const PositionSet *> inputs;
+  sets.reserve(std::distance(it, it_end));
+  for (; it != it_end; ++it) {
+    sets.push_back(positionSetOf(**it));
+    inputs.push_back(&sets.back());
+  }
+  const auto& result = intersect ? PositionSet::intersect(inputs) : PositionSet::unite(inputs);
+  auto positions = new pos_list_t;
+  result.materialize(*positions);
+  return positions;
+}
+
+}
+
 PointerCalculator::PointerCalculator(hyrise::storage::c_atable_ptr_t t, pos_list_t *pos, field_list_t *f) : table(t), pos_list(pos), fields(f) {
   // prevent nested pos_list/fields: if the input table is a
   // PointerCalculator instance, combine the old and new
-  // pos_list/fields lists
+  // pos_list/fields lists, so that every pointer calculator refers
+  // to its base table directly and row and column lookups never
+  // walk a chain
   if (auto p = std::dynamic_pointer_cast<const PointerCalculator>(t)) {
-    if (pos_list != nullptr && p->pos_list != nullptr) {
-      pos_list = new pos_list_t(pos->size());
-      for (size_t i = 0; i < pos->size(); i++) {
-        (*pos_list)[i] = p->pos_list->at(pos->at(i));
+    if (p->pos_list != nullptr) {
+      if (pos == nullptr) {
+        pos_list = new pos_list_t(*p->pos_list);
+      } else {
+        pos_list = new pos_list_t(pos->size());
+        for (size_t i = 0; i < pos->size(); i++) {
+          (*pos_list)[i] = p->pos_list->at(pos->at(i));
+        }
+        delete pos;
       }
-      table = p->table;
-      delete pos;
     }
-    if (fields != nullptr && p->fields != nullptr) {
-      fields = new field_list_t(f->size());
-      for (size_t i = 0; i < f->size(); i++) {
-        (*fields)[i] = p->fields->at(f->at(i));
+    if (p->fields != nullptr) {
+      if (f == nullptr) {
+        fields = new field_list_t(*p->fields);
+      } else {
+        fields = new field_list_t(f->size());
+        for (size_t i = 0; i < f->size(); i++) {
+          (*fields)[i] = p->fields->at(f->at(i));
+        }
+        delete f;
       }
-      table = p->table;
     }
+    table = p->table;
   }
   if (auto trv = std::dynamic_pointer_cast<const TableRangeView>(t)){
     const auto start =  trv->getStart();
-    if (pos_list != nullptr && start != 0) {
+    if (pos_list == nullptr) {
+      // the view only covers part of the underlying table
+      pos_list = new pos_list_t(trv->size());
+      std::iota(pos_list->begin(), pos_list->end(), start);
+    } else if (start != 0) {
       for (size_t i = 0; i < pos->size(); i++) {
         (*pos_list)[i] += start;
       }
@@ -58,7 +103,15 @@ PointerCalculator::PointerCalculator(const PointerCalculator& other) : table(oth
 }
 
 hyrise::storage::atable_ptr_t PointerCalculator::copy() const {
-  return create(table, fields, pos_list);
+  return std::make_shared<PointerCalculator>(*this);
+}
+
+size_t PointerCalculator::columnBytes(const size_t column) const {
+  return 0;
+}
+
+size_t PointerCalculator::bytes() const {
+  return (pos_list ? pos_list->capacity() * sizeof(pos_t) : 0) + (fields ? fields->capacity() * sizeof(field_t) : 0);
 }
 
 PointerCalculator::~PointerCalculator() {
@@ -110,7 +163,7 @@ void PointerCalculator::updateFieldMapping() {
 void PointerCalculator::setPositions(const pos_list_t pos) {
   if (pos_list != nullptr)
     delete pos_list;
-  pos_list = new std::vector<pos_t>(pos);
+  pos_list = new pos_list_t(pos);
 }
 
 void PointerCalculator::setFields(const field_list_t f) {
@@ -198,6 +251,20 @@ ValueId PointerCalculator::getValueId(const size_t column, const size_t row) con
   return table->getValueId(actual_column, actual_row);
 }
 
+void PointerCalculator::gatherValueIds(const size_t column, const pos_list_t &rows, std::vector<ValueId> &valueIds) const {
+  const size_t actual_column = fields ? fields->at(column) : column;
+  if (pos_list == nullptr) {
+    table->gatherValueIds(actual_column, rows, valueIds);
+    return;
+  }
+
+  pos_list_t actual_rows(rows.size());
+  for (size_t i = 0; i < rows.size(); ++i) {
+    actual_rows[i] = pos_list->at(rows[i]);
+  }
+  table->gatherValueIds(actual_column, actual_rows, valueIds);
+}
+
 unsigned PointerCalculator::partitionCount() const {
   return slice_count;
 }
@@ -318,17 +385,9 @@ hyrise::storage::atable_ptr_t PointerCalculator::copy_structure(const field_list
 }
 
 std::shared_ptr<PointerCalculator> PointerCalculator::intersect(const std::shared_ptr<const PointerCalculator>& other) const {
-  pos_list_t *result = new pos_list_t();
-  result->reserve(std::max(pos_list->size(), other->pos_list->size()));
-  assert(std::is_sorted(begin(*pos_list), end(*pos_list)) && std::is_sorted(begin(*other->pos_list), end(*other->pos_list)) && "Both lists have to be sorted");
-  
-  intersect_pos_list(
-    pos_list->begin(), pos_list->end(),
-    other->pos_list->begin(), other->pos_list->end(),
-    std::back_inserter(*result));
-
   assert((other->table == this->table) && "Should point to same table");
-  return create(table, result, fields);
+  pc_vector v {std::static_pointer_cast<const PointerCalculator>(shared_from_this()), other};
+  return create(table, combine(begin(v), end(v), true), copy_vec(fields));
 }
 
 
@@ -337,30 +396,21 @@ bool PointerCalculator::isSmaller( std::shared_ptr<const PointerCalculator> lx,
 }
 
 std::shared_ptr<const PointerCalculator> PointerCalculator::intersect_many(pc_vector::iterator it, pc_vector::iterator it_end) {
-  std::sort(it, it_end, PointerCalculator::isSmaller);
-  std::shared_ptr<const PointerCalculator> base = *(it++);
-  for (;it != it_end; ++it) {
-    base = base->intersect(*it);
-  }
-  return base;
+  // All inputs are intersected in one pass instead of pairwise
+  const auto& base = *it;
+  if (std::next(it) == it_end)
+    return base;
+  return create(base->table, combine(it, it_end, true), copy_vec(base->fields));
 }
 
 std::shared_ptr<PointerCalculator> PointerCalculator::unite(const std::shared_ptr<const PointerCalculator>& other) const {
   assert((other->table == this->table) && "Should point to same table");
-  if (pos_list && other->pos_list) {
-    auto result = new pos_list_t();
-    result->reserve(pos_list->size() + other->pos_list->size());
-    assert(std::is_sorted(begin(*pos_list), end(*pos_list)) && std::is_sorted(begin(*other->pos_list), end(*other->pos_list)) && "Both lists have to be sorted");
-    std::set_union(pos_list->begin(), pos_list->end(),
-                   other->pos_list->begin(), other->pos_list->end(),
-                   std::back_inserter(*result));
-    return create(table, result, copy_vec(fields));
-  } else {
-    pos_list_t* positions = nullptr;
-    if (pos_list == nullptr) { positions = other->pos_list; }
-    if (other->pos_list == nullptr) { positions = pos_list; }
-    return create(table, copy_vec(positions), copy_vec(fields));
+  if (pos_list == nullptr || other->pos_list == nullptr) {
+    // one side covers all rows
+    return create(table, nullptr, copy_vec(fields));
   }
+  pc_vector v {std::static_pointer_cast<const PointerCalculator>(shared_from_this()), other};
+  return create(table, combine(begin(v), end(v), false), copy_vec(fields));
 }
 
 std::shared_ptr<PointerCalculator> PointerCalculator::concatenate(const std::shared_ptr<const PointerCalculator>& other) const {
@@ -370,11 +420,14 @@ std::shared_ptr<PointerCalculator> PointerCalculator::concatenate(const std::sha
 }
 
 std::shared_ptr<const PointerCalculator> PointerCalculator::unite_many(pc_vector::const_iterator it, pc_vector::const_iterator it_end){
-  std::shared_ptr<const PointerCalculator> base = *(it++);
-  for (;it != it_end; ++it) {
-    base = base->unite(*it);
+  const auto& base = *it;
+  if (std::next(it) == it_end)
+    return base;
+  for (auto pc = it; pc != it_end; ++pc) {
+    if ((*pc)->pos_list == nullptr)
+      return create(base->table, nullptr, copy_vec(base->fields));
   }
-  return base;
+  return create(base->table, combine(it, it_end, false), copy_vec(base->fields));
 }
 
 std::shared_ptr<PointerCalculator> PointerCalculator::concatenate_many(pc_vector::const_iterator it, pc_vector::const_iterator it_end) {
@@ -54,6 +54,10 @@ public:
   
   // AbstractTable interface
   hyrise::storage::atable_ptr_t copy() const override;
+  /// Columns belong to the referenced table
+  size_t columnBytes(size_t column) const override;
+  /// Bytes of the positions and fields
+  size_t bytes() const override;
   hyrise::storage::atable_ptr_t copy_structure(const field_list_t *fields = nullptr, const bool reuse_dict = false, const size_t initial_size = 0, const bool with_containers = true, const bool compressed = false) const override;
   const ColumnMetadata *metadataAt(const size_t column_index, const size_t row_index = 0, const table_id_t table_id = 0) const override;
   const AbstractTable::SharedDictionaryPtr& dictionaryAt(const size_t column, const size_t row = 0, const table_id_t table_id = 0) const override;
@@ -62,6 +66,7 @@ public:
   size_t size() const override;
   size_t columnCount() const override;
   ValueId getValueId(const size_t column, const size_t row) const override;
+  void gatherValueIds(const size_t column, const pos_list_t &rows, std::vector<ValueId> &valueIds) const override;
   unsigned partitionCount() const override;
   size_t partitionWidth(const size_t slice) const override;
   void print(const size_t limit = (size_t) -1) const override;
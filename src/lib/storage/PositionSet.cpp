@@ -0,0 +1,450 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/PositionSet.h"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+namespace hyrise {
+namespace storage {
+
+namespace {
+
+const size_t word_bits = 64;
+
+inline pos_t alignDown(const pos_t position) {
+  return position & ~(word_bits - 1);
+}
+
+inline size_t wordsFor(const pos_t base, const pos_t last) {
+  return (last - base + word_bits - 1) / word_bits;
+}
+
+// Sets the bits for [first, last) in `words` starting at `base`
+void setRange(std::vector<uint64_t> &words, const pos_t base, const pos_t first, const pos_t last) {
+  for (pos_t position = first; position < last;) {
+    const size_t word = (position - base) / word_bits;
+    const size_t bit = (position - base) % word_bits;
+    const size_t bits = std::min<size_t>(word_bits - bit, last - position);
+    words[word] |= (bits == word_bits ? ~0ull : ((1ull << bits) - 1)) << bit;
+    position += bits;
+  }
+}
+
+// Index of the first element >= target in sorted values[index, size),
+// searching exponentially from index
+template <typename T>
+size_t gallop(const T *values, size_t index, const size_t size, const T target) {
+  size_t step = 1;
+  size_t low = index;
+  while (index < size && values[index] < target) {
+    low = index + 1;
+    index += step;
+    step *= 2;
+  }
+  return std::lower_bound(values + low, values + std::min(index + 1, size), target) - values;
+}
+
+}
+
+/// Iterates over the positions of a set in ascending order
+class PositionSet::Cursor {
+public:
+  explicit Cursor(const PositionSet &set) : _set(&set), _index(0), _current(set._first), _valid(!set.empty()) {
+  }
+
+  bool valid() const {
+    return _valid;
+  }
+
+  pos_t value() const {
+    return _current;
+  }
+
+  void next() {
+    switch (_set->_representation) {
+      case Array32:
+      case Array64:
+        moveTo(_index + 1);
+        break;
+      default:
+        seek(_current + 1);
+    }
+  }
+
+  /// Moves to the first position >= target
+  void seek(const pos_t target) {
+    if (!_valid || target <= _current)
+      return;
+
+    switch (_set->_representation) {
+      case Range:
+        _current = target;
+        _valid = _current < _set->_last;
+        break;
+      case Bitmap:
+        seekBit(target);
+        break;
+      case Array32:
+        if (target >= _set->_last) {
+          _valid = false;
+        } else {
+          moveTo(gallop(_set->_offsets.data(), _index, _set->_size, static_cast<uint32_t>(target - _set->_first)));
+        }
+        break;
+      case Array64:
+        moveTo(gallop(_set->_positions, _index, _set->_size, target));
+        break;
+    }
+  }
+
+private:
+  void moveTo(const size_t index) {
+    _index = index;
+    _valid = index < _set->_size;
+    if (_valid)
+      _current = _set->_representation == Array32 ? _set->_first + _set->_offsets[index] : _set->_positions[index];
+  }
+
+  void seekBit(const pos_t target) {
+    if (target >= _set->_last) {
+      _valid = false;
+      return;
+    }
+    const auto& words = _set->_words;
+    size_t word = (target - _set->_base) / word_bits;
+    uint64_t bits = words[word] & (~0ull << ((target - _set->_base) % word_bits));
+    while (bits == 0) {
+      if (++word == words.size()) {
+        _valid = false;
+        return;
+      }
+      bits = words[word];
+    }
+    _current = _set->_base + word * word_bits + __builtin_ctzll(bits);
+  }
+
+  const PositionSet *_set;
+  size_t _index;
+  pos_t _current;
+  bool _valid;
+};
+
+PositionSet::PositionSet() : _representation(Range), _size(0), _first(0), _last(0), _base(0), _positions(nullptr) {
+}
+
+PositionSet::PositionSet(const pos_t first, const pos_t last) : _representation(Range), _size(0), _first(first),
+                                                              _last(last), _base(0), _positions(nullptr) {
+  if (last > first) {
+    _size = last - first;
+  } else {
+    _first = _last = 0;
+  }
+}
+
+PositionSet::PositionSet(const pos_list_t &positions) : PositionSet(fromSorted(positions, true)) {
+}
+
+PositionSet PositionSet::wrap(const pos_list_t &positions) {
+  return fromSorted(positions, false);
+}
+
+PositionSet PositionSet::fromSorted(const pos_list_t &positions, const bool copy) {
+  if (positions.empty())
+    return PositionSet();
+
+  const pos_t first = positions.front();
+  const pos_t last = positions.back() + 1;
+  const size_t size = positions.size();
+  if (last - first == size)
+    return PositionSet(first, last);
+
+  PositionSet result;
+  result._size = size;
+  result._first = first;
+  result._last = last;
+
+  const bool narrow = last - first <= std::numeric_limits<uint32_t>::max();
+  const size_t bitmap_bytes = wordsFor(alignDown(first), last) * sizeof(uint64_t);
+  const size_t array_bytes = size * (narrow ? sizeof(uint32_t) : sizeof(pos_t));
+  if (bitmap_bytes < array_bytes) {
+    result._representation = Bitmap;
+    result._base = alignDown(first);
+    result._words.assign(wordsFor(result._base, last), 0);
+    for (const auto& position : positions) {
+      const pos_t bit = position - result._base;
+      result._words[bit / word_bits] |= 1ull << (bit % word_bits);
+    }
+  } else if (narrow && copy) {
+    result._representation = Array32;
+    result._offsets.resize(size);
+    for (size_t i = 0; i < size; ++i)
+      result._offsets[i] = positions[i] - first;
+  } else {
+    result._representation = Array64;
+    if (copy) {
+      result._owned = positions;
+      result._positions = result._owned.data();
+    } else {
+      result._positions = positions.data();
+    }
+  }
+  return result;
+}
+
+PositionSet PositionSet::fromBitmap(const pos_t base, std::vector<uint64_t> &&words) {
+  size_t size = 0;
+  for (const auto& word : words)
+    size += __builtin_popcountll(word);
+  if (size == 0)
+    return PositionSet();
+
+  size_t first_word = 0;
+  while (words[first_word] == 0)
+    ++first_word;
+  size_t last_word = words.size() - 1;
+  while (words[last_word] == 0)
+    --last_word;
+  const pos_t first = base + first_word * word_bits + __builtin_ctzll(words[first_word]);
+  const pos_t last = base + last_word * word_bits + word_bits - __builtin_clzll(words[last_word]);
+  if (last - first == size)
+    return PositionSet(first, last);
+
+  const size_t bitmap_bytes = (last_word - first_word + 1) * sizeof(uint64_t);
+  if (bitmap_bytes > size * sizeof(uint32_t) && last - first <= std::numeric_limits<uint32_t>::max()) {
+    PositionSet result;
+    result._representation = Array32;
+    result._size = size;
+    result._first = first;
+    result._last = last;
+    result._offsets.reserve(size);
+    for (size_t word = first_word; word <= last_word; ++word) {
+      for (uint64_t bits = words[word]; bits != 0; bits &= bits - 1)
+        result._offsets.push_back(base + word * word_bits + __builtin_ctzll(bits) - first);
+    }
+    return result;
+  }
+
+  PositionSet result;
+  result._representation = Bitmap;
+  result._size = size;
+  result._first = first;
+  result._last = last;
+  result._base = base + first_word * word_bits;
+  words.erase(words.begin() + last_word + 1, words.end());
+  words.erase(words.begin(), words.begin() + first_word);
+  result._words = std::move(words);
+  return result;
+}
+
+bool PositionSet::contains(const pos_t position) const {
+  if (position < _first || position >= _last)
+    return false;
+
+  switch (_representation) {
+    case Range:
+      return true;
+    case Bitmap: {
+      const pos_t bit = position - _base;
+      return (_words[bit / word_bits] >> (bit % word_bits)) & 1;
+    }
+    case Array32:
+      return std::binary_search(_offsets.begin(), _offsets.end(), static_cast<uint32_t>(position - _first));
+    case Array64:
+      return std::binary_search(_positions, _positions + _size, position);
+  }
+  return false;
+}
+
+size_t PositionSet::memoryUsage() const {
+  switch (_representation) {
+    case Bitmap:
+      return _words.size() * sizeof(uint64_t);
+    case Array32:
+      return _offsets.size() * sizeof(uint32_t);
+    case Array64:
+      return _size * sizeof(pos_t);
+    default:
+      return 0;
+  }
+}
+
+void PositionSet::materialize(pos_list_t &positions) const {
+  positions.reserve(positions.size() + _size);
+  switch (_representation) {
+    case Range:
+      for (pos_t position = _first; position < _last; ++position)
+        positions.push_back(position);
+      break;
+    case Bitmap:
+      for (size_t word = 0; word < _words.size(); ++word) {
+        for (uint64_t bits = _words[word]; bits != 0; bits &= bits - 1)
+          positions.push_back(_base + word * word_bits + __builtin_ctzll(bits));
+      }
+      break;
+    case Array32:
+      for (const auto& offset : _offsets)
+        positions.push_back(_first + offset);
+      break;
+    case Array64:
+      positions.insert(positions.end(), _positions, _positions + _size);
+      break;
+  }
+}
+
+pos_list_t PositionSet::toPositions() const {
+  pos_list_t positions;
+  materialize(positions);
+  return positions;
+}
+
+void PositionSet::setBits(std::vector<uint64_t> &words, const pos_t base) const {
+  switch (_representation) {
+    case Range:
+      setRange(words, base, _first, _last);
+      break;
+    case Bitmap: {
+      const size_t offset = (_base - base) / word_bits;
+      for (size_t word = 0; word < _words.size(); ++word)
+        words[offset + word] |= _words[word];
+      break;
+    }
+    case Array32:
+      for (const auto& offset : _offsets) {
+        const pos_t bit = _first + offset - base;
+        words[bit / word_bits] |= 1ull << (bit % word_bits);
+      }
+      break;
+    case Array64:
+      for (size_t i = 0; i < _size; ++i) {
+        const pos_t bit = _positions[i] - base;
+        words[bit / word_bits] |= 1ull << (bit % word_bits);
+      }
+      break;
+  }
+}
+
+PositionSet PositionSet::intersect(const std::vector<const PositionSet *> &sets) {
+  if (sets.empty())
+    return PositionSet();
+
+  pos_t first = 0;
+  pos_t last = std::numeric_limits<pos_t>::max();
+  bool dense = true;
+  for (const auto& set : sets) {
+    if (set->empty())
+      return PositionSet();
+    first = std::max(first, set->_first);
+    last = std::min(last, set->_last);
+    dense &= set->_representation == Range || set->_representation == Bitmap;
+  }
+  if (first >= last)
+    return PositionSet();
+
+  if (dense) {
+    // Ranges only limit [first, last), bitmaps are combined word by word
+    const pos_t base = alignDown(first);
+    std::vector<uint64_t> words(wordsFor(base, last), 0);
+    setRange(words, base, first, last);
+    for (const auto& set : sets) {
+      if (set->_representation != Bitmap)
+        continue;
+      const size_t offset = (base - set->_base) / word_bits;
+      const uint64_t *other = set->_words.data() + offset;
+      const size_t count = std::min(words.size(), set->_words.size() - offset);
+      for (size_t word = 0; word < count; ++word)
+        words[word] &= other[word];
+      std::fill(words.begin() + count, words.end(), 0);
+    }
+    return fromBitmap(base, std::move(words));
+  }
+
+  // Leapfrog over all sets, the smallest one proposes the candidates
+  auto sorted = sets;
+  std::sort(sorted.begin(), sorted.end(), [](const PositionSet *l, const PositionSet *r) {
+    return l->size() < r->size();
+  });
+  std::vector<Cursor> cursors;
+  for (const auto& set : sorted)
+    cursors.emplace_back(*set);
+
+  pos_list_t result;
+  cursors[0].seek(first);
+  pos_t candidate = cursors[0].value();
+  size_t agreeing = 1;
+  for (size_t i = 1 % cursors.size(); cursors[i].valid() && candidate < last; i = (i + 1) % cursors.size()) {
+    auto& cursor = cursors[i];
+    if (agreeing < cursors.size()) {
+      cursor.seek(candidate);
+      if (!cursor.valid())
+        break;
+      if (cursor.value() == candidate) {
+        ++agreeing;
+        continue;
+      }
+      candidate = cursor.value();
+      agreeing = 1;
+    } else {
+      result.push_back(candidate);
+      cursor.next();
+      if (!cursor.valid())
+        break;
+      candidate = cursor.value();
+      agreeing = 1;
+    }
+  }
+  return fromSorted(result, true);
+}
+
+PositionSet PositionSet::unite(const std::vector<const PositionSet *> &sets) {
+  pos_t first = std::numeric_limits<pos_t>::max();
+  pos_t last = 0;
+  size_t total = 0;
+  bool dense = false;
+  for (const auto& set : sets) {
+    if (set->empty())
+      continue;
+    first = std::min(first, set->_first);
+    last = std::max(last, set->_last);
+    total += set->size();
+    dense |= set->_representation == Range || set->_representation == Bitmap;
+  }
+  if (total == 0)
+    return PositionSet();
+
+  if (dense || (last - first) / word_bits <= total) {
+    const pos_t base = alignDown(first);
+    std::vector<uint64_t> words(wordsFor(base, last), 0);
+    for (const auto& set : sets)
+      set->setBits(words, base);
+    return fromBitmap(base, std::move(words));
+  }
+
+  // Sparse inputs are merged
+  typedef std::pair<pos_t, size_t> entry_t;
+  std::priority_queue<entry_t, std::vector<entry_t>, std::greater<entry_t> > heap;
+  std::vector<Cursor> cursors;
+  for (const auto& set : sets)
+    cursors.emplace_back(*set);
+  for (size_t i = 0; i < cursors.size(); ++i) {
+    if (cursors[i].valid())
+      heap.push(entry_t(cursors[i].value(), i));
+  }
+
+  pos_list_t result;
+  result.reserve(total);
+  while (!heap.empty()) {
+    const entry_t top = heap.top();
+    heap.pop();
+    if (result.empty() || result.back() != top.first)
+      result.push_back(top.first);
+    auto& cursor = cursors[top.second];
+    cursor.next();
+    if (cursor.valid())
+      heap.push(entry_t(cursor.value(), top.second));
+  }
+  return fromSorted(result, true);
+}
+
+}
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_POSITIONSET_H_
+#define SRC_LIB_STORAGE_POSITIONSET_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "storage/storage_types.h"
+
+namespace hyrise {
+namespace storage {
+
+/// Sorted set of row positions used for set operations on position
+/// lists.
+///
+/// The positions are kept in the most compact of four representations,
+/// chosen by their density: a range of consecutive positions, a bitmap
+/// over the positions between the smallest and the largest one, a sorted
+/// array of 32 bit offsets to the smallest position, or a sorted array of
+/// 64 bit positions. Intersections and unions are computed on any number
+/// of sets in one pass: bitmaps are combined word by word, all other
+/// representations are merged or probed with cursors that skip ahead in
+/// the sparser inputs.
+class PositionSet {
+public:
+  enum Representation {
+    Range,
+    Bitmap,
+    Array32,
+    Array64
+  };
+
+  /// Empty set
+  PositionSet();
+
+  /// All positions in [first, last)
+  PositionSet(const pos_t first, const pos_t last);
+
+  /// Copies the sorted and unique `positions` into the most compact
+  /// representation
+  explicit PositionSet(const pos_list_t &positions);
+
+  /// Refers to the sorted and unique `positions` instead of copying them
+  /// if they are sparse, in which case they have to outlive the set
+  static PositionSet wrap(const pos_list_t &positions);
+
+  PositionSet(PositionSet &&other) = default;
+  PositionSet &operator=(PositionSet &&other) = default;
+
+  Representation representation() const {
+    return _representation;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+  bool empty() const {
+    return _size == 0;
+  }
+
+  bool contains(const pos_t position) const;
+
+  /// Number of bytes used to store the positions
+  size_t memoryUsage() const;
+
+  /// Appends all positions in ascending order
+  void materialize(pos_list_t &positions) const;
+
+  pos_list_t toPositions() const;
+
+  static PositionSet intersect(const std::vector<const PositionSet *> &sets);
+  static PositionSet unite(const std::vector<const PositionSet *> &sets);
+
+private:
+  class Cursor;
+
+  PositionSet(const PositionSet &) = delete;
+  PositionSet &operator=(const PositionSet &) = delete;
+
+  /// Chooses the representation for the bits set in `words`, where the
+  /// first bit stands for position `base`
+  static PositionSet fromBitmap(const pos_t base, std::vector<uint64_t> &&words);
+  /// Chooses the representation for sorted and unique `positions`
+  static PositionSet fromSorted(const pos_list_t &positions, const bool copy);
+
+  void setBits(std::vector<uint64_t> &words, const pos_t base) const;
+
+  Representation _representation;
+  size_t _size;
+  // Smallest position, and the largest one plus one
+  pos_t _first;
+  pos_t _last;
+
+  // Bitmap; bit i stands for _base + i, _base is a multiple of 64
+  pos_t _base;
+  std::vector<uint64_t> _words;
+  // Array32; offsets to _first
+  std::vector<uint32_t> _offsets;
+  // Array64; either refers to _owned or to wrapped positions
+  pos_list_t _owned;
+  const pos_t *_positions;
+};
+
+}
+}
+
+#endif  // SRC_LIB_STORAGE_POSITIONSET_H_
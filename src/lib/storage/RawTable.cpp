@@ -110,6 +110,14 @@ size_t RawTable::size() const { return _size; };
 
 size_t RawTable::columnCount() const { return _width; }
 
+size_t RawTable::columnBytes(const size_t column) const {
+  return bytes() / _width;
+}
+
+size_t RawTable::bytes() const {
+  return (_endOfStorage - _data) + _offsets.capacity() * sizeof(size_t);
+}
+
 void RawTable::reserve(const size_t nr_of_values) {}
 
 void RawTable::resize(const size_t nr_of_values) {}
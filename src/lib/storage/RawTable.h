@@ -104,6 +104,11 @@ public:
 
   size_t columnCount() const;
 
+  // Rows have variable width, their storage is split evenly over the columns
+  size_t columnBytes(size_t column) const;
+
+  size_t bytes() const;
+
   void reserve(const size_t nr_of_values);
 
   void resize(const size_t nr_of_values);
@@ -0,0 +1,113 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_RUNLENGTHVECTOR_H_
+#define SRC_LIB_STORAGE_RUNLENGTHVECTOR_H_
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "storage/EncodedAttributeVector.h"
+
+/*
+  Run length encoded column for sorted or clustered value ids.
+
+  Run i covers the rows [end(i - 1), end(i)) and has the value value(i);
+  get() finds the run of a row with a binary search, scans evaluate a
+  predicate once per run.
+*/
+template <typename T>
+class RunLengthVector : public EncodedAttributeVector<T> {
+public:
+  typedef T value_type;
+
+  explicit RunLengthVector(const std::vector<T> &values) : EncodedAttributeVector<T>(values.size()) {
+    for (size_t row = 0; row < values.size(); ++row) {
+      if (row == 0 || values[row] != values[row - 1]) {
+        _values.push_back(values[row]);
+        _ends.push_back(row);
+      }
+      _ends.back() = row + 1;
+    }
+  }
+
+  T get(size_t column, size_t row) const {
+    this->checkAccess(column, row);
+    return _values[run(row)];
+  }
+
+  void set(size_t column, size_t row, T value) {
+    this->checkAccess(column, row);
+    const size_t r = run(row);
+    if (_values[r] == value)
+      return;
+
+    // Split the run around the row, then join runs with the same value
+    const size_t first = begin(r);
+    const size_t last = _ends[r];
+    std::vector<T> values;
+    std::vector<size_t> ends;
+    if (first < row) {
+      values.push_back(_values[r]);
+      ends.push_back(row);
+    }
+    values.push_back(value);
+    ends.push_back(row + 1);
+    if (row + 1 < last) {
+      values.push_back(_values[r]);
+      ends.push_back(last);
+    }
+    _values.erase(_values.begin() + r);
+    _ends.erase(_ends.begin() + r);
+    _values.insert(_values.begin() + r, values.begin(), values.end());
+    _ends.insert(_ends.begin() + r, ends.begin(), ends.end());
+
+    for (size_t i = std::min(r + values.size(), _values.size() - 1); i > 0 && i + 1 > r; --i) {
+      if (_values[i] == _values[i - 1]) {
+        _ends[i - 1] = _ends[i];
+        _values.erase(_values.begin() + i);
+        _ends.erase(_ends.begin() + i);
+      }
+    }
+  }
+
+  // Run that contains `row`
+  size_t run(size_t row) const {
+    return std::upper_bound(_ends.begin(), _ends.end(), row) - _ends.begin();
+  }
+
+  size_t runs() const {
+    return _values.size();
+  }
+
+  T value(size_t run) const {
+    return _values[run];
+  }
+
+  // First row of `run`
+  size_t begin(size_t run) const {
+    return run == 0 ? 0 : _ends[run - 1];
+  }
+
+  // First row after `run`
+  size_t end(size_t run) const {
+    return _ends[run];
+  }
+
+  std::string encoding() const {
+    return "RunLength";
+  }
+
+  size_t bytes() const {
+    return _values.size() * sizeof(T) + _ends.size() * sizeof(size_t);
+  }
+
+  std::shared_ptr<BaseAttributeVector<T>> copy() {
+    return std::make_shared<RunLengthVector>(*this);
+  }
+
+private:
+  std::vector<T> _values;
+  std::vector<size_t> _ends;
+};
+
+#endif  // SRC_LIB_STORAGE_RUNLENGTHVECTOR_H_
@@ -0,0 +1,229 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/SecondaryIndex.h"
+
+#include <algorithm>
+
+#include "storage/GroupKeyIndex.h"
+#include "storage/memory_usage.h"
+#include "storage/meta_storage.h"
+#include "storage/Store.h"
+
+namespace hyrise {
+namespace storage {
+
+namespace {
+
+struct equal_functor {
+  typedef SecondaryIndex::KeyRange value_type;
+
+  const SecondaryIndex &index;
+  const size_t key;
+  const c_atable_ptr_t &table;
+  const pos_t row;
+
+  equal_functor(const SecondaryIndex &i, const size_t k, const c_atable_ptr_t &t, const pos_t r) :
+      index(i), key(k), table(t), row(r) {}
+
+  template <typename T>
+  value_type operator()() {
+    return index.equal(key, table->getValue<T>(index.fields()[key], row));
+  }
+};
+
+}
+
+SecondaryIndex::SecondaryIndex(const std::shared_ptr<const Store> &store, const field_list_t &fields) :
+    _store(store), _fields(fields) {
+  if (_fields.empty())
+    throw std::runtime_error("A secondary index needs at least one key column");
+  for (const auto& field : _fields) {
+    if (field >= store->columnCount())
+      throw std::runtime_error("Key column " + std::to_string(field) + " does not exist");
+  }
+  rebuild();
+}
+
+SecondaryIndex::~SecondaryIndex() {
+}
+
+void SecondaryIndex::shrink() {
+  _positions.shrink_to_fit();
+  _keys.shrink_to_fit();
+  std::lock_guard<std::mutex> lock(_delta_mutex);
+  for (auto& entry : _delta)
+    entry.second.shrink_to_fit();
+}
+
+size_t SecondaryIndex::bytes() const {
+  std::lock_guard<std::mutex> lock(_delta_mutex);
+  return vectorBytes(_offsets) + vectorBytes(_positions) + vectorBytes(_keys) + mapBytes(_delta);
+}
+
+std::shared_ptr<const Store> SecondaryIndex::store() const {
+  auto store = _store.lock();
+  if (!store)
+    throw std::runtime_error("The indexed store no longer exists");
+  return store;
+}
+
+std::shared_ptr<AbstractDictionary> SecondaryIndex::dictionary(const size_t key, const table_id_t table_id) const {
+  if (key >= _fields.size())
+    throw std::runtime_error("The index has no key column " + std::to_string(key));
+  return store()->dictionaryByTableId(_fields[key], table_id);
+}
+
+void SecondaryIndex::rebuild() {
+  const auto s = store();
+  const auto main = s->getMainTable();
+  const size_t rows = main->size();
+  const size_t width = _fields.size() - 1;
+
+  // Rows of every value id of the first key column in ascending order
+  const auto groups = s->groupKeyIndex(_fields[0]);
+  _offsets = groups->offsets();
+  _positions = groups->positions();
+
+  _keys.clear();
+  if (width > 0) {
+    std::vector<value_id_t> keys(rows * width);
+    for (size_t row = 0; row < rows; ++row) {
+      for (size_t key = 0; key < width; ++key)
+        keys[row * width + key] = main->getValueId(_fields[key + 1], row).valueId;
+    }
+
+    // Order the entries of every value id of the first key column by the
+    // remaining key columns, rows with equal keys stay ascending
+    auto less = [&keys, width](const pos_t left, const pos_t right) {
+      return std::lexicographical_compare(keys.begin() + left * width, keys.begin() + (left + 1) * width,
+                                          keys.begin() + right * width, keys.begin() + (right + 1) * width);
+    };
+    for (size_t id = 0; id + 1 < _offsets.size(); ++id)
+      std::stable_sort(_positions.begin() + _offsets[id], _positions.begin() + _offsets[id + 1], less);
+
+    _keys.resize(rows * width);
+    for (size_t entry = 0; entry < rows; ++entry)
+      std::copy(keys.begin() + _positions[entry] * width, keys.begin() + (_positions[entry] + 1) * width,
+                _keys.begin() + entry * width);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_delta_mutex);
+    _delta.clear();
+  }
+  addDeltaRows(0, s->getDeltaTable()->size());
+}
+
+void SecondaryIndex::addDeltaRows(const size_t begin, const size_t end) {
+  const auto delta = store()->getDeltaTable();
+  std::vector<value_id_t> ids;
+  ids.reserve(end > begin ? end - begin : 0);
+  for (size_t row = begin; row < end; ++row)
+    ids.push_back(delta->getValueId(_fields[0], row).valueId);
+
+  std::lock_guard<std::mutex> lock(_delta_mutex);
+  for (size_t row = begin; row < end; ++row)
+    _delta[ids[row - begin]].push_back(row);
+}
+
+std::vector<SecondaryIndex::KeyRange> SecondaryIndex::keyOf(const c_atable_ptr_t &table, const pos_t row) const {
+  std::vector<KeyRange> ranges;
+  type_switch<hyrise_basic_types> ts;
+  for (size_t key = 0; key < _fields.size(); ++key) {
+    equal_functor fun(*this, key, table, row);
+    ranges.push_back(ts(table->typeOfColumn(_fields[key]), fun));
+  }
+  return ranges;
+}
+
+pos_list_t SecondaryIndex::lookup(const std::vector<KeyRange> &ranges) const {
+  if (ranges.empty() || ranges.size() > _fields.size())
+    throw std::runtime_error("A lookup restricts between one and all key columns of the index");
+
+  pos_list_t rows;
+  const auto& first = ranges.front();
+  const value_id_t hi = std::min<value_id_t>(first.main_hi, _offsets.size() - 1);
+  for (value_id_t id = first.main_lo; id < hi; ++id)
+    collectMain(ranges, 1, _offsets[id], _offsets[id + 1], rows);
+
+  // Only the entries of equal keys are ordered by row
+  const bool points = std::all_of(ranges.begin(), ranges.end(), [](const KeyRange &range) {
+    return range.main_hi - range.main_lo <= 1;
+  });
+  if (!points || ranges.size() < _fields.size())
+    std::sort(rows.begin(), rows.end());
+
+  collectDelta(ranges, rows);
+  return rows;
+}
+
+void SecondaryIndex::collectMain(const std::vector<KeyRange> &ranges, const size_t key,
+                                 const size_t begin, const size_t end, pos_list_t &rows) const {
+  if (key == ranges.size()) {
+    rows.insert(rows.end(), _positions.begin() + begin, _positions.begin() + end);
+    return;
+  }
+
+  const size_t width = _fields.size() - 1;
+  const auto& range = ranges[key];
+  auto id = [this, width, key](const size_t entry) { return _keys[entry * width + key - 1]; };
+
+  // The entries are ordered by this key column only within groups of
+  // equal previous key columns. After equality restrictions there is a
+  // single group, otherwise walk the groups.
+  const bool single = std::all_of(ranges.begin() + 1, ranges.begin() + key, [](const KeyRange &range) {
+    return range.main_hi - range.main_lo <= 1;
+  });
+  size_t group = begin;
+  while (group < end) {
+    size_t group_end = single ? end : group + 1;
+    while (group_end < end && std::equal(_keys.begin() + group * width, _keys.begin() + group * width + key - 1,
+                                         _keys.begin() + group_end * width))
+      ++group_end;
+
+    // First entry of the group whose value id is not less than `value`
+    auto bound = [&](const value_id_t value) {
+      size_t first = group, last = group_end;
+      while (first < last) {
+        const size_t mid = first + (last - first) / 2;
+        if (id(mid) < value)
+          first = mid + 1;
+        else
+          last = mid;
+      }
+      return first;
+    };
+    if (range.main_lo < range.main_hi)
+      collectMain(ranges, key + 1, bound(range.main_lo), bound(range.main_hi), rows);
+    group = group_end;
+  }
+}
+
+void SecondaryIndex::collectDelta(const std::vector<KeyRange> &ranges, pos_list_t &rows) const {
+  const auto s = store();
+  const auto delta = s->getDeltaTable();
+  const pos_t offset = s->deltaOffset();
+
+  pos_list_t candidates;
+  {
+    std::lock_guard<std::mutex> lock(_delta_mutex);
+    for (const auto& id : ranges.front().delta) {
+      const auto it = _delta.find(id);
+      if (it != _delta.end())
+        candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  for (const auto& row : candidates) {
+    bool matches = true;
+    for (size_t key = 1; key < ranges.size() && matches; ++key) {
+      const auto& ids = ranges[key].delta;
+      matches = std::binary_search(ids.begin(), ids.end(), delta->getValueId(_fields[key], row).valueId);
+    }
+    if (matches)
+      rows.push_back(offset + row);
+  }
+}
+
+}
+}
@@ -0,0 +1,136 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_SECONDARYINDEX_H_
+#define SRC_LIB_STORAGE_SECONDARYINDEX_H_
+
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "helper/types.h"
+
+#include "storage/AbstractIndex.h"
+#include "storage/BaseDictionary.h"
+
+namespace hyrise {
+namespace storage {
+
+class Store;
+
+/// Index on one or more columns of a Store that is maintained with the
+/// store.
+///
+/// The main index is built on the value ids of the main. Since main
+/// dictionaries are ordered, it lists the rows of the main ordered by
+/// their key: `_offsets` holds the first entry of every value id of the
+/// first key column, `_positions` the rows and `_keys` the value ids of
+/// the remaining key columns of every entry. merge() rebuilds it.
+///
+/// The delta index maps the delta value id of the first key column to
+/// the delta rows with that value. Writers add their rows with
+/// Store::indexDelta once all values of the rows are written.
+///
+/// Lookups return the rows that match regardless of their visibility,
+/// Store::validatePositions removes the rows a transaction must not see.
+class SecondaryIndex : public AbstractIndex {
+ public:
+  /// Values one key column is restricted to: the main value ids in
+  /// [main_lo, main_hi) and the delta value ids in `delta` (ascending)
+  struct KeyRange {
+    value_id_t main_lo = 0;
+    value_id_t main_hi = 0;
+    std::vector<value_id_t> delta;
+  };
+
+  /// Indexes `fields` of all rows of `store`
+  SecondaryIndex(const std::shared_ptr<const Store> &store, const field_list_t &fields);
+  virtual ~SecondaryIndex();
+
+  void shrink();
+
+  size_t bytes() const;
+
+  const field_list_t &fields() const {
+    return _fields;
+  }
+
+  /// Builds the main index from the current main of the store and
+  /// indexes all rows of the current delta
+  void rebuild();
+
+  /// Adds the delta rows [begin, end) to the delta index
+  void addDeltaRows(size_t begin, size_t end);
+
+  /// Restricts key column `key` (an index into fields()) to the values
+  /// in [lo, hi]
+  template <typename T>
+  KeyRange range(size_t key, const T &lo, const T &hi) const;
+
+  template <typename T>
+  KeyRange equal(size_t key, const T &value) const {
+    return range(key, value, value);
+  }
+
+  /// Restricts all key columns to the key of `row` of `table`, a table
+  /// with the columns of the store, e.g. rows about to be inserted
+  std::vector<KeyRange> keyOf(const c_atable_ptr_t &table, pos_t row) const;
+
+  /// Ascending rows of the store whose first ranges.size() key columns
+  /// lie in `ranges`
+  pos_list_t lookup(const std::vector<KeyRange> &ranges) const;
+
+ private:
+  std::shared_ptr<const Store> store() const;
+  std::shared_ptr<AbstractDictionary> dictionary(size_t key, table_id_t table_id) const;
+
+  // Appends the rows of the main entries [begin, end) that match the
+  // ranges from `key` on; the entries match the ranges before `key`
+  void collectMain(const std::vector<KeyRange> &ranges, size_t key, size_t begin, size_t end, pos_list_t &rows) const;
+  void collectDelta(const std::vector<KeyRange> &ranges, pos_list_t &rows) const;
+
+  std::weak_ptr<const Store> _store;
+  const field_list_t _fields;
+
+  std::vector<size_t> _offsets;
+  std::vector<pos_t> _positions;
+  std::vector<value_id_t> _keys;
+
+  mutable std::mutex _delta_mutex;
+  std::unordered_map<value_id_t, std::vector<pos_t> > _delta;
+};
+
+template <typename T>
+SecondaryIndex::KeyRange SecondaryIndex::range(const size_t key, const T &lo, const T &hi) const {
+  auto main = std::dynamic_pointer_cast<BaseDictionary<T> >(dictionary(key, 0));
+  auto delta = std::dynamic_pointer_cast<BaseDictionary<T> >(dictionary(key, 1));
+  if (!main || !delta)
+    throw std::runtime_error("Key type does not match the type of the indexed column");
+
+  KeyRange result;
+  if (hi < lo)
+    return result;
+
+  // The main dictionary is ordered
+  result.main_lo = main->getValueIdForValue(lo);
+  result.main_hi = main->getValueIdForValueGreater(hi);
+
+  if (!(lo < hi)) {
+    value_id_t id;
+    if (delta->findValueId(lo, id))
+      result.delta.push_back(id);
+  } else {
+    const value_id_t delta_size = delta->size();
+    for (value_id_t id = 0; id < delta_size; ++id) {
+      const T value = delta->getValueForValueId(id);
+      if (!(value < lo) && !(hi < value))
+        result.delta.push_back(id);
+    }
+  }
+  return result;
+}
+
+}
+}
+
+#endif  // SRC_LIB_STORAGE_SECONDARYINDEX_H_
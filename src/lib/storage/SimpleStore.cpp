@@ -41,6 +41,10 @@ size_t SimpleStore::columnCount() const {
   return _main->columnCount();
 }
 
+size_t SimpleStore::columnBytes(const size_t column) const {
+  return _main->columnBytes(column) + _delta->columnBytes(column);
+}
+
 void SimpleStore::setDictionaryAt(AbstractTable::SharedDictionaryPtr dict,
                      const size_t column, const size_t row, const table_id_t table_id) {
   _main->setDictionaryAt(dict, column, row, table_id);
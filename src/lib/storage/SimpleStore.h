@@ -37,6 +37,11 @@ public:
    */
   size_t size() const;
 
+  /**
+   * @see AbstractTable
+   */
+  size_t columnBytes(size_t column) const;
+
   /**
    * @see AbstractTable
    */
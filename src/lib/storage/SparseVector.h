@@ -0,0 +1,86 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_SPARSEVECTOR_H_
+#define SRC_LIB_STORAGE_SPARSEVECTOR_H_
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "storage/EncodedAttributeVector.h"
+
+/*
+  Column of mostly one value: every row has the default value except the
+  exceptions, which are stored as sorted rows with their values.
+*/
+template <typename T>
+class SparseVector : public EncodedAttributeVector<T> {
+public:
+  typedef T value_type;
+
+  SparseVector(const std::vector<T> &values, T default_value) :
+      EncodedAttributeVector<T>(values.size()), _default(default_value) {
+    for (size_t row = 0; row < values.size(); ++row) {
+      if (values[row] != default_value) {
+        _positions.push_back(row);
+        _values.push_back(values[row]);
+      }
+    }
+  }
+
+  T get(size_t column, size_t row) const {
+    this->checkAccess(column, row);
+    const auto it = std::lower_bound(_positions.begin(), _positions.end(), row);
+    return (it != _positions.end() && *it == row) ? _values[it - _positions.begin()] : _default;
+  }
+
+  void set(size_t column, size_t row, T value) {
+    this->checkAccess(column, row);
+    const auto it = std::lower_bound(_positions.begin(), _positions.end(), row);
+    const size_t i = it - _positions.begin();
+    const bool exception = it != _positions.end() && *it == row;
+    if (value == _default) {
+      if (exception) {
+        _positions.erase(it);
+        _values.erase(_values.begin() + i);
+      }
+    } else if (exception) {
+      _values[i] = value;
+    } else {
+      _positions.insert(it, row);
+      _values.insert(_values.begin() + i, value);
+    }
+  }
+
+  T defaultValue() const {
+    return _default;
+  }
+
+  // Rows whose value is not the default, ascending
+  const std::vector<size_t> &exceptions() const {
+    return _positions;
+  }
+
+  // Value of the i-th exception
+  T exception(size_t i) const {
+    return _values[i];
+  }
+
+  std::string encoding() const {
+    return "Sparse";
+  }
+
+  size_t bytes() const {
+    return sizeof(T) + _positions.size() * sizeof(size_t) + _values.size() * sizeof(T);
+  }
+
+  std::shared_ptr<BaseAttributeVector<T>> copy() {
+    return std::make_shared<SparseVector>(*this);
+  }
+
+private:
+  T _default;
+  std::vector<size_t> _positions;
+  std::vector<T> _values;
+};
+
+#endif  // SRC_LIB_STORAGE_SPARSEVECTOR_H_
@@ -0,0 +1,93 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/SpillingHashTable.h"
+
+#include "storage/AbstractTable.h"
+#include "storage/HashTable.h"
+#include "storage/memory_usage.h"
+
+#include "memory/QueryArena.h"
+
+namespace hyrise {
+namespace storage {
+
+SpillingHashTable::SpillingHashTable(const c_atable_ptr_t &table, const field_list_t &fields, const size_t row_offset) :
+    _table(table), _fields(fields), _row_offset(row_offset) {
+}
+
+SpillingHashTable::~SpillingHashTable() {
+}
+
+size_t SpillingHashTable::estimatedBytes(const size_t rows, const size_t fields) {
+  const size_t key_bytes = fields == 1 ? sizeof(join_single_key_t) : sizeof(join_key_t) + fields * sizeof(size_t);
+  // Nodes with the header of their arena allocation, buckets while growing
+  return rows * (key_bytes + sizeof(pos_t) + map_node_bytes + 16 + 2 * sizeof(void *));
+}
+
+size_t SpillingHashTable::partitionOf(const c_atable_ptr_t &table, const field_list_t &columns,
+                                      const pos_t row, const size_t partitions) {
+  const auto key = GroupKeyHash<join_key_t>::getGroupKey(table, columns, columns.size(), row);
+  // The upper bits, hash tables of a partition use the lower ones
+  return ((GroupKeyHash<join_key_t>()(key) * 0x9e3779b97f4a7c15ull) >> 32) % partitions;
+}
+
+void SpillingHashTable::partition(const c_atable_ptr_t &table, const field_list_t &columns,
+                                  memory::SpilledPartitions &partitions) {
+  for (pos_t row = 0, rows = table->size(); row < rows; ++row)
+    partitions.add(partitionOf(table, columns, row, partitions.size()), row);
+}
+
+void SpillingHashTable::checkPartition(const size_t rows, const size_t fields) {
+  if (!memory::QueryArena::fits(estimatedBytes(rows, fields)))
+    throw std::runtime_error("A partition of " + std::to_string(rows) + " rows does not fit into the memory limit "
+                             "of the query, the keys are too skewed or the table is too large to spill");
+}
+
+const memory::SpilledPartitions &SpillingHashTable::partitions() const {
+  std::call_once(_partitioned, [this]() {
+    _partitions.reset(new memory::SpilledPartitions(
+        memory::SpilledPartitions::partitionsFor(estimatedBytes(_table->size(), _fields.size()))));
+    partition(_table, _fields, *_partitions);
+  });
+  return *_partitions;
+}
+
+size_t SpillingHashTable::getRowOffset() const {
+  return _row_offset;
+}
+
+size_t SpillingHashTable::size() const {
+  return _table->size();
+}
+
+pos_list_t SpillingHashTable::get(const c_atable_ptr_t &table, const field_list_t &columns, const pos_t row) const {
+  const auto key = GroupKeyHash<join_key_t>::getGroupKey(table, columns, columns.size(), row);
+  pos_list_t result;
+  for (pos_t own = 0, rows = _table->size(); own < rows; ++own) {
+    if (GroupKeyHash<join_key_t>::getGroupKey(_table, _fields, _fields.size(), own) == key)
+      result.push_back(own + _row_offset);
+  }
+  return result;
+}
+
+c_atable_ptr_t SpillingHashTable::getTable() const {
+  return _table;
+}
+
+field_list_t SpillingHashTable::getFields() const {
+  return _fields;
+}
+
+size_t SpillingHashTable::getFieldCount() const {
+  return _fields.size();
+}
+
+uint64_t SpillingHashTable::numKeys() const {
+  return _table->size();
+}
+
+size_t SpillingHashTable::bytes() const {
+  return _fields.capacity() * sizeof(field_t);
+}
+
+}
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_SPILLINGHASHTABLE_H_
+#define SRC_LIB_STORAGE_SPILLINGHASHTABLE_H_
+
+#include <memory>
+#include <mutex>
+
+#include "helper/types.h"
+
+#include "memory/SpillFile.h"
+
+#include "storage/AbstractHashTable.h"
+
+namespace hyrise {
+namespace storage {
+
+/// Stands in for the hash table of a HashBuild whose input does not fit
+/// into the memory limit of the query. It keeps only the table and the
+/// key columns; GroupByScan and HashJoinProbe hash one partition of the
+/// table at a time instead. The table is partitioned to spill files once,
+/// by the first operation that needs the partitions.
+class SpillingHashTable : public AbstractHashTable {
+ public:
+  /// `row_offset` is added to the positions of rows like in HashTable
+  SpillingHashTable(const c_atable_ptr_t &table, const field_list_t &fields, size_t row_offset = 0);
+  virtual ~SpillingHashTable();
+
+  /// Bytes a hash table over `rows` rows and `fields` key columns takes
+  static size_t estimatedBytes(size_t rows, size_t fields);
+
+  /// Partition of the key in `columns` of `row`. Equal values belong to
+  /// the same partition in every table.
+  static size_t partitionOf(const c_atable_ptr_t &table, const field_list_t &columns, pos_t row, size_t partitions);
+
+  /// Adds the rows of `table` to their partitions
+  static void partition(const c_atable_ptr_t &table, const field_list_t &columns,
+                        memory::SpilledPartitions &partitions);
+
+  /// Throws if the hash table of a partition of `rows` rows does not fit
+  /// into the memory left for the query, i.e. its keys are too skewed or
+  /// the table is too large even for max_partitions partitions
+  static void checkPartition(size_t rows, size_t fields);
+
+  /// Rows of the table by partition, shared by all operations using the
+  /// hash table
+  const memory::SpilledPartitions &partitions() const;
+
+  size_t getRowOffset() const;
+
+  /// Number of rows in the table
+  size_t size() const;
+  /// Scans all rows of the table
+  pos_list_t get(const c_atable_ptr_t &table, const field_list_t &columns, pos_t row) const;
+  c_atable_ptr_t getTable() const;
+  field_list_t getFields() const;
+  size_t getFieldCount() const;
+  /// Number of rows, the keys are only known after partitioning
+  uint64_t numKeys() const;
+  size_t bytes() const;
+
+ private:
+  c_atable_ptr_t _table;
+  const field_list_t _fields;
+  const size_t _row_offset;
+  mutable std::once_flag _partitioned;
+  mutable std::unique_ptr<memory::SpilledPartitions> _partitions;
+};
+
+}
+}
+
+#endif  // SRC_LIB_STORAGE_SPILLINGHASHTABLE_H_
@@ -1,6 +1,8 @@
 // Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
 #include <storage/Store.h>
+#include <algorithm>
 #include <iostream>
+#include <set>
 
 
 #include <io/TransactionManager.h>
@@ -11,18 +13,22 @@
 #include <helper/locking.h>
 #include <helper/cas.h>
 
+#include "storage/CompressionAdvisor.h"
 #include "storage/DictionaryFactory.h"
 #include "storage/ConcurrentUnorderedDictionary.h"
 #include "storage/ConcurrentFixedLengthVector.h"
+#include "storage/GroupKeyIndex.h"
+#include "storage/SecondaryIndex.h"
 
 namespace hyrise { namespace storage {
 
 TableMerger* createDefaultMerger() {
-  return new TableMerger(new DefaultMergeStrategy, new SequentialHeapMerger, false);
+  return new TableMerger(new DefaultMergeStrategy, new SequentialHeapMerger, true);
 }
 
 Store::Store() :
-  merger(createDefaultMerger()) {
+  merger(createDefaultMerger()),
+  _allocator(memory::Allocator::current()) {
   setUuid();
 }
 
@@ -38,9 +44,12 @@ Store::Store(atable_ptr_t main_table) :
     _main_table(main_table),
     delta(main_table->copy_structure(create_concurrent_dict, create_concurrent_storage)),
     merger(createDefaultMerger()),
+    _allocator(memory::Allocator::current()),
     _cidBeginVector(main_table->size(), 0),
     _cidEndVector(main_table->size(), tx::INF_CID),
-    _tidVector(main_table->size(), tx::UNKNOWN) {
+    _tidVector(main_table->size(), tx::UNKNOWN),
+    _main_zones(ZoneMap::build(main_table)),
+    _delta_zones(std::make_shared<ZoneMap>(main_table->columnCount())) {
   setUuid();
 }
 
@@ -49,9 +58,14 @@ Store::~Store() {
 }
 
 void Store::merge() {
+  merge(nullptr);
+}
+
+void Store::merge(atable_ptr_t new_main) {
   if (merger == nullptr) {
     throw std::runtime_error("No Merger set.");
   }
+  memory::AllocatorScope allocator(_allocator);
 
   // Create new delta and merge
   atable_ptr_t new_delta = delta->copy_structure(create_concurrent_dict, create_concurrent_storage);
@@ -66,9 +80,12 @@ void Store::merge() {
     validPositions[i] = isVisibleForTransaction(i, last_commit_id, tx::MERGE_TID);
   });
 
-  auto tables = merger->merge(tmp, true, validPositions);
+  auto tables = new_main == nullptr ?
+      merger->merge(tmp, true, validPositions) :
+      merger->mergeToTable(new_main, tmp, true, validPositions);
   assert(tables.size() == 1);
   _main_table = tables.front();
+  CompressionAdvisor::compress(_main_table);
   // Fixup the cid and tid vectors
   _cidBeginVector = tbb::concurrent_vector<tx::transaction_cid_t>(_main_table->size(), tx::UNKNOWN_CID);
   _cidEndVector = tbb::concurrent_vector<tx::transaction_cid_t>(_main_table->size(), tx::INF_CID);
@@ -77,6 +94,17 @@ void Store::merge() {
   // Replace the delta partition
   delta = new_delta;
   _delta_size = new_delta->size();
+
+  _main_zones = ZoneMap::build(_main_table);
+  _delta_zones = std::make_shared<ZoneMap>(delta->columnCount());
+
+  {
+    std::lock_guard<std::mutex> lock(_group_keys_mutex);
+    for (auto& group_keys : _group_keys)
+      group_keys.second = GroupKeyIndex::build(_main_table, group_keys.first);
+  }
+  for (const auto& index : _indexes)
+    index->rebuild();
 }
 
 
@@ -88,6 +116,74 @@ atable_ptr_t Store::getDeltaTable() const {
   return delta;
 }
 
+std::shared_ptr<const ZoneMap> Store::zoneMap(const table_id_t table_id) const {
+  return table_id == 0 ? _main_zones : _delta_zones;
+}
+
+std::shared_ptr<const GroupKeyIndex> Store::groupKeyIndex(const field_t column) const {
+  std::lock_guard<std::mutex> lock(_group_keys_mutex);
+  auto& index = _group_keys[column];
+  if (!index)
+    index = GroupKeyIndex::build(_main_table, column);
+  return index;
+}
+
+void Store::addIndex(const std::shared_ptr<SecondaryIndex>& index) {
+  _indexes.push_back(index);
+}
+
+std::vector<std::shared_ptr<SecondaryIndex>> Store::indexes() const {
+  return std::vector<std::shared_ptr<SecondaryIndex>>(_indexes.begin(), _indexes.end());
+}
+
+void Store::indexDelta(const size_t begin, const size_t end) {
+  for (const auto& index : _indexes)
+    index->addDeltaRows(begin, end);
+}
+
+void Store::setPrimaryKey(const std::shared_ptr<SecondaryIndex>& index) {
+  if (_primary_key)
+    throw std::runtime_error("The store already has a primary key");
+  _primary_key = index;
+  addIndex(index);
+}
+
+std::shared_ptr<SecondaryIndex> Store::primaryKey() const {
+  return _primary_key;
+}
+
+std::unique_lock<std::mutex> Store::lockPrimaryKey() const {
+  return std::unique_lock<std::mutex>(_primary_key_mutex);
+}
+
+bool Store::holdsKey(const pos_t pos, const tx::transaction_id_t tid) const {
+  if (_cidEndVector[pos] != tx::INF_CID)
+    return false;
+  if (_cidBeginVector[pos] != tx::INF_CID)
+    return _tidVector[pos] != tid;
+  return _tidVector[pos] == tid || tx::TransactionManager::isRunningTransaction(_tidVector[pos]);
+}
+
+void Store::checkPrimaryKey(const c_atable_ptr_t& rows, const tx::transaction_id_t tid) const {
+  if (!_primary_key)
+    return;
+
+  const auto& fields = _primary_key->fields();
+  std::set<std::vector<value_id_t>> keys;
+  for (size_t row = 0; row < rows->size(); ++row) {
+    std::vector<value_id_t> key;
+    for (const auto& field : fields)
+      key.push_back(rows->getValueId(field, row).valueId);
+    if (!keys.insert(key).second)
+      throw std::runtime_error("Duplicate primary key in row " + std::to_string(row) + " of the inserted rows");
+
+    for (const auto& pos : _primary_key->lookup(_primary_key->keyOf(rows, row))) {
+      if (holdsKey(pos, tid))
+        throw std::runtime_error("Row " + std::to_string(row) + " of the inserted rows violates the primary key");
+    }
+  }
+}
+
 const ColumnMetadata *Store::metadataAt(const size_t column_index, const size_t row_index, const table_id_t table_id) const {
   size_t offset = _main_table->size();
   if (row_index < offset) {
@@ -131,6 +227,9 @@ inline Store::table_offset_idx_t Store::responsibleTable(const size_t row) const
 void Store::setValueId(const size_t column, const size_t row, ValueId vid) {
   auto location = responsibleTable(row);
   location.table->setValueId(column, location.offset_in_table, vid);
+  const auto& zones = location.table_index == 0 ? _main_zones : _delta_zones;
+  if (zones)
+    zones->extend(column, location.offset_in_table, vid.valueId);
 }
 
 ValueId Store::getValueId(const size_t column, const size_t row) const {
@@ -140,6 +239,37 @@ ValueId Store::getValueId(const size_t column, const size_t row) const {
   return valueId;
 }
 
+void Store::gatherValueIds(const size_t column, const pos_list_t &rows, std::vector<ValueId> &valueIds) const {
+  const size_t offset = _main_table->size();
+  if (std::all_of(rows.begin(), rows.end(), [offset](const pos_t row) { return row < offset; })) {
+    _main_table->gatherValueIds(column, rows, valueIds);
+    return;
+  }
+
+  // Gather main and delta rows separately and interleave the results
+  pos_list_t main_rows, delta_rows;
+  for (const auto& row : rows) {
+    if (row < offset) {
+      main_rows.push_back(row);
+    } else {
+      delta_rows.push_back(row - offset);
+    }
+  }
+  std::vector<ValueId> main_ids, delta_ids;
+  _main_table->gatherValueIds(column, main_rows, main_ids);
+  delta->gatherValueIds(column, delta_rows, delta_ids);
+
+  valueIds.resize(rows.size());
+  size_t next_main = 0, next_delta = 0;
+  for (size_t i = 0; i < rows.size(); ++i) {
+    if (rows[i] < offset) {
+      valueIds[i] = main_ids[next_main++];
+    } else {
+      valueIds[i] = delta_ids[next_delta++];
+      valueIds[i].table = 1;
+    }
+  }
+}
 
 size_t Store::size() const {
   return _main_table->size() + delta->size();
@@ -175,6 +305,29 @@ void Store::setMerger(TableMerger *_merger) {
 
 void Store::setDelta(atable_ptr_t _delta) {
   delta = _delta;
+  _delta_zones = ZoneMap::build(delta);
+}
+
+size_t Store::columnBytes(const size_t column) const {
+  return _main_table->columnBytes(column) + delta->columnBytes(column);
+}
+
+size_t Store::bytes() const {
+  return AbstractTable::bytes() + transactionBytes() + indexBytes();
+}
+
+size_t Store::transactionBytes() const {
+  return (_cidBeginVector.capacity() + _cidEndVector.capacity() + _tidVector.capacity()) * sizeof(tx::transaction_id_t);
+}
+
+size_t Store::indexBytes() const {
+  size_t result = 0;
+  for (const auto& index : _indexes)
+    result += index->bytes();
+  std::lock_guard<std::mutex> lock(_group_keys_mutex);
+  for (const auto& group_keys : _group_keys)
+    result += group_keys.second ? group_keys.second->bytes() : 0;
+  return result;
 }
 
 atable_ptr_t Store::copy() const {
@@ -182,6 +335,8 @@ atable_ptr_t Store::copy() const {
 
   new_store->_main_table = _main_table->copy();
   new_store->delta = delta->copy();
+  new_store->_main_zones = ZoneMap::build(new_store->_main_table);
+  new_store->_delta_zones = ZoneMap::build(new_store->delta);
 
   if (merger == nullptr) {
     new_store->merger = nullptr;
@@ -273,6 +428,8 @@ std::pair<size_t, size_t> Store::resizeDelta(size_t num) {
 std::pair<size_t, size_t> Store::appendToDelta(size_t num) {
   std::size_t start =_delta_size.fetch_add(num);
   delta->resize(start + num);
+  if (_delta_zones)
+    _delta_zones->reserve(start + num);
 
   auto main_tables_size = _main_table->size();
   _cidBeginVector.resize(main_tables_size + start + num, tx::INF_CID);
@@ -289,6 +446,8 @@ void Store::copyRowToDelta(const c_atable_ptr_t& source, const size_t src_row, c
   _tidVector[main_tables_size + dst_row] = tid;
 
   delta->copyRowFrom(source, src_row, dst_row, true);
+  if (_delta_zones)
+    _delta_zones->extendRow(delta, dst_row);
 }
 
 tx::TX_CODE Store::commitPositions(const pos_list_t& pos, const tx::transaction_cid_t cid, bool valid) {
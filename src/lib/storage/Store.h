@@ -15,14 +15,22 @@
 #include <storage/AbstractMergeStrategy.h>
 #include <storage/SequentialHeapMerger.h>
 #include <storage/PrettyPrinter.h>
+#include <storage/ZoneMap.h>
 
 #include <helper/types.h>
+#include <memory/Allocator.h>
+
+#include <map>
+#include <mutex>
 
 #include "tbb/concurrent_vector.h"
 
 namespace hyrise {
 namespace storage {
 
+class GroupKeyIndex;
+class SecondaryIndex;
+
 /**
  * Store consists of one or more main tables and a delta store and is the
  * only entity capable of modifying the content of the table(s) after
@@ -39,8 +47,51 @@ public:
   void setDelta(atable_ptr_t _delta);
   atable_ptr_t getDeltaTable() const;
   size_t deltaOffset() const;
+
+  /// Merges main and delta into a new main. Columns of the new main that
+  /// have an attribute vector of their own get the encoding the
+  /// CompressionAdvisor picks for them. The new main is allocated with
+  /// the allocator of the store.
   void merge();
 
+  /// Merges main and delta into `new_main`, an empty table with the
+  /// columns of the current main table, e.g. in a different vertical
+  /// partitioning
+  void merge(atable_ptr_t new_main);
+
+  /// Zone map of the main (table_id 0) or the delta (table_id 1), rows
+  /// are relative to that table
+  std::shared_ptr<const ZoneMap> zoneMap(table_id_t table_id) const;
+
+  /// Rows of every value id of `column` in the main, built on first use
+  /// and rebuilt by merge()
+  std::shared_ptr<const GroupKeyIndex> groupKeyIndex(field_t column) const;
+
+  /// Keeps `index` up to date: merge() rebuilds it, indexDelta() adds
+  /// delta rows to it
+  void addIndex(const std::shared_ptr<SecondaryIndex>& index);
+  std::vector<std::shared_ptr<SecondaryIndex>> indexes() const;
+
+  /// Adds the delta rows [begin, end), as returned by appendToDelta, to
+  /// all indexes. Writers call it once all values of the rows are set.
+  void indexDelta(size_t begin, size_t end);
+
+  /// Declares the key columns of `index` the primary key of the store and
+  /// maintains the index like addIndex
+  void setPrimaryKey(const std::shared_ptr<SecondaryIndex>& index);
+  std::shared_ptr<SecondaryIndex> primaryKey() const;
+
+  /// Serializes inserts into a store with a primary key: inserters hold
+  /// the lock from checkPrimaryKey until their rows are indexed
+  std::unique_lock<std::mutex> lockPrimaryKey() const;
+
+  /// Throws if two of `rows` (a table with the columns of the store) have
+  /// the same primary key or a row of the store holds the key of one of
+  /// them. Rows hold their key unless they are deleted, or inserted by a
+  /// transaction other than `tid` that is no longer running, i.e. rolled
+  /// back. Rows transaction `tid` marked for deletion free their key.
+  void checkPrimaryKey(const c_atable_ptr_t& rows, tx::transaction_id_t tid) const;
+
   /// Replaces the merger used for merging main tables with delta.
   /// @param _merger Pointer to a merger instance.
   void setMerger(TableMerger *_merger);
@@ -76,6 +127,7 @@ public:
   const AbstractTable::SharedDictionaryPtr& dictionaryAt(size_t column, size_t row = 0, table_id_t table_id = 0) const override;
   const AbstractTable::SharedDictionaryPtr& dictionaryByTableId(size_t column, table_id_t table_id) const override;
   ValueId getValueId(size_t column, size_t row) const override;
+  void gatherValueIds(size_t column, const pos_list_t &rows, std::vector<ValueId> &valueIds) const override;
   void setValueId(size_t column, size_t row, ValueId vid) override;
   size_t size() const override;
   size_t columnCount() const override;
@@ -84,9 +136,17 @@ public:
   void print(size_t limit = (size_t) - 1) const override;
   table_id_t subtableCount() const override { return 2; }
   atable_ptr_t copy() const override;
+  size_t columnBytes(size_t column) const override;
+  /// Bytes of main, delta, transaction vectors and indexes
+  size_t bytes() const override;
   const attr_vectors_t getAttributeVectors(size_t column) const override;
   void debugStructure(size_t level=0) const override;
 
+  /// Bytes of the begin, end and transaction id vectors
+  size_t transactionBytes() const;
+  /// Bytes of the secondary and group key indexes
+  size_t indexBytes() const;
+
  private:
   std::atomic<std::size_t> _delta_size;
   //* Vector containing the main tables
@@ -98,6 +158,22 @@ public:
   //* Current merger
   TableMerger *merger;
 
+  //* Allocator that was current when the store was created, the mains of
+  //* its merges use it as well
+  memory::Allocator *_allocator;
+
+  //* Group key indexes of the main by column
+  mutable std::mutex _group_keys_mutex;
+  mutable std::map<field_t, std::shared_ptr<GroupKeyIndex>> _group_keys;
+
+  //* Secondary indexes on the store
+  tbb::concurrent_vector<std::shared_ptr<SecondaryIndex>> _indexes;
+
+  //* Index of the primary key, if the store has one
+  std::shared_ptr<SecondaryIndex> _primary_key;
+  mutable std::mutex _primary_key_mutex;
+  bool holdsKey(pos_t pos, tx::transaction_id_t tid) const;
+
   typedef struct { const atable_ptr_t& table; size_t offset_in_table; size_t table_index; } table_offset_idx_t;
   table_offset_idx_t responsibleTable(size_t row) const;
  
@@ -108,6 +184,10 @@ public:
   tbb::concurrent_vector<tx::transaction_id_t> _cidEndVector;
   // Stores the TID for each record to identify your own writes
   tbb::concurrent_vector<tx::transaction_id_t> _tidVector;
+
+  //* Value id synopses of main and delta
+  std::shared_ptr<ZoneMap> _main_zones;
+  std::shared_ptr<ZoneMap> _delta_zones;
   friend class PrettyPrinter;
 };
 
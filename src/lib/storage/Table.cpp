@@ -5,7 +5,10 @@
 #include <cmath>
 
 #include "storage/AttributeVectorFactory.h"
+#include "storage/BitCompressedVector.h"
+#include "storage/ConcurrentFixedLengthVector.h"
 #include "storage/DictionaryFactory.h"
+#include "storage/FixedLengthVector.h"
 #include "storage/ValueIdMap.hpp"
 
 using namespace hyrise::storage;
@@ -51,7 +54,7 @@ Table::Table(
     std::vector<uint64_t> bits(_dictionaries.size(), 0);
     if (d) {
       for (size_t i = 0; i < _dictionaries.size(); ++i)
-        bits[i] = _dictionaries[i]->size() == 1 ? 1 : ceil(log(_dictionaries[i]->size()) / log(2.0));
+        bits[i] = bitsForValues(_dictionaries[i]->size());
     }
     tuples = AttributeVectorFactory::getAttributeVector2<value_id_t>(width, initial_size, compressed, bits);
   }
@@ -176,6 +179,46 @@ ValueId Table::getValueId(const size_t column, const size_t row) const {
 }
 
 
+namespace {
+
+// Decodes the value ids of all rows with one call of `get` each, which the
+// compiler inlines for the concrete vector types
+template <typename Get>
+void gather(Get get, const pos_list_t &rows, std::vector<ValueId> &valueIds) {
+  valueIds.resize(rows.size());
+  for (size_t i = 0; i < rows.size(); ++i) {
+    valueIds[i].valueId = get(rows[i]);
+    valueIds[i].table = 0;
+  }
+}
+
+}
+
+void Table::gatherValueIds(const size_t column, const pos_list_t &rows, std::vector<ValueId> &valueIds) const {
+  assert(column < width);
+  typedef FixedLengthVector<value_id_t> fixed_t;
+  typedef BitCompressedVector<value_id_t> compressed_t;
+  typedef ConcurrentFixedLengthVector<value_id_t> concurrent_t;
+
+  const auto vector = tuples.get();
+  if (const auto fixed = dynamic_cast<const fixed_t *>(vector)) {
+    gather([fixed, column](const pos_t row) { return fixed->fixed_t::get(column, row); }, rows, valueIds);
+  } else if (const auto compressed = dynamic_cast<const compressed_t *>(vector)) {
+    if (const auto bytes = compressed->aligned<uint8_t>())
+      gather([bytes](const pos_t row) { return bytes[row]; }, rows, valueIds);
+    else if (const auto shorts = compressed->aligned<uint16_t>())
+      gather([shorts](const pos_t row) { return shorts[row]; }, rows, valueIds);
+    else
+      gather([compressed, column](const pos_t row) { return compressed->compressed_t::get(column, row); }, rows,
+             valueIds);
+  } else if (const auto concurrent = dynamic_cast<const concurrent_t *>(vector)) {
+    gather([concurrent, column](const pos_t row) { return concurrent->concurrent_t::getRef(column, row); }, rows,
+           valueIds);
+  } else {
+    gather([vector, column](const pos_t row) { return vector->get(column, row); }, rows, valueIds);
+  }
+}
+
 void Table::setValueId(const size_t column, const size_t row, const ValueId valueId) {
   assert(column < width);
   tuples->set(column, row, valueId.valueId);
@@ -210,10 +253,10 @@ const AbstractTable::SharedDictionaryPtr& Table::dictionaryByTableId(const size_
 
 void Table::setDictionaryAt(AbstractTable::SharedDictionaryPtr dict, const size_t column, const size_t row, const table_id_t table_id) {
 
-  // Swap the dictionaries
-  if (_dictionaries[column] == nullptr || _dictionaries[column]->size() != dict->size()) {
-    // Rewrite the doc vector
-    tuples->rewriteColumn(column, dict->size() == 1 ? 1 : ceil(log(dict->size()) / log(2)));
+  // Swap the dictionaries, compressed attribute vectors store the column
+  // with the minimal bit width for the new dictionary
+  if (_compressed && (_dictionaries[column] == nullptr || _dictionaries[column]->size() != dict->size())) {
+    tuples->rewriteColumn(column, bitsForValues(dict->size()));
   }
   _dictionaries[column] = dict;
 }
@@ -225,6 +268,13 @@ void Table::setAttributes(SharedAttributeVector doc) {
 }
 
 
+size_t Table::columnBytes(const size_t column) const {
+  size_t result = _dictionaries[column] ? _dictionaries[column]->bytes() : 0;
+  if (tuples)
+    result += tuples->bytes() / columnCount();
+  return result;
+}
+
 hyrise::storage::atable_ptr_t Table::copy() const {
   auto new_table = std::make_shared<table_type>(new std::vector<const ColumnMetadata *>(_metadata.begin(), _metadata.end()));
 
@@ -11,6 +11,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <iostream>
 
 #include "helper/types.h"
 
@@ -85,6 +86,8 @@ public:
 
   ValueId getValueId(const size_t column, const size_t row) const;
 
+  void gatherValueIds(const size_t column, const pos_list_t &rows, std::vector<ValueId> &valueIds) const;
+
   void setValueId(const size_t column, const size_t row, const ValueId valueId);
 
   void reserve(const size_t nr_of_values);
@@ -120,6 +123,8 @@ public:
 
   virtual hyrise::storage::atable_ptr_t copy() const;
 
+  virtual size_t columnBytes(size_t column) const;
+
   void setNumRows(size_t s) {
     tuples->setNumRows(s);
   }
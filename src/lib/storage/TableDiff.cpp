@@ -53,15 +53,22 @@ bool line_equal(const AbstractTable* const left,
   return true;
 }
 
+// Columns that occur several times under one name, e.g. in join results,
+// are paired by the order of their occurrence
 std::map<field_t, field_t> compareSchemas(const AbstractTable* const left,
                                                      const AbstractTable* const right) {
   std::map<field_t, field_t> m;
+  std::map<std::string, size_t> occurrences;
   for (field_t col_left = 0; col_left < left->columnCount(); col_left++) {
-    try{
-      field_t col_right = right->numberOfColumn(left->nameOfColumn(col_left));
+    const std::string name = left->nameOfColumn(col_left);
+    size_t occurrence = occurrences[name]++;
+    for (field_t col_right = 0; col_right < right->columnCount(); col_right++) {
+      if (right->nameOfColumn(col_right) == name) {
         m[col_left] = col_right;
+        if (occurrence-- == 0)
+          break;
+      }
     }
-    catch (MissingColumnException exception) {}
   }
 
   return m;
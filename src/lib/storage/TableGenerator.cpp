@@ -17,6 +17,7 @@
 #include <storage/MutableVerticalTable.h>
 #include <storage/AbstractMergeStrategy.h>
 #include <storage/SequentialHeapMerger.h>
+#include <storage/Store.h>
 #include <storage/TableMerger.h>
 #include <helper/Progress.h>
 
@@ -971,4 +972,16 @@ hyrise::storage::atable_ptr_t TableGenerator::int_random_weighted_delta(size_t r
 }
 
 
+std::pair<size_t, size_t> TableGenerator::append_committed(const std::shared_ptr<Store> &store, size_t rows,
+                                                           const std::function<void(pos_t)> &fill) {
+  const auto area = store->appendToDelta(rows);
+  pos_list_t written;
+  for (pos_t row = store->deltaOffset() + area.first; row < store->deltaOffset() + area.second; ++row) {
+    fill(row);
+    written.push_back(row);
+  }
+  store->commitPositions(written, tx::UNKNOWN_CID, true);
+  return area;
+}
+
 }}
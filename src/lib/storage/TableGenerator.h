@@ -6,6 +6,8 @@
 #include <stdlib.h>
 #include <time.h>
 
+#include <functional>
+#include <memory>
 #include <vector>
 #include <string>
 #include <set>
@@ -14,6 +16,8 @@
 
 namespace hyrise { namespace storage {
 
+class Store;
+
 class TableGenerator {
  public:
 
@@ -68,6 +72,14 @@ class TableGenerator {
   hyrise::storage::atable_ptr_t int_random_weighted(size_t rows, size_t cols, size_t n, size_t h);
   hyrise::storage::atable_ptr_t int_random_weighted_delta(size_t rows, size_t cols, size_t n, size_t h);
 
+  /*
+    Appends `rows` rows to the delta of `store` and commits them. `fill`
+    sets the values of every new row, given its position in the store.
+    Returns the new delta rows like Store::appendToDelta.
+  */
+  std::pair<size_t, size_t> append_committed(const std::shared_ptr<Store> &store, size_t rows,
+                                             const std::function<void(pos_t)> &fill);
+
  protected:
   bool _quiet;
   size_t _total;
@@ -74,6 +74,10 @@ table_id_t TableRangeView::subtableCount() const{
   return 1;
 }
 
+size_t TableRangeView::columnBytes(size_t column) const {
+  return 0;
+}
+
 atable_ptr_t TableRangeView::copy() const{
   return std::make_shared<TableRangeView>(_table, _start, _end);
 }
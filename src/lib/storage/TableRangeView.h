@@ -35,6 +35,8 @@ public:
   // specific to TableRangeView
   table_id_t subtableCount() const;
   atable_ptr_t copy() const;
+  // Columns belong to the viewed table
+  size_t columnBytes(size_t column) const;
   void print(const size_t limit = (size_t) -1) const;
   c_atable_ptr_t getTable() const;
   c_atable_ptr_t getActualTable() const;
@@ -0,0 +1,81 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#include "storage/ZoneMap.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "storage/AbstractTable.h"
+#include "storage/BaseAttributeVector.h"
+
+namespace hyrise {
+namespace storage {
+
+const size_t ZoneMap::chunk_rows;
+
+ZoneMap::ZoneMap(const size_t columns) : _columns(columns) {
+}
+
+std::shared_ptr<ZoneMap> ZoneMap::build(const c_atable_ptr_t &table) {
+  auto zones = std::make_shared<ZoneMap>(table->columnCount());
+  const size_t rows = table->size();
+  zones->reserve(rows);
+
+  for (size_t column = 0; column < table->columnCount(); ++column) {
+    attr_vectors_t vectors;
+    try {
+      vectors = table->getAttributeVectors(column);
+    } catch (const std::runtime_error &) {
+    }
+    std::shared_ptr<BaseAttributeVector<value_id_t> > vector;
+    if (vectors.size() == 1)
+      vector = std::dynamic_pointer_cast<BaseAttributeVector<value_id_t> >(vectors.front().attribute_vector);
+
+    for (size_t first = 0; first < rows; first += chunk_rows) {
+      const size_t last = std::min(rows, first + chunk_rows);
+      value_id_t min = std::numeric_limits<value_id_t>::max();
+      value_id_t max = 0;
+      for (size_t row = first; row < last; ++row) {
+        const value_id_t id = vector ? vector->get(vectors.front().attribute_offset, row)
+                                     : table->getValueId(column, row).valueId;
+        min = std::min(min, id);
+        max = std::max(max, id);
+      }
+      auto& zone = zones->_zones[first / chunk_rows * zones->_columns + column];
+      zone.min = min;
+      zone.max = max;
+    }
+  }
+  return zones;
+}
+
+void ZoneMap::reserve(const size_t rows) {
+  _zones.grow_to_at_least((rows + chunk_rows - 1) / chunk_rows * _columns);
+}
+
+void ZoneMap::extend(const size_t column, const size_t row, const value_id_t valueId) {
+  reserve(row + 1);
+  auto& zone = _zones[row / chunk_rows * _columns + column];
+  value_id_t current = zone.min;
+  while (valueId < current && !zone.min.compare_exchange_weak(current, valueId)) {}
+  current = zone.max;
+  while (valueId > current && !zone.max.compare_exchange_weak(current, valueId)) {}
+}
+
+void ZoneMap::extendRow(const c_atable_ptr_t &table, const size_t row) {
+  for (size_t column = 0; column < _columns; ++column)
+    extend(column, row, table->getValueId(column, row).valueId);
+}
+
+size_t ZoneMap::chunkCount() const {
+  return _zones.size() / std::max<size_t>(_columns, 1);
+}
+
+ZoneMap::Synopsis ZoneMap::synopsis(const size_t column, const size_t chunk) const {
+  if (chunk >= chunkCount())
+    return {std::numeric_limits<value_id_t>::max(), 0};
+  const auto& zone = _zones[chunk * _columns + column];
+  return {zone.min, zone.max};
+}
+
+}
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_ZONEMAP_H_
+#define SRC_LIB_STORAGE_ZONEMAP_H_
+
+#include <atomic>
+#include <limits>
+#include <memory>
+
+#include "tbb/concurrent_vector.h"
+
+#include "helper/types.h"
+
+namespace hyrise {
+namespace storage {
+
+/// Smallest and largest value id of every column in chunks of chunk_rows
+/// consecutive rows of a table.
+///
+/// Scans compare their value id filters against the synopsis of a chunk
+/// and skip chunks that cannot contain a match. The Store builds the zone
+/// map of its main table when the main is set, i.e. at load and merge
+/// time, and extends the zone map of its delta whenever it writes a delta
+/// row. Extending is safe while other threads extend or read the zone map.
+class ZoneMap {
+ public:
+  static const size_t chunk_rows = 65536;
+
+  struct Synopsis {
+    value_id_t min;
+    value_id_t max;
+
+    /// True if no row of the chunk has been written
+    bool empty() const {
+      return min > max;
+    }
+  };
+
+  explicit ZoneMap(size_t columns);
+
+  /// Zone map of all rows of `table`
+  static std::shared_ptr<ZoneMap> build(const c_atable_ptr_t &table);
+
+  /// Makes room for the chunks of `rows` rows
+  void reserve(size_t rows);
+
+  /// Widens the synopsis of the chunk of `row`
+  void extend(size_t column, size_t row, value_id_t valueId);
+
+  /// Widens the synopses of the chunk of `row` by the value ids the row
+  /// has in `table`
+  void extendRow(const c_atable_ptr_t &table, size_t row);
+
+  size_t columnCount() const {
+    return _columns;
+  }
+
+  /// Number of chunks with a synopsis
+  size_t chunkCount() const;
+
+  Synopsis synopsis(size_t column, size_t chunk) const;
+
+ private:
+  struct Zone {
+    std::atomic<value_id_t> min;
+    std::atomic<value_id_t> max;
+
+    Zone() : min(std::numeric_limits<value_id_t>::max()), max(0) {}
+  };
+
+  const size_t _columns;
+  // Zones of the chunk c at c * _columns
+  tbb::concurrent_vector<Zone> _zones;
+};
+
+}
+}
+
+#endif  // SRC_LIB_STORAGE_ZONEMAP_H_
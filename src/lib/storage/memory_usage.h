@@ -0,0 +1,58 @@
+// Copyright (c) 2012 Hasso-Plattner-Institut fuer Softwaresystemtechnik GmbH. All rights reserved.
+#ifndef SRC_LIB_STORAGE_MEMORY_USAGE_H_
+#define SRC_LIB_STORAGE_MEMORY_USAGE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace hyrise {
+namespace storage {
+
+/*
+  Approximate sizes of values and standard containers for the bytes()
+  of dictionaries, indices and hash tables.
+*/
+
+// Bytes a value keeps on the heap
+template <typename T>
+size_t heapBytes(const T &) {
+  return 0;
+}
+
+inline size_t heapBytes(const std::string &value) {
+  // Short strings are stored inline
+  return value.capacity() < sizeof(std::string) ? 0 : value.capacity() + 1;
+}
+
+template <typename T, typename A>
+size_t heapBytes(const std::vector<T, A> &values);
+
+template <typename T, typename A>
+size_t vectorBytes(const std::vector<T, A> &values) {
+  size_t result = values.capacity() * sizeof(T);
+  for (const auto& value : values)
+    result += heapBytes(value);
+  return result;
+}
+
+template <typename T, typename A>
+size_t heapBytes(const std::vector<T, A> &values) {
+  return vectorBytes(values);
+}
+
+// Bookkeeping of a node of std::map and unordered maps next to its value
+const size_t map_node_bytes = 4 * sizeof(void *);
+
+template <typename Map>
+size_t mapBytes(const Map &map) {
+  size_t result = map.size() * (sizeof(typename Map::value_type) + map_node_bytes);
+  for (const auto& entry : map)
+    result += heapBytes(entry.first) + heapBytes(entry.second);
+  return result;
+}
+
+}
+}
+
+#endif  // SRC_LIB_STORAGE_MEMORY_USAGE_H_
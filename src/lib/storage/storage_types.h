@@ -8,6 +8,8 @@
 #include <stdint.h>
 #include <ostream>
 
+#include "memory/QueryArena.h"
+
 
 #define STORAGE_XSTR(x) STORAGE_STR(x)
 #define STORAGE_STR(x) #x
@@ -47,7 +49,7 @@ typedef size_t field_t;
 typedef std::string field_name_t;
 typedef std::vector<field_name_t> field_name_list_t;
 
-typedef std::vector<pos_t> pos_list_t;
+typedef std::vector<pos_t, hyrise::memory::ArenaAllocator<pos_t> > pos_list_t;
 typedef std::vector<field_t> field_list_t;
 
 